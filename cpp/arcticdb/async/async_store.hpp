@@ -8,7 +8,10 @@
 #pragma once
 
 #include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/async/index_segment_cache.hpp>
+#include <arcticdb/async/read_hedging.hpp>
 #include <arcticdb/util/clock.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/storage/store.hpp>
 #include <arcticdb/entity/performance_tracing.hpp>
 #include <arcticdb/storage/library.hpp>
@@ -58,7 +61,7 @@ public:
 
         return async::submit_cpu_task(EncodeAtomTask{
             key_type, version_id, stream_id, start_index, end_index, current_timestamp(),
-            std::move(segment), codec_, encoding_version_
+            std::move(segment), codec_for(key_type), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(WriteSegmentTask{library_});
@@ -80,7 +83,7 @@ public:
 
         return async::submit_cpu_task(EncodeAtomTask{
             key_type, version_id, stream_id, start_index, end_index, creation_ts,
-            std::move(segment), codec_, encoding_version_
+            std::move(segment), codec_for(key_type), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(WriteSegmentTask{library_});
@@ -96,7 +99,7 @@ public:
         SegmentInMemory &&segment) override {
         util::check(is_ref_key_class(key_type), "Expected ref key type got  {}", key_type);
         return async::submit_cpu_task(EncodeRefTask{
-            key_type, stream_id, std::move(segment), codec_, encoding_version_
+            key_type, stream_id, std::move(segment), codec_for(key_type), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(WriteSegmentTask{library_});
@@ -117,7 +120,7 @@ public:
 
         auto encoded = EncodeAtomTask{
             key_type, version_id, stream_id, start_index, end_index, current_timestamp(),
-            std::move(segment), codec_, encoding_version_
+            std::move(segment), codec_for(key_type), encoding_version_
         }();
         return WriteSegmentTask{library_}(std::move(encoded));
     }
@@ -131,7 +134,7 @@ public:
         const StreamId &stream_id,
         SegmentInMemory &&segment) override {
         util::check(is_ref_key_class(key_type), "Expected ref key type got  {}", key_type);
-        auto encoded = EncodeRefTask{key_type, stream_id, std::move(segment), codec_, encoding_version_}();
+        auto encoded = EncodeRefTask{key_type, stream_id, std::move(segment), codec_for(key_type), encoding_version_}();
         return WriteSegmentTask{library_}(std::move(encoded));
     }
 
@@ -153,7 +156,7 @@ public:
                     segment.descriptor().id());
 
         return async::submit_cpu_task(EncodeSegmentTask{
-            key, std::move(segment), codec_, encoding_version_
+            key, std::move(segment), codec_for(variant_key_type(key)), encoding_version_
         })
             .via(&async::io_executor())
             .thenValue(UpdateSegmentTask{library_, opts});
@@ -183,17 +186,58 @@ public:
         library_->iterate_type(type, func, prefix);
     }
 
+    void iterate_type_parallel(KeyType type, entity::IterateTypeVisitor func) override {
+        const auto max_ranges = static_cast<size_t>(ConfigsMap::instance()->get_int("Storage.IterateTypeRanges", 16));
+        auto ranges = library_->key_ranges(type, max_ranges);
+        if(ranges.size() <= 1) {
+            library_->iterate_type(type, func);
+            return;
+        }
+
+        std::mutex visitor_mutex;
+        entity::IterateTypeVisitor serialized_visitor = [&visitor_mutex, &func](VariantKey&& key) {
+            std::lock_guard lock{visitor_mutex};
+            func(std::move(key));
+        };
+        std::vector<folly::Future<folly::Unit>> futures;
+        futures.reserve(ranges.size());
+        for(auto& range : ranges)
+            futures.emplace_back(async::submit_io_task(IterateTypeRangeTask{library_, type, std::move(range), serialized_visitor}));
+
+        // Every range must finish before rethrowing, as the visitor refers to this frame
+        auto results = folly::collectAll(futures).get();
+        for(auto& result : results)
+            result.throwUnlessValue();
+    }
+
+    void iterate_type_with_size(KeyType type, entity::IterateTypeWithSizeVisitor func,
+                                const std::string &prefix) override {
+        library_->iterate_type_with_size(type, func, prefix);
+    }
+
     folly::Future<std::pair<entity::VariantKey, SegmentInMemory>> read(const entity::VariantKey &key,
                                                                        storage::ReadKeyOpts opts) override {
+        if(auto cached = read_cached_index_segment(key))
+            return folly::makeFuture(std::move(*cached));
+
         return async::submit_io_task(ReadCompressedTask{key, library_, opts})
             .via(&async::cpu_executor())
-            .thenValue(DecodeSegmentTask{});
+            .thenValue(DecodeSegmentTask{})
+            .thenValue([library = library_](std::pair<entity::VariantKey, SegmentInMemory>&& key_seg) {
+                cache_index_segment(*library, key_seg);
+                return std::move(key_seg);
+            });
     }
 
     std::pair<entity::VariantKey, SegmentInMemory> read_sync(const entity::VariantKey &key,
                                                              storage::ReadKeyOpts opts) override {
+        if(auto cached = read_cached_index_segment(key))
+            return std::move(*cached);
+
         auto read_task = ReadCompressedTask{key, library_, opts};
-        return DecodeSegmentTask{}(read_task());
+        auto key_seg = DecodeSegmentTask{}(read_task());
+        cache_index_segment(*library_, key_seg);
+        return key_seg;
     }
 
     folly::Future<storage::KeySegmentPair> read_compressed(const entity::VariantKey &key,
@@ -303,9 +347,7 @@ public:
         std::vector<storage::KeySegmentPair> res;
         res.reserve(keys.size());
         for (auto key : keys) {
-            batch.push_back(async::submit_io_task(ReadCompressedTask(std::move(key),
-                                                                     library_,
-                                                                     storage::ReadKeyOpts{})));
+            batch.push_back(read_compressed_hedged(std::move(key)));
             if (batch.size() == args.batch_size_) {
                 if (may_fail)
                     copy_to_results_with_failure(batch, res, keys);
@@ -333,7 +375,7 @@ public:
         util::check(!keys.empty(), "Unexpected empty keys in batch_read_compressed");
 
         auto key_seg_futs = folly::window(keys, [*this](auto &&key) {
-            return async::submit_io_task(ReadCompressedTask(std::forward<decltype(key)>(key), library_, storage::ReadKeyOpts{}));
+            return read_compressed_hedged(entity::VariantKey{std::forward<decltype(key)>(key)});
         }, args.batch_size_);
 
         util::check(key_seg_futs.size() == keys.size(),
@@ -428,11 +470,12 @@ public:
 
         auto encode_futs = folly::window(key_segments, [*this](auto &&ks) {
             auto [key, seg] = std::forward<decltype(ks)>(ks);
+            auto codec = codec_for(key.key_type);
             return async::submit_cpu_task(
                 EncodeAtomTask(std::move(key),
                                ClockType::nanos_since_epoch(),
                                std::move(seg),
-                               codec_,
+                               std::move(codec),
                                encoding_version_));
         }, write_count);
 
@@ -461,9 +504,55 @@ public:
         library_->set_failure_sim(cfg);
     }
 
+    void set_key_type_codec(KeyType key_type, const std::optional<arcticdb::proto::encoding::VariantCodec>& codec) override {
+        std::lock_guard lock{key_type_codecs_->mutex_};
+        if(codec)
+            key_type_codecs_->codecs_[key_type] = std::make_shared<arcticdb::proto::encoding::VariantCodec>(*codec);
+        else
+            key_type_codecs_->codecs_.erase(key_type);
+    }
+
 private:
+    struct KeyTypeCodecs {
+        std::mutex mutex_;
+        std::unordered_map<KeyType, std::shared_ptr<arcticdb::proto::encoding::VariantCodec>> codecs_;
+    };
+
+    std::shared_ptr<arcticdb::proto::encoding::VariantCodec> codec_for(KeyType key_type) const {
+        std::lock_guard lock{key_type_codecs_->mutex_};
+        auto it = key_type_codecs_->codecs_.find(key_type);
+        return it == key_type_codecs_->codecs_.end() ? codec_ : it->second;
+    }
+
+    std::optional<std::pair<entity::VariantKey, SegmentInMemory>> read_cached_index_segment(const entity::VariantKey& key) const {
+        if(!IndexSegmentCache::is_cacheable(key))
+            return std::nullopt;
+
+        auto segment = IndexSegmentCache::instance()->get(library_->cache_id(), to_atom(key));
+        if(!segment)
+            return std::nullopt;
+
+        return std::make_pair(key, std::move(*segment));
+    }
+
+    static void cache_index_segment(storage::Library& library, const std::pair<entity::VariantKey, SegmentInMemory>& key_seg) {
+        if(IndexSegmentCache::is_cacheable(key_seg.first))
+            IndexSegmentCache::instance()->put(library.cache_id(), to_atom(key_seg.first), key_seg.second);
+    }
+
+    folly::Future<storage::KeySegmentPair> read_compressed_hedged(entity::VariantKey&& key) const {
+        return read_hedging_->read([library = library_, key = std::move(key)] (ReadHedging::OnStart on_start) {
+            return async::submit_io_task(ReadCompressedTask(key, library, storage::ReadKeyOpts{}, std::move(on_start)));
+        });
+    }
+
+
     std::shared_ptr<storage::Library> library_;
     std::shared_ptr<arcticdb::proto::encoding::VariantCodec> codec_;
+    // Copies of the store share their overrides
+    std::shared_ptr<KeyTypeCodecs> key_type_codecs_ = std::make_shared<KeyTypeCodecs>();
+    // Shared by copies of the store, so that they hedge from the same latencies and budget
+    std::shared_ptr<ReadHedging> read_hedging_ = std::make_shared<ReadHedging>();
     const EncodingVersion encoding_version_;
 };
 
@@ -0,0 +1,135 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/async/index_segment_cache.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <folly/hash/Hash.h>
+
+namespace arcticdb::async {
+
+std::shared_ptr<IndexSegmentCache> IndexSegmentCache::instance() {
+    std::call_once(IndexSegmentCache::init_flag_, &IndexSegmentCache::init);
+    return IndexSegmentCache::instance_;
+}
+
+void IndexSegmentCache::destroy_instance() {
+    if(instance_)
+        instance_->clear();
+    instance_.reset();
+}
+
+void IndexSegmentCache::init() {
+    instance_ = std::make_shared<IndexSegmentCache>();
+}
+
+IndexSegmentCache::IndexSegmentCache(std::optional<size_t> max_bytes) :
+    max_bytes_(max_bytes.value_or(static_cast<size_t>(std::max<int64_t>(
+        0, ConfigsMap::instance()->get_int("IndexSegmentCache.MaxBytes", 128 * 1024 * 1024))))),
+    max_candidates_(static_cast<size_t>(std::max<int64_t>(
+        1, ConfigsMap::instance()->get_int("IndexSegmentCache.MaxCandidates", 16 * 1024)))) {
+}
+
+size_t IndexSegmentCache::CacheKeyHash::operator()(const CacheKey& cache_key) const {
+    return folly::hash::hash_combine(std::hash<std::string>{}(cache_key.first), std::hash<entity::AtomKey>{}(cache_key.second));
+}
+
+std::optional<SegmentInMemory> IndexSegmentCache::get(const std::string& library_id, const entity::AtomKey& key) {
+    if(max_bytes_ == 0)
+        return std::nullopt;
+
+    std::lock_guard lock{mutex_};
+    auto it = entries_.find(CacheKey{library_id, key});
+    if(it == entries_.end()) {
+        ++stats_.misses_;
+        return std::nullopt;
+    }
+    ++stats_.hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->segment_.clone();
+}
+
+void IndexSegmentCache::put(const std::string& library_id, const entity::AtomKey& key, const SegmentInMemory& segment) {
+    const auto bytes = segment.num_bytes() + segment.string_pool_size();
+    if(max_bytes_ == 0 || bytes > max_bytes_)
+        return;
+
+    CacheKey cache_key{library_id, key};
+    {
+        std::lock_guard lock{mutex_};
+        if(entries_.find(cache_key) != entries_.end() || !admit(CacheKeyHash{}(cache_key)))
+            return;
+    }
+
+    auto copy = segment.clone();
+    std::lock_guard lock{mutex_};
+    if(entries_.find(cache_key) != entries_.end())
+        return;
+
+    evict_to(max_bytes_ - bytes);
+    lru_.push_front(Entry{cache_key, std::move(copy), bytes});
+    entries_.emplace(std::move(cache_key), lru_.begin());
+    stats_.bytes_ += bytes;
+    stats_.entries_ = entries_.size();
+}
+
+void IndexSegmentCache::remove(const std::string& library_id, const entity::AtomKey& key) {
+    std::lock_guard lock{mutex_};
+    auto it = entries_.find(CacheKey{library_id, key});
+    if(it == entries_.end())
+        return;
+
+    stats_.bytes_ -= it->second->bytes_;
+    lru_.erase(it->second);
+    entries_.erase(it);
+    stats_.entries_ = entries_.size();
+}
+
+void IndexSegmentCache::clear() {
+    std::lock_guard lock{mutex_};
+    entries_.clear();
+    lru_.clear();
+    candidate_order_.clear();
+    candidates_.clear();
+    stats_.bytes_ = 0;
+    stats_.entries_ = 0;
+}
+
+IndexSegmentCache::Stats IndexSegmentCache::stats() const {
+    std::lock_guard lock{mutex_};
+    return stats_;
+}
+
+void IndexSegmentCache::evict_to(size_t max_bytes) {
+    while(stats_.bytes_ > max_bytes && !lru_.empty()) {
+        auto& entry = lru_.back();
+        ARCTICDB_DEBUG(log::storage(), "Evicting {} from the index segment cache", entry.cache_key_.second);
+        stats_.bytes_ -= entry.bytes_;
+        entries_.erase(entry.cache_key_);
+        lru_.pop_back();
+        ++stats_.evictions_;
+    }
+}
+
+bool IndexSegmentCache::admit(size_t hash) {
+    if(candidates_.erase(hash) != 0)
+        return true;
+
+    if(candidate_order_.size() == max_candidates_) {
+        candidates_.erase(candidate_order_.front());
+        candidate_order_.pop_front();
+    }
+    candidates_.insert(hash);
+    candidate_order_.push_back(hash);
+    return false;
+}
+
+std::shared_ptr<IndexSegmentCache> IndexSegmentCache::instance_;
+std::once_flag IndexSegmentCache::init_flag_;
+
+} // namespace arcticdb::async
@@ -0,0 +1,99 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/column_store/memory_segment.hpp>
+#include <arcticdb/entity/atom_key.hpp>
+
+#include <deque>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace arcticdb::async {
+
+/*
+ * Process-wide LRU cache of decoded TABLE_INDEX segments, bounded by IndexSegmentCache.MaxBytes (0 disables it).
+ *
+ * Index keys are never rewritten, so a cached segment stays valid until its key is removed. Entries are keyed by
+ * Library::cache_id as well as the key, so stores sharing a library's storages share them but libraries of the same
+ * name on different storages do not. Removals through the Library evict entries; removals by other processes are not
+ * seen, which only matters to readers still holding a reference to the removed version.
+ *
+ * A segment is only copied into the cache when it is put for the second time, so one-off reads do not pay for a copy.
+ * Callers get their own copy on a hit, since readers detach fields from the segments they are given.
+ */
+class IndexSegmentCache {
+    static std::shared_ptr<IndexSegmentCache> instance_;
+    static std::once_flag init_flag_;
+
+    static void init();
+
+public:
+    struct Stats {
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+        uint64_t evictions_ = 0;
+        size_t entries_ = 0;
+        size_t bytes_ = 0;
+    };
+
+    static std::shared_ptr<IndexSegmentCache> instance();
+    static void destroy_instance();
+
+    static bool is_cacheable(const entity::VariantKey& key) {
+        return std::holds_alternative<entity::AtomKey>(key) && std::get<entity::AtomKey>(key).type() == entity::KeyType::TABLE_INDEX;
+    }
+
+    // Uses IndexSegmentCache.MaxBytes when no limit is given
+    explicit IndexSegmentCache(std::optional<size_t> max_bytes = std::nullopt);
+
+    std::optional<SegmentInMemory> get(const std::string& library_id, const entity::AtomKey& key);
+
+    // Copies the segment in if the key was put before and has not yet been admitted
+    void put(const std::string& library_id, const entity::AtomKey& key, const SegmentInMemory& segment);
+
+    void remove(const std::string& library_id, const entity::AtomKey& key);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+    using CacheKey = std::pair<std::string, entity::AtomKey>;
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& cache_key) const;
+    };
+
+    struct Entry {
+        CacheKey cache_key_;
+        SegmentInMemory segment_;
+        size_t bytes_;
+    };
+
+    void evict_to(size_t max_bytes);
+
+    bool admit(size_t hash);
+
+    const size_t max_bytes_;
+    const size_t max_candidates_;
+    mutable std::mutex mutex_;
+    // Most recently used first
+    std::list<Entry> lru_;
+    std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHash> entries_;
+    // Hashes of keys put once, oldest first. A collision only admits a key early.
+    std::deque<size_t> candidate_order_;
+    std::unordered_set<size_t> candidates_;
+    Stats stats_;
+};
+
+} // namespace arcticdb::async
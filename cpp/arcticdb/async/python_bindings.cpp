@@ -8,6 +8,7 @@
 #include <arcticdb/python/python_utils.hpp>
 #include <arcticdb/async/python_bindings.hpp>
 #include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/async/index_segment_cache.hpp>
 
 namespace py = pybind11;
 
@@ -23,6 +24,16 @@ void register_bindings(py::module &m) {
         }), "Number of threads used to execute tasks");
 
     async.def("print_scheduler_stats", &print_scheduler_stats);
+
+    py::class_<IndexSegmentCache::Stats>(async, "IndexSegmentCacheStats")
+        .def_readonly("hits", &IndexSegmentCache::Stats::hits_)
+        .def_readonly("misses", &IndexSegmentCache::Stats::misses_)
+        .def_readonly("evictions", &IndexSegmentCache::Stats::evictions_)
+        .def_readonly("entries", &IndexSegmentCache::Stats::entries_)
+        .def_readonly("bytes", &IndexSegmentCache::Stats::bytes_);
+
+    async.def("index_segment_cache_stats", [] () { return IndexSegmentCache::instance()->stats(); });
+    async.def("clear_index_segment_cache", [] () { IndexSegmentCache::instance()->clear(); });
 }
 
 } // namespace arcticdb::async
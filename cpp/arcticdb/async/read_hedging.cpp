@@ -0,0 +1,189 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/async/read_hedging.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+
+namespace arcticdb::async {
+
+namespace {
+
+// Budget is counted in hundredths of a percent of a read
+constexpr int64_t CreditsPerHedge = 10'000;
+// Caps how many hedges can be saved up for a burst of slow reads
+constexpr int64_t MaxCredits = 10 * CreditsPerHedge;
+constexpr size_t MinSamples = 100;
+
+} // namespace
+
+ReadHedging::ReadHedging() :
+    ReadHedging(
+        ConfigsMap::instance()->get_int("ReadHedging.Enabled", 0) != 0,
+        static_cast<double>(ConfigsMap::instance()->get_int("ReadHedging.Percentile", 95)),
+        std::chrono::milliseconds{ConfigsMap::instance()->get_int("ReadHedging.MinDelayMs", 1)},
+        static_cast<double>(ConfigsMap::instance()->get_int("ReadHedging.BudgetPercent", 5)),
+        static_cast<size_t>(ConfigsMap::instance()->get_int("ReadHedging.WindowSize", 1024))) {
+}
+
+ReadHedging::ReadHedging(bool enabled, double percentile, std::chrono::microseconds min_delay, double budget_percent, size_t window_size) :
+    enabled_(enabled),
+    percentile_(percentile),
+    min_delay_(min_delay),
+    credits_per_read_(static_cast<int64_t>(budget_percent * CreditsPerHedge / 100.0)),
+    window_size_(std::max(window_size, MinSamples)) {
+    util::check(percentile > 0.0 && percentile <= 100.0, "ReadHedging percentile {} is not in (0, 100]", percentile);
+    util::check(budget_percent >= 0.0, "ReadHedging budget {} is negative", budget_percent);
+    latencies_.reserve(window_size_);
+}
+
+void ReadHedging::record_latency(std::chrono::microseconds latency) {
+    std::lock_guard lock{mutex_};
+    if(latencies_.size() < window_size_)
+        latencies_.push_back(latency.count());
+    else
+        latencies_[next_latency_] = latency.count();
+
+    next_latency_ = (next_latency_ + 1) % window_size_;
+    if(latencies_.size() < MinSamples)
+        return;
+
+    // Recomputing on every read would sort the window each time, the percentile moves slowly enough for this
+    if(delay_us_ >= 0 && ++since_update_ < window_size_ / 16)
+        return;
+
+    since_update_ = 0;
+    auto sorted = latencies_;
+    const auto rank = std::min(sorted.size() - 1, static_cast<size_t>(percentile_ / 100.0 * static_cast<double>(sorted.size())));
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    delay_us_ = std::max(sorted[rank], static_cast<int64_t>(min_delay_.count()));
+    const auto median = sorted.size() / 2;
+    std::nth_element(sorted.begin(), sorted.begin() + median, sorted.end());
+    median_us_ = sorted[median];
+}
+
+std::optional<std::chrono::microseconds> ReadHedging::hedge_delay() const {
+    const auto delay_us = delay_us_.load();
+    if(delay_us < 0)
+        return std::nullopt;
+
+    return std::chrono::microseconds{delay_us};
+}
+
+void ReadHedging::earn_budget() {
+    auto credits = credits_.load();
+    while(credits < MaxCredits && !credits_.compare_exchange_weak(credits, std::min(credits + credits_per_read_, MaxCredits))) {}
+}
+
+bool ReadHedging::try_spend_budget() {
+    auto credits = credits_.load();
+    while(credits >= CreditsPerHedge) {
+        if(credits_.compare_exchange_weak(credits, credits - CreditsPerHedge))
+            return true;
+    }
+    return false;
+}
+
+ReadHedging::Stats ReadHedging::stats() const {
+    Stats stats;
+    stats.reads_ = reads_;
+    stats.hedges_ = hedges_;
+    stats.hedge_wins_ = hedge_wins_;
+    return stats;
+}
+
+folly::Future<storage::KeySegmentPair> ReadHedging::read(ReadFunction read_function) {
+    if(!enabled_)
+        return read_function([] {});
+
+    ++reads_;
+    earn_budget();
+    auto state = std::make_shared<HedgedRead>();
+    auto result = state->promise_.getFuture();
+    attempt(state, read_function, false);
+    return result;
+}
+
+void ReadHedging::attempt(const std::shared_ptr<HedgedRead>& state, const ReadFunction& read_function, bool is_hedge) {
+    // Set when the read starts running, which happens before its future completes
+    auto start = std::make_shared<std::optional<std::chrono::steady_clock::time_point>>();
+    auto on_start = [that = shared_from_this(), state, read_function, start, is_hedge] () {
+        *start = std::chrono::steady_clock::now();
+        if(!is_hedge)
+            that->arm_hedge(state, read_function);
+    };
+    read_function(std::move(on_start)).thenTry([that = shared_from_this(), state, start, is_hedge] (folly::Try<storage::KeySegmentPair>&& result) {
+        if(result.hasValue() && *start)
+            that->record_latency(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - **start));
+
+        that->complete(*state, std::move(result), is_hedge);
+    });
+}
+
+void ReadHedging::arm_hedge(const std::shared_ptr<HedgedRead>& state, const ReadFunction& read_function) {
+    // No timer for a read that could not be hedged anyway
+    const auto delay = hedge_delay();
+    if(!delay || state->done_)
+        return;
+
+    // Runs on the timer thread, so that deciding to hedge does not wait behind the reads queued on the IO pool
+    folly::futures::sleep(*delay).via(&folly::InlineExecutor::instance()).thenValue(
+        [that = shared_from_this(), state, read_function] (auto&&) {
+            that->hedge(state, read_function);
+        });
+}
+
+bool ReadHedging::would_start_within(std::chrono::microseconds delay) const {
+    const auto pending = static_cast<int64_t>(async::io_executor().getPendingTaskCount());
+    const auto threads = static_cast<int64_t>(std::max<size_t>(1, async::TaskScheduler::instance()->io_thread_count()));
+    return pending * std::max<int64_t>(0, median_us_.load()) / threads <= delay.count();
+}
+
+void ReadHedging::hedge(const std::shared_ptr<HedgedRead>& state, const ReadFunction& read_function) {
+    if(state->done_)
+        return;
+
+    const auto delay = hedge_delay();
+    if(!delay || !would_start_within(*delay) || !try_spend_budget()) {
+        arm_hedge(state, read_function);
+        return;
+    }
+
+    // Once every attempt has failed the read has failed, and there is nothing left to hedge
+    auto outstanding = state->outstanding_.load();
+    do {
+        if(outstanding == 0) {
+            credits_ += CreditsPerHedge;
+            return;
+        }
+    } while(!state->outstanding_.compare_exchange_weak(outstanding, outstanding + 1));
+
+    ++hedges_;
+    attempt(state, read_function, true);
+}
+
+void ReadHedging::complete(HedgedRead& state, folly::Try<storage::KeySegmentPair>&& result, bool is_hedge) {
+    if(result.hasValue()) {
+        if(state.done_.exchange(true))
+            return;
+
+        if(is_hedge)
+            ++hedge_wins_;
+
+        state.promise_.setValue(std::move(result.value()));
+    } else if(--state.outstanding_ == 0 && !state.done_.exchange(true)) {
+        state.promise_.setException(std::move(result.exception()));
+    }
+}
+
+} // namespace arcticdb::async
@@ -0,0 +1,114 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/storage/key_segment_pair.hpp>
+
+#include <folly/futures/Future.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace arcticdb::async {
+
+/*
+ * Hedges reads against tail latency: if a read has not completed after the ReadHedging.Percentile latency of recent
+ * reads (at least ReadHedging.MinDelayMs), the same read is issued again and whichever completes first wins. Extra
+ * reads are paid for from a budget that each read tops up by ReadHedging.BudgetPercent of a read, so that hedging
+ * never adds more than that fraction of load even when the store as a whole slows down. No read is hedged until
+ * enough latencies have been seen to estimate the percentile.
+ *
+ * Latencies, and the wait before hedging, are measured from when the read starts running rather than when it was
+ * queued, so that queueing behind other reads is neither counted as slow storage nor hedged. A hedge is only issued
+ * once the tasks queued on the IO pool ahead of it would, at the median latency, have started within the hedge delay;
+ * until then, or while the budget is spent, the read is checked again after each further hedge delay until it
+ * completes. Batch reads keep more reads in flight than there are IO threads, so the queue is seldom empty.
+ *
+ * Off unless ReadHedging.Enabled is set. The losing read is not cancelled, its result is discarded.
+ */
+class ReadHedging : public std::enable_shared_from_this<ReadHedging> {
+public:
+    // Called by the read once it starts running
+    using OnStart = std::function<void()>;
+    using ReadFunction = std::function<folly::Future<storage::KeySegmentPair>(OnStart)>;
+
+    struct Stats {
+        uint64_t reads_ = 0;
+        uint64_t hedges_ = 0;
+        uint64_t hedge_wins_ = 0;
+    };
+
+    // Configured from the ReadHedging.* options
+    ReadHedging();
+
+    ReadHedging(bool enabled, double percentile, std::chrono::microseconds min_delay, double budget_percent, size_t window_size);
+
+    [[nodiscard]] bool enabled() const {
+        return enabled_;
+    }
+
+    // Issues the read, and again if the first attempt is slow and the budget allows
+    folly::Future<storage::KeySegmentPair> read(ReadFunction read_function);
+
+    void record_latency(std::chrono::microseconds latency);
+
+    // How long to wait before hedging a read, unset until enough latencies have been recorded
+    [[nodiscard]] std::optional<std::chrono::microseconds> hedge_delay() const;
+
+    void earn_budget();
+
+    bool try_spend_budget();
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    struct HedgedRead {
+        folly::Promise<storage::KeySegmentPair> promise_;
+        std::atomic<bool> done_{false};
+        // Attempts that have not failed yet, the read only fails once all of them have
+        std::atomic<uint32_t> outstanding_{1};
+    };
+
+    void attempt(const std::shared_ptr<HedgedRead>& state, const ReadFunction& read_function, bool is_hedge);
+
+    void complete(HedgedRead& state, folly::Try<storage::KeySegmentPair>&& result, bool is_hedge);
+
+    void arm_hedge(const std::shared_ptr<HedgedRead>& state, const ReadFunction& read_function);
+
+    void hedge(const std::shared_ptr<HedgedRead>& state, const ReadFunction& read_function);
+
+    // Whether a read submitted to the IO pool now would start within the given delay
+    [[nodiscard]] bool would_start_within(std::chrono::microseconds delay) const;
+
+    const bool enabled_;
+    const double percentile_;
+    const std::chrono::microseconds min_delay_;
+    const int64_t credits_per_read_;
+    const size_t window_size_;
+
+    mutable std::mutex mutex_;
+    // Ring buffer of the most recent latencies
+    std::vector<int64_t> latencies_;
+    size_t next_latency_ = 0;
+    size_t since_update_ = 0;
+    // Negative until enough latencies have been recorded
+    std::atomic<int64_t> delay_us_{-1};
+    std::atomic<int64_t> median_us_{-1};
+
+    std::atomic<int64_t> credits_{0};
+    std::atomic<uint64_t> reads_{0};
+    std::atomic<uint64_t> hedges_{0};
+    std::atomic<uint64_t> hedge_wins_{0};
+};
+
+} // namespace arcticdb::async
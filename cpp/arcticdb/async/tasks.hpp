@@ -22,6 +22,7 @@
 #include <arcticdb/processing/processing_unit.hpp>
 #include <arcticdb/util/constructors.hpp>
 
+#include <functional>
 #include <type_traits>
 
 namespace arcticdb::async {
@@ -186,11 +187,14 @@ struct ReadCompressedTask : BaseTask {
     entity::VariantKey key_;
     std::shared_ptr<storage::Library> lib_;
     storage::ReadKeyOpts opts_;
+    // Called when the task starts running, for timing the read without the time it spent queued
+    std::function<void()> on_start_;
 
-    ReadCompressedTask(entity::VariantKey key, std::shared_ptr<storage::Library> lib, storage::ReadKeyOpts opts)
+    ReadCompressedTask(entity::VariantKey key, std::shared_ptr<storage::Library> lib, storage::ReadKeyOpts opts, std::function<void()> on_start = {})
         : key_(std::move(key)),
         lib_(std::move(lib)),
-        opts_(opts) {
+        opts_(opts),
+        on_start_(std::move(on_start)) {
         ARCTICDB_DEBUG(log::storage(), "Creating read compressed task for key {}: {}",
                              variant_key_type(key_),
                              variant_key_view(key_));
@@ -204,6 +208,9 @@ struct ReadCompressedTask : BaseTask {
 
     storage::KeySegmentPair operator()() {
         ARCTICDB_SAMPLE(ReadCompressed, 0)
+        if(on_start_)
+            on_start_();
+
         return read();
     }
 };
@@ -544,6 +551,31 @@ struct RemoveTask : BaseTask {
     }
 };
 
+struct IterateTypeRangeTask : BaseTask {
+    std::shared_ptr<storage::Library> lib_;
+    KeyType key_type_;
+    storage::KeyRange range_;
+    IterateTypeVisitor visitor_;
+
+    IterateTypeRangeTask(
+        std::shared_ptr<storage::Library> lib,
+        KeyType key_type,
+        storage::KeyRange range,
+        IterateTypeVisitor visitor) :
+        lib_(std::move(lib)),
+        key_type_(key_type),
+        range_(std::move(range)),
+        visitor_(std::move(visitor)) {
+    }
+
+    ARCTICDB_MOVE_ONLY_DEFAULT(IterateTypeRangeTask)
+
+    folly::Unit operator()() {
+        lib_->iterate_type_in_range(key_type_, range_, visitor_);
+        return folly::Unit{};
+    }
+};
+
 struct RemoveBatchTask : BaseTask {
     std::vector<VariantKey> keys_;
     std::shared_ptr<storage::Library> lib_;
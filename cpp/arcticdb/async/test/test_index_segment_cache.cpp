@@ -0,0 +1,127 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/async/index_segment_cache.hpp>
+#include <arcticdb/storage/library.hpp>
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/test/generators.hpp>
+
+namespace arcticdb {
+
+namespace {
+AtomKey cache_test_key(VersionId version_id) {
+    return atom_key_builder().version_id(version_id).creation_ts(version_id).content_hash(version_id)
+        .start_index(0).end_index(1).build(StreamId{StringId{"sym"}}, KeyType::TABLE_INDEX);
+}
+
+SegmentInMemory cache_test_segment(uint64_t value) {
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"sym"}}, stream::RowCountIndex{}, {
+        scalar_field(DataType::UINT64, "value")})};
+    segment.set_scalar(0, value);
+    segment.end_row();
+    return segment;
+}
+
+size_t cache_test_bytes(const SegmentInMemory& segment) {
+    return segment.num_bytes() + segment.string_pool_size();
+}
+
+// Segments are admitted on their second put
+void cache_test_admit(async::IndexSegmentCache& cache, const std::string& library_id, const AtomKey& key, const SegmentInMemory& segment) {
+    cache.put(library_id, key, segment);
+    cache.put(library_id, key, segment);
+}
+
+} // namespace
+
+TEST(IndexSegmentCache, HitReturnsCopy) {
+    async::IndexSegmentCache cache{1024 * 1024};
+    const auto key = cache_test_key(0);
+    ASSERT_FALSE(cache.get("lib", key));
+
+    cache_test_admit(cache, "lib", key, cache_test_segment(5));
+    ASSERT_FALSE(cache.get("other_lib", key));
+
+    auto first = cache.get("lib", key);
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first->scalar_at<uint64_t>(0, 0).value(), 5u);
+    first->column(0).set_scalar(0, uint64_t{6});
+    ASSERT_EQ(cache.get("lib", key)->scalar_at<uint64_t>(0, 0).value(), 5u);
+
+    const auto stats = cache.stats();
+    ASSERT_EQ(stats.hits_, 2u);
+    ASSERT_EQ(stats.misses_, 2u);
+    ASSERT_EQ(stats.entries_, 1u);
+
+    cache.remove("lib", key);
+    ASSERT_FALSE(cache.get("lib", key));
+    ASSERT_EQ(cache.stats().bytes_, 0u);
+}
+
+TEST(IndexSegmentCache, EvictsLeastRecentlyUsed) {
+    const auto segment_bytes = cache_test_bytes(cache_test_segment(0));
+    async::IndexSegmentCache cache{2 * segment_bytes};
+    for (VersionId version_id = 0; version_id < 2; ++version_id)
+        cache_test_admit(cache, "lib", cache_test_key(version_id), cache_test_segment(version_id));
+
+    // Touching version 0 leaves version 1 as the least recently used
+    ASSERT_TRUE(cache.get("lib", cache_test_key(0)));
+    cache_test_admit(cache, "lib", cache_test_key(2), cache_test_segment(2));
+
+    ASSERT_TRUE(cache.get("lib", cache_test_key(0)));
+    ASSERT_FALSE(cache.get("lib", cache_test_key(1)));
+    ASSERT_TRUE(cache.get("lib", cache_test_key(2)));
+    ASSERT_EQ(cache.stats().evictions_, 1u);
+    ASSERT_EQ(cache.stats().bytes_, 2 * segment_bytes);
+}
+
+TEST(IndexSegmentCache, AdmitsOnSecondPut) {
+    ScopedConfig max_candidates("IndexSegmentCache.MaxCandidates", 1);
+    async::IndexSegmentCache cache{1024 * 1024};
+    cache.put("lib", cache_test_key(0), cache_test_segment(0));
+    ASSERT_FALSE(cache.get("lib", cache_test_key(0)));
+
+    // Only the most recent one-off put is remembered
+    cache.put("lib", cache_test_key(1), cache_test_segment(1));
+    cache.put("lib", cache_test_key(0), cache_test_segment(0));
+    ASSERT_FALSE(cache.get("lib", cache_test_key(0)));
+    ASSERT_EQ(cache.stats().entries_, 0u);
+
+    cache.put("lib", cache_test_key(0), cache_test_segment(0));
+    ASSERT_TRUE(cache.get("lib", cache_test_key(0)));
+    ASSERT_EQ(cache.stats().entries_, 1u);
+}
+
+TEST(IndexSegmentCache, KeyedOnStoragesAndEvictedByLibrary) {
+    auto [path, storages] = get_test_config_data();
+    storage::Library library{path, std::move(storages)};
+    auto [other_path, other_storages] = get_test_config_data();
+    storage::Library other_library{other_path, std::move(other_storages)};
+    ASSERT_EQ(library.name(), other_library.name());
+    ASSERT_NE(library.cache_id(), other_library.cache_id());
+
+    auto cache = async::IndexSegmentCache::instance();
+    const auto key = cache_test_key(0);
+    cache_test_admit(*cache, library.cache_id(), key, cache_test_segment(0));
+    ASSERT_TRUE(cache->get(library.cache_id(), key));
+    ASSERT_FALSE(cache->get(other_library.cache_id(), key));
+
+    library.remove(Composite<VariantKey>{VariantKey{key}}, storage::RemoveOpts{true});
+    ASSERT_FALSE(cache->get(library.cache_id(), key));
+}
+
+TEST(IndexSegmentCache, Disabled) {
+    async::IndexSegmentCache cache{0};
+    cache_test_admit(cache, "lib", cache_test_key(0), cache_test_segment(0));
+    ASSERT_FALSE(cache.get("lib", cache_test_key(0)));
+    ASSERT_EQ(cache.stats().entries_, 0u);
+}
+
+} // namespace arcticdb
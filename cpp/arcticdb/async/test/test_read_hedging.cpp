@@ -0,0 +1,243 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/async/async_store.hpp>
+#include <arcticdb/async/read_hedging.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/entity/variant_key.hpp>
+#include <arcticdb/storage/library.hpp>
+#include <arcticdb/storage/storages.hpp>
+#include <arcticdb/storage/memory/sharded_memory_storage.hpp>
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+#define GTEST_COUT std::cerr << "[          ] [ INFO ]"
+
+namespace arcticdb {
+
+using namespace std::chrono_literals;
+
+namespace {
+AtomKey hedging_test_key() {
+    return atom_key_builder().version_id(0).creation_ts(0).content_hash(0)
+        .start_index(0).end_index(1).build(StreamId{StringId{"sym"}}, KeyType::TABLE_DATA);
+}
+
+void prime_latencies(async::ReadHedging& hedging, size_t count, std::chrono::microseconds latency) {
+    for(size_t i = 0; i < count; ++i)
+        hedging.record_latency(latency);
+}
+} // namespace
+
+TEST(ReadHedging, DelayIsPercentileOfRecentLatencies) {
+    // Recomputed every 100 latencies
+    async::ReadHedging hedging{true, 95.0, 0us, 5.0, 1600};
+    for(auto i = 1; i < 100; ++i)
+        hedging.record_latency(std::chrono::microseconds{i});
+
+    ASSERT_FALSE(hedging.hedge_delay());
+    for(auto i = 100; i <= 1000; ++i)
+        hedging.record_latency(std::chrono::microseconds{i});
+
+    ASSERT_EQ(hedging.hedge_delay(), std::chrono::microseconds{951});
+
+    // Older latencies drop out of the window
+    prime_latencies(hedging, 1600, 10us);
+    ASSERT_EQ(hedging.hedge_delay(), 10us);
+}
+
+TEST(ReadHedging, DelayHasFloor) {
+    async::ReadHedging hedging{true, 95.0, 2ms, 5.0, 100};
+    prime_latencies(hedging, 100, 10us);
+    ASSERT_EQ(hedging.hedge_delay(), 2ms);
+}
+
+TEST(ReadHedging, BudgetCapsHedges) {
+    async::ReadHedging hedging{true, 95.0, 0us, 5.0, 100};
+    ASSERT_FALSE(hedging.try_spend_budget());
+
+    auto hedges_after = [&hedging] (size_t reads) {
+        for(size_t i = 0; i < reads; ++i)
+            hedging.earn_budget();
+
+        size_t hedges = 0;
+        while(hedging.try_spend_budget())
+            ++hedges;
+
+        return hedges;
+    };
+
+    ASSERT_EQ(hedges_after(100), 5u);
+    // Budget cannot be saved up indefinitely
+    ASSERT_EQ(hedges_after(100'000), 10u);
+}
+
+TEST(ReadHedging, HedgeWinsOverSlowRead) {
+    auto hedging = std::make_shared<async::ReadHedging>(true, 95.0, 0us, 5.0, 100);
+    prime_latencies(*hedging, 100, 1ms);
+    for(auto i = 0; i < 20; ++i)
+        hedging->earn_budget();
+
+    folly::Promise<storage::KeySegmentPair> slow_read;
+    std::atomic<int> calls{0};
+    auto result = hedging->read([&] (async::ReadHedging::OnStart on_start) {
+        on_start();
+        if(calls++ == 0)
+            return slow_read.getFuture();
+
+        return folly::makeFuture(storage::KeySegmentPair{VariantKey{hedging_test_key()}});
+    });
+
+    auto kv = std::move(result).get(5s);
+    ASSERT_EQ(to_atom(kv.variant_key()), hedging_test_key());
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(hedging->stats().hedges_, 1u);
+    ASSERT_EQ(hedging->stats().hedge_wins_, 1u);
+
+    // The losing read is ignored
+    slow_read.setValue(storage::KeySegmentPair{VariantKey{hedging_test_key()}});
+    ASSERT_EQ(hedging->stats().hedge_wins_, 1u);
+}
+
+TEST(ReadHedging, FailsOnceEveryAttemptFails) {
+    auto hedging = std::make_shared<async::ReadHedging>(true, 95.0, 0us, 5.0, 100);
+    auto result = hedging->read([] (async::ReadHedging::OnStart on_start) {
+        on_start();
+        return folly::makeFuture<storage::KeySegmentPair>(std::runtime_error("read failed"));
+    });
+    ASSERT_THROW(std::move(result).get(5s), std::runtime_error);
+    ASSERT_EQ(hedging->stats().hedges_, 0u);
+}
+
+TEST(ReadHedging, QueuedReadIsNotHedged) {
+    auto hedging = std::make_shared<async::ReadHedging>(true, 95.0, 0us, 5.0, 100);
+    prime_latencies(*hedging, 100, 1ms);
+    for(auto i = 0; i < 20; ++i)
+        hedging->earn_budget();
+
+    // Never starts, as if waiting behind other reads in the IO pool
+    folly::Promise<storage::KeySegmentPair> queued_read;
+    auto result = hedging->read([&] (async::ReadHedging::OnStart) {
+        return queued_read.getFuture();
+    });
+
+    std::this_thread::sleep_for(20ms);
+    ASSERT_EQ(hedging->stats().hedges_, 0u);
+    queued_read.setValue(storage::KeySegmentPair{VariantKey{hedging_test_key()}});
+    ASSERT_EQ(to_atom(std::move(result).get(5s).variant_key()), hedging_test_key());
+}
+
+TEST(ReadHedging, HedgedOnceQueueDrains) {
+    auto hedging = std::make_shared<async::ReadHedging>(true, 95.0, 0us, 5.0, 100);
+    prime_latencies(*hedging, 100, 1ms);
+    for(auto i = 0; i < 20; ++i)
+        hedging->earn_budget();
+
+    // Occupy every IO thread, with enough queued behind them that a hedge would not start within the delay
+    std::atomic<bool> release{false};
+    std::vector<folly::Future<folly::Unit>> blockers;
+    for(size_t i = 0; i < 10 * async::TaskScheduler::instance()->io_thread_count(); ++i) {
+        blockers.emplace_back(folly::via(&async::io_executor(), [&release] () {
+            while(!release)
+                std::this_thread::sleep_for(1ms);
+        }));
+    }
+
+    folly::Promise<storage::KeySegmentPair> slow_read;
+    std::atomic<int> calls{0};
+    auto result = hedging->read([&] (async::ReadHedging::OnStart on_start) {
+        on_start();
+        if(calls++ == 0)
+            return slow_read.getFuture();
+
+        return folly::makeFuture(storage::KeySegmentPair{VariantKey{hedging_test_key()}});
+    });
+
+    std::this_thread::sleep_for(20ms);
+    ASSERT_EQ(hedging->stats().hedges_, 0u);
+
+    // The check is repeated until the read completes, so the read is hedged once the queue has drained
+    release = true;
+    auto kv = std::move(result).get(5s);
+    ASSERT_EQ(to_atom(kv.variant_key()), hedging_test_key());
+    ASSERT_EQ(hedging->stats().hedges_, 1u);
+    ASSERT_EQ(hedging->stats().hedge_wins_, 1u);
+    folly::collectAll(blockers).get();
+    slow_read.setValue(storage::KeySegmentPair{VariantKey{hedging_test_key()}});
+}
+
+/*
+ * Reads batches from a store where a few reads straggle through batch_read_compressed, which keeps a full window of
+ * reads queued on the IO pool, and reports the batch times with and without hedging
+ */
+TEST(ReadHedging, TailLatencyBenchmark) {
+    constexpr VersionId num_keys = 100;
+    constexpr size_t warmup_batches = 2;
+    constexpr size_t num_batches = 20;
+    storage::memory::ShardedMemoryStorage::Config cfg;
+    cfg.set_seed(42);
+    cfg.mutable_read()->set_latency_us(200);
+    cfg.mutable_read()->set_jitter_us(100);
+    cfg.mutable_read()->set_straggler_prob(0.03);
+    cfg.mutable_read()->set_straggler_us(20'000);
+    const storage::LibraryPath path{"hedging", "test"};
+    auto library = std::make_shared<storage::Library>(
+        path, storage::create_storages(path, storage::OpenMode::DELETE, storage::memory::pack_sharded_config(cfg)));
+
+    std::vector<VariantKey> keys;
+    {
+        async::AsyncStore<> store{library, codec::default_lz4_codec(), EncodingVersion::V1};
+        for(VersionId version_id = 0; version_id < num_keys; ++version_id) {
+            SegmentInMemory segment{stream_descriptor(StreamId{StringId{"sym"}}, stream::RowCountIndex{}, {
+                scalar_field(DataType::UINT64, "value")})};
+            segment.set_scalar(0, version_id);
+            segment.end_row();
+            keys.push_back(store.write(KeyType::TABLE_DATA, version_id, StreamId{StringId{"sym"}}, 0, 1, std::move(segment)).get());
+        }
+    }
+
+    ScopedConfig batch_size("BatchRead.BatchSize", num_keys);
+    ScopedConfig min_delay("ReadHedging.MinDelayMs", 1);
+    ScopedConfig budget("ReadHedging.BudgetPercent", 10);
+    ScopedConfig window("ReadHedging.WindowSize", 100);
+    std::vector<std::chrono::microseconds> means;
+    for(bool enabled : {false, true}) {
+        ScopedConfig enable("ReadHedging.Enabled", enabled ? 1 : 0);
+        auto store = std::make_shared<async::AsyncStore<>>(library, codec::default_lz4_codec(), EncodingVersion::V1);
+        std::vector<std::chrono::microseconds> times;
+        for(size_t batch = 0; batch < warmup_batches + num_batches; ++batch) {
+            std::vector<stream::StreamSource::ReadContinuation> continuations;
+            for(size_t i = 0; i < keys.size(); ++i)
+                continuations.emplace_back([] (storage::KeySegmentPair&& key_seg) { return key_seg.variant_key(); });
+
+            auto batch_keys = keys;
+            const auto start = std::chrono::steady_clock::now();
+            store->batch_read_compressed(std::move(batch_keys), std::move(continuations), BatchReadArgs{}).get(10s);
+            if(batch >= warmup_batches)
+                times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+        }
+
+        std::sort(times.begin(), times.end());
+        const auto total = std::accumulate(times.begin(), times.end(), std::chrono::microseconds{0});
+        means.push_back(total / static_cast<int64_t>(times.size()));
+        GTEST_COUT << " hedging " << (enabled ? "on" : "off") << ": batch of " << keys.size() << " mean " << means.back().count()
+                   << "us p50 " << times[times.size() / 2].count() << "us max " << times.back().count() << "us" << std::endl;
+    }
+    ASSERT_LT(means[1], means[0]);
+}
+
+} // namespace arcticdb
@@ -142,7 +142,8 @@ void decode_block(const BlockType &block, const std::uint8_t *input, T *output)
                                                      input,
                                                      size_to_decode,
                                                      output,
-                                                     decoded_size);
+                                                     decoded_size,
+                                                     block.codec().zstd().dictionary_id());
                 break;
             case arcticdb::proto::encoding::VariantCodec::kLz4:
                 arcticdb::detail::Lz4Decoder::decode_block<T>(encoder_version,
@@ -208,10 +209,7 @@ std::size_t decode_ndarray(
         }
 
         if(field.sparse_map_bytes()) {
-            util::check_magic<util::BitMagicStart>(data_in);
-            const auto bitmap_size =   field.sparse_map_bytes() - (sizeof(util::BitMagicStart) + sizeof(util::BitMagicEnd)); //TODO functions
-            bv = util::deserialize_bytes_to_bitmap(data_in, bitmap_size);
-            util::check_magic<util::BitMagicEnd>(data_in);
+            bv = util::decode_sparse_map(data_in, field.sparse_map_bytes());
             data_sink.set_allow_sparse(true);
         }
 
@@ -471,16 +471,28 @@ class MetaBuffer {
 
 size_t encode_bitmap(const util::BitMagic &sparse_map, Buffer &out, std::ptrdiff_t &pos) {
     ARCTICDB_DEBUG(log::version(), "Encoding sparse map of count: {}", sparse_map.count());
+    // Readers older than the compact encodings only understand the BitMagic serialization
+    const bool adaptive = ConfigsMap::instance()->get_int("Codec.AdaptiveSparseMaps", 0) != 0;
     bm::serializer<bm::bvector<> > bvs;
     bm::serializer<bm::bvector<> >::buffer sbuf;
     bvs.serialize(sparse_map, sbuf);
-    auto sz = sbuf.size();
+    auto compact = adaptive ? util::encode_sparse_map_compact(sparse_map, sbuf.size()) : std::nullopt;
+    auto sz = compact ? compact->second.size() : sbuf.size();
     auto total_sz = sz + sizeof(util::BitMagicStart) + sizeof(util::BitMagicEnd);
     out.assert_size(pos + total_sz);
 
     uint8_t* target = out.data() + pos;
-    util::write_magic<util::BitMagicStart>(target);
-    std::memcpy(target, sbuf.data(), sz);
+    if(compact) {
+        if(compact->first == util::SparseRunsStart::Magic)
+            util::write_magic<util::SparseRunsStart>(target);
+        else
+            util::write_magic<util::SparsePositionsStart>(target);
+
+        std::memcpy(target, compact->second.data(), sz);
+    } else {
+        util::write_magic<util::BitMagicStart>(target);
+        std::memcpy(target, sbuf.data(), sz);
+    }
     target += sz;
     util::write_magic<util::BitMagicEnd>(target);
     pos = pos + static_cast<ptrdiff_t>(total_sz);
@@ -823,4 +835,18 @@ SegmentInMemory decode_segment(Segment&& s) {
     return res;
 }
 
+SegmentInMemory decode_segment_copy(const Segment& segment) {
+    auto hdr = segment.header();
+    const bool is_v2 = EncodingVersion(hdr.encoding_version()) == EncodingVersion::V2;
+    auto fields = is_v2 && segment.fields_ptr() ? std::make_shared<FieldCollection>(segment.fields_ptr()->clone()) : std::make_shared<FieldCollection>();
+    StreamDescriptor descriptor(std::make_shared<StreamDescriptor::Proto>(std::move(*hdr.mutable_stream_descriptor())), std::move(fields));
+    if(!is_v2)
+        descriptor.fields() = field_collection_from_proto(std::move(*descriptor.mutable_proto().mutable_fields()));
+
+    descriptor.fields().regenerate_offsets();
+    SegmentInMemory res(std::move(descriptor));
+    decode_into_memory_segment(segment, hdr, res, res.descriptor());
+    return res;
+}
+
 } // namespace arcticdb
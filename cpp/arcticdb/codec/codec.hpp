@@ -130,6 +130,10 @@ Buffer decode_encoded_fields(
 SegmentInMemory decode_segment(
     Segment&& segment);
 
+// Decodes without consuming the segment, e.g. to check an encoding that is still to be written
+SegmentInMemory decode_segment_copy(
+    const Segment& segment);
+
 void decode_into_memory_segment(
     const Segment& segment,
     arcticdb::proto::encoding::SegmentHeader& hdr,
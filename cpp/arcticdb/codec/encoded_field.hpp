@@ -40,14 +40,21 @@ struct ZstdCodec {
     void MergeFrom(const arcticdb::proto::encoding::VariantCodec::Zstd &zstd) {
         level_ = zstd.level();
         is_streaming = zstd.is_streaming();
+        dictionary_id_ = zstd.dictionary_id();
+    }
+
+    uint64_t dictionary_id() const {
+        return dictionary_id_;
     }
 
     int32_t level_ = 0;
     bool is_streaming = false;
     uint8_t padding_ = 0;
+    // Trailing so that blocks written before dictionaries existed read back as zero, i.e. no dictionary
+    uint64_t dictionary_id_ = 0;
 };
 
-static_assert(sizeof(ZstdCodec) == encoding_size);
+static_assert(sizeof(ZstdCodec) == encoding_size + sizeof(uint64_t));
 
 struct TurboPforCodec {
     static constexpr Codec type_ = Codec::TurboPfor;
@@ -111,6 +118,10 @@ struct BlockCodec {
         memset(data(), 0, DataSize);
     }
 
+    const ZstdCodec &zstd() const {
+        return *reinterpret_cast<const ZstdCodec*>(data_.data());
+    }
+
     ZstdCodec *mutable_zstd() {
         codec_ = Codec::Zstd;
         auto zstd = new(data()) ZstdCodec{};
@@ -137,7 +148,7 @@ struct BlockCodec {
 
     arcticdb::proto::encoding::VariantCodec::CodecCase codec_case() const {
         switch (codec_) {
-        case Codec::Zstd:return arcticdb::proto::encoding::VariantCodec::kLz4;
+        case Codec::Zstd:return arcticdb::proto::encoding::VariantCodec::kZstd;
         case Codec::Lz4:return arcticdb::proto::encoding::VariantCodec::kLz4;
         case Codec::TurboPfor:return arcticdb::proto::encoding::VariantCodec::kTp4;
         case Codec::Passthrough:return arcticdb::proto::encoding::VariantCodec::kPassthrough;
@@ -152,6 +163,8 @@ struct BlockCodec {
     }
 };
 
+static_assert(sizeof(ZstdCodec) <= BlockCodec::DataSize);
+
 struct EncodedBlock {
     uint32_t in_bytes_ = 0;
     uint32_t out_bytes_ = 0;
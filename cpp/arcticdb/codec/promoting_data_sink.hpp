@@ -0,0 +1,129 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/types.hpp>
+#include <arcticdb/util/preconditions.hpp>
+#include <arcticdb/util/sparse_utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace arcticdb {
+
+/*
+ * Converts count values from src to dest. The two can overlap as long as each destination value ends no later than
+ * the start of the next source value still to be read, which holds when decoding into the tail of a destination that
+ * is at least as wide. Each chunk is copied out before it is converted, so that the conversion loop works on
+ * non-aliasing arrays and the compiler can vectorise it with widening conversions.
+ */
+template<typename SourceType, typename DestinationType>
+void promote_values(const uint8_t* src, uint8_t* dest, size_t count) {
+    constexpr size_t chunk_size = 64;
+    std::array<SourceType, chunk_size> in;
+    std::array<DestinationType, chunk_size> out;
+    while(count > 0) {
+        const auto num = std::min(count, chunk_size);
+        std::memcpy(in.data(), src, num * sizeof(SourceType));
+        for(size_t i = 0; i < num; ++i)
+            out[i] = static_cast<DestinationType>(in[i]);
+
+        std::memcpy(dest, out.data(), num * sizeof(DestinationType));
+        src += num * sizeof(SourceType);
+        dest += num * sizeof(DestinationType);
+        count -= num;
+    }
+}
+
+/*
+ * Data sink that decodes a column straight into a destination column of a type at least as wide, without a temporary
+ * buffer. The encoded values are decoded into the tail of the destination, and if widen_blocks is set, each block is
+ * widened into place as soon as the codec has decoded it, while it is still in cache. Sparse columns are decoded
+ * without widening and expanded afterwards with expand_and_promote_using_bitmap.
+ */
+template<typename SourceType, typename DestinationType>
+class PromotingDataSink {
+    static_assert(sizeof(SourceType) <= sizeof(DestinationType), "Promoting data sink can only widen");
+
+public:
+    PromotingDataSink(uint8_t* dest, size_t num_rows, bool widen_blocks) :
+        dest_(dest),
+        dest_bytes_(num_rows * sizeof(DestinationType)),
+        widen_blocks_(widen_blocks) {
+    }
+
+    shape_t *allocate_shapes(std::size_t s) ARCTICDB_UNUSED {
+        if (s == 0) return nullptr;
+        util::check_arg(s == 8, "expected exactly one shape, actual {}", s / sizeof(shape_t));
+        return &shape_;
+    }
+
+    uint8_t *allocate_data(std::size_t size) ARCTICDB_UNUSED {
+        util::check_arg(size % sizeof(SourceType) == 0 && size / sizeof(SourceType) * sizeof(DestinationType) <= dest_bytes_,
+                        "Promoting data sink overflow trying to allocate {} bytes in a buffer of {}", size, dest_bytes_);
+
+        src_ = dest_ + dest_bytes_ - size;
+        return src_;
+    }
+
+    void advance_data(std::size_t size) ARCTICDB_UNUSED {
+        const auto count = size / sizeof(SourceType);
+        if(widen_blocks_)
+            promote_values<SourceType, DestinationType>(src_ + values_ * sizeof(SourceType), dest_ + values_ * sizeof(DestinationType), count);
+
+        values_ += count;
+    }
+
+    void advance_shapes(std::size_t) ARCTICDB_UNUSED {}
+
+    void set_allow_sparse(bool) ARCTICDB_UNUSED {}
+
+    // The dense values, valid until they are widened
+    [[nodiscard]] const uint8_t* source_data() const {
+        return src_;
+    }
+
+    [[nodiscard]] size_t values_decoded() const {
+        return values_;
+    }
+
+private:
+    uint8_t *dest_;
+    size_t dest_bytes_;
+    bool widen_blocks_;
+    uint8_t *src_ = nullptr;
+    size_t values_ = 0;
+    shape_t shape_ = 0;
+};
+
+/*
+ * Expands dense values sitting in the tail of a destination of num_rows rows to the rows set in the bitmap, widening
+ * each one and default initializing the rows in between. Working forwards, there are never more dense values left to
+ * read than rows left to write, so no write reaches a value that has not been read.
+ */
+template<typename SourceTagType, typename DestinationTagType>
+void expand_and_promote_using_bitmap(const util::BitMagic& bv, const uint8_t* dense_ptr, uint8_t* dest, size_t num_rows) {
+    using SourceType = typename SourceTagType::DataTypeTag::raw_type;
+    using DestinationType = typename DestinationTagType::DataTypeTag::raw_type;
+    size_t next_row = 0;
+    for(auto en = bv.first(); en < bv.end(); ++en) {
+        const size_t row = *en;
+        util::check(row < num_rows, "Sparse map row {} out of range for {} rows", row, num_rows);
+        util::default_initialize<DestinationTagType>(dest + next_row * sizeof(DestinationType), (row - next_row) * sizeof(DestinationType));
+        SourceType value;
+        std::memcpy(&value, dense_ptr, sizeof(SourceType));
+        const auto promoted = static_cast<DestinationType>(value);
+        std::memcpy(dest + row * sizeof(DestinationType), &promoted, sizeof(DestinationType));
+        dense_ptr += sizeof(SourceType);
+        next_row = row + 1;
+    }
+    util::default_initialize<DestinationTagType>(dest + next_row * sizeof(DestinationType), (num_rows - next_row) * sizeof(DestinationType));
+}
+
+} // namespace arcticdb
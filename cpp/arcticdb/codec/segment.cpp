@@ -144,6 +144,12 @@ Segment Segment::from_bytes(const std::uint8_t* src, std::size_t readable_size,
 }
 
 
+Segment Segment::from_shared_bytes(const std::uint8_t* src, std::size_t readable_size, std::shared_ptr<const void> owner) {
+    auto segment = from_bytes(src, readable_size, false);
+    segment.owner_ = std::move(owner);
+    return segment;
+}
+
 Segment Segment::from_buffer(std::shared_ptr<Buffer>&& buffer) {
     ARCTICDB_SAMPLE(SegmentFromBytes, 0)
     auto* fixed_hdr = reinterpret_cast<Segment::FixedHeader*>(buffer->data());
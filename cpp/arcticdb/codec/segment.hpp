@@ -121,6 +121,7 @@ class Segment {
         swap(header_, that.header_);
         swap(arena_, that.arena_);
         swap(fields_, that.fields_);
+        swap(owner_, that.owner_);
         move_buffer(std::move(that));
     }
 
@@ -129,6 +130,7 @@ class Segment {
         swap(header_, that.header_);
         swap(arena_, that.arena_);
         swap(fields_, that.fields_);
+        swap(owner_, that.owner_);
         move_buffer(std::move(that));
         return *this;
     }
@@ -143,6 +145,9 @@ class Segment {
 
     static Segment from_bytes(const std::uint8_t *src, std::size_t readable_size, bool copy_data = false);
 
+    // Views bytes without copying them, keeping whatever owns them alive for as long as the segment references them
+    static Segment from_shared_bytes(const std::uint8_t *src, std::size_t readable_size, std::shared_ptr<const void> owner);
+
     void write_to(std::uint8_t *dst, std::size_t hdr_sz);
 
     std::pair<uint8_t*, size_t> try_internal_write(std::shared_ptr<Buffer>& tmp, size_t hdr_size);
@@ -249,6 +254,7 @@ class Segment {
     arcticdb::proto::encoding::SegmentHeader* header_ = nullptr;
     VariantBuffer buffer_;
     std::shared_ptr<FieldCollection> fields_;
+    std::shared_ptr<const void> owner_;
 };
 
 } //namespace arcticdb
@@ -7,12 +7,15 @@
 
 #include <arcticdb/util/buffer.hpp>
 #include <arcticdb/codec/codec.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
 #include <arcticdb/entity/types.hpp>
 #include <arcticdb/util/test/test_utils.hpp>
 #include <arcticdb/util/test/generators.hpp>
 #include <arcticdb/util/random.h>
 #include <arcticdb/stream/row_builder.hpp>
 #include <arcticdb/stream/aggregator.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/sparse_utils.hpp>
 
 #include <gtest/gtest.h>
 
@@ -217,4 +220,82 @@ TEST(SegmentEncoderTest, StressTestString) {
                 rb.set_string(timestamp(j), strings[(i + j) & (VectorSize - 1)]);
         });
     }
-}
\ No newline at end of file
+}
+TEST(SegmentEncoderTest, ZstdDictionary) {
+    // Many small, similar segments, which is where a trained dictionary pays off
+    auto record = [] (size_t i) {
+        return fmt::format("{{\"symbol\": \"equities/emea/sym_{}\", \"venue\": \"XLON\", \"currency\": \"GBP\", \"lot\": {}}}", i, i % 7);
+    };
+    std::vector<std::string> sample_data;
+    for(size_t i = 0; i < 2000; ++i)
+        sample_data.emplace_back(record(i));
+
+    auto dictionary = train_zstd_dictionary(std::vector<std::string_view>(sample_data.begin(), sample_data.end()), 16 * 1024);
+    ASSERT_FALSE(dictionary.empty());
+    const auto dictionary_id = ZstdDictionaries::instance()->add(std::move(dictionary))->id();
+    ASSERT_EQ(ZstdDictionaries::instance()->get(dictionary_id)->id(), dictionary_id);
+
+    const auto tsd = create_tsd<DataTypeTag<DataType::ASCII_DYNAMIC64>, Dimension::Dim0>("thing", 1);
+    SegmentInMemory s(StreamDescriptor{tsd});
+    for(size_t i = 0; i < 3; ++i) {
+        s.set_scalar(0, timestamp(i));
+        s.set_string(1, record(5000 + i));
+        s.end_row();
+    }
+
+    arcticdb::proto::encoding::VariantCodec plain;
+    plain.mutable_zstd()->set_level(3);
+    auto with_dictionary = plain;
+    with_dictionary.mutable_zstd()->set_dictionary_id(dictionary_id);
+
+    for(auto encode : {&encode_v1, &encode_v2}) {
+        auto plain_size = encode(s.clone(), plain).total_segment_size();
+        Segment seg = encode(s.clone(), with_dictionary);
+        ASSERT_LT(seg.total_segment_size(), plain_size);
+
+        SegmentInMemory res = decode_segment(std::move(seg));
+        ASSERT_EQ(res.row_count(), 3u);
+        for(size_t i = 0; i < 3; ++i)
+            ASSERT_EQ(res.string_at(i, 1).value(), record(5000 + i));
+    }
+}
+
+TEST(SegmentEncoderTest, AdaptiveSparseMaps) {
+    const size_t num_rows = 1'000'000;
+    util::BitMagic very_sparse;
+    for(size_t i = 0; i < 10; ++i)
+        very_sparse.set(bv_size(i * 99'991));
+
+    util::BitMagic clustered;
+    clustered.set_range(1000, 400'000);
+    clustered.set_range(600'000, num_rows - 1);
+
+    util::BitMagic random;
+    init_random(42);
+    for(size_t i = 0; i < num_rows; i += 1 + random_int() % 5)
+        random.set(bv_size(i));
+
+    auto encoded_size = [] (const util::BitMagic& bv, util::BitMagic& decoded) {
+        bm::serializer<util::BitMagic>::statistics_type stat{};
+        bv.calc_stat(&stat);
+        Buffer buffer;
+        buffer.ensure(stat.max_serialize_mem + sizeof(util::BitMagicStart) + sizeof(util::BitMagicEnd));
+        std::ptrdiff_t pos = 0;
+        const auto bytes = encode_bitmap(bv, buffer, pos);
+        const uint8_t* data = buffer.data();
+        decoded = util::decode_sparse_map(data, bytes);
+        EXPECT_EQ(data, buffer.data() + bytes);
+        return bytes;
+    };
+
+    for(const auto* bv : {&very_sparse, &clustered, &random}) {
+        util::BitMagic decoded;
+        const auto bitmagic_bytes = encoded_size(*bv, decoded);
+        ASSERT_TRUE(decoded == *bv);
+
+        ScopedConfig adaptive("Codec.AdaptiveSparseMaps", 1);
+        const auto adaptive_bytes = encoded_size(*bv, decoded);
+        ASSERT_TRUE(decoded == *bv);
+        ASSERT_LE(adaptive_bytes, bitmagic_bytes);
+    }
+}
@@ -0,0 +1,87 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/codec/promoting_data_sink.hpp>
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace arcticdb {
+
+namespace {
+// Feeds values to the sink block by block, in the same way as decode_ndarray
+template<typename SourceType, typename DestinationType>
+void decode_blocks(PromotingDataSink<SourceType, DestinationType>& sink, const std::vector<SourceType>& values, size_t block_size) {
+    auto data = sink.allocate_data(values.size() * sizeof(SourceType));
+    for(size_t start = 0; start < values.size(); start += block_size) {
+        const auto count = std::min(block_size, values.size() - start);
+        std::memcpy(data + start * sizeof(SourceType), values.data() + start, count * sizeof(SourceType));
+        sink.advance_data(count * sizeof(SourceType));
+    }
+}
+} // namespace
+
+TEST(PromotingDataSink, WidensBlocksInPlace) {
+    constexpr size_t num_rows = 1000;
+    std::vector<int32_t> values(num_rows);
+    std::iota(values.begin(), values.end(), -500);
+
+    std::vector<int64_t> dest(num_rows);
+    PromotingDataSink<int32_t, int64_t> sink{reinterpret_cast<uint8_t*>(dest.data()), num_rows, true};
+    decode_blocks(sink, values, 97);
+
+    ASSERT_EQ(sink.values_decoded(), num_rows);
+    for(size_t i = 0; i < num_rows; ++i)
+        ASSERT_EQ(dest[i], values[i]);
+}
+
+TEST(PromotingDataSink, WidensFloats) {
+    constexpr size_t num_rows = 300;
+    std::vector<float> values(num_rows);
+    for(size_t i = 0; i < num_rows; ++i)
+        values[i] = static_cast<float>(i) / 8.0f;
+
+    std::vector<double> dest(num_rows);
+    PromotingDataSink<float, double> sink{reinterpret_cast<uint8_t*>(dest.data()), num_rows, true};
+    decode_blocks(sink, values, 64);
+
+    for(size_t i = 0; i < num_rows; ++i)
+        ASSERT_EQ(dest[i], static_cast<double>(values[i]));
+}
+
+TEST(PromotingDataSink, ExpandsSparse) {
+    using SourceTag = TypeDescriptorTag<DataTypeTag<DataType::UINT8>, DimensionTag<Dimension::Dim0>>;
+    using DestinationTag = TypeDescriptorTag<DataTypeTag<DataType::FLOAT64>, DimensionTag<Dimension::Dim0>>;
+    constexpr size_t num_rows = 200;
+
+    // Rows clustered at the end are the case where the dense values sit closest to the rows being written
+    util::BitMagic bv;
+    std::vector<uint8_t> values;
+    for(size_t row = 0; row < num_rows; ++row) {
+        if(row % 7 == 0 || row > 150) {
+            bv.set(row);
+            values.push_back(static_cast<uint8_t>(row));
+        }
+    }
+
+    std::vector<double> dest(num_rows);
+    PromotingDataSink<uint8_t, double> sink{reinterpret_cast<uint8_t*>(dest.data()), num_rows, false};
+    decode_blocks(sink, values, 16);
+    expand_and_promote_using_bitmap<SourceTag, DestinationTag>(bv, sink.source_data(), reinterpret_cast<uint8_t*>(dest.data()), num_rows);
+
+    for(size_t row = 0; row < num_rows; ++row) {
+        if(bv.test(row))
+            ASSERT_EQ(dest[row], static_cast<double>(row));
+        else
+            ASSERT_TRUE(std::isnan(dest[row]));
+    }
+}
+
+} // namespace arcticdb
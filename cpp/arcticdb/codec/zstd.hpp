@@ -13,11 +13,21 @@
 #include <arcticdb/storage/common.hpp>
 #include <arcticdb/util/pb_util.hpp>
 #include <arcticdb/util/dump_bytes.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
 
 #include <zstd.h>
 
 namespace arcticdb::detail {
 
+// Resolving a dictionary takes a lock on the process-wide cache, whereas consecutive blocks almost always share one
+inline const ZstdDictionary& zstd_dictionary(uint64_t dictionary_id) {
+    thread_local std::shared_ptr<const ZstdDictionary> last;
+    if(!last || last->id() != dictionary_id)
+        last = ZstdDictionaries::instance()->get(dictionary_id);
+
+    return *last;
+}
+
 struct ZstdBlockEncoder {
 
     using Opts = arcticdb::proto::encoding::VariantCodec::Zstd;
@@ -41,7 +51,17 @@ struct ZstdBlockEncoder {
             std::size_t out_capacity,
             std::ptrdiff_t &pos,
             CodecType& out_codec) {
-        std::size_t compressed_bytes = ZSTD_compress(out, out_capacity, in, block_utils.bytes_, opts.level());
+        std::size_t compressed_bytes;
+        if(opts.dictionary_id() != 0) {
+            thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+            const auto& dictionary = zstd_dictionary(opts.dictionary_id());
+            compressed_bytes = ZSTD_compress_usingCDict(context.get(), out, out_capacity, in, block_utils.bytes_,
+                                                        dictionary.compression_dictionary(opts.level()));
+            util::check(!ZSTD_isError(compressed_bytes), "zstd compression with dictionary {} failed: {}",
+                        opts.dictionary_id(), ZSTD_getErrorName(compressed_bytes));
+        } else {
+            compressed_bytes = ZSTD_compress(out, out_capacity, in, block_utils.bytes_, opts.level());
+        }
         hasher(in, block_utils.count_);
         pos += compressed_bytes;
         out_codec.mutable_zstd()->MergeFrom(opts);
@@ -66,12 +86,20 @@ struct ZstdDecoder {
         const std::uint8_t *in,
         std::size_t in_bytes,
         T *t_out,
-        std::size_t out_bytes) {
+        std::size_t out_bytes,
+        std::uint64_t dictionary_id = 0) {
 
         const std::size_t decomp_size = ZSTD_getFrameContentSize(in, in_bytes);
         util::check_arg(decomp_size == out_bytes, "expected out_bytes == zstd deduced bytes, actual {} != {}",
                         out_bytes, decomp_size);
-        std::size_t real_decomp = ZSTD_decompress(t_out, out_bytes, in, in_bytes);
+        std::size_t real_decomp;
+        if(dictionary_id != 0) {
+            thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+            real_decomp = ZSTD_decompress_usingDDict(context.get(), t_out, out_bytes, in, in_bytes,
+                                                     zstd_dictionary(dictionary_id).decompression_dictionary());
+        } else {
+            real_decomp = ZSTD_decompress(t_out, out_bytes, in, in_bytes);
+        }
         util::check_arg(real_decomp == out_bytes, "expected out_bytes == zstd decompressed bytes, actual {} != {}",
                         out_bytes, real_decomp);
     }
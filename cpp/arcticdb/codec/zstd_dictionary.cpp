@@ -0,0 +1,126 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/codec/zstd_dictionary.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/hash.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <zstd.h>
+#include <zdict.h>
+
+namespace arcticdb {
+
+ZstdDictionary::ZstdDictionary(std::string data) :
+    id_(zstd_dictionary_id(data)),
+    data_(std::move(data)),
+    ddict_(ZSTD_createDDict(data_.data(), data_.size())) {
+    util::check(ddict_ != nullptr, "Failed to load zstd dictionary {} of {} bytes", id_, data_.size());
+}
+
+ZstdDictionary::~ZstdDictionary() {
+    for(auto& [level, cdict] : cdicts_)
+        ZSTD_freeCDict(cdict);
+
+    ZSTD_freeDDict(ddict_);
+}
+
+const ZSTD_CDict* ZstdDictionary::compression_dictionary(int level) const {
+    std::lock_guard lock{mutex_};
+    auto it = cdicts_.find(level);
+    if(it == cdicts_.end()) {
+        auto cdict = ZSTD_createCDict(data_.data(), data_.size(), level);
+        util::check(cdict != nullptr, "Failed to digest zstd dictionary {} at level {}", id_, level);
+        it = cdicts_.try_emplace(level, cdict).first;
+    }
+    return it->second;
+}
+
+uint64_t zstd_dictionary_id(std::string_view data) {
+    // Zero marks a block compressed without a dictionary
+    const auto id = hash(data);
+    return id == 0 ? 1 : id;
+}
+
+std::string train_zstd_dictionary(const std::vector<std::string_view>& samples, size_t max_dictionary_size) {
+    std::string sample_buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for(const auto& sample : samples) {
+        if(sample.empty())
+            continue;
+
+        sample_buffer.append(sample);
+        sample_sizes.push_back(sample.size());
+    }
+
+    std::string dictionary(max_dictionary_size, '\0');
+    const auto dictionary_size = ZDICT_trainFromBuffer(
+        dictionary.data(),
+        dictionary.size(),
+        sample_buffer.data(),
+        sample_sizes.data(),
+        static_cast<unsigned>(sample_sizes.size()));
+
+    if(ZDICT_isError(dictionary_size)) {
+        log::codec().info("Could not train a zstd dictionary from {} samples: {}", sample_sizes.size(), ZDICT_getErrorName(dictionary_size));
+        return {};
+    }
+    dictionary.resize(dictionary_size);
+    return dictionary;
+}
+
+std::shared_ptr<ZstdDictionaries> ZstdDictionaries::instance() {
+    static auto instance = std::make_shared<ZstdDictionaries>();
+    return instance;
+}
+
+std::shared_ptr<const ZstdDictionary> ZstdDictionaries::add(std::string data) {
+    auto dictionary = std::make_shared<const ZstdDictionary>(std::move(data));
+    std::lock_guard lock{mutex_};
+    return dictionaries_.try_emplace(dictionary->id(), std::move(dictionary)).first->second;
+}
+
+std::shared_ptr<const ZstdDictionary> ZstdDictionaries::find(uint64_t id) {
+    std::lock_guard lock{mutex_};
+    auto it = dictionaries_.find(id);
+    return it == dictionaries_.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<const ZstdDictionary> ZstdDictionaries::get(uint64_t id) {
+    if(auto dictionary = find(id); dictionary)
+        return dictionary;
+
+    std::vector<std::shared_ptr<ZstdDictionaryLoader>> loaders;
+    {
+        std::lock_guard lock{loader_mutex_};
+        for(const auto& [handle, loader] : loaders_)
+            loaders.emplace_back(loader);
+    }
+
+    for(auto& loader : loaders) {
+        if(auto data = (*loader)(id); data) {
+            util::check(zstd_dictionary_id(*data) == id, "Loaded zstd dictionary does not match requested id {}", id);
+            return add(std::move(*data));
+        }
+    }
+    storage::raise<ErrorCode::E_KEY_NOT_FOUND>("zstd dictionary {} is not available in any open library", id);
+}
+
+size_t ZstdDictionaries::register_loader(ZstdDictionaryLoader&& loader) {
+    std::lock_guard lock{loader_mutex_};
+    const auto handle = next_handle_++;
+    loaders_.try_emplace(handle, std::make_shared<ZstdDictionaryLoader>(std::move(loader)));
+    return handle;
+}
+
+void ZstdDictionaries::unregister_loader(size_t handle) {
+    std::lock_guard lock{loader_mutex_};
+    loaders_.erase(handle);
+}
+
+} // namespace arcticdb
@@ -0,0 +1,105 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <folly/Function.h>
+#include <boost/core/noncopyable.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+typedef struct ZSTD_CDict_s ZSTD_CDict;
+typedef struct ZSTD_DDict_s ZSTD_DDict;
+
+namespace arcticdb {
+
+/*
+ * A trained zstd dictionary. Its id is the hash of its contents, so an id recorded in a block's codec metadata
+ * identifies the same dictionary in every library and process. The digested forms used by the compressor are built
+ * on first use and kept for the lifetime of the dictionary.
+ */
+class ZstdDictionary : boost::noncopyable {
+public:
+    explicit ZstdDictionary(std::string data);
+    ~ZstdDictionary();
+
+    uint64_t id() const { return id_; }
+
+    const std::string& data() const { return data_; }
+
+    const ZSTD_CDict* compression_dictionary(int level) const;
+
+    const ZSTD_DDict* decompression_dictionary() const { return ddict_; }
+
+private:
+    uint64_t id_;
+    std::string data_;
+    ZSTD_DDict* ddict_;
+    mutable std::mutex mutex_;
+    mutable std::map<int, ZSTD_CDict*> cdicts_;
+};
+
+uint64_t zstd_dictionary_id(std::string_view data);
+
+// Returns an empty string if zstd could not find enough common content in the samples to build a dictionary
+std::string train_zstd_dictionary(const std::vector<std::string_view>& samples, size_t max_dictionary_size);
+
+// Fetches the contents of a dictionary that is not yet cached, returning nullopt if the source does not have it
+using ZstdDictionaryLoader = folly::Function<std::optional<std::string>(uint64_t)>;
+
+/*
+ * Process-wide cache of the dictionaries referenced by encoded blocks. Dictionaries are stored as library keys, so
+ * each open library registers a loader and a block referencing an uncached dictionary is resolved by asking each of
+ * them in turn. Dictionaries are small and few, so they are never evicted.
+ */
+class ZstdDictionaries : boost::noncopyable {
+public:
+    static std::shared_ptr<ZstdDictionaries> instance();
+
+    std::shared_ptr<const ZstdDictionary> add(std::string data);
+
+    // Raises if no registered loader has the dictionary
+    std::shared_ptr<const ZstdDictionary> get(uint64_t id);
+
+    size_t register_loader(ZstdDictionaryLoader&& loader);
+
+    void unregister_loader(size_t handle);
+
+private:
+    std::shared_ptr<const ZstdDictionary> find(uint64_t id);
+
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<const ZstdDictionary>> dictionaries_;
+    std::mutex loader_mutex_;
+    std::map<size_t, std::shared_ptr<ZstdDictionaryLoader>> loaders_;
+    size_t next_handle_ = 0;
+};
+
+// Keeps a loader registered for as long as it is alive
+class ZstdDictionaryLoaderRegistration : boost::noncopyable {
+public:
+    explicit ZstdDictionaryLoaderRegistration(ZstdDictionaryLoader&& loader) :
+        handle_(ZstdDictionaries::instance()->register_loader(std::move(loader))) {
+    }
+
+    ~ZstdDictionaryLoaderRegistration() {
+        ZstdDictionaries::instance()->unregister_loader(handle_);
+    }
+
+private:
+    size_t handle_;
+};
+
+} // namespace arcticdb
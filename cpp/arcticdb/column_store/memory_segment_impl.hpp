@@ -896,6 +896,9 @@ public:
         }
         output.allow_sparse_ = allow_sparse_;
         output.compacted_ = compacted_;
+        if(index_fields_)
+            output.index_fields_ = std::make_shared<FieldCollection>(index_fields_->clone());
+
         return output;
     }
 
@@ -51,6 +51,9 @@ KeyData get_key_data(KeyType key_type) {
     STRING_REF(KeyType::LIBRARY_CONFIG, cref, 'C')
     STRING_KEY(KeyType::COLUMN_STATS, cstats, 'S')
     STRING_REF(KeyType::SNAPSHOT_REF, tref, 't')
+    STRING_KEY(KeyType::SNAPSHOT_MANIFEST, tman, 'n')
+    STRING_REF(KeyType::DEDUP_INDEX, dedup, 'D')
+    STRING_REF(KeyType::ZSTD_DICTIONARY, zdict, 'z')
     // Less important
     STRING_KEY(KeyType::LOG, log, 'o')
     STRING_KEY(KeyType::LOG_COMPACTED, logc, 'O')
@@ -61,7 +64,10 @@ KeyData get_key_data(KeyType key_type) {
     STRING_KEY(KeyType::MULTI_KEY, mref, 'm')
     STRING_REF(KeyType::LOCK, lref, 'x')
     STRING_REF(KeyType::SNAPSHOT_TOMBSTONE, ttomb, 'X')
+    STRING_REF(KeyType::DELETE_JOURNAL, djour, 'J')
+    STRING_REF(KeyType::RECOMPRESS_JOURNAL, rjour, 'R')
     STRING_KEY(KeyType::APPEND_DATA, app, 'b')
+    STRING_KEY(KeyType::APPEND_MANIFEST, aman, 'A')
     // Unused
     STRING_KEY(KeyType::PARTITION, pref, 'p')
     STRING_REF(KeyType::STORAGE_INFO, sref, 'h')
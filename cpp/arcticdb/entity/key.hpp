@@ -178,6 +178,36 @@ enum class KeyType : int {
      * Contains column stats about the index key with the same stream ID and version number
      */
     COLUMN_STATS = 25,
+    /*
+     * Per-symbol index of the content hashes of data keys written for the symbol, used to de-duplicate
+     * segments against all live versions rather than just the latest one
+     */
+    DEDUP_INDEX = 26,
+    /*
+     * Library-level trained zstd dictionaries, keyed by dictionary id, plus the mapping of key types to the
+     * dictionary their segments are currently compressed with
+     */
+    ZSTD_DICTIONARY = 27,
+    /*
+     * One shard of a large snapshot's contents. The SNAPSHOT_REF of a sharded snapshot holds these rather than index
+     * keys, each under the first symbol in its shard, so that amending the snapshot only rewrites the touched shards
+     */
+    SNAPSHOT_MANIFEST = 28,
+    /*
+     * Records the index keys a delete is reclaiming, and those whose data must be kept, until all of their keys have
+     * been removed, so that an interrupted delete can be finished later rather than leaving orphaned data keys
+     */
+    DELETE_JOURNAL = 29,
+    /*
+     * The keys of a symbol's older incomplete segments. The APPEND_REF holds the keys of the latest incompletes, which
+     * are periodically folded into a new one of these so that the head stays small
+     */
+    APPEND_MANIFEST = 30,
+    /*
+     * The data segments a recompression has already rewritten, with the keys they replace, so that an interrupted
+     * recompression links them when it is run again rather than rewriting them
+     */
+    RECOMPRESS_JOURNAL = 31,
     UNDEFINED
 };
 
@@ -194,12 +224,18 @@ inline std::vector<KeyType> key_types_write_precedence() {
         KeyType::VERSION_REF,
         KeyType::SYMBOL_LIST,
         KeyType::SNAPSHOT,
+        KeyType::SNAPSHOT_MANIFEST,
         KeyType::SNAPSHOT_REF,
         KeyType::SNAPSHOT_TOMBSTONE,
         KeyType::APPEND_REF,
         KeyType::APPEND_DATA,
+        KeyType::APPEND_MANIFEST,
         KeyType::PARTITION,
-        KeyType::OFFSET
+        KeyType::OFFSET,
+        KeyType::DEDUP_INDEX,
+        KeyType::ZSTD_DICTIONARY,
+        KeyType::DELETE_JOURNAL,
+        KeyType::RECOMPRESS_JOURNAL
     };
 }
 
@@ -186,6 +186,12 @@ struct TypedTensor : public NativeTensor {
     }
 
     TypedTensor(const NativeTensor& tensor, ssize_t slice_num, ssize_t regular_slice_size, ssize_t nvalues) :
+            TypedTensor(tensor, slice_num * (tensor.ndim() > 1 ? nvalues : regular_slice_size), nvalues) {
+    }
+
+    // The nvalues values starting at row_offset. One-dimensional tensors can be divided at any row, matrices only
+    // into equal sections of nvalues values
+    TypedTensor(const NativeTensor& tensor, ssize_t row_offset, ssize_t nvalues) :
             NativeTensor(
                     nvalues * itemsize(),
                     tensor.ndim(),
@@ -196,29 +202,30 @@ struct TypedTensor : public NativeTensor {
                     nullptr
                     ) {
 
-        ssize_t stride_offset;
+        ssize_t byte_offset;
         if(ndim() > 1) {
             // Check that we can evenly subdivide a matrix into n rows (otherwise we'd have to have
             // extra state to track how far along a row we were
             util::check(nvalues >= shape(0) && nvalues % shape(0) == 0,
                         "Cannot subdivide a tensor of width {} into {}-sized sections", shape(0), nvalues);
+            util::check(row_offset % nvalues == 0,
+                        "Cannot start a {}-sized section of a tensor of width {} at value {}", nvalues, shape(0), row_offset);
 
             // Adjust the column shape
             auto divisor = calc_elements(shape(), ndim()) / nvalues;
             shapes_[0] /= divisor;
-            stride_offset = strides(0) * (shape(0));
+            // The new column shape * the column stride tells us how far to move the data pointer from the origin
+            byte_offset = (row_offset / nvalues) * strides(0) * shape(0);
         }
         else {
             shapes_[0] = nvalues;
-            stride_offset = regular_slice_size * strides(0);
+            byte_offset = row_offset * strides(0);
         }
 
-        // The new column shape * the column stride tells us how far to move the data pointer from the origin
-
-        ptr = reinterpret_cast<const uint8_t*>(tensor.data()) + (slice_num * stride_offset);
+        ptr = reinterpret_cast<const uint8_t*>(tensor.data()) + byte_offset;
         util::check(ptr < static_cast<const uint8_t*>(tensor.ptr) + std::abs(tensor.extent(0)),
                 "Tensor overflow, cannot put slice pointer at byte {} in a tensor of {} bytes",
-                slice_num * stride_offset, tensor.extent(0));
+                byte_offset, tensor.extent(0));
     }
 };
 template<typename T>
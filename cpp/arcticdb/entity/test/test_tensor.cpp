@@ -320,4 +320,32 @@ TEST(SparseArray, SubDivideUneven) {
     for(uint32_t x = 0; x < num_rows; ++x) {
         ASSERT_EQ(output[x], x);
     }
-}
\ No newline at end of file
+}
+TEST(StridedArray, SubDivideAtRowOffsets) {
+    using namespace arcticdb::entity;
+    using data_t = uint32_t;
+    constexpr size_t num_rows = 100;
+    // Every other value of the underlying buffer, as a strided column would be
+    auto data = std::make_shared<std::vector<data_t>>(num_rows * 2);
+    for(auto i = 0u; i < num_rows; ++i)
+        (*data)[i * 2] = i;
+
+    const std::vector<stride_t> strides = {2 * sizeof(data_t)};
+    const std::vector<shape_t> shapes = {num_rows};
+    const DataType dt = DataType::UINT32;
+    NativeTensor tensor{ssize_t(num_rows * sizeof(data_t)), 1, strides.data(), shapes.data(), dt, get_type_size(dt), static_cast<const void*>(data->data())};
+
+    // Irregular slices, as content-defined or time-bucketed slicing produce
+    const std::vector<ssize_t> boundaries = {0, 7, 30, 31, 64, 100};
+    std::vector<data_t> output(num_rows);
+    for(size_t i = 0; i + 1 < boundaries.size(); ++i) {
+        TypedTensor<data_t> typed_tensor{tensor, boundaries[i], boundaries[i + 1] - boundaries[i]};
+        arcticdb::util::FlattenHelper f{typed_tensor};
+        data_t* dest = output.data() + boundaries[i];
+        f.flatten(dest, reinterpret_cast<const data_t*>(typed_tensor.data()));
+    }
+
+    for(uint32_t x = 0; x < num_rows; ++x) {
+        ASSERT_EQ(output[x], x);
+    }
+}
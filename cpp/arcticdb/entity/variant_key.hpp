@@ -21,6 +21,9 @@ using VariantKey = std::variant<entity::AtomKey, entity::RefKey>;
 
 using IterateTypeVisitor = std::function<void(VariantKey &&key)>;
 
+// Also passed the stored size of the key's object in bytes
+using IterateTypeWithSizeVisitor = std::function<void(VariantKey &&key, size_t size)>;
+
 // Aliases to clarify usage and allow more detailed typing in the future, similar to aliases for AtomKey:
 /** Should be a SNAPSHOT_REF key or the legacy SNAPSHOT AtomKey. */
 using SnapshotVariantKey = VariantKey;
@@ -0,0 +1,319 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/pipeline/arrow_input.hpp>
+#include <arcticdb/column_store/string_pool.hpp>
+#include <arcticdb/entity/performance_tracing.hpp>
+#include <arcticdb/util/offset_string.hpp>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace arcticdb::pipelines {
+
+struct ArrowInputData : boost::noncopyable {
+    ArrowArray array_{};
+    ArrowSchema schema_{};
+    std::vector<std::vector<uint8_t>> owned_buffers_;
+
+    ArrowInputData(ArrowArray* array, ArrowSchema* schema) :
+        array_(*array),
+        schema_(*schema) {
+        // Moving the structs marks the originals released, as the C data interface specifies
+        array->release = nullptr;
+        schema->release = nullptr;
+    }
+
+    ~ArrowInputData() {
+        if(array_.release)
+            array_.release(&array_);
+
+        if(schema_.release)
+            schema_.release(&schema_);
+    }
+
+    template<typename T>
+    T* allocate(size_t count) {
+        auto& buffer = owned_buffers_.emplace_back(std::max(count * sizeof(T), size_t{1}), uint8_t{0});
+        return reinterpret_cast<T*>(buffer.data());
+    }
+};
+
+namespace {
+
+bool is_valid(const ArrowArray& array, size_t row) {
+    if(array.null_count == 0 || array.buffers[0] == nullptr)
+        return true;
+
+    const auto pos = static_cast<size_t>(array.offset) + row;
+    return (static_cast<const uint8_t*>(array.buffers[0])[pos / 8] >> (pos % 8)) & 1;
+}
+
+std::optional<DataType> fixed_width_type(std::string_view format) {
+    if(format.size() != 1)
+        return std::nullopt;
+
+    switch(format[0]) {
+    case 'c': return DataType::INT8;
+    case 'C': return DataType::UINT8;
+    case 's': return DataType::INT16;
+    case 'S': return DataType::UINT16;
+    case 'i': return DataType::INT32;
+    case 'I': return DataType::UINT32;
+    case 'l': return DataType::INT64;
+    case 'L': return DataType::UINT64;
+    case 'f': return DataType::FLOAT32;
+    case 'g': return DataType::FLOAT64;
+    default: return std::nullopt;
+    }
+}
+
+// Nanoseconds per unit for the Arrow timestamp formats, which take the form ts<unit>:<timezone>
+std::optional<int64_t> timestamp_multiplier(std::string_view format) {
+    if(format.size() < 4 || format.substr(0, 2) != "ts" || format[3] != ':')
+        return std::nullopt;
+
+    switch(format[2]) {
+    case 'n': return 1;
+    case 'u': return 1'000;
+    case 'm': return 1'000'000;
+    case 's': return 1'000'000'000;
+    default: return std::nullopt;
+    }
+}
+
+bool is_string_format(std::string_view format) {
+    return format == "u" || format == "U" || format == "z" || format == "Z";
+}
+
+bool is_utf_format(std::string_view format) {
+    return format == "u" || format == "U";
+}
+
+NativeTensor make_tensor(DataType data_type, size_t rows, const void* data) {
+    const auto shape = static_cast<shape_t>(rows);
+    const auto elsize = static_cast<ssize_t>(get_type_size(data_type));
+    return NativeTensor{static_cast<ssize_t>(rows) * elsize, 1, nullptr, &shape, data_type, elsize, data};
+}
+
+template<typename T>
+const T* values_at(const ArrowArray& array, size_t buffer) {
+    return static_cast<const T*>(array.buffers[buffer]) + array.offset;
+}
+
+template<typename T>
+NativeTensor import_numeric(const ArrowArray& array, std::string_view name, DataType data_type, ArrowInputData& data) {
+    const auto rows = static_cast<size_t>(array.length);
+    const auto* values = values_at<T>(array, 1);
+    if(array.null_count == 0)
+        return make_tensor(data_type, rows, values);
+
+    if constexpr (std::is_floating_point_v<T>) {
+        auto* output = data.allocate<T>(rows);
+        for(size_t row = 0; row < rows; ++row)
+            output[row] = is_valid(array, row) ? values[row] : std::numeric_limits<T>::quiet_NaN();
+
+        return make_tensor(data_type, rows, output);
+    } else {
+        user_input::raise<ErrorCode::E_INVALID_USER_ARGUMENT>(
+            "Column {} has {} nulls, which cannot be stored in a column of type {}", name, array.null_count, data_type);
+    }
+}
+
+NativeTensor import_timestamps(const ArrowArray& array, int64_t multiplier, ArrowInputData& data) {
+    const auto rows = static_cast<size_t>(array.length);
+    const auto* values = values_at<timestamp>(array, 1);
+    if(array.null_count == 0 && multiplier == 1)
+        return make_tensor(DataType::NANOSECONDS_UTC64, rows, values);
+
+    auto* output = data.allocate<timestamp>(rows);
+    for(size_t row = 0; row < rows; ++row)
+        output[row] = is_valid(array, row) ? values[row] * multiplier : std::numeric_limits<timestamp>::min();
+
+    return make_tensor(DataType::NANOSECONDS_UTC64, rows, output);
+}
+
+NativeTensor import_bools(const ArrowArray& array, std::string_view name, ArrowInputData& data) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(array.null_count == 0,
+        "Column {} has {} nulls, which cannot be stored in a bool column", name, array.null_count);
+    const auto rows = static_cast<size_t>(array.length);
+    const auto* bits = static_cast<const uint8_t*>(array.buffers[1]);
+    auto* output = data.allocate<bool>(rows);
+    for(size_t row = 0; row < rows; ++row) {
+        const auto pos = static_cast<size_t>(array.offset) + row;
+        output[row] = (bits[pos / 8] >> (pos % 8)) & 1;
+    }
+    return make_tensor(DataType::BOOL8, rows, output);
+}
+
+template<typename OffsetType>
+std::string_view string_at(const ArrowArray& array, size_t row) {
+    const auto* offsets = values_at<OffsetType>(array, 1);
+    const auto* chars = static_cast<const char*>(array.buffers[2]);
+    return {chars + offsets[row], static_cast<size_t>(offsets[row + 1] - offsets[row])};
+}
+
+// Adds each string in a string array to the pool, returning the pool offsets with placeholders for nulls
+std::vector<StringPool::offset_t> pool_strings(const ArrowArray& array, std::string_view format, StringPool& pool) {
+    const auto rows = static_cast<size_t>(array.length);
+    const bool large = format == "U" || format == "Z";
+    std::vector<StringPool::offset_t> output(rows);
+    for(size_t row = 0; row < rows; ++row) {
+        if(!is_valid(array, row)) {
+            output[row] = not_a_string();
+            continue;
+        }
+        const auto sv = large ? string_at<int64_t>(array, row) : string_at<int32_t>(array, row);
+        output[row] = pool.get(sv).offset();
+    }
+    return output;
+}
+
+template<typename IndexType>
+void gather_dictionary(const ArrowArray& array, const std::vector<StringPool::offset_t>& dictionary, StringPool::offset_t* output) {
+    const auto* indices = values_at<IndexType>(array, 1);
+    for(size_t row = 0; row < static_cast<size_t>(array.length); ++row)
+        output[row] = is_valid(array, row) ? dictionary[static_cast<size_t>(indices[row])] : not_a_string();
+}
+
+NativeTensor import_strings(
+    const ArrowArray& array,
+    const ArrowSchema& schema,
+    std::string_view name,
+    StringPool& pool,
+    ArrowInputData& data) {
+    const auto rows = static_cast<size_t>(array.length);
+    auto* output = data.allocate<StringPool::offset_t>(rows);
+    if(schema.dictionary == nullptr) {
+        const auto offsets = pool_strings(array, schema.format, pool);
+        std::copy(offsets.begin(), offsets.end(), output);
+        return make_tensor(is_utf_format(schema.format) ? DataType::UTF_DYNAMIC64 : DataType::ASCII_DYNAMIC64, rows, output);
+    }
+
+    // Each dictionary value is pooled once and the indices are mapped onto the pooled offsets
+    const std::string_view value_format{schema.dictionary->format};
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(is_string_format(value_format),
+        "Column {} is dictionary encoded with unsupported value format {}", name, value_format);
+    const auto dictionary = pool_strings(*array.dictionary, value_format, pool);
+    const std::string_view index_format{schema.format};
+    if(index_format == "c") gather_dictionary<int8_t>(array, dictionary, output);
+    else if(index_format == "C") gather_dictionary<uint8_t>(array, dictionary, output);
+    else if(index_format == "s") gather_dictionary<int16_t>(array, dictionary, output);
+    else if(index_format == "S") gather_dictionary<uint16_t>(array, dictionary, output);
+    else if(index_format == "i") gather_dictionary<int32_t>(array, dictionary, output);
+    else if(index_format == "I") gather_dictionary<uint32_t>(array, dictionary, output);
+    else if(index_format == "l") gather_dictionary<int64_t>(array, dictionary, output);
+    else if(index_format == "L") gather_dictionary<uint64_t>(array, dictionary, output);
+    else user_input::raise<ErrorCode::E_INVALID_USER_ARGUMENT>("Column {} has unsupported dictionary index format {}", name, index_format);
+
+    return make_tensor(is_utf_format(value_format) ? DataType::UTF_DYNAMIC64 : DataType::ASCII_DYNAMIC64, rows, output);
+}
+
+NativeTensor import_column(
+    const ArrowArray& array,
+    const ArrowSchema& schema,
+    StringPool& pool,
+    ArrowInputData& data) {
+    const std::string_view format{schema.format};
+    const std::string_view name{schema.name};
+    if(schema.dictionary != nullptr || is_string_format(format))
+        return import_strings(array, schema, name, pool, data);
+
+    if(format == "b")
+        return import_bools(array, name, data);
+
+    if(format == "n") {
+        const auto rows = static_cast<size_t>(array.length);
+        return make_tensor(DataType::EMPTYVAL, rows, data.allocate<uint64_t>(rows));
+    }
+
+    if(auto multiplier = timestamp_multiplier(format); multiplier)
+        return import_timestamps(array, *multiplier, data);
+
+    const auto data_type = fixed_width_type(format);
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(data_type.has_value(),
+        "Column {} has Arrow format {}, which cannot be imported", name, format);
+
+    return entity::details::visit_type(*data_type, [&](auto tag) -> NativeTensor {
+        using RawType = typename decltype(tag)::raw_type;
+        if constexpr (std::is_arithmetic_v<RawType>)
+            return import_numeric<RawType>(array, name, *data_type, data);
+        else
+            util::raise_rte("Unexpected type {} for Arrow import", *data_type);
+    });
+}
+
+} // namespace
+
+ArrowInputFrame arrow_to_frame(
+    const StreamId& stream_id,
+    ArrowArray* array,
+    ArrowSchema* schema,
+    const std::optional<std::string>& index_column) {
+    ARCTICDB_SAMPLE_DEFAULT(ArrowToFrame)
+    util::check(array != nullptr && schema != nullptr && array->release && schema->release, "Expected live Arrow structs to import");
+    auto data = std::make_shared<ArrowInputData>(array, schema);
+    const auto& input = data->array_;
+    const auto& input_schema = data->schema_;
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(std::string_view{input_schema.format} == "+s",
+        "Expected an Arrow struct array to import, got format {}", input_schema.format);
+    util::check(input.n_children == input_schema.n_children, "Arrow array has {} children but its schema has {}",
+        input.n_children, input_schema.n_children);
+    util::check(input.offset == 0, "Cannot import a sliced Arrow struct array");
+
+    ArrowInputFrame output;
+    auto& frame = output.frame_;
+    frame.desc.set_id(stream_id);
+    frame.num_rows = input.length;
+    frame.string_pool = std::make_shared<StringPool>();
+
+    if(index_column) {
+        frame.desc.set_index_field_count(1);
+        frame.desc.set_index_type(IndexDescriptor::TIMESTAMP);
+        frame.desc.add_scalar_field(DataType::NANOSECONDS_UTC64, *index_column);
+        frame.index = stream::TimeseriesIndex(*index_column);
+    } else {
+        frame.index = stream::RowCountIndex();
+        frame.desc.set_index_type(IndexDescriptor::ROWCOUNT);
+    }
+
+    for(int64_t col = 0; col < input.n_children; ++col) {
+        const auto& child = *input.children[col];
+        const auto& child_schema = *input_schema.children[col];
+        util::check(child.length == input.length, "Arrow column {} has length {} in a struct of length {}",
+            child_schema.name, child.length, input.length);
+
+        auto tensor = import_column(child, child_schema, *frame.string_pool, *data);
+        if(index_column && *index_column == child_schema.name) {
+            user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(tensor.data_type() == DataType::NANOSECONDS_UTC64,
+                "Index column {} must be a timestamp, got {}", *index_column, tensor.data_type());
+            frame.index_tensor = std::move(tensor);
+        } else {
+            frame.desc.add_field(scalar_field(tensor.data_type(), child_schema.name));
+            frame.field_tensors.push_back(std::move(tensor));
+        }
+    }
+
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!index_column || frame.index_tensor.has_value(),
+        "Index column {} not found in Arrow data", index_column.value_or(""));
+    if(frame.index_tensor) {
+        const auto* index = static_cast<const timestamp*>(frame.index_tensor->data());
+        frame.desc.set_sorted(std::is_sorted(index, index + frame.num_rows) ? SortedValue::ASCENDING : SortedValue::UNSORTED);
+    }
+
+    if(frame.num_rows > 0)
+        frame.set_index_range();
+
+    output.data_ = std::move(data);
+    return output;
+}
+
+} // namespace arcticdb::pipelines
@@ -0,0 +1,42 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/pipeline/arrow_output.hpp>
+#include <arcticdb/pipeline/input_tensor_frame.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace arcticdb::pipelines {
+
+// Holds the imported Arrow structs and any converted copies of their buffers
+struct ArrowInputData;
+
+struct ArrowInputFrame {
+    InputTensorFrame frame_;
+    // The frame's tensors point into this, so it must outlive any write of the frame
+    std::shared_ptr<ArrowInputData> data_;
+};
+
+/*
+ * Builds a frame from an Arrow struct array such as an exported record batch, taking ownership of both structs.
+ *
+ * Numeric columns without nulls are used in place. Booleans, timestamps in units other than nanoseconds and floats
+ * with nulls are converted, with nulls becoming NaN or NaT. Strings, including dictionary-encoded strings, are
+ * gathered into a string pool that the write path reads from directly. If index_column is given it must be a
+ * timestamp column and becomes the frame's timeseries index, otherwise the frame has a row-count index.
+ */
+ArrowInputFrame arrow_to_frame(
+    const StreamId& stream_id,
+    ArrowArray* array,
+    ArrowSchema* schema,
+    const std::optional<std::string>& index_column);
+
+} // namespace arcticdb::pipelines
@@ -0,0 +1,346 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/pipeline/arrow_output.hpp>
+#include <arcticdb/pipeline/string_pool_utils.hpp>
+#include <arcticdb/entity/performance_tracing.hpp>
+#include <arcticdb/util/offset_string.hpp>
+#ifdef ARCTICDB_USING_CONDA
+    #include <robin_hood.h>
+#else
+    #include <arcticdb/util/third_party/robin_hood.hpp>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arcticdb::pipelines {
+
+namespace {
+
+void release_schema(ArrowSchema* schema);
+
+void release_array(ArrowArray* array);
+
+struct SchemaData {
+    std::string format_;
+    std::string name_;
+    std::vector<ArrowSchema> children_;
+    std::vector<ArrowSchema*> child_pointers_;
+    std::unique_ptr<ArrowSchema> dictionary_;
+
+    SchemaData(std::string format, std::string name, size_t num_children) :
+        format_(std::move(format)),
+        name_(std::move(name)),
+        children_(num_children) {
+        for(auto& child : children_)
+            child_pointers_.push_back(&child);
+    }
+
+    ~SchemaData() {
+        // A consumer that moves a child out marks it released
+        for(auto& child : children_) {
+            if(child.release)
+                child.release(&child);
+        }
+        if(dictionary_ && dictionary_->release)
+            dictionary_->release(dictionary_.get());
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(SchemaData)
+};
+
+struct ArrayData {
+    // Keeps the column buffers that are exported without copying alive
+    SegmentInMemory frame_;
+    std::vector<std::vector<uint8_t>> owned_buffers_;
+    std::vector<const void*> buffers_;
+    std::vector<ArrowArray> children_;
+    std::vector<ArrowArray*> child_pointers_;
+    std::unique_ptr<ArrowArray> dictionary_;
+
+    ArrayData(SegmentInMemory frame, size_t num_children) :
+        frame_(std::move(frame)),
+        children_(num_children) {
+        for(auto& child : children_)
+            child_pointers_.push_back(&child);
+    }
+
+    ~ArrayData() {
+        for(auto& child : children_) {
+            if(child.release)
+                child.release(&child);
+        }
+        if(dictionary_ && dictionary_->release)
+            dictionary_->release(dictionary_.get());
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(ArrayData)
+
+    // Zero-filled. Never returns null, since consumers may not accept null buffers even when they are empty
+    uint8_t* allocate(size_t bytes) {
+        return owned_buffers_.emplace_back(std::max(bytes, size_t{1}), uint8_t{0}).data();
+    }
+};
+
+void release_schema(ArrowSchema* schema) {
+    delete static_cast<SchemaData*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+void release_array(ArrowArray* array) {
+    delete static_cast<ArrayData*>(array->private_data);
+    array->release = nullptr;
+}
+
+void publish_schema(ArrowSchema* schema, std::unique_ptr<SchemaData> data, int64_t flags) {
+    auto* raw = data.release();
+    *schema = ArrowSchema{
+        raw->format_.c_str(),
+        raw->name_.c_str(),
+        nullptr,
+        flags,
+        static_cast<int64_t>(raw->children_.size()),
+        raw->children_.empty() ? nullptr : raw->child_pointers_.data(),
+        raw->dictionary_.get(),
+        &release_schema,
+        raw
+    };
+}
+
+void publish_array(ArrowArray* array, std::unique_ptr<ArrayData> data, int64_t length, int64_t null_count) {
+    auto* raw = data.release();
+    *array = ArrowArray{
+        length,
+        null_count,
+        0,
+        static_cast<int64_t>(raw->buffers_.size()),
+        static_cast<int64_t>(raw->children_.size()),
+        raw->buffers_.data(),
+        raw->children_.empty() ? nullptr : raw->child_pointers_.data(),
+        raw->dictionary_.get(),
+        &release_array,
+        raw
+    };
+}
+
+size_t bitmap_bytes(size_t rows) {
+    return (rows + 7) / 8;
+}
+
+void set_bit(uint8_t* bitmap, size_t pos) {
+    bitmap[pos / 8] |= static_cast<uint8_t>(1u << (pos % 8));
+}
+
+const char* fixed_width_format(DataType data_type) {
+    switch(data_type) {
+    case DataType::UINT8: return "C";
+    case DataType::UINT16: return "S";
+    case DataType::UINT32: return "I";
+    case DataType::UINT64: return "L";
+    case DataType::INT8: return "c";
+    case DataType::INT16: return "s";
+    case DataType::INT32: return "i";
+    case DataType::INT64: return "l";
+    case DataType::FLOAT32: return "f";
+    case DataType::FLOAT64: return "g";
+    case DataType::BOOL8: return "b";
+    case DataType::NANOSECONDS_UTC64: return "tsn:";
+    default:
+        util::raise_rte("No Arrow format for data type {}", datatype_to_str(data_type));
+    }
+}
+
+// Returns the column's values as one contiguous block, pointing into the column when it is held in a single block
+const uint8_t* contiguous_values(const ChunkedBuffer& buffer, ArrayData& data) {
+    if(buffer.num_blocks() == 1)
+        return buffer.data();
+
+    auto* output = data.allocate(buffer.bytes());
+    auto* pos = output;
+    for(const auto* block : buffer.blocks()) {
+        memcpy(pos, block->data(), block->bytes());
+        pos += block->bytes();
+    }
+    return output;
+}
+
+void export_fixed_width(const Column& column, size_t rows, ArrayData& data, int64_t& null_count) {
+    const auto data_type = column.type().data_type();
+    const auto type_size = get_type_size(data_type);
+    const uint8_t* values = contiguous_values(column.data().buffer(), data);
+    const void* validity = nullptr;
+    null_count = 0;
+
+    if(column.is_sparse() || static_cast<size_t>(column.row_count()) < rows) {
+        // Sparse columns hold only the present values, so they are expanded and the sparse map becomes the validity bitmap
+        auto* expanded = data.allocate(rows * type_size);
+        auto* bitmap = data.allocate(bitmap_bytes(rows));
+        if(column.is_sparse()) {
+            const auto& sparse_map = column.sparse_map();
+            size_t dense_pos = 0;
+            for(auto en = sparse_map.first(); en < sparse_map.end(); ++en, ++dense_pos) {
+                memcpy(expanded + *en * type_size, values + dense_pos * type_size, type_size);
+                set_bit(bitmap, *en);
+            }
+            null_count = static_cast<int64_t>(rows - dense_pos);
+        } else {
+            const auto present = static_cast<size_t>(column.row_count());
+            memcpy(expanded, values, present * type_size);
+            for(size_t row = 0; row < present; ++row)
+                set_bit(bitmap, row);
+            null_count = static_cast<int64_t>(rows - present);
+        }
+        values = expanded;
+        validity = bitmap;
+    }
+
+    if(data_type == DataType::BOOL8) {
+        // Arrow booleans are bit-packed
+        auto* packed = data.allocate(bitmap_bytes(rows));
+        for(size_t row = 0; row < rows; ++row) {
+            if(values[row])
+                set_bit(packed, row);
+        }
+        values = packed;
+    }
+
+    data.buffers_ = {validity, values};
+}
+
+// Fills the offsets and data buffers of a large string or binary array with the strings at the given pool offsets
+void fill_large_strings(const StringPool& pool, const std::vector<StringPool::offset_t>& offsets, ArrayData& data) {
+    size_t total_bytes = 0;
+    for(auto offset : offsets) {
+        if(is_a_string(offset))
+            total_bytes += pool.get_const_view(offset).size();
+    }
+
+    auto* arrow_offsets = reinterpret_cast<int64_t*>(data.allocate((offsets.size() + 1) * sizeof(int64_t)));
+    auto* chars = data.allocate(total_bytes);
+    int64_t pos = 0;
+    for(size_t i = 0; i < offsets.size(); ++i) {
+        arrow_offsets[i] = pos;
+        if(is_a_string(offsets[i])) {
+            const auto sv = pool.get_const_view(offsets[i]);
+            memcpy(chars + pos, sv.data(), sv.size());
+            pos += static_cast<int64_t>(sv.size());
+        }
+    }
+    arrow_offsets[offsets.size()] = pos;
+    data.buffers_.push_back(arrow_offsets);
+    data.buffers_.push_back(chars);
+}
+
+void export_strings(
+    const SegmentInMemory& frame,
+    const Column& column,
+    std::string_view name,
+    ArrowArray* array,
+    ArrowSchema* schema,
+    bool dictionary_strings) {
+    util::check(!column.is_inflated(), "Column {} holds Python strings, read it with arrow output set to export it", name);
+    util::check(!column.is_sparse(), "Cannot export sparse string column {}", name);
+
+    const auto rows = frame.row_count();
+    const auto& pool = frame.const_string_pool();
+    const auto& buffer = column.data().buffer();
+    const auto present = std::min(rows, static_cast<size_t>(column.row_count()));
+
+    std::vector<StringPool::offset_t> offsets(rows, not_a_string());
+    for(size_t row = 0; row < present; ++row)
+        offsets[row] = get_offset_string_at(row, buffer);
+
+    auto data = std::make_unique<ArrayData>(frame, 0);
+    auto* validity = data->allocate(bitmap_bytes(rows));
+    int64_t null_count = 0;
+    robin_hood::unordered_flat_map<StringPool::offset_t, int32_t> unique;
+    std::vector<StringPool::offset_t> dictionary_offsets;
+    for(size_t row = 0; row < rows; ++row) {
+        if(!is_a_string(offsets[row])) {
+            ++null_count;
+            continue;
+        }
+        set_bit(validity, row);
+        if(dictionary_strings && unique.try_emplace(offsets[row], static_cast<int32_t>(dictionary_offsets.size())).second)
+            dictionary_offsets.push_back(offsets[row]);
+    }
+
+    const auto string_format = is_utf_type(column.type().data_type()) ? "U" : "Z";
+    data->buffers_.push_back(null_count == 0 ? nullptr : validity);
+    if(!dictionary_strings || dictionary_offsets.size() * 2 > rows) {
+        fill_large_strings(pool, offsets, *data);
+        publish_array(array, std::move(data), static_cast<int64_t>(rows), null_count);
+        publish_schema(schema, std::make_unique<SchemaData>(string_format, std::string{name}, 0), ARROW_FLAG_NULLABLE);
+        return;
+    }
+
+    // Mostly repeated values, so each distinct string is written once to the dictionary
+    auto* indices = reinterpret_cast<int32_t*>(data->allocate(rows * sizeof(int32_t)));
+    for(size_t row = 0; row < rows; ++row) {
+        if(is_a_string(offsets[row]))
+            indices[row] = unique[offsets[row]];
+    }
+    data->buffers_.push_back(indices);
+
+    auto dictionary_data = std::make_unique<ArrayData>(frame, 0);
+    dictionary_data->buffers_.push_back(nullptr);
+    fill_large_strings(pool, dictionary_offsets, *dictionary_data);
+    data->dictionary_ = std::make_unique<ArrowArray>();
+    publish_array(data->dictionary_.get(), std::move(dictionary_data), static_cast<int64_t>(dictionary_offsets.size()), 0);
+    publish_array(array, std::move(data), static_cast<int64_t>(rows), null_count);
+
+    auto schema_data = std::make_unique<SchemaData>("i", std::string{name}, 0);
+    schema_data->dictionary_ = std::make_unique<ArrowSchema>();
+    publish_schema(schema_data->dictionary_.get(), std::make_unique<SchemaData>(string_format, "", 0), 0);
+    publish_schema(schema, std::move(schema_data), ARROW_FLAG_NULLABLE);
+}
+
+void export_column(const SegmentInMemory& frame, size_t col, ArrowArray* array, ArrowSchema* schema, bool dictionary_strings) {
+    const auto& column = frame.column(static_cast<position_t>(col));
+    const auto name = frame.field(col).name();
+    const auto data_type = column.type().data_type();
+    const auto rows = frame.row_count();
+
+    if(is_sequence_type(data_type)) {
+        export_strings(frame, column, name, array, schema, dictionary_strings);
+        return;
+    }
+
+    auto data = std::make_unique<ArrayData>(frame, 0);
+    int64_t null_count = 0;
+    std::string format;
+    if(is_empty_type(data_type)) {
+        format = "n";
+        null_count = static_cast<int64_t>(rows);
+    } else {
+        format = fixed_width_format(data_type);
+        export_fixed_width(column, rows, *data, null_count);
+    }
+    publish_array(array, std::move(data), static_cast<int64_t>(rows), null_count);
+    publish_schema(schema, std::make_unique<SchemaData>(std::move(format), std::string{name}, 0), ARROW_FLAG_NULLABLE);
+}
+
+} // namespace
+
+void export_arrow(const SegmentInMemory& frame, ArrowArray* array, ArrowSchema* schema, bool dictionary_strings) {
+    ARCTICDB_SAMPLE_DEFAULT(ExportArrow)
+    util::check(array != nullptr && schema != nullptr, "Null Arrow struct passed to export_arrow");
+    const auto num_columns = static_cast<size_t>(frame.descriptor().field_count());
+    auto array_data = std::make_unique<ArrayData>(frame, num_columns);
+    auto schema_data = std::make_unique<SchemaData>("+s", "", num_columns);
+    array_data->buffers_.push_back(nullptr);
+
+    for(size_t col = 0; col < num_columns; ++col)
+        export_column(frame, col, &array_data->children_[col], &schema_data->children_[col], dictionary_strings);
+
+    publish_array(array, std::move(array_data), static_cast<int64_t>(frame.row_count()), 0);
+    publish_schema(schema, std::move(schema_data), 0);
+}
+
+} // namespace arcticdb::pipelines
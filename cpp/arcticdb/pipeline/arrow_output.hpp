@@ -0,0 +1,68 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/column_store/memory_segment.hpp>
+
+#include <cstdint>
+
+// The Arrow C data interface, as specified at https://arrow.apache.org/docs/format/CDataInterface.html. The structs
+// form a stable ABI, so they are declared here rather than taking a dependency on Arrow.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace arcticdb::pipelines {
+
+/*
+ * Exports a frame as an Arrow struct array with one child per column, which consumers such as pyarrow import as a
+ * record batch. Ownership of both structs passes to the caller, who must call their release callbacks.
+ *
+ * Numeric and timestamp columns held in a single block are exported without copying, with the array keeping the
+ * frame alive until it is released. String columns must have been left in the frame's string pool by reading with
+ * ReadOptions::set_arrow_output. With dictionary_strings they become dictionary arrays when their values repeat enough
+ * for that to be smaller, and large string arrays otherwise. Without it they are always large string arrays, so that
+ * every frame of an export has the same schema.
+ */
+void export_arrow(const SegmentInMemory& frame, ArrowArray* array, ArrowSchema* schema, bool dictionary_strings = true);
+
+} // namespace arcticdb::pipelines
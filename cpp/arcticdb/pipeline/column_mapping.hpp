@@ -5,7 +5,16 @@
  * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
  */
 
+#pragma once
+
 #include <arcticdb/entity/types.hpp>
+#include <arcticdb/entity/field_collection.hpp>
+#include <arcticdb/codec/variant_encoded_field_collection.hpp>
+#include <arcticdb/util/buffer_holder.hpp>
+#include <arcticdb/util/hash.hpp>
+
+#include <optional>
+#include <vector>
 
 namespace arcticdb {
 
@@ -38,6 +47,51 @@ struct ColumnMapping {
     }
 };
 
+// Decodes a field into an output column of a different type
+using PromotionKernel = void (*)(
+    const uint8_t*& data,
+    uint8_t* dest,
+    const VariantField& field,
+    const TypeDescriptor& source_type_desc,
+    size_t num_rows,
+    const std::shared_ptr<BufferHolder>& buffers);
+
+struct FieldDecodeStep {
+    FieldDecodeStep() = default;
+
+    FieldDecodeStep(size_t dest_col, TypeDescriptor source_type_desc, size_t dest_size, PromotionKernel promotion) :
+        dest_col_(dest_col),
+        source_type_desc_(source_type_desc),
+        dest_size_(dest_size),
+        promotion_(promotion) {
+    }
+
+    // Unset if the field is not selected in the output frame, so is skipped
+    std::optional<size_t> dest_col_;
+    TypeDescriptor source_type_desc_;
+    size_t dest_size_ = 0;
+    // Null if the field decodes straight into the output column
+    PromotionKernel promotion_ = nullptr;
+};
+
+/*
+ * How each field of a segment maps to the output frame in a dynamic schema read, indexed by the field's position in
+ * the segment. Worked out once per distinct set of segment fields, so that segments sharing a schema decode without
+ * looking up each field's column by name.
+ */
+struct DecodePlan {
+    std::vector<FieldDecodeStep> steps_;
+};
+
+// One pass over the fields' packed bytes, rather than a walk of the fields
+inline HashedValue hash_fields(const FieldCollection& fields) {
+    HashAccum accum;
+    for(const auto* block : fields.column_data().buffer().blocks())
+        accum(block->data(), block->bytes());
+
+    return accum.digest();
+}
+
 struct StaticColumnMappingIterator {
     const size_t index_fieldcount_;
     const size_t field_count_;
@@ -79,11 +79,10 @@ RawType* flatten_tensor(
         std::optional<ChunkedBuffer>& flattened_buffer,
         size_t rows_to_write,
         const NativeTensor& tensor,
-        size_t slice_num,
-        size_t regular_slice_size
+        size_t row
         ) {
     flattened_buffer = ChunkedBuffer::presized(rows_to_write * sizeof(RawType));
-    TypedTensor<RawType> t(tensor, slice_num, regular_slice_size, rows_to_write);
+    TypedTensor<RawType> t(tensor, static_cast<ssize_t>(row), static_cast<ssize_t>(rows_to_write));
     util::FlattenHelper flattener{t};
     auto dst = reinterpret_cast<RawType*>(flattened_buffer->data());
     flattener.flatten(dst, reinterpret_cast<RawType const*>(t.data()));
@@ -98,9 +97,8 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
     size_t col,
     size_t rows_to_write,
     size_t row,
-    size_t slice_num,
-    size_t regular_slice_size,
-    bool sparsify_floats
+    bool sparsify_floats,
+    const StringPool* string_pool = nullptr
 ) {
     return type_desc.visit_tag([&](auto &&tag) {
         using RawType = typename std::decay_t<decltype(tag)>::DataTypeTag::raw_type;
@@ -123,12 +121,21 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
                 for (size_t s = 0; s < rows_to_write; ++s, char_data += str_stride) {
                     agg.set_string_at(col, s, char_data, str_len);
                 }
+            } else if (string_pool != nullptr) {
+                auto src_ptr = reinterpret_cast<const StringPool::offset_t*>(tensor.data()) + row;
+                auto& column = agg.segment().column(col);
+                column.allocate_data(rows_to_write * sizeof(StringPool::offset_t));
+                auto out_ptr = reinterpret_cast<StringPool::offset_t*>(column.buffer().data());
+                auto& segment_pool = agg.segment().string_pool();
+                for (size_t s = 0; s < rows_to_write; ++s, ++src_ptr) {
+                    *out_ptr++ = is_a_string(*src_ptr) ? segment_pool.get(string_pool->get_const_view(*src_ptr)).offset() : *src_ptr;
+                }
             } else {
                 auto data = const_cast<void *>(tensor.data());
                 auto ptr_data = reinterpret_cast<PyObject **>(data);
                 ptr_data += row;
                 if (!c_style)
-                    ptr_data = flatten_tensor<PyObject*>(flattened_buffer, rows_to_write, tensor, slice_num, regular_slice_size);
+                    ptr_data = flatten_tensor<PyObject*>(flattened_buffer, rows_to_write, tensor, row);
 
                 auto none = py::none{};
                 std::variant<convert::StringEncodingError, convert::PyStringWrapper> wrapper_or_error;
@@ -186,7 +193,7 @@ std::optional<convert::StringEncodingError> aggregator_set_data(
                             tensor.strides(0),
                             sizeof(RawType));
 
-                    TypedTensor <RawType> t(tensor, slice_num, regular_slice_size, rows_to_write);
+                    TypedTensor <RawType> t(tensor, static_cast<ssize_t>(row), static_cast<ssize_t>(rows_to_write));
                     agg.set_array(col, t);
                 }
             }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <arcticdb/entity/native_tensor.hpp>
+#include <arcticdb/column_store/string_pool.hpp>
 #include <arcticdb/stream/index.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/entity/index_range.hpp>
@@ -35,6 +36,8 @@ struct InputTensorFrame {
     stream::Index index;
     std::optional<entity::NativeTensor> index_tensor;
     std::vector<entity::NativeTensor> field_tensors;
+    // When set, dynamic string tensors hold offsets into this pool rather than Python objects
+    std::shared_ptr<StringPool> string_pool;
     IndexRange index_range;
     ssize_t num_rows = 0;
     mutable ssize_t offset = 0;
@@ -13,11 +13,17 @@
 #include <arcticdb/util/bitset.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/pipeline/index_segment_reader.hpp>
+#include <arcticdb/util/hash.hpp>
 
 #include <boost/iterator_adaptors.hpp>
+#include <folly/concurrency/ConcurrentHashMap.h>
 
 #include <memory>
 
+namespace arcticdb {
+struct DecodePlan;
+}
+
 namespace arcticdb::pipelines {
 
 struct PipelineContext;
@@ -129,6 +135,8 @@ struct PipelineContext : public std::enable_shared_from_this<PipelineContext> {
     std::vector<unsigned char> compacted_;
     std::optional<size_t> incompletes_after_;
     bool bucketize_dynamic_ = false;
+    // Dynamic schema decode plans, keyed by the hash of the segment fields they were built for
+    folly::ConcurrentHashMap<HashedValue, std::shared_ptr<DecodePlan>> decode_plans_;
 
     PipelineContextRow operator[](size_t num) {
         return PipelineContextRow{shared_from_this(), num};
@@ -19,6 +19,7 @@
 #include <arcticdb/util/type_handler.hpp>
 #include <arcticdb/entity/type_utils.hpp>
 #include <arcticdb/codec/slice_data_sink.hpp>
+#include <arcticdb/codec/promoting_data_sink.hpp>
 #include <arcticdb/storage/store.hpp>
 #include <arcticdb/stream/index.hpp>
 #include <arcticdb/pipeline/column_mapping.hpp>
@@ -270,6 +271,43 @@ void decode_or_expand(
     });
 }
 
+template <typename SourceTagType, typename DestinationTagType, typename EncodedFieldType>
+void decode_and_promote_impl(
+    const uint8_t*& data,
+    uint8_t* dest,
+    const EncodedFieldType& encoded_field_info,
+    const TypeDescriptor& source_type_descriptor,
+    size_t num_rows) {
+    using SourceType = typename SourceTagType::DataTypeTag::raw_type;
+    using DestinationType = typename DestinationTagType::DataTypeTag::raw_type;
+    const bool is_sparse = encoded_field_info.has_ndarray() && encoded_field_info.ndarray().sparse_map_bytes() > 0;
+    PromotingDataSink<SourceType, DestinationType> sink{dest, num_rows, !is_sparse};
+    std::optional<util::BitMagic> bv;
+    data += decode_field(source_type_descriptor, encoded_field_info, data, sink, bv);
+    if (is_sparse) {
+        util::check(bv.has_value(), "Expected a sparse map when promoting a sparse field");
+        expand_and_promote_using_bitmap<SourceTagType, DestinationTagType>(*bv, sink.source_data(), dest, num_rows);
+    } else if (const auto decoded = sink.values_decoded(); decoded < num_rows) {
+        util::default_initialize<DestinationTagType>(dest + decoded * sizeof(DestinationType), (num_rows - decoded) * sizeof(DestinationType));
+    }
+}
+
+/*
+ * Decodes a column into a destination column of a wider type, converting each block as it is decoded rather than
+ * decoding the whole column into a temporary buffer first.
+ */
+template <typename SourceTagType, typename DestinationTagType>
+void decode_and_promote(
+    const uint8_t*& data,
+    uint8_t* dest,
+    const VariantField& field,
+    const TypeDescriptor& source_type_descriptor,
+    size_t num_rows) {
+    util::variant_match(field, [&] (auto field) {
+        decode_and_promote_impl<SourceTagType, DestinationTagType>(data, dest, *field, source_type_descriptor, num_rows);
+    });
+}
+
 void advance_field_size(
     const VariantField& variant_field,
     const uint8_t*& data,
@@ -373,6 +411,99 @@ void decode_into_frame_static(
     }
 }
 
+template<typename SourceTagType, typename DestinationTagType>
+void promote_column(
+    const uint8_t*& data,
+    uint8_t* dest,
+    const VariantField& field,
+    const TypeDescriptor& source_type_desc,
+    size_t num_rows,
+    const std::shared_ptr<BufferHolder>& buffers) {
+    using SourceType = typename SourceTagType::DataTypeTag::raw_type;
+    using DestinationType = typename DestinationTagType::DataTypeTag::raw_type;
+    if constexpr(std::is_same_v<SourceType, DestinationType>) {
+        // Same representation, e.g. string pool offsets, so nothing to convert
+        decode_or_expand(data, dest, field, source_type_desc, num_rows * sizeof(DestinationType), buffers);
+    } else {
+        if constexpr(sizeof(SourceType) <= sizeof(DestinationType)) {
+            if(!TypeHandlerRegistry::instance()->get_handler(source_type_desc.data_type())) {
+                decode_and_promote<SourceTagType, DestinationTagType>(data, dest, field, source_type_desc, num_rows);
+                return;
+            }
+        }
+        // Narrowing promotions such as UINT64 to FLOAT32 cannot decode in place
+        const auto src_bytes = sizeof(SourceType) * num_rows;
+        Buffer tmp_buf{src_bytes};
+        decode_or_expand(data, tmp_buf.data(), field, source_type_desc, src_bytes, buffers);
+        promote_values<SourceType, DestinationType>(tmp_buf.data(), dest, num_rows);
+    }
+}
+
+PromotionKernel promotion_kernel(const TypeDescriptor& source_type_desc, const TypeDescriptor& dest_type_desc, std::string_view field_name) {
+    util::check(static_cast<bool>(has_valid_type_promotion(source_type_desc, dest_type_desc)), "Can't promote type {} to type {} in field {}",
+                source_type_desc, dest_type_desc, field_name);
+
+    return dest_type_desc.visit_tag([&] (auto dest_desc_tag) {
+        using DestinationTagType = decltype(dest_desc_tag);
+        using DestinationType = typename DestinationTagType::DataTypeTag::raw_type;
+        return source_type_desc.visit_tag([&] (auto src_desc_tag) -> PromotionKernel {
+            using SourceTagType = decltype(src_desc_tag);
+            using SourceType = typename SourceTagType::DataTypeTag::raw_type;
+            if constexpr(std::is_same_v<SourceType, DestinationType> || (std::is_arithmetic_v<SourceType> && std::is_arithmetic_v<DestinationType>)) {
+                return &promote_column<SourceTagType, DestinationTagType>;
+            } else {
+                util::raise_rte("Can't promote type {} to type {} in field {}", source_type_desc, dest_type_desc, field_name);
+                return nullptr;
+            }
+        });
+    });
+}
+
+std::shared_ptr<DecodePlan> build_decode_plan(const SegmentInMemory& frame, const StreamDescriptor& desc, size_t index_fieldcount) {
+    auto plan = std::make_shared<DecodePlan>();
+    plan->steps_.resize(desc.field_count());
+    for (auto field_col = index_fieldcount; field_col < desc.field_count(); ++field_col) {
+        const auto& field = desc.fields(field_col);
+        auto frame_loc_opt = frame.column_index(field.name());
+        if (!frame_loc_opt)
+            continue;
+
+        const auto dst_col = *frame_loc_opt;
+        const auto& dest_type_desc = frame.field(dst_col).type();
+        PromotionKernel promotion = trivially_compatible_types(field.type(), dest_type_desc) ? nullptr : promotion_kernel(field.type(), dest_type_desc, field.name());
+        plan->steps_[field_col] = FieldDecodeStep{dst_col, field.type(), sizeof_datatype(dest_type_desc), promotion};
+    }
+    return plan;
+}
+
+/*
+ * Segments with an encoded descriptor field already carry the hashes of its blocks, so they are keyed without
+ * touching the fields. Segments without one fall back to hashing the fields' packed bytes.
+ */
+HashedValue decode_plan_key(const arcticdb::proto::encoding::SegmentHeader& hdr, const FieldCollection& fields) {
+    if (hdr.has_descriptor_field() && hdr.descriptor_field().has_ndarray()) {
+        HashAccum accum;
+        hash_field(hdr.descriptor_field(), accum);
+        return accum.digest();
+    }
+    return hash_fields(fields);
+}
+
+// Plans are shared between segments with the same fields, and built by whichever segment is decoded first
+std::shared_ptr<DecodePlan> get_decode_plan(
+        const SegmentInMemory& frame,
+        const arcticdb::proto::encoding::SegmentHeader& hdr,
+        PipelineContextRow& context,
+        size_t index_fieldcount) {
+    const auto& desc = context.descriptor();
+    const auto key = decode_plan_key(hdr, desc.fields());
+    auto& decode_plans = context.parent_->decode_plans_;
+    if (auto it = decode_plans.find(key); it != decode_plans.cend())
+        return it->second;
+
+    return decode_plans.insert(key, build_decode_plan(frame, desc, index_fieldcount)).first->second;
+}
+
 void decode_into_frame_dynamic(
         SegmentInMemory &frame,
         PipelineContextRow &context,
@@ -395,53 +526,35 @@ void decode_into_frame_dynamic(
         auto index_field = fields.at(0u);
         decode_index_field(frame, index_field, data, begin, end, context);
 
+        const auto plan = get_decode_plan(frame, hdr, context, index_fieldcount);
+        const auto& row_range = context.slice_and_key().slice_.row_range;
+        const auto num_rows = row_range.diff();
+        const auto first_row = row_range.first - frame.offset();
         auto field_count = context.slice_and_key().slice_.col_range.diff() + index_fieldcount;
+        util::check(field_count <= plan->steps_.size(), "Decode plan has {} fields, expected at least {}", plan->steps_.size(), field_count);
         for (auto field_col = index_fieldcount; field_col < field_count; ++field_col) {
-            auto field_name = context.descriptor().fields(field_col).name();
             auto encoded_field = fields.at(field_col);
-            auto frame_loc_opt = frame.column_index(field_name);
-            if (!frame_loc_opt) {
+            const auto& step = plan->steps_[field_col];
+            if (!step.dest_col_) {
                 // Column is not selected in the output frame.
                 advance_field_size(encoded_field, data, has_magic_numbers);
                 continue;
             }
 
-            auto dst_col = frame_loc_opt.value();
-            auto& buffer = frame.column(static_cast<position_t>(dst_col)).data().buffer();
-            if(ColumnMapping m{frame, dst_col, field_col, context};!trivially_compatible_types(m.source_type_desc_, m.dest_type_desc_)) {
-                util::check(static_cast<bool>(has_valid_type_promotion(m.source_type_desc_, m.dest_type_desc_)), "Can't promote type {} to type {} in field {}",
-                            m.source_type_desc_, m.dest_type_desc_, m.frame_field_descriptor_.name());
-
-                    m.dest_type_desc_.visit_tag([&buffer, &m, &data, encoded_field, buffers] (auto dest_desc_tag) {
-                        using DestinationType =  typename decltype(dest_desc_tag)::DataTypeTag::raw_type;
-                        m.source_type_desc_.visit_tag([&buffer, &m, &data, &encoded_field, &buffers] (auto src_desc_tag ) {
-                            using SourceType =  typename decltype(src_desc_tag)::DataTypeTag::raw_type;
-                            if constexpr(std::is_arithmetic_v<SourceType> && std::is_arithmetic_v<DestinationType>) {
-                                const auto src_bytes = sizeof_datatype(m.source_type_desc_) * m.num_rows_;
-                                Buffer tmp_buf{src_bytes};
-                                decode_or_expand(data, tmp_buf.data(), encoded_field, m.source_type_desc_, src_bytes, buffers);
-                                auto src_ptr = reinterpret_cast<SourceType *>(tmp_buf.data());
-                                auto dest_ptr = reinterpret_cast<DestinationType *>(buffer.data() + m.offset_bytes_);
-                                for (auto i = 0u; i < m.num_rows_; ++i) {
-                                    *dest_ptr++ = static_cast<DestinationType>(*src_ptr++);
-                                }
-                            }
-                            else {
-                                util::raise_rte("Can't promote type {} to type {} in field {}", m.source_type_desc_, m.dest_type_desc_, m.frame_field_descriptor_.name());
-                            }
-                        });
-                    });
-                    ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", m.frame_field_descriptor_.name(), data - begin);
+            auto& buffer = frame.column(static_cast<position_t>(*step.dest_col_)).data().buffer();
+            auto dest = buffer.data() + step.dest_size_ * first_row;
+            if(step.promotion_) {
+                step.promotion_(data, dest, encoded_field, step.source_type_desc_, num_rows, buffers);
             } else {
-                ARCTICDB_TRACE(log::storage(), "Creating data slice at {} with total size {} ({} rows)", m.offset_bytes_, m.dest_bytes_,
-                                     context.slice_and_key().slice_.row_range.diff());
+                ARCTICDB_TRACE(log::storage(), "Creating data slice at {} with total size {} ({} rows)", step.dest_size_ * first_row,
+                               step.dest_size_ * num_rows, num_rows);
                 util::check(data != end,
                             "Reached end of input block with {} fields to decode",
                             field_count - field_col);
 
-                decode_or_expand(data, buffer.data() + m.offset_bytes_, encoded_field, m.source_type_desc_, m.dest_bytes_, buffers);
+                decode_or_expand(data, dest, encoded_field, step.source_type_desc_, step.dest_size_ * num_rows, buffers);
             }
-            ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", frame.field(dst_col).name(), data - begin);
+            ARCTICDB_TRACE(log::codec(), "Decoded column {} to position {}", frame.field(*step.dest_col_).name(), data - begin);
         }
 
         decode_string_pool(hdr, data, begin, end, context);
@@ -708,6 +821,51 @@ public:
     }
 };
 
+/*
+ * Rewrites the offsets in a string column from the string pools of the segments that it was decoded from to offsets
+ * into the frame's own string pool, which then holds every string in the frame as UTF-8 (or raw bytes for ASCII types).
+ * Used instead of creating Python strings when the frame is to be exported through the Arrow C data interface.
+ */
+class FramePoolStringReducer {
+    SegmentInMemory frame_;
+    size_t row_ = 0;
+    ChunkedBuffer& buffer_;
+
+public:
+    FramePoolStringReducer(Column& column, SegmentInMemory frame) :
+        frame_(std::move(frame)),
+        buffer_(column.data().buffer()) {
+    }
+
+    void reduce(PipelineContextRow& context_row, size_t column_index) {
+        const auto segment_type = context_row.descriptor()[column_index].type().data_type();
+        const auto is_fixed = is_fixed_string_type(segment_type);
+        const auto is_utf32 = is_fixed && is_utf_type(segment_type);
+        auto& frame_pool = frame_.string_pool();
+        const auto& segment_pool = context_row.string_pool();
+
+        size_t end = context_row.slice_and_key().slice_.row_range.second - frame_.offset();
+        for (; row_ < end; ++row_) {
+            auto val = get_string_from_buffer(row_, buffer_, segment_pool);
+            util::variant_match(val,
+                [&] (std::string_view sv) {
+                    StringPool::offset_t offset;
+                    if(is_utf32) {
+                        offset = frame_pool.get(utf32_to_utf8(sv)).offset();
+                    } else if(is_fixed) {
+                        offset = frame_pool.get(sv.substr(0, std::min(sv.size(), strnlen(sv.data(), sv.size())))).offset();
+                    } else {
+                        offset = frame_pool.get(sv).offset();
+                    }
+                    set_offset_string_at(row_, buffer_, offset);
+                },
+                [] (StringPool::offset_t) {
+                    // Missing values keep their placeholder
+                });
+        }
+    }
+};
+
 
 namespace {
 
@@ -997,6 +1155,7 @@ struct ReduceColumnTask : async::BaseTask {
     std::shared_ptr<LockType> lock_;
     bool dynamic_schema_;
     bool do_lock_;
+    bool arrow_output_;
 
     ReduceColumnTask(
         const SegmentInMemory& frame,
@@ -1007,7 +1166,8 @@ struct ReduceColumnTask : async::BaseTask {
         std::shared_ptr<PyObject> py_nan,
         std::shared_ptr<LockType> lock,
         bool dynamic_schema,
-        bool do_lock) :
+        bool do_lock,
+        bool arrow_output) :
         frame_(frame),
         column_index_(c),
         slice_map_(std::move(slice_map)),
@@ -1016,7 +1176,8 @@ struct ReduceColumnTask : async::BaseTask {
         py_nan_(py_nan),
         lock_(std::move(lock)),
         dynamic_schema_(dynamic_schema),
-        do_lock_(do_lock) {
+        do_lock_(do_lock),
+        arrow_output_(arrow_output) {
     }
 
     folly::Unit operator()() {
@@ -1028,7 +1189,7 @@ struct ReduceColumnTask : async::BaseTask {
         if(dynamic_schema_ && column_data == slice_map_->columns_.end()) {
             column.default_initialize_rows(0, frame_.row_count(), false);
             bool dynamic_type = is_dynamic_string_type(field_type);
-            if(dynamic_type) {
+            if(dynamic_type && !arrow_output_) {
                 EmptyDynamicStringReducer reducer(column, frame_, frame_field, sizeof(StringPool::offset_t), lock_);
                 reducer.reduce(frame_.row_count());
             }
@@ -1041,7 +1202,14 @@ struct ReduceColumnTask : async::BaseTask {
                 }
                 null_reducer.finalize();
             }
-            if (is_sequence_type(field_type)) {
+            if (is_sequence_type(field_type) && arrow_output_) {
+                FramePoolStringReducer string_reducer{column, frame_};
+                for (const auto &row : column_data->second) {
+                    PipelineContextRow context_row{context_, row.second.context_index_};
+                    if(context_row.slice_and_key().slice().row_range.diff() > 0)
+                        string_reducer.reduce(context_row, row.second.column_index_);
+                }
+            } else if (is_sequence_type(field_type)) {
                 auto string_reducer = get_string_reducer(column, context_, frame_, frame_field, *slice_map_, unique_string_map_, py_nan_, lock_, do_lock_);
                 for (const auto &row : column_data->second) {
                     PipelineContextRow context_row{context_, row.second.context_index_};
@@ -1066,6 +1234,7 @@ void reduce_and_fix_columns(
         return;
 
     bool dynamic_schema = opt_false(read_options.dynamic_schema_);
+    bool arrow_output = opt_false(read_options.arrow_output_);
     auto slice_map = std::make_shared<FrameSliceMap>(context, dynamic_schema);
     static auto spinlock = std::make_shared<LockType>();
     std::shared_ptr<UniqueStringMapType> unique_string_map;
@@ -1087,7 +1256,7 @@ void reduce_and_fix_columns(
         std::vector<folly::Future<folly::Unit>> jobs;
         static const auto batch_size = ConfigsMap::instance()->get_int("StringAllocation.BatchSize", 50);
         for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
-            jobs.emplace_back(async::submit_cpu_task(ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, true)));
+            jobs.emplace_back(async::submit_cpu_task(ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, true, arrow_output)));
             if(jobs.size() == static_cast<size_t>(batch_size)) {
                 folly::collect(jobs).get();
                 jobs.clear();
@@ -1098,7 +1267,7 @@ void reduce_and_fix_columns(
             folly::collect(jobs).get();
     } else {
         for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
-            ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false)();
+            ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false, arrow_output)();
         }
     }
 
@@ -81,6 +81,11 @@ void decode_into_frame_static(
     const std::shared_ptr<BufferHolder> buffers
     );
 
+// Identifies the segment's fields, so that segments sharing them share a decode plan
+HashedValue decode_plan_key(const arcticdb::proto::encoding::SegmentHeader& hdr, const FieldCollection& fields);
+
+std::shared_ptr<DecodePlan> build_decode_plan(const SegmentInMemory& frame, const StreamDescriptor& desc, size_t index_fieldcount);
+
 void decode_into_frame_dynamic(
         SegmentInMemory &frame,
         PipelineContextRow &context,
@@ -21,6 +21,7 @@ struct ReadOptions {
     std::optional<bool> optimise_string_memory_;
     std::optional<bool> batch_throw_on_error_;
     std::optional<bool> read_previous_on_failure_;
+    std::optional<bool> arrow_output_;
 
     void set_force_strings_to_fixed(const std::optional<bool>& force_strings_to_fixed) {
         force_strings_to_fixed_ = force_strings_to_fixed;
@@ -57,5 +58,11 @@ struct ReadOptions {
     void set_batch_throw_on_error(bool batch_throw_on_error) {
         batch_throw_on_error_ = batch_throw_on_error;
     }
+
+    // Leaves strings in the frame's string pool for export through the Arrow C data interface rather than creating
+    // Python objects for them
+    void set_arrow_output(const std::optional<bool>& arrow_output) {
+        arrow_output_ = arrow_output;
+    }
 };
 } //namespace arcticdb
\ No newline at end of file
@@ -9,6 +9,14 @@
 #include <arcticdb/pipeline/write_options.hpp>
 #include <arcticdb/util/variant.hpp>
 #include <arcticdb/util/simple_string_hash.hpp>
+#include <arcticdb/util/hash.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <lz4.h>
+
+#include <functional>
+#include <unordered_map>
 
 namespace arcticdb::pipelines {
 
@@ -26,6 +34,21 @@ SlicingPolicy get_slicing_policy(
         return HashedSlicer(num_buckets, options.segment_row_size);
     }
 
+    const auto slicers_set = int(options.time_bucket_ns > 0) + int(options.content_defined_slicing) + int(options.target_segment_bytes > 0);
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(slicers_set <= 1,
+        "Only one of time_bucket_ns ({}), content_defined_slicing ({}) and target_segment_bytes ({}) can be set",
+        options.time_bucket_ns, options.content_defined_slicing, options.target_segment_bytes);
+
+    if(options.time_bucket_ns > 0 && std::holds_alternative<stream::TimeseriesIndex>(frame.index))
+        return TimeBucketSlicer{
+            timestamp(options.time_bucket_ns), options.column_group_size, options.segment_row_size, options.time_bucket_min_rows};
+
+    if(options.content_defined_slicing)
+        return ContentDefinedSlicer{options.column_group_size, options.segment_row_size};
+
+    if(options.target_segment_bytes > 0)
+        return AdaptiveSlicer{frame, options.target_segment_bytes, !options.dynamic_schema || options.bucketize_dynamic};
+
     return FixedSlicer{options.column_group_size, options.segment_row_size};
 }
 
@@ -52,7 +75,10 @@ std::pair<size_t, size_t> get_first_and_last_row(const arcticdb::pipelines::Inpu
     return {frame.offset, frame.num_rows + frame.offset};
 }
 
-std::vector<FrameSlice> FixedSlicer::operator()(const arcticdb::pipelines::InputTensorFrame& frame) const {
+std::vector<FrameSlice> slice_columns_over_rows(
+        const arcticdb::pipelines::InputTensorFrame& frame,
+        const std::vector<size_t>& column_group_sizes,
+        const std::vector<RowRange>& row_ranges) {
     const auto [index_count, total_field_count] = get_index_and_field_count(frame);
     auto field_count = total_field_count - index_count;
     auto tensor_pos = std::begin(frame.field_tensors);
@@ -63,17 +89,17 @@ std::vector<FrameSlice> FixedSlicer::operator()(const arcticdb::pipelines::Input
     auto index = frame.desc.index();
 
     std::vector<FrameSlice> slices;
-    slices.reserve(field_count / col_per_slice_ + std::size_t((field_count % col_per_slice_) == 0ULL));
-
-    const auto [first_row, last_row] = get_first_and_last_row(frame);
+    slices.reserve(column_group_sizes.size() * row_ranges.size());
 
     // order of the frame slices is used in the mark_index_slices impl. If slices are not grouped and ordered the same
     // way, one will need to modify the mark_index_slices method to use two passes instead of one
     auto col = index_count;
+    auto group_size = std::begin(column_group_sizes);
     do {
+        util::check(group_size != std::end(column_group_sizes), "Column groups cover fewer than the {} columns of the frame", field_count);
         auto tensor_next = tensor_pos;
         auto fields_next = fields_pos;
-        auto distance = std::min(size_t(std::distance(tensor_pos, std::end(frame.field_tensors))), col_per_slice_);
+        auto distance = std::min(size_t(std::distance(tensor_pos, std::end(frame.field_tensors))), *group_size++);
         std::advance(tensor_next, distance);
         std::advance(fields_next, distance);
 
@@ -88,20 +114,325 @@ std::vector<FrameSlice> FixedSlicer::operator()(const arcticdb::pipelines::Input
 
 
         auto desc = std::make_shared<StreamDescriptor>(id, index, current_fields);
-        for (std::size_t r = first_row, end = last_row; r < end; r += row_per_slice_) {
-            auto rdist = std::min(last_row-r, row_per_slice_);
+        for (const auto& row_range : row_ranges) {
             slices.push_back(FrameSlice(desc,
                                         ColRange{col, col+distance},
-                                        RowRange{r, r+rdist}));
+                                        row_range));
         }
 
-        col += col_per_slice_;
+        col += distance;
         tensor_pos = tensor_next;
         fields_pos = fields_next;
     } while (tensor_pos!=std::end(frame.field_tensors));
     return slices;
 }
 
+std::vector<FrameSlice> slice_columns_over_rows(
+        const arcticdb::pipelines::InputTensorFrame& frame,
+        size_t col_per_slice,
+        const std::vector<RowRange>& row_ranges) {
+    std::vector<size_t> column_group_sizes;
+    for(auto remaining = frame.field_tensors.size(); remaining > 0; remaining -= column_group_sizes.back())
+        column_group_sizes.push_back(std::min(remaining, col_per_slice));
+
+    if(column_group_sizes.empty())
+        column_group_sizes.push_back(0);
+
+    return slice_columns_over_rows(frame, column_group_sizes, row_ranges);
+}
+
+std::vector<RowRange> regular_row_ranges(const arcticdb::pipelines::InputTensorFrame& frame, size_t row_per_slice) {
+    const auto [first_row, last_row] = get_first_and_last_row(frame);
+    std::vector<RowRange> row_ranges;
+    for (std::size_t r = first_row, end = last_row; r < end; r += row_per_slice) {
+        auto rdist = std::min(last_row-r, row_per_slice);
+        row_ranges.emplace_back(r, r+rdist);
+    }
+    return row_ranges;
+}
+
+std::vector<FrameSlice> FixedSlicer::operator()(const arcticdb::pipelines::InputTensorFrame& frame) const {
+    return slice_columns_over_rows(frame, col_per_slice_, regular_row_ranges(frame, row_per_slice_));
+}
+
+namespace {
+uint64_t boundary_mask_for_rows(size_t expected_rows) {
+    uint64_t mask = 1;
+    while(mask < expected_rows)
+        mask <<= 1;
+
+    return mask - 1;
+}
+
+// Numeric columns (and the index) contribute to the row hash, strings and multi-dimensional columns do not
+std::vector<const NativeTensor*> hashable_tensors(const InputTensorFrame& frame) {
+    std::vector<const NativeTensor*> output;
+    auto is_hashable = [] (const NativeTensor& tensor) {
+        return tensor.ndim() == 1 && (is_numeric_type(tensor.data_type()) || is_bool_type(tensor.data_type()));
+    };
+    if(frame.index_tensor && is_hashable(*frame.index_tensor))
+        output.push_back(&*frame.index_tensor);
+
+    for(const auto& tensor : frame.field_tensors) {
+        if(is_hashable(tensor))
+            output.push_back(&tensor);
+    }
+    return output;
+}
+
+HashedValue hash_row(const std::vector<const NativeTensor*>& tensors, size_t row) {
+    HashAccum accum;
+    for(const auto* tensor : tensors) {
+        auto ptr = reinterpret_cast<const uint8_t*>(tensor->data()) + row * tensor->strides(0);
+        accum(ptr, get_type_size(tensor->data_type()));
+    }
+    return accum.digest();
+}
+}
+
+ContentDefinedSlicer::ContentDefinedSlicer(std::size_t col_per_slice, std::size_t row_per_slice) :
+    col_per_slice_(col_per_slice),
+    row_per_slice_(std::max(row_per_slice, size_t{4})),
+    min_row_per_slice_(row_per_slice_ / 4),
+    max_row_per_slice_(row_per_slice_ * 4),
+    boundary_mask_(boundary_mask_for_rows(row_per_slice_ - min_row_per_slice_)) {
+}
+
+std::vector<RowRange> ContentDefinedSlicer::row_ranges(const arcticdb::pipelines::InputTensorFrame& frame) const {
+    const auto [first_row, last_row] = get_first_and_last_row(frame);
+    const auto tensors = hashable_tensors(frame);
+    std::vector<RowRange> output;
+    auto slice_start = first_row;
+    uint64_t rolling_hash = 0;
+    for(auto row = first_row; row < last_row; ++row) {
+        // Gear-style rolling hash, each row's contribution is shifted out after 64 rows
+        rolling_hash = (rolling_hash << 1) + hash_row(tensors, row - first_row);
+        const auto rows_in_slice = row + 1 - slice_start;
+        if(rows_in_slice < min_row_per_slice_)
+            continue;
+
+        if((rolling_hash & boundary_mask_) == 0 || rows_in_slice == max_row_per_slice_) {
+            output.emplace_back(slice_start, row + 1);
+            slice_start = row + 1;
+            rolling_hash = 0;
+        }
+    }
+    if(slice_start < last_row)
+        output.emplace_back(slice_start, last_row);
+
+    return output;
+}
+
+std::vector<FrameSlice> ContentDefinedSlicer::operator()(const arcticdb::pipelines::InputTensorFrame& frame) const {
+    return slice_columns_over_rows(frame, col_per_slice_, row_ranges(frame));
+}
+
+TimeBucketSlicer::TimeBucketSlicer(
+    timestamp bucket_ns,
+    std::size_t col_per_slice,
+    std::size_t row_per_slice,
+    std::size_t min_row_per_slice) :
+    bucket_ns_(bucket_ns),
+    col_per_slice_(col_per_slice),
+    row_per_slice_(std::max(row_per_slice, size_t{1})),
+    min_row_per_slice_(std::min(min_row_per_slice, row_per_slice_)) {
+    util::check(bucket_ns_ > 0, "Time bucket width must be positive, got {}", bucket_ns_);
+}
+
+std::vector<RowRange> TimeBucketSlicer::row_ranges(const arcticdb::pipelines::InputTensorFrame& frame) const {
+    util::check(static_cast<bool>(frame.index_tensor), "Time bucket slicing requires a timestamp index");
+    const auto& index = frame.index_tensor.value();
+    const auto [first_row, last_row] = get_first_and_last_row(frame);
+    auto bucket_of = [this] (timestamp ts) {
+        // Floor rather than truncate, so that buckets before the epoch are the same width
+        return ts >= 0 ? ts / bucket_ns_ : (ts + 1) / bucket_ns_ - 1;
+    };
+
+    std::vector<RowRange> output;
+    auto slice_start = first_row;
+    for(auto row = first_row; row < last_row; ++row) {
+        const auto rows_in_slice = row - slice_start;
+        if(rows_in_slice == 0)
+            continue;
+
+        if(rows_in_slice == row_per_slice_) {
+            output.emplace_back(slice_start, row);
+            slice_start = row;
+        } else if(rows_in_slice >= min_row_per_slice_) {
+            const auto pos = row - first_row;
+            if(bucket_of(*index.ptr_cast<timestamp>(pos)) != bucket_of(*index.ptr_cast<timestamp>(pos - 1))) {
+                output.emplace_back(slice_start, row);
+                slice_start = row;
+            }
+        }
+    }
+    if(slice_start < last_row)
+        output.emplace_back(slice_start, last_row);
+
+    return output;
+}
+
+std::vector<FrameSlice> TimeBucketSlicer::operator()(const arcticdb::pipelines::InputTensorFrame& frame) const {
+    return slice_columns_over_rows(frame, col_per_slice_, row_ranges(frame));
+}
+
+namespace {
+// Columns of the same kind are kept together in a column slice where possible
+enum class ColumnKind : uint8_t {
+    Integer,
+    Float,
+    Bool,
+    String,
+    Other
+};
+
+struct ColumnEstimate {
+    double bytes_per_row_;
+    ColumnKind kind_;
+    bool compressible_;
+
+    bool similar_to(const ColumnEstimate& other) const {
+        return kind_ == other.kind_ && compressible_ == other.compressible_;
+    }
+};
+
+// Compressed size as a fraction of the raw size of the first rows of a one-dimensional column. LZ4 is only a cheap
+// proxy for the library's codec: it is the default, and stronger codecs such as ZSTD compress further, so with those
+// the estimate errs towards smaller segments.
+double sampled_compression_ratio(const NativeTensor& tensor, size_t num_rows) {
+    static const auto sample_rows = ConfigsMap::instance()->get_int("AdaptiveSlicing.SampleRows", 4096);
+    const auto rows = std::min(num_rows, size_t(sample_rows));
+    const auto elsize = size_t(tensor.elsize());
+    if(rows == 0 || elsize == 0)
+        return 1.0;
+
+    std::vector<char> sample(rows * elsize);
+    const auto* data = reinterpret_cast<const char*>(tensor.data());
+    for(size_t row = 0; row < rows; ++row)
+        memcpy(sample.data() + row * elsize, data + row * tensor.strides(0), elsize);
+
+    std::vector<char> compressed(LZ4_compressBound(int(sample.size())));
+    const auto compressed_bytes = LZ4_compress_default(sample.data(), compressed.data(), int(sample.size()), int(compressed.size()));
+    return compressed_bytes > 0 ? std::min(1.0, double(compressed_bytes) / double(sample.size())) : 1.0;
+}
+
+bool is_sampled_column(const NativeTensor& tensor) {
+    return tensor.ndim() == 1 && !is_sequence_type(tensor.data_type());
+}
+
+// Compressing a sample of every column of a wide frame can cost as much as the write, so at most
+// AdaptiveSlicing.SampledColumns evenly spaced columns are sampled, and the others take the mean ratio of the sampled
+// columns of their type. A type with no sampled column is sampled once, on its first column.
+class CompressionRatios {
+public:
+    CompressionRatios(const InputTensorFrame& frame, size_t num_rows) :
+        num_rows_(num_rows),
+        ratios_(frame.field_tensors.size()) {
+        const auto max_sampled = size_t(std::max(ConfigsMap::instance()->get_int("AdaptiveSlicing.SampledColumns", 32), int64_t{1}));
+        const auto stride = std::max((ratios_.size() + max_sampled - 1) / max_sampled, size_t{1});
+        for(size_t col = 0; col < ratios_.size(); col += stride) {
+            if(is_sampled_column(frame.field_tensors[col]))
+                sample(col, frame.field_tensors[col]);
+        }
+    }
+
+    double ratio(size_t col, const NativeTensor& tensor) {
+        if(ratios_[col])
+            return *ratios_[col];
+
+        auto it = by_type_.find(tensor.data_type());
+        if(it == by_type_.end())
+            return sample(col, tensor);
+
+        return it->second.first / double(it->second.second);
+    }
+
+private:
+    double sample(size_t col, const NativeTensor& tensor) {
+        const auto ratio = sampled_compression_ratio(tensor, num_rows_);
+        ratios_[col] = ratio;
+        auto& [total, count] = by_type_[tensor.data_type()];
+        total += ratio;
+        ++count;
+        return ratio;
+    }
+
+    size_t num_rows_;
+    std::vector<std::optional<double>> ratios_;
+    // Sum and count of the sampled ratios of each type
+    std::unordered_map<DataType, std::pair<double, size_t>> by_type_;
+};
+
+ColumnEstimate estimate_column(const NativeTensor& tensor, size_t num_rows, const std::function<double()>& compression_ratio) {
+    // Strings are stored as offsets into a pool, which cannot be sampled here without the GIL
+    static const auto string_bytes = ConfigsMap::instance()->get_int("AdaptiveSlicing.StringBytesPerRow", 16);
+    const auto data_type = tensor.data_type();
+    if(is_sequence_type(data_type))
+        return {double(string_bytes), ColumnKind::String, true};
+
+    if(tensor.ndim() != 1)
+        return {num_rows > 0 ? double(tensor.nbytes()) / double(num_rows) : double(tensor.elsize()), ColumnKind::Other, false};
+
+    const auto ratio = compression_ratio();
+    const auto kind = is_floating_point_type(data_type) ? ColumnKind::Float :
+                      is_bool_type(data_type) ? ColumnKind::Bool :
+                      is_integer_type(data_type) || is_time_type(data_type) ? ColumnKind::Integer : ColumnKind::Other;
+    return {double(tensor.elsize()) * ratio, kind, ratio < 0.5};
+}
+} // namespace
+
+AdaptiveSlicer::AdaptiveSlicer(const InputTensorFrame& frame, std::size_t target_bytes, bool column_slicing) {
+    const auto min_rows = ConfigsMap::instance()->get_int("AdaptiveSlicing.MinRows", 10'000);
+    const auto max_rows = ConfigsMap::instance()->get_int("AdaptiveSlicing.MaxRows", 2'000'000);
+    util::check(target_bytes > 0, "Adaptive slicing needs a positive target segment size");
+    const auto num_rows = size_t(std::max(frame.num_rows, ssize_t{0}));
+
+    CompressionRatios ratios{frame, num_rows};
+    std::vector<ColumnEstimate> estimates;
+    estimates.reserve(frame.field_tensors.size());
+    for(size_t col = 0; col < frame.field_tensors.size(); ++col) {
+        const auto& tensor = frame.field_tensors[col];
+        estimates.emplace_back(estimate_column(tensor, num_rows, [&ratios, col, &tensor] () { return ratios.ratio(col, tensor); }));
+    }
+
+    // The index is repeated in every column slice
+    const auto index_bytes = frame.index_tensor ? estimate_column(*frame.index_tensor, num_rows, [&frame, num_rows] () {
+        return sampled_compression_ratio(*frame.index_tensor, num_rows);
+    }).bytes_per_row_ : 0.0;
+    auto total_bytes = index_bytes;
+    for(const auto& estimate : estimates)
+        total_bytes += estimate.bytes_per_row_;
+
+    const auto rows_for_target = size_t(double(target_bytes) / std::max(total_bytes, 1.0));
+    row_per_slice_ = std::clamp(rows_for_target, size_t(std::max(min_rows, int64_t{1})), size_t(std::max(max_rows, min_rows)));
+
+    // When even the minimum row count makes segments too big, the columns are split so that each slice fits
+    const auto rows_in_slice = std::max(std::min(row_per_slice_, num_rows), size_t{1});
+    const auto group_budget = std::max(double(target_bytes) / double(rows_in_slice) - index_bytes, 1.0);
+    size_t group_size = 0;
+    double group_bytes = 0.0;
+    for(size_t i = 0; i < estimates.size(); ++i) {
+        if(column_slicing && group_size > 0) {
+            const auto over_budget = group_bytes + estimates[i].bytes_per_row_ > group_budget;
+            const auto kind_changes = !estimates[i].similar_to(estimates[i - 1]) && group_bytes >= group_budget / 2;
+            if(over_budget || kind_changes) {
+                column_group_sizes_.push_back(group_size);
+                group_size = 0;
+                group_bytes = 0.0;
+            }
+        }
+        ++group_size;
+        group_bytes += estimates[i].bytes_per_row_;
+    }
+    column_group_sizes_.push_back(group_size);
+    ARCTICDB_DEBUG(log::version(), "Adaptive slicing of {} chose {} rows and {} column slices for {} estimated bytes per row",
+                   frame.desc.id(), row_per_slice_, column_group_sizes_.size(), total_bytes);
+}
+
+std::vector<FrameSlice> AdaptiveSlicer::operator()(const arcticdb::pipelines::InputTensorFrame& frame) const {
+    return slice_columns_over_rows(frame, column_group_sizes_, regular_row_ranges(frame, row_per_slice_));
+}
+
 std::vector<FrameSlice> HashedSlicer::operator()(const arcticdb::pipelines::InputTensorFrame& frame) const {
     std::vector<uint32_t> buckets;
     const auto [index_count, field_count] = get_index_and_field_count(frame);
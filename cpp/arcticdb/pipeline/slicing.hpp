@@ -56,10 +56,85 @@ private:
     size_t row_per_slice_;
 };
 
+/*
+ * Chooses row boundaries from the content of the frame rather than from fixed row counts, using a rolling hash
+ * over the index and numeric values of each row. Inserting or removing rows only moves the boundaries near the
+ * change, so unchanged regions of a frame produce identical segments (and content hashes) across versions and can
+ * be de-duplicated. Slices are between a quarter of and four times row_per_slice rows long. Columns are grouped as
+ * in the FixedSlicer.
+ */
+class ContentDefinedSlicer {
+public:
+    explicit ContentDefinedSlicer(std::size_t col_per_slice = 127, std::size_t row_per_slice = 100'000);
+
+    std::vector<FrameSlice> operator() (const InputTensorFrame &frame) const;
+
+    // The row ranges chosen for the frame, in the same coordinates as the frame slices
+    std::vector<RowRange> row_ranges(const InputTensorFrame &frame) const;
+
+    auto row_per_slice() const { return row_per_slice_; }
+
+private:
+    size_t col_per_slice_;
+    size_t row_per_slice_;
+    size_t min_row_per_slice_;
+    size_t max_row_per_slice_;
+    uint64_t boundary_mask_;
+};
+
+/*
+ * Aligns row boundaries of timestamp-indexed frames to fixed-width time buckets (e.g. hourly or daily), so that each
+ * segment covers a predictable time range. A bucket with more than row_per_slice rows is split, and buckets with
+ * fewer than min_row_per_slice rows are merged with the following ones.
+ */
+class TimeBucketSlicer {
+public:
+    TimeBucketSlicer(
+        timestamp bucket_ns,
+        std::size_t col_per_slice = 127,
+        std::size_t row_per_slice = 100'000,
+        std::size_t min_row_per_slice = 0);
+
+    std::vector<FrameSlice> operator() (const InputTensorFrame &frame) const;
+
+    std::vector<RowRange> row_ranges(const InputTensorFrame &frame) const;
+
+    auto row_per_slice() const { return row_per_slice_; }
+
+private:
+    timestamp bucket_ns_;
+    size_t col_per_slice_;
+    size_t row_per_slice_;
+    size_t min_row_per_slice_;
+};
+
+/*
+ * Picks the row and column slice sizes of each write so that segments compress to about target_bytes, estimating
+ * the compressed size of a row of each column from its type and, for numeric columns, from compressing a sample of
+ * a bounded number of them.
+ * Columns stay in frame order, so column slices are contiguous runs of columns, cut preferably where the type or
+ * compressibility of the columns changes. Without column slicing (e.g. for dynamic schema) only the row count
+ * adapts.
+ */
+class AdaptiveSlicer {
+public:
+    AdaptiveSlicer(const InputTensorFrame &frame, std::size_t target_bytes, bool column_slicing = true);
+
+    std::vector<FrameSlice> operator() (const InputTensorFrame &frame) const;
+
+    auto row_per_slice() const { return row_per_slice_; }
+
+    const std::vector<size_t>& column_group_sizes() const { return column_group_sizes_; }
+
+private:
+    size_t row_per_slice_;
+    std::vector<size_t> column_group_sizes_;
+};
+
 class NoSlicing {
 };
 
-using SlicingPolicy = std::variant<NoSlicing, FixedSlicer, HashedSlicer>;
+using SlicingPolicy = std::variant<NoSlicing, FixedSlicer, HashedSlicer, ContentDefinedSlicer, TimeBucketSlicer, AdaptiveSlicer>;
 
 SlicingPolicy get_slicing_policy(
     const WriteOptions& options,
@@ -0,0 +1,183 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/arrow_input.hpp>
+#include <arcticdb/pipeline/arrow_output.hpp>
+#include <arcticdb/stream/index.hpp>
+
+TEST(ArrowOutput, ExportSegment) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    const std::vector<std::string> names{"alpha", "beta", "gamma"};
+    constexpr size_t num_rows = 20;
+    constexpr size_t missing_row = 5;
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"arrow"}}, stream::RowCountIndex{}, {
+        scalar_field(DataType::INT64, "ints"),
+        scalar_field(DataType::FLOAT64, "floats"),
+        scalar_field(DataType::BOOL8, "flags"),
+        scalar_field(DataType::UTF_DYNAMIC64, "names"),
+        scalar_field(DataType::ASCII_DYNAMIC64, "codes")
+    })};
+    for(size_t row = 0; row < num_rows; ++row) {
+        segment.set_scalar(0, static_cast<int64_t>(row));
+        segment.set_scalar(1, row * 0.5);
+        segment.set_scalar(2, row % 3 == 0);
+        if(row == missing_row)
+            segment.set_no_string_at(3, static_cast<position_t>(row), not_a_string());
+        else
+            segment.set_string(3, names[row % names.size()]);
+        segment.set_string(4, fmt::format("code_{}", row));
+        segment.end_row();
+    }
+
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(segment, &array, &schema);
+
+    ASSERT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 5);
+    ASSERT_EQ(array.n_children, 5);
+    ASSERT_EQ(array.length, num_rows);
+
+    // Single-block numeric columns are exported without copying
+    ASSERT_STREQ(schema.children[0]->format, "l");
+    ASSERT_STREQ(schema.children[0]->name, "ints");
+    const auto* ints = array.children[0];
+    ASSERT_EQ(ints->null_count, 0);
+    ASSERT_EQ(ints->buffers[1], segment.column(0).data().buffer().data());
+
+    ASSERT_STREQ(schema.children[1]->format, "g");
+    ASSERT_EQ(static_cast<const double*>(array.children[1]->buffers[1])[7], 3.5);
+
+    ASSERT_STREQ(schema.children[2]->format, "b");
+    const auto* flags = static_cast<const uint8_t*>(array.children[2]->buffers[1]);
+    for(size_t row = 0; row < num_rows; ++row)
+        ASSERT_EQ(((flags[row / 8] >> (row % 8)) & 1) == 1, row % 3 == 0);
+
+    // Repeated strings are dictionary encoded
+    const auto* names_schema = schema.children[3];
+    ASSERT_STREQ(names_schema->format, "i");
+    ASSERT_NE(names_schema->dictionary, nullptr);
+    ASSERT_STREQ(names_schema->dictionary->format, "U");
+    const auto* names_array = array.children[3];
+    ASSERT_EQ(names_array->null_count, 1);
+    const auto* validity = static_cast<const uint8_t*>(names_array->buffers[0]);
+    ASSERT_EQ((validity[missing_row / 8] >> (missing_row % 8)) & 1, 0);
+    const auto* dictionary = names_array->dictionary;
+    ASSERT_EQ(dictionary->length, names.size());
+    const auto* indices = static_cast<const int32_t*>(names_array->buffers[1]);
+    const auto* dictionary_offsets = static_cast<const int64_t*>(dictionary->buffers[1]);
+    const auto* dictionary_chars = static_cast<const char*>(dictionary->buffers[2]);
+    for(size_t row = 0; row < num_rows; ++row) {
+        if(row == missing_row)
+            continue;
+
+        const auto index = indices[row];
+        const std::string_view value{dictionary_chars + dictionary_offsets[index], static_cast<size_t>(dictionary_offsets[index + 1] - dictionary_offsets[index])};
+        ASSERT_EQ(value, names[row % names.size()]);
+    }
+
+    // Distinct strings are written out in full
+    ASSERT_STREQ(schema.children[4]->format, "Z");
+    const auto* codes = array.children[4];
+    ASSERT_EQ(codes->n_buffers, 3);
+    const auto* offsets = static_cast<const int64_t*>(codes->buffers[1]);
+    const auto* chars = static_cast<const char*>(codes->buffers[2]);
+    ASSERT_EQ(std::string_view(chars + offsets[12], offsets[13] - offsets[12]), "code_12");
+
+    // The array keeps the exported frame memory alive after the segment goes away
+    segment = SegmentInMemory{};
+    ASSERT_EQ(static_cast<const int64_t*>(array.children[0]->buffers[1])[19], 19);
+
+    array.release(&array);
+    ASSERT_EQ(array.release, nullptr);
+    schema.release(&schema);
+    ASSERT_EQ(schema.release, nullptr);
+}
+
+TEST(ArrowOutput, PlainStrings) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"arrow"}}, stream::RowCountIndex{}, {
+        scalar_field(DataType::UTF_DYNAMIC64, "names")
+    })};
+    for(size_t row = 0; row < 10; ++row) {
+        segment.set_string(0, "repeated");
+        segment.end_row();
+    }
+
+    // Without dictionary strings the encoding does not depend on the values, as an export of several frames needs
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(segment, &array, &schema, false);
+    ASSERT_STREQ(schema.children[0]->format, "U");
+    ASSERT_EQ(schema.children[0]->dictionary, nullptr);
+    const auto* offsets = static_cast<const int64_t*>(array.children[0]->buffers[1]);
+    const auto* chars = static_cast<const char*>(array.children[0]->buffers[2]);
+    ASSERT_EQ(std::string_view(chars + offsets[9], offsets[10] - offsets[9]), "repeated");
+
+    array.release(&array);
+    schema.release(&schema);
+}
+
+TEST(ArrowOutput, RoundTripThroughInput) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    const std::vector<std::string> names{"alpha", "beta"};
+    constexpr size_t num_rows = 10;
+    constexpr size_t missing_row = 3;
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"arrow"}}, stream::TimeseriesIndex::default_index(), {
+        scalar_field(DataType::UINT32, "counts"),
+        scalar_field(DataType::UTF_DYNAMIC64, "names")
+    })};
+    for(size_t row = 0; row < num_rows; ++row) {
+        segment.set_scalar(0, static_cast<timestamp>(row * 100));
+        segment.set_scalar(1, static_cast<uint32_t>(row * 2));
+        if(row == missing_row)
+            segment.set_no_string_at(2, static_cast<position_t>(row), not_a_string());
+        else
+            segment.set_string(2, names[row % names.size()]);
+        segment.end_row();
+    }
+
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(segment, &array, &schema);
+    const auto index_name = std::string{segment.field(0).name()};
+    auto input = arrow_to_frame(StreamId{StringId{"arrow"}}, &array, &schema, index_name);
+
+    // Importing takes ownership of the structs
+    ASSERT_EQ(array.release, nullptr);
+    ASSERT_EQ(schema.release, nullptr);
+
+    const auto& frame = input.frame_;
+    ASSERT_EQ(frame.num_rows, num_rows);
+    ASSERT_EQ(frame.desc.index().type(), IndexDescriptor::TIMESTAMP);
+    ASSERT_TRUE(frame.index_tensor.has_value());
+    ASSERT_EQ(frame.index_tensor->data_type(), DataType::NANOSECONDS_UTC64);
+    ASSERT_EQ(static_cast<const timestamp*>(frame.index_tensor->data())[7], 700);
+    ASSERT_EQ(frame.desc.get_sorted(), SortedValue::ASCENDING);
+
+    ASSERT_EQ(frame.field_tensors.size(), 2);
+    ASSERT_EQ(frame.field_tensors[0].data_type(), DataType::UINT32);
+    ASSERT_EQ(static_cast<const uint32_t*>(frame.field_tensors[0].data())[4], 8u);
+
+    // Dictionary encoded strings are gathered into the frame's string pool
+    ASSERT_TRUE(is_dynamic_string_type(frame.field_tensors[1].data_type()));
+    const auto* offsets = static_cast<const StringPool::offset_t*>(frame.field_tensors[1].data());
+    for(size_t row = 0; row < num_rows; ++row) {
+        if(row == missing_row)
+            ASSERT_EQ(offsets[row], not_a_string());
+        else
+            ASSERT_EQ(frame.string_pool->get_const_view(offsets[row]), names[row % names.size()]);
+    }
+}
@@ -0,0 +1,106 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/read_frame.hpp>
+#include <arcticdb/pipeline/column_mapping.hpp>
+#include <arcticdb/codec/codec.hpp>
+#include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/entity/type_utils.hpp>
+#include <arcticdb/stream/index.hpp>
+
+namespace arcticdb {
+
+namespace {
+using DecodePlanFields = std::vector<std::pair<std::string, DataType>>;
+
+SegmentInMemory decode_plan_segment(const DecodePlanFields& fields, size_t num_rows) {
+    std::vector<FieldRef> field_refs;
+    for(const auto& [name, type] : fields)
+        field_refs.emplace_back(scalar_field(type, name));
+
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"sym"}}, stream::RowCountIndex{}, field_refs)};
+    for(size_t row = 0; row < num_rows; ++row) {
+        for(size_t col = 0; col < fields.size(); ++col) {
+            const auto pos = static_cast<position_t>(col);
+            switch(fields[col].second) {
+            case DataType::UINT8: segment.set_scalar(pos, static_cast<uint8_t>(row)); break;
+            case DataType::INT16: segment.set_scalar(pos, static_cast<int16_t>(row)); break;
+            case DataType::INT32: segment.set_scalar(pos, static_cast<int32_t>(row)); break;
+            case DataType::INT64: segment.set_scalar(pos, static_cast<int64_t>(row)); break;
+            case DataType::FLOAT64: segment.set_scalar(pos, static_cast<double>(row)); break;
+            default: util::raise_rte("Unexpected type in decode plan test");
+            }
+        }
+        segment.end_row();
+    }
+    return segment;
+}
+
+HashedValue decode_plan_test_key(const DecodePlanFields& fields, size_t num_rows, EncodingVersion encoding_version) {
+    auto segment = encode_dispatch(decode_plan_segment(fields, num_rows), codec::default_lz4_codec(), encoding_version);
+    return pipelines::decode_plan_key(segment.header(), *segment.fields_ptr());
+}
+} // namespace
+
+TEST(DecodePlan, KeysFollowFields) {
+    const DecodePlanFields base{{"a", DataType::INT32}, {"b", DataType::FLOAT64}};
+    const DecodePlanFields added{{"a", DataType::INT32}, {"b", DataType::FLOAT64}, {"c", DataType::FLOAT64}};
+    const DecodePlanFields dropped{{"a", DataType::INT32}};
+    const DecodePlanFields promoted{{"a", DataType::INT64}, {"b", DataType::FLOAT64}};
+    const DecodePlanFields renamed{{"a", DataType::INT32}, {"c", DataType::FLOAT64}};
+
+    // V1 segments are keyed by the fields themselves, V2 segments by the hashes of their encoded descriptor field
+    for(auto encoding_version : {EncodingVersion::V1, EncodingVersion::V2}) {
+        const auto key = decode_plan_test_key(base, 10, encoding_version);
+        ASSERT_EQ(key, decode_plan_test_key(base, 10, encoding_version));
+        // Independent of the data
+        ASSERT_EQ(key, decode_plan_test_key(base, 25, encoding_version));
+        for(const auto& other : {added, dropped, promoted, renamed})
+            ASSERT_NE(key, decode_plan_test_key(other, 10, encoding_version));
+    }
+
+    // Segments without an encoded descriptor field fall back to hashing the fields
+    auto segment = encode_v1(decode_plan_segment(base, 10), codec::default_lz4_codec());
+    ASSERT_FALSE(segment.header().has_descriptor_field());
+    ASSERT_EQ(pipelines::decode_plan_key(segment.header(), *segment.fields_ptr()), hash_fields(*segment.fields_ptr()));
+}
+
+TEST(DecodePlan, StepsMatchFieldLookup) {
+    // The output frame of a dynamic schema read of a, b and c, where a has been promoted to int64
+    auto frame = decode_plan_segment({{"a", DataType::INT64}, {"b", DataType::FLOAT64}, {"c", DataType::FLOAT64}}, 0);
+    const std::vector<DecodePlanFields> segment_fields{
+        {{"a", DataType::INT32}, {"b", DataType::FLOAT64}},
+        {{"a", DataType::INT32}, {"b", DataType::FLOAT64}, {"c", DataType::FLOAT64}},
+        {{"c", DataType::FLOAT64}, {"a", DataType::INT64}},
+        // Not selected
+        {{"a", DataType::INT64}, {"d", DataType::FLOAT64}},
+        {{"b", DataType::INT16}, {"a", DataType::UINT8}}};
+
+    for(const auto& fields : segment_fields) {
+        const auto segment = decode_plan_segment(fields, 1);
+        const auto& desc = segment.descriptor();
+        const auto plan = pipelines::build_decode_plan(frame, desc, 0);
+        ASSERT_EQ(plan->steps_.size(), desc.field_count());
+        for(size_t field_col = 0; field_col < desc.field_count(); ++field_col) {
+            const auto& field = desc.fields(field_col);
+            const auto& step = plan->steps_[field_col];
+            const auto dest_col = frame.column_index(field.name());
+            ASSERT_EQ(step.dest_col_, dest_col) << field.name();
+            if(!dest_col)
+                continue;
+
+            const auto& dest_type = frame.field(*dest_col).type();
+            ASSERT_EQ(step.source_type_desc_, field.type());
+            ASSERT_EQ(step.dest_size_, sizeof_datatype(dest_type));
+            ASSERT_EQ(step.promotion_ != nullptr, !trivially_compatible_types(field.type(), dest_type)) << field.name();
+        }
+    }
+}
+
+} // namespace arcticdb
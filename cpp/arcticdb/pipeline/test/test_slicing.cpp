@@ -0,0 +1,167 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/slicing.hpp>
+#include <arcticdb/stream/test/stream_test_common.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <numeric>
+#include <set>
+
+namespace {
+std::vector<arcticdb::entity::FieldRef> integral_fields() {
+    using namespace arcticdb::entity;
+    return {
+        scalar_field(DataType::INT64, "bigints"),
+        scalar_field(DataType::UINT32, "ints")
+    };
+}
+}
+
+TEST(Slicing, ContentDefinedBounds) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    const size_t num_rows = 20000;
+    const size_t row_per_slice = 1000;
+    auto wrapper = get_test_frame<stream::TimeseriesIndex>("cdc", integral_fields(), num_rows, 0);
+    ContentDefinedSlicer slicer{127, row_per_slice};
+    auto ranges = slicer.row_ranges(wrapper.frame_);
+
+    ASSERT_FALSE(ranges.empty());
+    ASSERT_EQ(ranges.front().first, 0u);
+    ASSERT_EQ(ranges.back().second, num_rows);
+    for(size_t i = 0; i < ranges.size(); ++i) {
+        const auto rows = ranges[i].second - ranges[i].first;
+        ASSERT_LE(rows, row_per_slice * 4);
+        if(i + 1 < ranges.size()) {
+            ASSERT_GE(rows, row_per_slice / 4);
+            ASSERT_EQ(ranges[i].second, ranges[i + 1].first);
+        }
+    }
+
+    auto slices = slicer(wrapper.frame_);
+    ASSERT_EQ(slices.size(), ranges.size());
+}
+
+TEST(Slicing, ContentDefinedShiftResilience) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    // Both frames hold identical rows for timestamps [shift, num_rows), the second is just missing the first few
+    const size_t num_rows = 50000;
+    const size_t shift = 500;
+    auto full = get_test_frame<stream::TimeseriesIndex>("cdc", integral_fields(), num_rows, 0);
+    auto shifted = get_test_frame<stream::TimeseriesIndex>("cdc", integral_fields(), num_rows - shift, shift);
+    ContentDefinedSlicer slicer{127, 1000};
+
+    std::set<size_t> full_boundaries;
+    for(const auto& range : slicer.row_ranges(full.frame_))
+        full_boundaries.insert(range.second);
+
+    auto shifted_ranges = slicer.row_ranges(shifted.frame_);
+    size_t matching = 0;
+    for(const auto& range : shifted_ranges) {
+        if(full_boundaries.count(range.second + shift) != 0)
+            ++matching;
+    }
+    // Boundaries resynchronise shortly after the shifted start, so almost all of them should line up
+    ASSERT_GE(matching, shifted_ranges.size() / 2);
+}
+
+TEST(Slicing, TimeBucketBoundaries) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    // Index values are start_val + row, so a bucket of 100ns holds 100 rows
+    const size_t num_rows = 1000;
+    const size_t start_val = 50;
+    auto wrapper = get_test_frame<stream::TimeseriesIndex>("bucketed", integral_fields(), num_rows, start_val);
+
+    TimeBucketSlicer slicer{100, 127, 1000};
+    auto ranges = slicer.row_ranges(wrapper.frame_);
+    ASSERT_EQ(ranges.size(), 11u);
+    ASSERT_EQ(ranges.front(), RowRange(0, 50));
+    ASSERT_EQ(ranges.back(), RowRange(950, 1000));
+    for(size_t i = 1; i < ranges.size(); ++i) {
+        ASSERT_EQ(ranges[i].first, ranges[i - 1].second);
+        ASSERT_EQ((ranges[i].first + start_val) % 100, 0u);
+    }
+
+    // Buckets larger than the row limit are split
+    TimeBucketSlicer capped{100, 127, 30};
+    for(const auto& range : capped.row_ranges(wrapper.frame_))
+        ASSERT_LE(range.diff(), 30u);
+
+    // Buckets smaller than the minimum are merged with the following ones, still cutting on a bucket boundary
+    TimeBucketSlicer merged{100, 127, 1000, 150};
+    auto merged_ranges = merged.row_ranges(wrapper.frame_);
+    for(size_t i = 0; i + 1 < merged_ranges.size(); ++i) {
+        ASSERT_GE(merged_ranges[i].diff(), 150u);
+        ASSERT_EQ((merged_ranges[i].second + start_val) % 100, 0u);
+    }
+}
+
+TEST(Slicing, AdaptiveSliceSizes) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+    using namespace arcticdb::entity;
+
+    ScopedConfig min_rows("AdaptiveSlicing.MinRows", 1000);
+    const size_t num_rows = 20000;
+    const size_t target_bytes = 256 * 1024;
+
+    // A narrow frame fits in a single segment
+    auto narrow = get_test_frame<stream::TimeseriesIndex>("narrow", integral_fields(), num_rows, 0);
+    AdaptiveSlicer narrow_slicer{narrow.frame_, 16 * target_bytes};
+    ASSERT_EQ(narrow_slicer.column_group_sizes().size(), 1u);
+    ASSERT_EQ(narrow_slicer(narrow.frame_).size(), 1u);
+
+    // A row of a wide frame is too big for the target, so it gets the minimum rows and is split into column slices
+    std::vector<FieldRef> wide_fields;
+    std::vector<std::string> names;
+    for(size_t i = 0; i < 400; ++i)
+        names.emplace_back(fmt::format("col_{}", i));
+    for(size_t i = 0; i < names.size(); ++i)
+        wide_fields.emplace_back(scalar_field(i < 200 ? DataType::INT64 : DataType::FLOAT64, names[i]));
+
+    auto wide = get_test_frame<stream::TimeseriesIndex>("wide", wide_fields, num_rows, 0);
+    AdaptiveSlicer wide_slicer{wide.frame_, target_bytes};
+    const auto& groups = wide_slicer.column_group_sizes();
+    ASSERT_GT(groups.size(), 1u);
+    ASSERT_EQ(std::accumulate(groups.begin(), groups.end(), size_t{0}), names.size());
+    ASSERT_EQ(wide_slicer.row_per_slice(), 1000u);
+
+    auto slices = wide_slicer(wide.frame_);
+    const auto row_slices = (num_rows + wide_slicer.row_per_slice() - 1) / wide_slicer.row_per_slice();
+    ASSERT_EQ(slices.size(), groups.size() * row_slices);
+    ASSERT_EQ(slices.back().col_range.second, names.size() + 1);
+
+    // Without column slicing only the row count adapts
+    AdaptiveSlicer unsliced{wide.frame_, target_bytes, false};
+    ASSERT_EQ(unsliced.column_group_sizes().size(), 1u);
+
+    // Sampling a few columns of each type is enough when the columns of a type compress alike
+    ScopedConfig sampled_columns("AdaptiveSlicing.SampledColumns", 4);
+    AdaptiveSlicer few_samples{wide.frame_, target_bytes};
+    ASSERT_EQ(few_samples.column_group_sizes(), groups);
+}
+
+TEST(Slicing, ConflictingSlicingOptions) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    auto test_frame = get_test_frame<stream::TimeseriesIndex>("conflicting", integral_fields(), 100, 0);
+    WriteOptions options{};
+    options.time_bucket_ns = 1'000;
+    ASSERT_TRUE(std::holds_alternative<TimeBucketSlicer>(get_slicing_policy(options, test_frame.frame_)));
+
+    options.target_segment_bytes = 1 << 20;
+    ASSERT_THROW(get_slicing_policy(options, test_frame.frame_), UserInputException);
+}
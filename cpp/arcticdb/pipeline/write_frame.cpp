@@ -36,7 +36,6 @@ using namespace arcticdb::stream;
 folly::Future<std::vector<SliceAndKey>> write_slices(
         const InputTensorFrame &frame,
         std::vector<FrameSlice>&& slices,
-        const SlicingPolicy &slicing,
         folly::Function<stream::StreamSink::PartialKey(const FrameSlice &)>&& partial_key_gen,
         const std::shared_ptr<stream::StreamSink>& sink,
         const std::shared_ptr<DeDupMap>& de_dup_map,
@@ -52,33 +51,16 @@ folly::Future<std::vector<SliceAndKey>> write_slices(
         using IdxType = std::decay_t<decltype(idx)>;
         using SingleSegmentAggregator = Aggregator<IdxType, FixedSchema, NeverSegmentPolicy>;
 
-        size_t slice_num_for_column = 0;
-        std::optional<size_t> first_row;
         for (const FrameSlice &slice : slices) {
             // Build in mem segment
             ARCTICDB_SUBSAMPLE_AGG(WriteSliceCopyToSegment)
-            if(!first_row)
-                first_row = slice.row_range.first;
-
-            if(slice.row_range.first == first_row.value())
-                slice_num_for_column = 0;
-
             SingleSegmentAggregator agg{FixedSchema{*slice.desc(), frame.index}, [&](auto &&segment) {
                 auto key = partial_key_gen(slice);
                 key_segs.emplace_back(partial_key_gen(slice), std::forward<SegmentInMemory>(segment));
             }};
 
-            auto regular_slice_size = util::variant_match(slicing,
-
-              [&](const NoSlicing &) {
-                  return slice.row_range.second - slice.row_range.first;
-              },
-              [&](const auto &slicer) {
-                return slicer.row_per_slice();
-              });
-
             auto offset_in_frame = slice_begin_pos(slice, frame);
-            // Offset is used for index value in row-count index
+            // Offset is used for index value in row-count index, and to locate the slice's rows in the tensors
             agg.set_offset(offset_in_frame);
             auto rows_to_write = slice.row_range.second - slice.row_range.first;
             if (frame.desc.index().field_count() > 0) {
@@ -86,7 +68,7 @@ folly::Future<std::vector<SliceAndKey>> write_slices(
                 auto opt_error = aggregator_set_data(
                     frame.desc.fields(0).type(),
                     frame.index_tensor.value(),
-                    agg, 0, rows_to_write, offset_in_frame, slice_num_for_column, regular_slice_size, false);
+                    agg, 0, rows_to_write, offset_in_frame, false, frame.string_pool.get());
                 if (opt_error.has_value()) {
                     opt_error->raise(frame.desc.fields(0).name(), offset_in_frame);
                 }
@@ -98,14 +80,12 @@ folly::Future<std::vector<SliceAndKey>> write_slices(
                 auto &tensor = frame.field_tensors[slice.absolute_field_col(col)];
                 auto opt_error = aggregator_set_data(
                     fd.type(),
-                    tensor, agg, abs_col, rows_to_write, offset_in_frame, slice_num_for_column,
-                    regular_slice_size, sparsify_floats);
+                    tensor, agg, abs_col, rows_to_write, offset_in_frame, sparsify_floats, frame.string_pool.get());
                 if (opt_error.has_value()) {
                     opt_error->raise(fd.name(), offset_in_frame);
                 }
             }
 
-            ++slice_num_for_column;
             agg.end_block_write(rows_to_write);
             agg.commit();
         }
@@ -148,7 +128,7 @@ folly::Future<std::vector<SliceAndKey>> slice_and_write(
     ARCTICDB_SUBSAMPLE_DEFAULT(SliceFrame)
     auto slices = slice(frame, slicing);
     ARCTICDB_SUBSAMPLE_DEFAULT(SliceAndWrite)
-    return write_slices(frame, std::move(slices), slicing, std::move(partial_key_gen), sink, de_dup_map, sparsify_floats);
+    return write_slices(frame, std::move(slices), std::move(partial_key_gen), sink, de_dup_map, sparsify_floats);
 }
 
 folly::Future<entity::AtomKey>
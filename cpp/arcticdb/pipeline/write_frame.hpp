@@ -38,7 +38,6 @@ folly::Future<std::vector<SliceAndKey>> slice_and_write(
 folly::Future<std::vector<SliceAndKey>> write_slices(
         const InputTensorFrame &frame,
         std::vector<FrameSlice>&& slices,
-        const SlicingPolicy &slicing,
         folly::Function<stream::StreamSink::PartialKey(const FrameSlice &)>&& partial_key_gen,
         const std::shared_ptr<stream::StreamSink>& sink,
         const std::shared_ptr<DeDupMap>& de_dup_map,
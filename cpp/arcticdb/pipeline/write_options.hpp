@@ -24,7 +24,12 @@ struct WriteOptions {
                 opt.ignore_sort_order(),
                 opt.bucketize_dynamic(),
                 opt.max_num_buckets() > 0 ? size_t(opt.max_num_buckets()) : def.max_num_buckets,
-                opt.compact_incomplete_dedup_rows()
+                opt.compact_incomplete_dedup_rows(),
+                opt.content_defined_slicing(),
+                opt.de_dup_index(),
+                opt.time_bucket_ns(),
+                opt.time_bucket_min_rows(),
+                opt.target_segment_bytes()
         };
     }
 
@@ -38,5 +43,10 @@ struct WriteOptions {
     bool bucketize_dynamic;
     size_t max_num_buckets = 150;
     bool compact_incomplete_dedup_rows;
+    bool content_defined_slicing = false;
+    bool de_dup_index = false;
+    uint64_t time_bucket_ns = 0;
+    uint64_t time_bucket_min_rows = 0;
+    uint64_t target_segment_bytes = 0;
 };
 } //namespace arcticdb
\ No newline at end of file
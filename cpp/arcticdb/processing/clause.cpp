@@ -15,6 +15,7 @@
 #include <arcticdb/pipeline/value_set.hpp>
 #include <arcticdb/pipeline/frame_slice.hpp>
 #include <arcticdb/stream/segment_aggregator.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
 #ifdef ARCTICDB_USING_CONDA
     #include <robin_hood.h>
 #else
@@ -123,12 +124,15 @@ struct SliceAndKeyWrapper {
     std::shared_ptr<Store> store_;
     SegmentInMemory::iterator it_;
     const StreamId id_;
+    // Position of the input in the merge, used to order rows with equal index values deterministically
+    const size_t ordinal_;
 
-    explicit SliceAndKeyWrapper(pipelines::SliceAndKey &&seg, std::shared_ptr<Store> store) :
+    explicit SliceAndKeyWrapper(pipelines::SliceAndKey &&seg, std::shared_ptr<Store> store, size_t ordinal) :
             seg_(std::move(seg)),
             store_(std::move(store)),
             it_(seg_.segment(store_).begin()),
-            id_(seg_.segment(store_).descriptor().id()) {
+            id_(seg_.segment(store_).descriptor().id()),
+            ordinal_(ordinal) {
     }
 
     bool advance() {
@@ -515,7 +519,10 @@ Composite<ProcessingUnit> MergeClause::process(std::shared_ptr<Store> store,
                                                                                IndexDescriptor::TIMESTAMP, 0);
                 const auto right_index = pipelines::index::index_value_from_row(right->row(),
                                                                                 IndexDescriptor::TIMESTAMP, 0);
-                return left_index > right_index;
+                if (left_index != right_index)
+                    return left_index > right_index;
+
+                return left->ordinal_ > right->ordinal_;
             };
 
     movable_priority_queue<std::unique_ptr<SliceAndKeyWrapper>, std::vector<std::unique_ptr<SliceAndKeyWrapper>>, decltype(compare)> input_streams{
@@ -525,7 +532,8 @@ Composite<ProcessingUnit> MergeClause::process(std::shared_ptr<Store> store,
     size_t max_end_row = 0;
     size_t min_start_col = std::numeric_limits<size_t>::max();
     size_t max_end_col = 0;
-    procs.broadcast([&input_streams, &store, &min_start_row, &max_end_row, &min_start_col, &max_end_col](auto &&proc) {
+    size_t ordinal = 0;
+    procs.broadcast([&input_streams, &store, &min_start_row, &max_end_row, &min_start_col, &max_end_col, &ordinal](auto &&proc) {
         auto slice_and_keys = proc.release_data();
         for (auto &&slice_and_key: slice_and_keys) {
             size_t start_row = slice_and_key.slice().row_range.start();
@@ -536,9 +544,13 @@ Composite<ProcessingUnit> MergeClause::process(std::shared_ptr<Store> store,
             min_start_col = start_col < min_start_col ? start_col : min_start_col;
             size_t end_col = slice_and_key.slice().col_range.end();
             max_end_col = end_col > max_end_col ? end_col : max_end_col;
+            if (slice_and_key.segment(store).row_count() == 0)
+                continue;
+
             input_streams.push(
                     std::make_unique<SliceAndKeyWrapper>(std::forward<pipelines::SliceAndKey>(slice_and_key),
-                                                         store));
+                                                         store,
+                                                         ordinal++));
         }
     });
     const RowRange row_range{min_start_row, max_end_row};
@@ -560,10 +572,121 @@ Composite<ProcessingUnit> MergeClause::process(std::shared_ptr<Store> store,
     return ret;
 }
 
+namespace {
+
+timestamp merge_index_value(const SegmentInMemory& segment, size_t row) {
+    return segment.scalar_at<timestamp>(row, 0).value();
+}
+
+// First row of a segment sorted on its index whose index value is not less than value
+size_t merge_lower_bound(const SegmentInMemory& segment, timestamp value) {
+    size_t first = 0;
+    size_t last = segment.row_count();
+    while (first < last) {
+        const auto mid = first + (last - first) / 2;
+        if (merge_index_value(segment, mid) < value)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+    return first;
+}
+
+// Index values splitting rows sampled from all the inputs into partitions of roughly equal size
+std::vector<timestamp> merge_partition_bounds(
+        const std::vector<pipelines::SliceAndKey>& inputs,
+        size_t total_rows,
+        size_t num_partitions) {
+    constexpr size_t samples_per_partition = 128;
+    const auto stride = std::max<size_t>(1, total_rows / (num_partitions * samples_per_partition));
+    std::vector<timestamp> samples;
+    samples.reserve(total_rows / stride + inputs.size());
+    for (const auto& input : inputs) {
+        const auto& segment = *input.segment_;
+        for (size_t row = 0; row < segment.row_count(); row += stride)
+            samples.emplace_back(merge_index_value(segment, row));
+    }
+    std::sort(std::begin(samples), std::end(samples));
+
+    std::vector<timestamp> bounds;
+    for (size_t i = 1; i < num_partitions; ++i) {
+        const auto bound = samples[i * samples.size() / num_partitions];
+        if (bound > (bounds.empty() ? samples.front() : bounds.back()))
+            bounds.emplace_back(bound);
+    }
+    return bounds;
+}
+
+} // namespace
+
+// The inputs are each sorted on the index, so they can be range-partitioned on sampled index values and the partitions
+// merged concurrently. Rows with equal index values always land in the same partition and are ordered by the position
+// of their input, so the partition outputs, which are collected in order, concatenate to exactly the serial merge.
 std::optional<std::vector<Composite<ProcessingUnit>>> MergeClause::repartition(
         std::vector<Composite<ProcessingUnit>> &&comps) const {
     std::vector<Composite<ProcessingUnit>> v;
-    v.push_back(merge_composites_shallow(std::move(comps)));
+    auto merged = merge_composites_shallow(std::move(comps));
+
+    size_t total_rows = 0;
+    bool all_loaded = true;
+    merged.broadcast([&total_rows, &all_loaded](const auto &proc) {
+        for (const auto &slice_and_key: proc.data()) {
+            if (slice_and_key.segment_.has_value())
+                total_rows += slice_and_key.segment_->row_count();
+            else
+                all_loaded = false;
+        }
+    });
+
+    const auto max_partitions = ConfigsMap::instance()->get_int("Merge.MaxPartitions", static_cast<int64_t>(async::TaskScheduler::instance()->cpu_thread_count()));
+    const auto min_partition_rows = std::max<int64_t>(1, ConfigsMap::instance()->get_int("Merge.MinPartitionRows", 100000));
+    const auto num_partitions = std::min(static_cast<size_t>(std::max<int64_t>(1, max_partitions)), total_rows / static_cast<size_t>(min_partition_rows));
+    if (!all_loaded || num_partitions < 2) {
+        v.push_back(std::move(merged));
+        return v;
+    }
+
+    std::vector<pipelines::SliceAndKey> inputs;
+    size_t min_start_row = std::numeric_limits<size_t>::max();
+    size_t max_end_row = 0;
+    size_t min_start_col = std::numeric_limits<size_t>::max();
+    size_t max_end_col = 0;
+    merged.broadcast([&inputs, &min_start_row, &max_end_row, &min_start_col, &max_end_col](auto &&proc) {
+        for (auto &&slice_and_key: proc.release_data()) {
+            min_start_row = std::min(min_start_row, slice_and_key.slice().row_range.start());
+            max_end_row = std::max(max_end_row, slice_and_key.slice().row_range.end());
+            min_start_col = std::min(min_start_col, slice_and_key.slice().col_range.start());
+            max_end_col = std::max(max_end_col, slice_and_key.slice().col_range.end());
+            if (slice_and_key.segment_->row_count() > 0)
+                inputs.emplace_back(std::move(slice_and_key));
+        }
+    });
+
+    // The merge labels its output with the extent of its inputs, so every partition is given that of all of them
+    auto merged_slice = inputs.front().slice();
+    merged_slice.row_range = pipelines::RowRange{min_start_row, max_end_row};
+    merged_slice.col_range = pipelines::ColRange{min_start_col, max_end_col};
+
+    const auto bounds = merge_partition_bounds(inputs, total_rows, num_partitions);
+    std::vector<std::vector<pipelines::SliceAndKey>> partitions(bounds.size() + 1);
+    for (const auto &input: inputs) {
+        const auto& segment = *input.segment_;
+        size_t start_row = 0;
+        for (size_t partition = 0; partition < partitions.size() && start_row < segment.row_count(); ++partition) {
+            const auto end_row = partition < bounds.size() ? merge_lower_bound(segment, bounds[partition]) : segment.row_count();
+            if (end_row > start_row) {
+                auto part = start_row == 0 && end_row == segment.row_count() ? segment : segment.truncate(start_row, end_row);
+                partitions[partition].emplace_back(std::move(part), pipelines::FrameSlice{merged_slice});
+                start_row = end_row;
+            }
+        }
+    }
+
+    for (auto &partition: partitions) {
+        if (!partition.empty())
+            v.emplace_back(ProcessingUnit{std::move(partition)});
+    }
+    ARCTICDB_DEBUG(log::version(), "Merging {} rows in {} partitions", total_rows, v.size());
     return v;
 }
 
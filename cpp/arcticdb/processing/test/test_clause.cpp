@@ -375,3 +375,69 @@ TEST(Clause, Merge) {
         }
     }
 }
+
+TEST(Clause, MergePartitioned) {
+    using namespace arcticdb;
+    ScopedConfig segment_size("Merge.SegmentSize", 100);
+    ScopedConfig max_partitions("Merge.MaxPartitions", 4);
+    ScopedConfig min_partition_rows("Merge.MinPartitionRows", 100);
+
+    // Overlapping index ranges, including rows with equal index values in different inputs
+    auto make_inputs = [] () {
+        Composite<ProcessingUnit> comp;
+        for(auto num_rows : {300u, 500u, 700u})
+            comp.push_back(ProcessingUnit{get_standard_timeseries_segment(fmt::format("merge_{}", num_rows), num_rows)});
+        return comp;
+    };
+
+    StreamDescriptor descriptor{};
+    descriptor.add_field(FieldRef{make_scalar_type(DataType::NANOSECONDS_UTC64),"time"});
+    MergeClause merge_clause{TimeseriesIndex{"time"}, DenseColumnPolicy{}, StreamId{"Merge"}, descriptor};
+    std::shared_ptr<Store> empty;
+
+    auto flatten = [&empty] (Composite<ProcessingUnit>& res, std::vector<SegmentInMemory>& output) {
+        res.broadcast([&empty, &output] (auto& proc) {
+            for(auto& slice_and_key : proc.data())
+                output.emplace_back(slice_and_key.segment(empty));
+        });
+    };
+
+    std::vector<SegmentInMemory> serial;
+    auto serial_res = merge_clause.process(empty, make_inputs());
+    flatten(serial_res, serial);
+
+    std::vector<Composite<ProcessingUnit>> inputs;
+    inputs.emplace_back(make_inputs());
+    auto partitions = merge_clause.repartition(std::move(inputs)).value();
+    ASSERT_GT(partitions.size(), 1u);
+    std::vector<SegmentInMemory> partitioned;
+    for(auto& partition : partitions) {
+        auto res = merge_clause.process(empty, std::move(partition));
+        flatten(res, partitioned);
+    }
+
+    auto rows_of = [] (const std::vector<SegmentInMemory>& segments) {
+        std::vector<std::tuple<timestamp, int8_t, uint64_t, std::string>> rows;
+        for(const auto& segment : segments) {
+            segment.init_column_map();
+            const auto int8_col = segment.column_index("int8").value();
+            const auto uint64_col = segment.column_index("uint64").value();
+            const auto strings_col = segment.column_index("strings").value();
+            for(size_t row = 0; row < segment.row_count(); ++row) {
+                rows.emplace_back(
+                    segment.scalar_at<timestamp>(row, 0).value(),
+                    segment.scalar_at<int8_t>(row, int8_col).value(),
+                    segment.scalar_at<uint64_t>(row, uint64_col).value(),
+                    std::string{segment.string_at(row, strings_col).value()});
+            }
+        }
+        return rows;
+    };
+
+    const auto serial_rows = rows_of(serial);
+    ASSERT_EQ(serial_rows.size(), 1500u);
+    ASSERT_TRUE(std::is_sorted(serial_rows.begin(), serial_rows.end(), [] (const auto& l, const auto& r) {
+        return std::get<0>(l) < std::get<0>(r);
+    }));
+    ASSERT_EQ(rows_of(partitioned), serial_rows);
+}
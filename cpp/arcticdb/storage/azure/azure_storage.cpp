@@ -225,14 +225,15 @@ auto default_prefix_handler() {
     };
 }
 
-template<class KeyBucketizer, class PrefixHandler>
+template<class Visitor, class KeyBucketizer, class PrefixHandler>
 void do_iterate_type_impl(KeyType key_type,
-    const IterateTypeVisitor& visitor,
+    const Visitor& visitor,
     const std::string& root_folder,
     Azure::Storage::Blobs::BlobContainerClient& container_client,
     KeyBucketizer&& bucketizer,
     PrefixHandler&& prefix_handler = default_prefix_handler(),
-    const std::string& prefix = std::string{}) {
+    const std::string& prefix = std::string{},
+    const std::optional<std::string>& end = std::nullopt) {
         ARCTICDB_SAMPLE(AzureStorageIterateType, 0)
         auto key_type_dir = key_type_folder(root_folder, key_type);
 
@@ -247,6 +248,10 @@ void do_iterate_type_impl(KeyType key_type,
         try{
             for (auto page = container_client.ListBlobs(options); page.HasPage(); page.MoveToNextPage()) {
                 for (const auto& blob : page.Blobs) {
+                    // Blobs are listed in name order, so nothing after the end of the range is wanted
+                    if (end && blob.Name >= *end)
+                        return;
+
                     auto key = blob.Name.substr(root_folder_size);
                     ARCTICDB_TRACE(log::version(), "Got object_list: {}, key: {}", blob.Name, key);
                     auto k = variant_key_from_bytes(
@@ -255,7 +260,10 @@ void do_iterate_type_impl(KeyType key_type,
                                 key_type);
                     ARCTICDB_DEBUG(log::storage(), "Iterating key {}: {}", variant_key_type(k), variant_key_view(k));
                     ARCTICDB_SUBSAMPLE(AzureStorageVisitKey, 0)
-                    visitor(std::move(k));
+                    if constexpr (std::is_invocable_v<Visitor, VariantKey&&, size_t>)
+                        visitor(std::move(k), static_cast<size_t>(blob.BlobSize));
+                    else
+                        visitor(std::move(k));
                     ARCTICDB_SUBSAMPLE(AzureStorageCursorNext, 0)
                 }
             }
@@ -268,6 +276,101 @@ void do_iterate_type_impl(KeyType key_type,
         }
 }
 
+// Tokenized key names start with the four character key descriptor and the '*' before the stream id
+constexpr size_t tokenized_id_offset = 5;
+
+// Printable ASCII is split between the ranges. Stream ids almost never start with anything else, but those that do
+// are covered by the first range of each descriptor, and by the last for ids starting with a UTF-8 lead byte.
+constexpr uint8_t first_printable = 0x21;
+constexpr uint8_t last_printable = 0x7E;
+
+std::string next_prefix(std::string prefix) {
+    prefix.back() = static_cast<char>(prefix.back() + 1);
+    return prefix;
+}
+
+/*
+ * Azure can only list blobs by prefix, so each key descriptor's keys are split on the first character of the stream
+ * id into ranges of whole characters, each listed with one prefix per character. The first range of a descriptor
+ * starts at the descriptor itself, and is listed in order up to its end instead. The descriptors present come from a
+ * single hierarchical listing, which returns each once.
+ */
+std::vector<KeyRange> do_key_ranges_impl(
+    KeyType key_type,
+    size_t max_ranges,
+    const std::string& root_folder,
+    Azure::Storage::Blobs::BlobContainerClient& container_client) {
+    const auto range_root = key_type_folder(root_folder, key_type) + "/";
+    std::vector<std::string> descriptors;
+    Azure::Storage::Blobs::ListBlobsOptions options;
+    options.Prefix = range_root + "*";
+    try {
+        for (auto page = container_client.ListBlobsByHierarchy("*", options); page.HasPage(); page.MoveToNextPage()) {
+            for (const auto& blob_prefix : page.BlobPrefixes) {
+                if (blob_prefix.size() == range_root.size() + tokenized_id_offset)
+                    descriptors.push_back(blob_prefix.substr(range_root.size()));
+            }
+        }
+    } catch (const Azure::Core::RequestFailedException& e) {
+        log::storage().warn("Failed to list azure key descriptors '{}' {}: {}", key_type, static_cast<int>(e.StatusCode), e.ReasonPhrase);
+        return {KeyRange{}};
+    }
+    if (descriptors.empty() || max_ranges < 2)
+        return {KeyRange{}};
+
+    const auto ranges_per_descriptor = std::max<size_t>(max_ranges / descriptors.size(), 1);
+    const size_t span = last_printable - first_printable + 1;
+    std::vector<KeyRange> ranges;
+    for (const auto& descriptor : descriptors) {
+        std::optional<std::string> start = descriptor;
+        for (size_t i = 1; i < ranges_per_descriptor; ++i) {
+            auto boundary = descriptor + static_cast<char>(first_printable + span * i / ranges_per_descriptor);
+            ranges.push_back(KeyRange{start, boundary});
+            start = std::move(boundary);
+        }
+        ranges.push_back(KeyRange{start, descriptor + static_cast<char>(last_printable + 1)});
+        ranges.push_back(KeyRange{descriptor + static_cast<char>(last_printable + 1), next_prefix(descriptor)});
+    }
+    return ranges;
+}
+
+template<class Visitor>
+void do_iterate_type_in_range_impl(
+    KeyType key_type,
+    const KeyRange& range,
+    const Visitor& visitor,
+    const std::string& root_folder,
+    Azure::Storage::Blobs::BlobContainerClient& container_client) {
+    if (!range.start_ && !range.end_) {
+        do_iterate_type_impl(key_type, visitor, root_folder, container_client, FlatBucketizer{});
+        return;
+    }
+
+    util::check(range.start_ && range.end_ && range.start_->size() >= tokenized_id_offset, "Invalid Azure key range");
+    const auto key_type_dir = key_type_folder(root_folder, key_type);
+    const auto descriptor = range.start_->substr(0, tokenized_id_offset);
+    auto list_prefix = [&] (const std::string& blob_prefix, const std::optional<std::string>& end) {
+        do_iterate_type_impl(key_type, visitor, root_folder, container_client, FlatBucketizer{},
+            [&blob_prefix] (const std::string&, const std::string&, const KeyDescriptor&, KeyType) { return blob_prefix; },
+            std::string{}, end);
+    };
+
+    if (range.start_->size() == tokenized_id_offset) {
+        list_prefix(fmt::format("{}/{}", key_type_dir, descriptor), fmt::format("{}/{}", key_type_dir, *range.end_));
+        return;
+    }
+
+    const auto first = static_cast<uint8_t>(range.start_->back());
+    const auto end = *range.end_ == next_prefix(descriptor) ? 0x100u : static_cast<unsigned>(static_cast<uint8_t>(range.end_->back()));
+    for (auto c = static_cast<unsigned>(first); c < end; ++c) {
+        // Past ASCII, only UTF-8 lead bytes can start a stream id
+        if (c > last_printable + 1 && (c < 0xC2 || c > 0xF4))
+            continue;
+
+        list_prefix(fmt::format("{}/{}{}", key_type_dir, descriptor, static_cast<char>(c)), std::nullopt);
+    }
+}
+
 template<class KeyBucketizer>
 bool do_key_exists_impl(
     const VariantKey& key,
@@ -318,6 +421,22 @@ void AzureStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& v
     detail::do_iterate_type_impl(key_type, std::move(visitor), root_folder_, container_client_, FlatBucketizer{}, std::move(prefix_handler), prefix);
 }
 
+void AzureStorage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix) {
+    auto prefix_handler = [] (const std::string& prefix, const std::string& key_type_dir, const KeyDescriptor key_descriptor, KeyType) {
+        return !prefix.empty() ? fmt::format("{}/{}*{}", key_type_dir, key_descriptor, prefix) : key_type_dir;
+    };
+
+    detail::do_iterate_type_impl(key_type, visitor, root_folder_, container_client_, FlatBucketizer{}, std::move(prefix_handler), prefix);
+}
+
+std::vector<KeyRange> AzureStorage::do_key_ranges(KeyType key_type, size_t max_ranges) {
+    return detail::do_key_ranges_impl(key_type, max_ranges, root_folder_, container_client_);
+}
+
+void AzureStorage::do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+    detail::do_iterate_type_in_range_impl(key_type, range, visitor, root_folder_, container_client_);
+}
+
 bool AzureStorage::do_key_exists(const VariantKey& key) {
     return detail::do_key_exists_impl(key, root_folder_, container_client_, FlatBucketizer{});
 }
@@ -13,6 +13,9 @@
 #include <arcticdb/util/preconditions.hpp>
 #include <arcticdb/util/variant.hpp>
 #include <folly/Function.h>
+#include <folly/hash/Hash.h>
+
+#include <limits>
 
 namespace arcticdb {
 
@@ -84,6 +87,40 @@ static inline FailureAction fault(double probability = 1.0) {
 }
 }
 
+/**
+ * Fails a given fraction of operations, choosing which from a seed and an identifier for each operation rather than
+ * from a random number, so that the same operations fail on every run however the threads are scheduled.
+ */
+class DeterministicFaults {
+public:
+    DeterministicFaults(double probability, uint64_t seed) :
+            probability_(probability),
+            seed_(seed) {
+        util::check_arg(probability >= 0, "Bad probability: {}", probability);
+    }
+
+    [[nodiscard]] bool enabled() const {
+        return probability_ > 0.0;
+    }
+
+    [[nodiscard]] bool should_fail(uint64_t operation_id) const {
+        if (!enabled())
+            return false;
+
+        const uint64_t mixed = folly::hash::twang_mix64(operation_id ^ seed_);
+        return static_cast<double>(mixed) / static_cast<double>(std::numeric_limits<uint64_t>::max()) < probability_;
+    }
+
+    void go(FailureType failure_type, uint64_t operation_id) const {
+        if (should_fail(operation_id))
+            throw StorageException(fmt::format("Simulating {} storage failure", failure_names[int(failure_type)]));
+    }
+
+private:
+    double probability_;
+    uint64_t seed_;
+};
+
 /** Independent state for each FailureType. Thread-safe except for the c'tors. */
 class FailureTypeState {
 public:
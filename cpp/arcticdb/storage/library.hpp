@@ -15,6 +15,8 @@
 #include <arcticdb/storage/storage_exceptions.hpp>
 #include <arcticdb/storage/open_mode.hpp>
 #include <arcticdb/storage/storages.hpp>
+#include <arcticdb/storage/shared_segment_cache.hpp>
+#include <arcticdb/async/index_segment_cache.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/util/composite.hpp>
 
@@ -39,7 +41,8 @@ class Library {
         LibraryDescriptor::VariantStoreConfig cfg) :
             library_path_(std::move(path)),
             storages_(std::move(storages)),
-            config_(std::move(cfg)){
+            config_(std::move(cfg)),
+            cache_id_(fmt::format("{}@{}", library_path_.to_delim_path(), storages_->instance_id())) {
         ARCTICDB_DEBUG(log::storage(), fmt::format("Opened library {}", library_path()));
         util::variant_match(config_,
                             [that = this](const arcticdb::proto::storage::VersionStoreConfig &version_config) {
@@ -67,6 +70,28 @@ class Library {
         storages_->iterate_type(key_type, visitor, prefix);
     }
 
+    /**
+     * Splits a key type into up to max_ranges ranges that can be passed to iterate_type_in_range concurrently. Returns
+     * a single open range if the storage cannot list part of a key type.
+     */
+    std::vector<KeyRange> key_ranges(KeyType key_type, size_t max_ranges) {
+        return storages_->key_ranges(key_type, max_ranges);
+    }
+
+    void iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+        ARCTICDB_SAMPLE(LibraryIterateInRange, 0)
+        storages_->iterate_type_in_range(key_type, range, visitor);
+    }
+
+    /**
+     * As iterate_type, but also passes each object's stored size in bytes, taken from listing metadata where the
+     * backend has it.
+     */
+    void iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix=std::string{}) {
+        ARCTICDB_SAMPLE(LibraryIterateWithSize, 0)
+        storages_->iterate_type_with_size(key_type, visitor, prefix);
+    }
+
     void write(Composite<KeySegmentPair>&& kvs) {
         ARCTICDB_SAMPLE(LibraryWrite, 0)
         if (open_mode() < OpenMode::WRITE)
@@ -99,6 +124,18 @@ class Library {
             throw PermissionException(library_path_, open_mode(), "delete");
 
         ARCTICDB_SAMPLE(LibraryRemove, 0)
+        if(auto cache = SharedSegmentCache::instance()) {
+            ks.broadcast([this, &cache](const VariantKey& key) {
+                if(SharedSegmentCache::is_cacheable(key))
+                    cache->remove(name(), to_atom(key));
+            });
+        }
+        if(auto index_cache = async::IndexSegmentCache::instance()) {
+            ks.broadcast([this, &index_cache](const VariantKey& key) {
+                if(async::IndexSegmentCache::is_cacheable(key))
+                    index_cache->remove(cache_id_, to_atom(key));
+            });
+        }
         storages_->remove(std::move(ks), opts);
     }
 
@@ -113,12 +150,22 @@ class Library {
     KeySegmentPair read(VariantKey key, ReadKeyOpts opts = ReadKeyOpts{}) {
         KeySegmentPair res{VariantKey{key}};
         util::check(!std::holds_alternative<StringId>(variant_key_id(key)) || !std::get<StringId>(variant_key_id(key)).empty(), "Unexpected empty id");
+        auto cache = SharedSegmentCache::is_cacheable(key) ? SharedSegmentCache::instance() : nullptr;
+        if(cache) {
+            if(auto segment = cache->get(name(), to_atom(key))) {
+                res.segment() = std::move(*segment);
+                return res;
+            }
+        }
         const ReadVisitor& visitor = [&res](const VariantKey&, Segment&& value) {
             res.segment() = std::move(value);
         };
 
         read(Composite<VariantKey>(std::move(key)), visitor, opts);
 
+        if(cache && res.has_segment())
+            cache->put(name(), to_atom(res.variant_key()), res.segment());
+
         return res;
     }
 
@@ -147,10 +194,16 @@ class Library {
         return library_path_.to_delim_path();
     }
 
+    /** The library name qualified by its storages' identity, for caches of decoded keys within the process */
+    const std::string& cache_id() const {
+        return cache_id_;
+    }
+
   private:
     LibraryPath library_path_;
     std::shared_ptr<Storages> storages_;
     LibraryDescriptor::VariantStoreConfig config_;
+    std::string cache_id_;
     bool storage_fallthrough_ = false;
 };
 
@@ -229,6 +229,10 @@ bool LmdbStorage::do_fast_delete() {
 }
 
 void LmdbStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string &prefix) {
+    do_iterate_type_with_size(key_type, [&visitor] (VariantKey&& k, size_t) { visitor(std::move(k)); }, prefix);
+}
+
+void LmdbStorage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix) {
     ARCTICDB_SAMPLE(LmdbStorageItType, 0);
     auto txn = ::lmdb::txn::begin(env(), nullptr, MDB_RDONLY); // scoped abort on
     std::string type_db = fmt::format("{}", key_type);
@@ -237,9 +241,11 @@ void LmdbStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& vi
     ARCTICDB_SUBSAMPLE(LmdbStorageOpenCursor, 0)
     auto db_cursor = ::lmdb::cursor::open(txn, dbi);
 
+    // Values are memory mapped, so getting one only reads its length from the page header rather than its contents
     MDB_val mdb_db_key;
+    MDB_val mdb_db_value;
     ARCTICDB_SUBSAMPLE(LmdbStorageCursorFirst, 0)
-    if (!db_cursor.get(&mdb_db_key, nullptr, MDB_cursor_op::MDB_FIRST)) {
+    if (!db_cursor.get(&mdb_db_key, &mdb_db_value, MDB_cursor_op::MDB_FIRST)) {
         return;
     }
     auto prefix_matcher = stream_id_prefix_matcher(prefix);
@@ -252,12 +258,54 @@ void LmdbStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& vi
         ARCTICDB_DEBUG(log::storage(), "Iterating key {}: {}", variant_key_type(k), variant_key_view(k));
         if (prefix_matcher(variant_key_id(k))) {
             ARCTICDB_SUBSAMPLE(LmdbStorageVisitKey, 0)
-            visitor(std::move(k));
+            visitor(std::move(k), mdb_db_value.mv_size);
         }
         ARCTICDB_SUBSAMPLE(LmdbStorageCursorNext, 0)
-    } while (db_cursor.get(&mdb_db_key, nullptr, MDB_cursor_op::MDB_NEXT));
+    } while (db_cursor.get(&mdb_db_key, &mdb_db_value, MDB_cursor_op::MDB_NEXT));
 }
 
+std::vector<KeyRange> LmdbStorage::do_key_ranges(KeyType key_type, size_t max_ranges) {
+    auto txn = ::lmdb::txn::begin(env(), nullptr, MDB_RDONLY);
+    ::lmdb::dbi& dbi = dbi_by_key_type_.at(fmt::format("{}", key_type));
+    auto db_cursor = ::lmdb::cursor::open(txn, dbi);
+
+    MDB_val first_key;
+    MDB_val last_key;
+    if (!db_cursor.get(&first_key, nullptr, MDB_cursor_op::MDB_FIRST) || !db_cursor.get(&last_key, nullptr, MDB_cursor_op::MDB_LAST))
+        return {KeyRange{}};
+
+    return split_key_range(
+        std::string_view{static_cast<const char*>(first_key.mv_data), first_key.mv_size},
+        std::string_view{static_cast<const char*>(last_key.mv_data), last_key.mv_size},
+        max_ranges);
+}
+
+void LmdbStorage::do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+    ARCTICDB_SAMPLE(LmdbStorageItTypeRange, 0);
+    // Each range is listed from its own thread, and LMDB read transactions belong to the thread that began them
+    auto txn = ::lmdb::txn::begin(env(), nullptr, MDB_RDONLY);
+    ::lmdb::dbi& dbi = dbi_by_key_type_.at(fmt::format("{}", key_type));
+    auto db_cursor = ::lmdb::cursor::open(txn, dbi);
+
+    MDB_val mdb_db_key;
+    bool found;
+    if (range.start_) {
+        mdb_db_key.mv_data = const_cast<char*>(range.start_->data());
+        mdb_db_key.mv_size = range.start_->size();
+        found = db_cursor.get(&mdb_db_key, nullptr, MDB_cursor_op::MDB_SET_RANGE);
+    } else {
+        found = db_cursor.get(&mdb_db_key, nullptr, MDB_cursor_op::MDB_FIRST);
+    }
+
+    while (found) {
+        const std::string_view stored_key{static_cast<const char*>(mdb_db_key.mv_data), mdb_db_key.mv_size};
+        if (!in_key_range(stored_key, range))
+            break;
+
+        visitor(variant_key_from_bytes(static_cast<uint8_t *>(mdb_db_key.mv_data), mdb_db_key.mv_size, key_type));
+        found = db_cursor.get(&mdb_db_key, nullptr, MDB_cursor_op::MDB_NEXT);
+    }
+}
 
 namespace {
 template<class T>
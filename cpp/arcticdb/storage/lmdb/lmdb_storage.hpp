@@ -54,6 +54,12 @@ class LmdbStorage final : public Storage {
 
     void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string &prefix) final;
 
+    void do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix) final;
+
+    std::vector<KeyRange> do_key_ranges(KeyType key_type, size_t max_ranges) final;
+
+    void do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) final;
+
     bool do_key_exists(const VariantKey & key) final;
 
     ::lmdb::env& env() { return *env_;  }
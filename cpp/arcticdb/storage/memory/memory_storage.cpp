@@ -137,6 +137,20 @@ namespace arcticdb::storage::memory {
         }
     }
 
+    void MemoryStorage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string& prefix) {
+        ARCTICDB_SAMPLE(MemoryStorageItTypeWithSize, 0)
+        auto& key_vec = data_[key_type];
+        auto prefix_matcher = stream_id_prefix_matcher(prefix);
+
+        for(auto& key_value : key_vec) {
+            auto key = key_value.first;
+
+            if (prefix_matcher(variant_key_id(key))) {
+                visitor(std::move(key), key_value.second.total_segment_size());
+            }
+        }
+    }
+
     MemoryStorage::MemoryStorage(const LibraryPath &library_path, OpenMode mode, const Config&) :
         Storage(library_path, mode) {
         arcticdb::entity::foreach_key_type([this](KeyType&& key_type) {
@@ -42,6 +42,8 @@ namespace arcticdb::storage::memory {
 
         void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string & prefix) final;
 
+        void do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string & prefix) final;
+
         std::string do_key_path(const VariantKey&) const final { return {}; };
 
         using KeyMap = folly::ConcurrentHashMap<VariantKey, Segment>;
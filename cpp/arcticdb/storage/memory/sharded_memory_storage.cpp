@@ -0,0 +1,225 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/storage/memory/sharded_memory_storage.hpp>
+
+#include <arcticdb/util/preconditions.hpp>
+#include <arcticdb/util/hash.hpp>
+#include <arcticdb/entity/performance_tracing.hpp>
+#include <arcticdb/storage/storage_options.hpp>
+#include <arcticdb/storage/storage_utils.hpp>
+
+#include <folly/hash/Hash.h>
+
+#include <thread>
+
+namespace arcticdb::storage::memory {
+
+namespace {
+
+constexpr uint32_t DefaultNumShards = 16;
+// Keeps the straggler draws independent of the fault draws
+constexpr uint64_t StragglerSeed = 0x5354524147474c45;
+
+uint64_t key_hash(const VariantKey& key) {
+    return arcticdb::hash(std::string_view{fmt::format("{}", key)});
+}
+
+} // namespace
+
+ShardedMemoryStorage::OperationProfile::OperationProfile(const Config::OperationProfile& conf, FailureType failure_type, uint64_t seed) :
+    failure_type_(failure_type),
+    latency_(conf.latency_us()),
+    jitter_us_(conf.jitter_us()),
+    bytes_per_second_(conf.bytes_per_second()),
+    faults_(conf.failure_prob(), seed ^ static_cast<uint64_t>(failure_type)),
+    stragglers_(conf.straggler_prob(), seed ^ StragglerSeed ^ static_cast<uint64_t>(failure_type)),
+    straggler_latency_(conf.straggler_us()) {
+}
+
+ShardedMemoryStorage::ShardedMemoryStorage(const LibraryPath &library_path, OpenMode mode, const Config& conf) :
+    Storage(library_path, mode),
+    seed_(conf.seed()),
+    read_(conf.read(), FailureType::READ, conf.seed()),
+    write_(conf.write(), FailureType::WRITE, conf.seed()),
+    remove_(conf.remove(), FailureType::DELETE, conf.seed()),
+    list_(conf.list(), FailureType::ITERATE, conf.seed()) {
+    const auto num_shards = conf.num_shards() == 0 ? DefaultNumShards : conf.num_shards();
+    for(auto i = 0u; i < num_shards; ++i)
+        attempts_.emplace_back(std::make_unique<AttemptShard>());
+
+    arcticdb::entity::foreach_key_type([this, num_shards](KeyType&& key_type) {
+        auto& shards = data_[key_type];
+        for(auto i = 0u; i < num_shards; ++i)
+            shards.emplace_back(std::make_unique<Shard>());
+    });
+}
+
+ShardedMemoryStorage::Shard& ShardedMemoryStorage::shard(const VariantKey& key) {
+    auto& shards = data_[variant_key_type(key)];
+    return *shards[std::hash<VariantKey>{}(key) % shards.size()];
+}
+
+void ShardedMemoryStorage::wait(const OperationProfile& profile, uint64_t hash, size_t bytes) const {
+    auto delay = profile.latency_;
+    if(profile.jitter_us_ > 0)
+        delay += std::chrono::microseconds{folly::hash::twang_mix64(hash ^ seed_) % profile.jitter_us_};
+
+    if(profile.bytes_per_second_ > 0)
+        delay += std::chrono::microseconds{bytes * 1'000'000 / profile.bytes_per_second_};
+
+    if(profile.stragglers_.enabled() && profile.stragglers_.should_fail(folly::hash::hash_128_to_64(hash, (*operations_)++)))
+        delay += profile.straggler_latency_;
+
+    if(delay.count() > 0)
+        std::this_thread::sleep_for(delay);
+}
+
+void ShardedMemoryStorage::simulate(const OperationProfile& profile, const VariantKey& key, size_t bytes) {
+    StorageFailureSimulator::instance()->go(profile.failure_type_);
+    const auto hash = profile.faults_.enabled() || profile.jitter_us_ > 0 || profile.stragglers_.enabled() ? key_hash(key) : 0;
+    if(profile.faults_.enabled())
+        inject_fault(profile, hash ^ static_cast<uint64_t>(profile.failure_type_));
+
+    wait(profile, hash, bytes);
+}
+
+void ShardedMemoryStorage::simulate(const OperationProfile& profile) {
+    StorageFailureSimulator::instance()->go(profile.failure_type_);
+    if(profile.faults_.enabled())
+        inject_fault(profile, static_cast<uint64_t>(profile.failure_type_));
+
+    wait(profile, 0, 0);
+}
+
+void ShardedMemoryStorage::inject_fault(const OperationProfile& profile, uint64_t operation_key) {
+    auto& attempts = *attempts_[operation_key % attempts_.size()];
+    const auto it = attempts.find(operation_key);
+    const auto attempt = it == attempts.cend() ? 0 : it->second;
+    const auto operation_id = folly::hash::hash_128_to_64(operation_key, attempt);
+    if(profile.faults_.should_fail(operation_id))
+        attempts.insert_or_assign(operation_key, attempt + 1);
+    else if(attempt > 0)
+        attempts.erase(operation_key);
+
+    profile.faults_.go(profile.failure_type_, operation_id);
+}
+
+void ShardedMemoryStorage::do_write(Composite<KeySegmentPair>&& kvs) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageWrite, 0)
+    kvs.broadcast([this] (auto& kv) {
+        auto& segment = kv.segment();
+        const auto hdr_size = segment.segment_header_bytes_size();
+        auto bytes = std::make_shared<std::vector<uint8_t>>(segment.total_segment_size(hdr_size));
+        segment.write_to(bytes->data(), hdr_size);
+        simulate(write_, kv.variant_key(), bytes->size());
+
+        auto& key_map = shard(kv.variant_key());
+        util::variant_match(kv.variant_key(),
+            [&](const RefKey&) {
+                key_map.insert_or_assign(kv.variant_key(), std::move(bytes));
+            },
+            [&](const AtomKey& key) {
+                if (!key_map.insert(kv.variant_key(), std::move(bytes)).second)
+                    throw DuplicateKeyException(key);
+            }
+        );
+    });
+}
+
+void ShardedMemoryStorage::do_update(Composite<KeySegmentPair>&& kvs, UpdateOpts opts) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageUpdate, 0)
+    kvs.broadcast([this, opts] (auto& kv) {
+        auto& segment = kv.segment();
+        const auto hdr_size = segment.segment_header_bytes_size();
+        auto bytes = std::make_shared<std::vector<uint8_t>>(segment.total_segment_size(hdr_size));
+        segment.write_to(bytes->data(), hdr_size);
+        simulate(write_, kv.variant_key(), bytes->size());
+
+        auto& key_map = shard(kv.variant_key());
+        if(opts.upsert_)
+            key_map.insert_or_assign(kv.variant_key(), std::move(bytes));
+        else
+            util::check_rte(static_cast<bool>(key_map.assign(kv.variant_key(), std::move(bytes))),
+                            "update called with upsert=false but key does not exist");
+    });
+}
+
+void ShardedMemoryStorage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visitor, ReadKeyOpts) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageRead, 0)
+    std::vector<VariantKey> failed_reads;
+    ks.broadcast([&] (auto& k) {
+        auto& key_map = shard(k);
+        auto it = key_map.find(k);
+        if(it == key_map.end()) {
+            simulate(read_, k, 0);
+            failed_reads.push_back(k);
+            return;
+        }
+
+        auto bytes = it->second;
+        simulate(read_, k, bytes->size());
+        ARCTICDB_DEBUG(log::storage(), "Read key {}: {}", variant_key_type(k), variant_key_view(k));
+        // The segment views the stored bytes, which are never modified, only replaced
+        visitor(k, Segment::from_shared_bytes(bytes->data(), bytes->size(), bytes));
+    });
+
+    if(!failed_reads.empty())
+        throw KeyNotFoundException(Composite<VariantKey>{std::move(failed_reads)});
+}
+
+bool ShardedMemoryStorage::do_key_exists(const VariantKey& key) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageKeyExists, 0)
+    simulate(read_, key, 0);
+    auto& key_map = shard(key);
+    return key_map.find(key) != key_map.end();
+}
+
+void ShardedMemoryStorage::do_remove(Composite<VariantKey>&& ks, RemoveOpts opts) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageRemove, 0)
+    ks.broadcast([&] (auto& k) {
+        simulate(remove_, k, 0);
+        if(shard(k).erase(k) == 0 && !opts.ignores_missing_key_)
+            util::raise_rte("Failed to find segment for key {}", variant_key_view(k));
+    });
+}
+
+bool ShardedMemoryStorage::do_fast_delete() {
+    foreach_key_type([&] (KeyType key_type) {
+        for(auto& key_map : data_[key_type])
+            key_map->clear();
+    });
+    return true;
+}
+
+void ShardedMemoryStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string& prefix) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageItType, 0)
+    simulate(list_);
+    auto prefix_matcher = stream_id_prefix_matcher(prefix);
+    for(auto& key_map : data_[key_type]) {
+        for(auto& key_value : *key_map) {
+            auto key = key_value.first;
+            if (prefix_matcher(variant_key_id(key)))
+                visitor(std::move(key));
+        }
+    }
+}
+
+void ShardedMemoryStorage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string& prefix) {
+    ARCTICDB_SAMPLE(ShardedMemoryStorageItTypeWithSize, 0)
+    simulate(list_);
+    auto prefix_matcher = stream_id_prefix_matcher(prefix);
+    for(auto& key_map : data_[key_type]) {
+        for(auto& key_value : *key_map) {
+            auto key = key_value.first;
+            if (prefix_matcher(variant_key_id(key)))
+                visitor(std::move(key), key_value.second->size());
+        }
+    }
+}
+
+} // namespace arcticdb::storage::memory
@@ -0,0 +1,106 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/storage/storage.hpp>
+#include <arcticdb/storage/failure_simulation.hpp>
+#include <arcticdb/entity/protobufs.hpp>
+#include <arcticdb/util/composite.hpp>
+#include <arcticdb/storage/key_segment_pair.hpp>
+#include <arcticdb/util/pb_util.hpp>
+
+#include <folly/concurrency/ConcurrentHashMap.h>
+
+#include <atomic>
+#include <chrono>
+
+namespace arcticdb::storage::memory {
+
+/*
+ * In-memory storage that behaves like a remote store, for benchmarking pipeline concurrency and tail latency
+ * reproducibly. Segments are kept as their encoded bytes, written once and then shared with every reader rather than
+ * copied on each read, in lock-free maps sharded by key. Each type of operation can be given a latency, a
+ * deterministic per-key jitter, a bandwidth limit, a rate of slow stragglers and a deterministic failure rate, on top
+ * of anything configured in the StorageFailureSimulator.
+ */
+class ShardedMemoryStorage final : public Storage {
+public:
+    using Config = arcticdb::proto::memory_storage::ShardedConfig;
+
+    ShardedMemoryStorage(const LibraryPath &lib, OpenMode mode, const Config &conf);
+
+private:
+    void do_write(Composite<KeySegmentPair>&& kvs) final;
+
+    void do_update(Composite<KeySegmentPair>&& kvs, UpdateOpts opts) final;
+
+    void do_read(Composite<VariantKey>&& ks, const ReadVisitor& visitor, ReadKeyOpts opts) final;
+
+    void do_remove(Composite<VariantKey>&& ks, RemoveOpts opts) final;
+
+    bool do_key_exists(const VariantKey& key) final;
+
+    bool do_supports_prefix_matching() const final {
+        return false;
+    }
+
+    bool do_fast_delete() final;
+
+    void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string & prefix) final;
+
+    void do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string & prefix) final;
+
+    std::string do_key_path(const VariantKey&) const final { return {}; };
+
+    struct OperationProfile {
+        OperationProfile(const Config::OperationProfile& conf, FailureType failure_type, uint64_t seed);
+
+        FailureType failure_type_;
+        std::chrono::microseconds latency_;
+        uint64_t jitter_us_;
+        uint64_t bytes_per_second_;
+        DeterministicFaults faults_;
+        DeterministicFaults stragglers_;
+        std::chrono::microseconds straggler_latency_;
+    };
+
+    using Bytes = std::shared_ptr<const std::vector<uint8_t>>;
+    using Shard = folly::ConcurrentHashMap<VariantKey, Bytes>;
+    // Failed attempts at an operation on a key since it last succeeded, so that a retry is a different operation to
+    // the fault injection. Entries are dropped on success, so only operations that are being retried are held.
+    using AttemptShard = folly::ConcurrentHashMap<uint64_t, uint64_t>;
+
+    Shard& shard(const VariantKey& key);
+
+    void simulate(const OperationProfile& profile, const VariantKey& key, size_t bytes);
+
+    void simulate(const OperationProfile& profile);
+
+    void inject_fault(const OperationProfile& profile, uint64_t operation_key);
+
+    void wait(const OperationProfile& profile, uint64_t key_hash, size_t bytes) const;
+
+    uint64_t seed_;
+    OperationProfile read_;
+    OperationProfile write_;
+    OperationProfile remove_;
+    OperationProfile list_;
+    std::vector<std::unique_ptr<AttemptShard>> attempts_;
+    // Operations started, which pick the stragglers. Held by pointer so that the storage stays movable
+    std::unique_ptr<std::atomic<uint64_t>> operations_ = std::make_unique<std::atomic<uint64_t>>(0);
+    // Pre-populated for every key type, so that concurrent access is fine
+    std::unordered_map<KeyType, std::vector<std::unique_ptr<Shard>>> data_;
+};
+
+inline arcticdb::proto::storage::VariantStorage pack_sharded_config(const ShardedMemoryStorage::Config& cfg = {}) {
+    arcticdb::proto::storage::VariantStorage output;
+    util::pack_to_any(cfg, *output.mutable_config());
+    return output;
+}
+
+} // namespace arcticdb::storage::memory
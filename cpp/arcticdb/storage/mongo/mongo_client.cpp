@@ -20,9 +20,18 @@
 #include <arcticdb/util/key_utils.hpp>
 #include <arcticdb/util/exponential_backoff.hpp>
 #include <mongocxx/model/replace_one.hpp>
+#include <mongocxx/model/insert_one.hpp>
+#include <mongocxx/options/bulk_write.hpp>
+#include <mongocxx/options/find.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <mongocxx/config/version.hpp>
 #include <arcticdb/util/composite.hpp>
 
+#include <unordered_map>
+
 namespace arcticdb::storage::mongo {
 
 namespace detail {
@@ -185,26 +194,26 @@ class MongoClientImpl {
         pool_(mongocxx::uri(connection_string_)){
 }
 
-    void write_segment(
+    void write_segments(
         const std::string &database_name,
         const std::string &collection_name,
-        storage::KeySegmentPair&& kv);
+        std::vector<storage::KeySegmentPair>&& kvs);
 
-    void update_segment(
+    void update_segments(
         const std::string &database_name,
         const std::string &collection_name,
-        storage::KeySegmentPair&& kv,
+        std::vector<storage::KeySegmentPair>&& kvs,
         bool upsert);
 
-    storage::KeySegmentPair read_segment(
+    std::vector<storage::KeySegmentPair> read_segments(
         const std::string &database_name,
         const std::string &collection_name,
-        const  entity::VariantKey &key);
+        const std::vector<entity::VariantKey> &keys);
 
-    void remove_keyvalue(
+    void remove_keyvalues(
         const std::string &database_name,
         const std::string &collection_name,
-        const  entity::VariantKey &key);
+        const std::vector<entity::VariantKey> &keys);
 
     void iterate_type(
         const std::string &database_name,
@@ -248,100 +257,123 @@ class MongoClientImpl {
     mongocxx::pool pool_;
 };
 
-void MongoClientImpl::write_segment(const std::string &database_name,
-                                    const std::string &collection_name,
-                                    storage::KeySegmentPair &&kv) {
+void MongoClientImpl::write_segments(const std::string &database_name,
+                                     const std::string &collection_name,
+                                     std::vector<storage::KeySegmentPair> &&kvs) {
     using namespace bsoncxx::builder::stream;
     using bsoncxx::builder::stream::document;
     ARCTICDB_SUBSAMPLE(MongoStorageWriteGetClient, 0)
     auto client = get_client();
 
-    ARCTICDB_SUBSAMPLE(MongoStorageWriteBuildDoc, 0)
-    auto doc = detail::build_document(kv);
-
     ARCTICDB_SUBSAMPLE(MongoStorageWriteGetCol, 0)
     mongocxx::database database = client->database(database_name.c_str());
     auto collection = database[collection_name];
 
-    ARCTICDB_SUBSAMPLE(MongoStorageWriteInsertOne, 0)
-    if(std::holds_alternative<RefKey>(kv.variant_key())) {
-        mongocxx::model::replace_one replace{document{} << "key" << fmt::format("{}", kv.ref_key()) << finalize, doc.view()};
-        replace.upsert(true);
-        auto bulk_write = collection.create_bulk_write();
-        bulk_write.append(replace);
-        auto result = bulk_write.execute();
-        util::check(bool(result), "Mongo error while putting key {}", kv.key_view());
-    } else {
-        auto result = collection.insert_one(doc.view());
-        util::check(bool(result), "Mongo error while putting key {}", kv.key_view());
+    // Later writes to the same ref key must win, atom keys can go in any order
+    const bool has_ref_keys = std::any_of(std::begin(kvs), std::end(kvs), [] (const auto& kv) {
+        return std::holds_alternative<RefKey>(kv.variant_key());
+    });
+    mongocxx::options::bulk_write options;
+    options.ordered(has_ref_keys);
+    auto bulk_write = collection.create_bulk_write(options);
+
+    ARCTICDB_SUBSAMPLE(MongoStorageWriteBuildDoc, 0)
+    for(auto& kv : kvs) {
+        auto doc = detail::build_document(kv);
+        if(std::holds_alternative<RefKey>(kv.variant_key())) {
+            mongocxx::model::replace_one replace{document{} << "key" << fmt::format("{}", kv.ref_key()) << finalize, std::move(doc)};
+            replace.upsert(true);
+            bulk_write.append(replace);
+        } else {
+            bulk_write.append(mongocxx::model::insert_one{std::move(doc)});
+        }
     }
+
+    ARCTICDB_SUBSAMPLE(MongoStorageWriteBulk, 0)
+    auto result = bulk_write.execute();
+    util::check(bool(result), "Mongo error while putting {} keys to {}", kvs.size(), collection_name);
 }
 
-void MongoClientImpl::update_segment(const std::string &database_name,
-                                    const std::string &collection_name,
-                                    storage::KeySegmentPair &&kv,
-                                    bool upsert) {
+void MongoClientImpl::update_segments(const std::string &database_name,
+                                      const std::string &collection_name,
+                                      std::vector<storage::KeySegmentPair> &&kvs,
+                                      bool upsert) {
     using namespace bsoncxx::builder::stream;
     using bsoncxx::builder::stream::document;
     ARCTICDB_SUBSAMPLE(MongoStorageUpdateGetClient, 0)
     auto client = get_client();
 
-    ARCTICDB_SUBSAMPLE(MongoStorageUpdateBuildDoc, 0)
-    auto doc = detail::build_document(kv);
-
     ARCTICDB_SUBSAMPLE(MongoStorageUpdateGetCol, 0)
     mongocxx::database database = client->database(database_name.c_str());
     auto collection = database[collection_name];
-
-    ARCTICDB_SUBSAMPLE(MongoStorageUpdateInsertOne, 0)
-    mongocxx::model::replace_one replace{document{} << "key" << fmt::format("{}", kv.variant_key()) << finalize, doc.view()};
-    replace.upsert(upsert);
     auto bulk_write = collection.create_bulk_write();
-    bulk_write.append(replace);
+
+    ARCTICDB_SUBSAMPLE(MongoStorageUpdateBuildDoc, 0)
+    for(auto& kv : kvs) {
+        auto doc = detail::build_document(kv);
+        mongocxx::model::replace_one replace{document{} << "key" << fmt::format("{}", kv.variant_key()) << finalize, std::move(doc)};
+        replace.upsert(upsert);
+        bulk_write.append(replace);
+    }
+
+    ARCTICDB_SUBSAMPLE(MongoStorageUpdateBulk, 0)
     auto result = bulk_write.execute();
-    util::check(bool(result), "Mongo error while updating key {}", kv.key_view());
-    util::check(upsert || result->modified_count() > 0, "update called with upsert=false but key does not exist");
+    util::check(bool(result), "Mongo error while updating {} keys in {}", kvs.size(), collection_name);
+    util::check(upsert || size_t(result->matched_count()) == kvs.size(), "update called with upsert=false but key does not exist");
 }
 
-storage::KeySegmentPair MongoClientImpl::read_segment(const std::string &database_name,
-                                                   const std::string &collection_name,
-                                                   const  entity::VariantKey &key) {
-    using namespace bsoncxx::builder::stream;
-    using bsoncxx::builder::stream::document;
+std::vector<storage::KeySegmentPair> MongoClientImpl::read_segments(const std::string &database_name,
+                                                                    const std::string &collection_name,
+                                                                    const std::vector<entity::VariantKey> &keys) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
     ARCTICDB_SUBSAMPLE(MongoStorageReadGetClient, 0)
 
     auto client = get_client();
 
     ARCTICDB_SUBSAMPLE(MongoStorageReadGetCol, 0)
-    auto database = client->database(database_name); //TODO maybe cache
+    auto database = client->database(database_name);
     auto collection = database[collection_name];
 
+    std::unordered_map<std::string, const entity::VariantKey*> keys_by_name;
+    bsoncxx::builder::basic::array names;
+    for(const auto& key : keys) {
+        auto name = fmt::format("{}", key);
+        names.append(name);
+        keys_by_name.try_emplace(std::move(name), &key);
+    }
+
+    std::vector<storage::KeySegmentPair> output;
     try {
-        ARCTICDB_SUBSAMPLE(MongoStorageReadFindOne, 0)
-        auto stream_id = variant_key_id(key);
+        ARCTICDB_SUBSAMPLE(MongoStorageReadFind, 0)
         if(StorageFailureSimulator::instance()->configured())
             StorageFailureSimulator::instance()->go(FailureType::READ);
 
-        auto result = collection.find_one(document{} << "key" << fmt::format("{}", key) << "stream_id" <<
-                                                                                                       fmt::format("{}", stream_id) << finalize);
-        if (result) {
-            const auto &doc = result->view();
-            auto size = doc["total_size"].get_int64().value;
+        for(const auto& doc : collection.find(make_document(kvp("key", make_document(kvp("$in", names.view())))))) {
+            // Ref keys can have been written more than once, only the first match is used
+            auto it = keys_by_name.find(detail::get_string_element(doc["key"]));
+            if(it == keys_by_name.end())
+                continue;
+
+            const auto& key = *it->second;
             entity::VariantKey stored_key{ detail::variant_key_from_document(doc, key) };
-            util::check(stored_key == key, "Key mismatch: {} != {}");
-            return storage::KeySegmentPair(
-                    std::move(stored_key),
-                    Segment::from_bytes(const_cast<uint8_t *>(result->view()["data"].get_binary().bytes), std::size_t(size), true)
-            );
-        } else {
-            // find_one returned nothing, if this was an exception it would fall through to the catch below.
-            throw std::runtime_error(fmt::format("Missing key in mongo: {} for symbol: {}", key, stream_id));
+            util::check(stored_key == key, "Key mismatch: {} != {}", stored_key, key);
+            auto size = doc["total_size"].get_int64().value;
+            output.emplace_back(
+                std::move(stored_key),
+                Segment::from_bytes(const_cast<uint8_t *>(doc["data"].get_binary().bytes), std::size_t(size), true));
+            keys_by_name.erase(it);
         }
     }
+    catch(const StorageException&) {
+        throw;
+    }
     catch(const std::exception& ex) {
-        log::storage().info("Segment read error: {}", ex.what());
-        throw storage::KeyNotFoundException{Composite<VariantKey>{VariantKey{key}}};
+        // Only keys absent from a complete result are missing, so a failure part way through must not report the rest
+        log::storage().error("Segment read error: {}", ex.what());
+        throw StorageException(fmt::format("Mongo error reading {} keys from {}: {}", keys.size(), collection_name, ex.what()));
     }
+    return output;
 }
 
 bool MongoClientImpl::key_exists(const std::string &database_name,
@@ -369,33 +401,30 @@ bool MongoClientImpl::key_exists(const std::string &database_name,
 }
 
 
-void MongoClientImpl::remove_keyvalue(const std::string &database_name,
-                                                 const std::string &collection_name,
-                                                 const entity::VariantKey &key) {
-    using namespace bsoncxx::builder::stream;
-    using bsoncxx::builder::stream::document;
+void MongoClientImpl::remove_keyvalues(const std::string &database_name,
+                                       const std::string &collection_name,
+                                       const std::vector<entity::VariantKey> &keys) {
+    using bsoncxx::builder::basic::kvp;
+    using bsoncxx::builder::basic::make_document;
     ARCTICDB_SUBSAMPLE(MongoStorageRemoveGetClient, 0)
 
     auto client = get_client();
-    auto database = client->database(database_name); //TODO cache
+    auto database = client->database(database_name);
     auto collection = database[collection_name];
     ARCTICDB_SUBSAMPLE(MongoStorageRemoveGetCol, 0)
-    mongocxx::stdx::optional<mongocxx::result::delete_result> result;
-    if (std::holds_alternative<RefKey>(key)) {
-        result = collection.delete_many(document{} << "key" << fmt::format("{}", key) << "stream_id" <<
-                                                   fmt::format("{}", variant_key_id(key)) << finalize);
-    } else {
-        result = collection.delete_one(document{} << "key" << fmt::format("{}", key) << "stream_id" <<
-                                                  fmt::format("{}", variant_key_id(key)) << finalize);
-    }
-    ARCTICDB_SUBSAMPLE(MongoStorageRemoveDelOne, 0)
+    bsoncxx::builder::basic::array names;
+    for(const auto& key : keys)
+        names.append(fmt::format("{}", key));
+
+    // Ref keys can have more than one document, all of which are removed
+    auto result = collection.delete_many(make_document(kvp("key", make_document(kvp("$in", names.view())))));
+    ARCTICDB_SUBSAMPLE(MongoStorageRemoveDelMany, 0)
     if (result) {
-        std::int32_t deleted_count = result->deleted_count();
-        util::warn(deleted_count == 1, "Expect to delete a single document with key {}",
-                   key); // possible values are 0 and 1 here when returned from delete_one
+        auto deleted_count = size_t(result->deleted_count());
+        util::warn(deleted_count >= keys.size(), "Expected to delete at least {} documents from {}, deleted {}",
+                   keys.size(), collection_name, deleted_count);
     } else
-        throw std::runtime_error(fmt::format("Mongo error deleting data for key {}", key));
-
+        throw std::runtime_error(fmt::format("Mongo error deleting {} keys from {}", keys.size(), collection_name));
 }
 
 void MongoClientImpl::iterate_type(const std::string &database_name,
@@ -412,9 +441,14 @@ void MongoClientImpl::iterate_type(const std::string &database_name,
     auto collection = client->database(database_name)[collection_name];
     ARCTICDB_SUBSAMPLE(MongoStorageItTypeFindAll, 0)
     bool has_prefix = prefix.has_value() && (!prefix.value().empty());
+    // Only the key fields are needed, and the cursor streams them in batches rather than holding every document
+    static const auto batch_size = ConfigsMap::instance()->get_int("MongoClient.CursorBatchSize", 1000);
+    mongocxx::options::find options;
+    options.projection(document{} << "data" << 0 << finalize);
+    options.batch_size(static_cast<int32_t>(batch_size));
     auto cursor =  has_prefix ?
-            collection.find(document{} << "stream_id" << prefix.value() << finalize):
-            collection.find({});
+            collection.find(document{} << "stream_id" << prefix.value() << finalize, options):
+            collection.find({}, options);
 
     for (auto &doc : cursor) {
         if(!is_ref_key_class(key_type)) {
@@ -468,29 +502,29 @@ MongoClient::~MongoClient() {
     delete client_;
 }
 
-void MongoClient::write_segment(const std::string &database_name,
+void MongoClient::write_segments(const std::string &database_name,
                                  const std::string &collection_name,
-                                 storage::KeySegmentPair &&kv) {
-    client_->write_segment(database_name, collection_name, std::move(kv));
+                                 std::vector<storage::KeySegmentPair> &&kvs) {
+    client_->write_segments(database_name, collection_name, std::move(kvs));
 }
 
-void MongoClient::update_segment(const std::string &database_name,
-                                const std::string &collection_name,
-                                storage::KeySegmentPair &&kv,
-                                bool upsert) {
-    client_->update_segment(database_name, collection_name, std::move(kv), upsert);
+void MongoClient::update_segments(const std::string &database_name,
+                                  const std::string &collection_name,
+                                  std::vector<storage::KeySegmentPair> &&kvs,
+                                  bool upsert) {
+    client_->update_segments(database_name, collection_name, std::move(kvs), upsert);
 }
 
-storage::KeySegmentPair MongoClient::read_segment(const std::string &database_name,
-                                             const std::string &collection_name,
-                                             const entity::VariantKey &key) {
-    return client_->read_segment(database_name, collection_name, key);
+std::vector<storage::KeySegmentPair> MongoClient::read_segments(const std::string &database_name,
+                                                                const std::string &collection_name,
+                                                                const std::vector<entity::VariantKey> &keys) {
+    return client_->read_segments(database_name, collection_name, keys);
 }
 
-void MongoClient::remove_keyvalue(const std::string &database_name,
-                                  const std::string &collection_name,
-                                  const entity::VariantKey &key) {
-    client_->remove_keyvalue(database_name, collection_name, key);
+void MongoClient::remove_keyvalues(const std::string &database_name,
+                                   const std::string &collection_name,
+                                   const std::vector<entity::VariantKey> &keys) {
+    client_->remove_keyvalues(database_name, collection_name, keys);
 }
 
 void MongoClient::iterate_type(const std::string &database_name,
@@ -0,0 +1,73 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/storage/storage.hpp>
+#include <arcticdb/entity/variant_key.hpp>
+
+#include <folly/Function.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arcticdb::storage::mongo {
+
+/*
+ * The operations MongoStorage needs from a Mongo client, so that tests can substitute a fake for a real server.
+ */
+class MongoClientWrapper {
+  public:
+    virtual ~MongoClientWrapper() = default;
+
+    // Each call is a single round trip, other than where the driver splits very large batches
+    virtual void write_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        std::vector<storage::KeySegmentPair>&& kvs) = 0;
+
+    virtual void update_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        std::vector<storage::KeySegmentPair>&& kvs,
+        bool upsert) = 0;
+
+    // Keys that are not found are left out of the result, any other failure throws
+    virtual std::vector<storage::KeySegmentPair> read_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const std::vector<entity::VariantKey> &keys) = 0;
+
+    virtual void remove_keyvalues(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const std::vector<entity::VariantKey> &keys) = 0;
+
+    virtual void iterate_type(
+        const std::string &database_name,
+        const std::string &collection_name,
+        KeyType key_type,
+        folly::Function<void(entity::VariantKey &&)>&& visitor,
+        const std::optional<std::string> &prefix) = 0;
+
+    virtual void ensure_collection(
+        std::string_view database_name,
+        std::string_view collection_name) = 0;
+
+    virtual void drop_collection(
+        std::string database_name,
+        std::string collection_name) = 0;
+
+    virtual bool key_exists(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const entity::VariantKey &key) = 0;
+};
+
+} // namespace arcticdb::storage::mongo
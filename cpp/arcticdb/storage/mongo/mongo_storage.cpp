@@ -20,12 +20,28 @@
 #include <arcticdb/storage/storage_options.hpp>
 #include <arcticdb/storage/storage.hpp>
 
+#include <unordered_set>
+
 namespace arcticdb::storage::mongo {
 
 std::string MongoStorage::collection_name(KeyType k) {
     return (fmt::format("{}{}", prefix_, k));
 }
 
+namespace {
+
+// Splits a key type's group into batches that each go to Mongo in a single round trip
+template<typename T, typename F>
+void for_each_batch(std::vector<T>&& items, F&& f) {
+    const auto batch_size = std::max<int64_t>(ConfigsMap::instance()->get_int("MongoClient.BatchSize", 1000), 1);
+    for(size_t start = 0; start < items.size(); start += batch_size) {
+        const auto end = std::min(items.size(), start + size_t(batch_size));
+        f(std::vector<T>{std::make_move_iterator(items.begin() + start), std::make_move_iterator(items.begin() + end)});
+    }
+}
+
+} // namespace
+
 void MongoStorage::do_write(Composite<KeySegmentPair>&& kvs) {
     namespace fg = folly::gen;
     auto fmt_db = [](auto &&kv) { return kv.key_type(); };
@@ -33,10 +49,10 @@ void MongoStorage::do_write(Composite<KeySegmentPair>&& kvs) {
     ARCTICDB_SAMPLE(MongoStorageWrite, 0)
 
     (fg::from(kvs.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach([&](auto &&group) {
-        for (auto &kv : group.values()) {
-            auto collection = collection_name(kv.key_type());
-            client_->write_segment(db_, collection, std::move(kv));
-        }
+        auto collection = collection_name(group.key());
+        for_each_batch(std::move(group.values()), [&] (std::vector<KeySegmentPair>&& batch) {
+            client_->write_segments(db_, collection, std::move(batch));
+        });
     });
 }
 
@@ -47,10 +63,10 @@ void MongoStorage::do_update(Composite<KeySegmentPair>&& kvs, UpdateOpts opts) {
     ARCTICDB_SAMPLE(MongoStorageWrite, 0)
 
     (fg::from(kvs.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach([&](auto &&group) {
-        for (auto &kv : group.values()) {
-            auto collection = collection_name(kv.key_type());
-            client_->update_segment(db_, collection, std::move(kv), opts.upsert_);
-        }
+        auto collection = collection_name(group.key());
+        for_each_batch(std::move(group.values()), [&] (std::vector<KeySegmentPair>&& batch) {
+            client_->update_segments(db_, collection, std::move(batch), opts.upsert_);
+        });
     });
 }
 
@@ -61,14 +77,19 @@ void MongoStorage::do_read(Composite<VariantKey>&& ks, const ReadVisitor& visito
     std::vector<VariantKey> failed_reads;
 
     (fg::from(ks.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach([&](auto &&group) {
-        for (auto &k : group.values()) {
-                auto collection = collection_name(variant_key_type(k));
-                auto kv = client_->read_segment(db_, collection, k);
-                if(kv.has_segment())
-                    visitor(k, std::move(kv.segment()));
-                else
-                   failed_reads.push_back(k);
-        }
+        auto collection = collection_name(group.key());
+        for_each_batch(std::move(group.values()), [&] (std::vector<VariantKey>&& batch) {
+            auto kvs = client_->read_segments(db_, collection, batch);
+            std::unordered_set<VariantKey> found;
+            for(auto& kv : kvs) {
+                found.insert(kv.variant_key());
+                visitor(kv.variant_key(), std::move(kv.segment()));
+            }
+            for(auto& k : batch) {
+                if(found.find(k) == found.end())
+                    failed_reads.push_back(std::move(k));
+            }
+        });
     });
 
     if(!failed_reads.empty())
@@ -89,10 +110,10 @@ void MongoStorage::do_remove(Composite<VariantKey>&& ks, RemoveOpts) {
     ARCTICDB_SAMPLE(MongoStorageRemove, 0)
 
     (fg::from(ks.as_range()) | fg::move | fg::groupBy(fmt_db)).foreach([&](auto &&group) {
-        for (auto &k : group.values()) {
-            auto collection = collection_name(variant_key_type(k));
-            client_->remove_keyvalue(db_, collection, k);
-        }
+        auto collection = collection_name(group.key());
+        for_each_batch(std::move(group.values()), [&] (std::vector<VariantKey>&& batch) {
+            client_->remove_keyvalues(db_, collection, batch);
+        });
     });
 }
 
@@ -111,19 +132,34 @@ bool MongoStorage::do_key_exists(const VariantKey& key) {
 
 using Config = arcticdb::proto::mongo_storage::Config;
 
+namespace {
+
+std::shared_ptr<MongoClientWrapper> connect(const Config& config) {
+    // The driver must be initialised before the first client is created
+    MongoInstance::instance();
+    return std::make_shared<MongoClient>(
+        config,
+        // One connection per IO thread, so that concurrent requests do not queue for a connection
+        ConfigsMap::instance()->get_int("MongoClient.MinPoolSize", ConfigsMap::instance()->get_int("VersionStore.NumIOThreads", 16)),
+        ConfigsMap::instance()->get_int("MongoClient.MaxPoolSize", 1000),
+        ConfigsMap::instance()->get_int("MongoClient.SelectionTimeoutMs", 120000));
+}
+
+} // namespace
+
 MongoStorage::MongoStorage(
     const LibraryPath &lib,
     OpenMode mode,
     const Config &config) :
+    MongoStorage(lib, mode, connect(config)) {
+}
+
+MongoStorage::MongoStorage(
+    const LibraryPath &lib,
+    OpenMode mode,
+    std::shared_ptr<MongoClientWrapper> client) :
     Storage(lib, mode),
-    instance_(MongoInstance::instance()),
-    client_(std::make_unique<MongoClient>(
-        config,
-        ConfigsMap::instance()->get_int("MongoClient.MinPoolSize", 100),
-        ConfigsMap::instance()->get_int("MongoClient.MaxPoolSize", 1000),
-        ConfigsMap::instance()->get_int("MongoClient.SelectionTimeoutMs", 120000))
-        ) {
-    instance_.reset(); //Just want to ensure singleton here, not hang onto it
+    client_(std::move(client)) {
     auto key_rg = lib.as_range();
     auto it = key_rg.begin();
     db_ = fmt::format("arcticc_{}", *it++);
@@ -9,21 +9,22 @@
 
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/storage/storage_factory.hpp>
+#include <arcticdb/storage/mongo/mongo_client_wrapper.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/util/composite.hpp>
 #include <folly/Range.h>
 
 namespace arcticdb::storage::mongo {
 
-class MongoInstance;
-class MongoClient;
-
 class MongoStorage final : public Storage {
   public:
     using Config = arcticdb::proto::mongo_storage::Config;
 
     MongoStorage(const LibraryPath &lib, OpenMode mode, const Config &conf);
 
+    // Uses the given client rather than connecting to a server, so that tests can pass a fake
+    MongoStorage(const LibraryPath &lib, OpenMode mode, std::shared_ptr<MongoClientWrapper> client);
+
   private:
     void do_write(Composite<KeySegmentPair>&& kvs) final;
 
@@ -47,8 +48,7 @@ class MongoStorage final : public Storage {
 
     std::string collection_name(KeyType k);
 
-    std::shared_ptr<MongoInstance> instance_;
-    std::shared_ptr<MongoClient> client_;
+    std::shared_ptr<MongoClientWrapper> client_;
     std::string db_;
     std::string prefix_;
 };
@@ -63,6 +63,12 @@ void register_bindings(py::module& storage, py::exception<arcticdb::ArcticExcept
         .value("SNAPSHOT_TOMBSTONE", KeyType::SNAPSHOT_TOMBSTONE)
         .value("LOG_COMPACTED", KeyType::LOG_COMPACTED)
         .value("COLUMN_STATS", KeyType::COLUMN_STATS)
+        .value("DEDUP_INDEX", KeyType::DEDUP_INDEX)
+        .value("ZSTD_DICTIONARY", KeyType::ZSTD_DICTIONARY)
+        .value("SNAPSHOT_MANIFEST", KeyType::SNAPSHOT_MANIFEST)
+        .value("DELETE_JOURNAL", KeyType::DELETE_JOURNAL)
+        .value("RECOMPRESS_JOURNAL", KeyType::RECOMPRESS_JOURNAL)
+        .value("APPEND_MANIFEST", KeyType::APPEND_MANIFEST)
         ;
 
     py::enum_<OpenMode>(storage, "OpenMode")
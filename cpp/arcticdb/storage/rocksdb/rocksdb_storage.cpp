@@ -169,6 +169,10 @@ bool RocksDBStorage::do_fast_delete() {
 }
 
 void RocksDBStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string& prefix) {
+    do_iterate_type_with_size(key_type, [&visitor] (VariantKey&& k, size_t) { visitor(std::move(k)); }, prefix);
+}
+
+void RocksDBStorage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string& prefix) {
     ARCTICDB_SAMPLE(RocksDBStorageItType, 0)
     auto prefix_matcher = stream_id_prefix_matcher(prefix);
 
@@ -181,13 +185,47 @@ void RocksDBStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor&
 
         ARCTICDB_DEBUG(log::storage(), "Iterating key {}: {}", variant_key_type(k), variant_key_view(k));
         if (prefix_matcher(variant_key_id(k))) {
-            visitor(std::move(k));
+            visitor(std::move(k), it->value().size());
         }
     }
     auto s = it->status();
     util::check(s.ok(), DEFAULT_ROCKSDB_NOT_OK_ERROR + s.ToString());
 }
 
+std::vector<KeyRange> RocksDBStorage::do_key_ranges(KeyType key_type, size_t max_ranges) {
+    auto handle = handles_by_key_type_.at(fmt::format("{}", key_type));
+    auto it = std::unique_ptr<::rocksdb::Iterator>(db_->NewIterator(::rocksdb::ReadOptions(), handle));
+    it->SeekToFirst();
+    if (!it->Valid())
+        return {KeyRange{}};
+
+    const auto first = it->key().ToString();
+    it->SeekToLast();
+    util::check(it->Valid(), DEFAULT_ROCKSDB_NOT_OK_ERROR + it->status().ToString());
+    const auto last = it->key().ToString();
+    return split_key_range(first, last, max_ranges);
+}
+
+void RocksDBStorage::do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+    ARCTICDB_SAMPLE(RocksDBStorageItTypeRange, 0)
+    auto handle = handles_by_key_type_.at(fmt::format("{}", key_type));
+    auto it = std::unique_ptr<::rocksdb::Iterator>(db_->NewIterator(::rocksdb::ReadOptions(), handle));
+    if (range.start_)
+        it->Seek(*range.start_);
+    else
+        it->SeekToFirst();
+
+    for (; it->Valid(); it->Next()) {
+        auto key_slice = it->key();
+        if (!in_key_range(std::string_view{key_slice.data(), key_slice.size()}, range))
+            break;
+
+        visitor(variant_key_from_bytes(reinterpret_cast<const uint8_t *>(key_slice.data()), key_slice.size(), key_type));
+    }
+    auto s = it->status();
+    util::check(s.ok(), DEFAULT_ROCKSDB_NOT_OK_ERROR + s.ToString());
+}
+
 std::vector<VariantKey> RocksDBStorage::do_remove_internal(Composite<VariantKey>&& ks, RemoveOpts opts) {
     auto grouper = [](auto &&k) { return variant_key_type(k); };
     std::vector<VariantKey> failed_deletes;
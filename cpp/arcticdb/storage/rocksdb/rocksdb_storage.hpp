@@ -46,6 +46,12 @@ namespace arcticdb::storage::rocksdb {
 
         void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string & prefix) final override;
 
+        void do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string & prefix) final override;
+
+        std::vector<KeyRange> do_key_ranges(KeyType key_type, size_t max_ranges) final override;
+
+        void do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) final override;
+
         // The _internal methods remove code duplication across update, write, and read methods.
         void do_write_internal(Composite<KeySegmentPair>&& kvs);
         std::vector<VariantKey> do_remove_internal(Composite<VariantKey>&& ks, RemoveOpts opts);
@@ -8,6 +8,7 @@
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <folly/gen/Base.h>
 #include <arcticdb/storage/object_store_utils.hpp>
+#include <arcticdb/storage/storage.hpp>
 #include <arcticdb/storage/storage_options.hpp>
 #include <arcticdb/storage/storage_utils.hpp>
 #include <arcticdb/entity/serialized_key.hpp>
@@ -346,7 +347,8 @@ namespace s3 {
                                   S3ClientType &s3_client,
                                   KeyBucketizer &&bucketizer,
                                   PrefixHandler &&prefix_handler = default_prefix_handler(),
-                                  const std::string &prefix = std::string{}
+                                  const std::string &prefix = std::string{},
+                                  const KeyRange &range = KeyRange{}
         ) {
             ARCTICDB_SAMPLE(S3StorageIterateType, 0)
             auto key_type_dir = key_type_folder(root_folder, key_type);
@@ -365,6 +367,11 @@ namespace s3 {
             Aws::S3::Model::ListObjectsV2Request objects_request;
             objects_request.WithBucket(bucket_name.c_str());
             objects_request.SetPrefix(key_prefix.c_str());
+            // Range bounds are relative to the key type's folder. No object is named exactly as a range boundary,
+            // since boundaries are shorter than any key, so listing after the start includes everything from it.
+            const auto range_root = key_type_dir + "/";
+            if (range.start_)
+                objects_request.SetStartAfter((range_root + *range.start_).c_str());
 
             bool more;
             do {
@@ -376,6 +383,9 @@ namespace s3 {
                     ARCTICDB_RUNTIME_DEBUG(log::storage(), "Received object list");
 
                     for (auto const &s3_object: object_list) {
+                        if (range.end_ && std::string_view{s3_object.GetKey().c_str(), s3_object.GetKey().size()} >= range_root + *range.end_)
+                            return;
+
                         auto key = s3_object.GetKey().substr(root_folder_size);
                         ARCTICDB_TRACE(log::version(), "Got object_list: {}, key: {}", s3_object.GetKey(), key);
                         auto k = variant_key_from_bytes(
@@ -386,7 +396,11 @@ namespace s3 {
                         ARCTICDB_DEBUG(log::storage(), "Iterating key {}: {}", variant_key_type(k),
                                        variant_key_view(k));
                         ARCTICDB_SUBSAMPLE(S3StorageVisitKey, 0)
-                        visitor(std::move(k));
+                        // Listings carry each object's size, so sizing visitors are served without any reads
+                        if constexpr (std::is_invocable_v<Visitor, VariantKey&&, size_t>)
+                            visitor(std::move(k), static_cast<size_t>(s3_object.GetSize()));
+                        else
+                            visitor(std::move(k));
                         ARCTICDB_SUBSAMPLE(S3StorageCursorNext, 0)
                     }
                     more = list_objects_outcome.GetResult().GetIsTruncated();
@@ -405,6 +419,33 @@ namespace s3 {
             } while (more);
         }
 
+        // Splits a key type on the first character of the stream id in its tokenized key names. Only the first key is
+        // listed, so the last range runs on from the end of the printable characters.
+        template<class S3ClientType>
+        std::vector<KeyRange> do_key_ranges_impl(KeyType key_type,
+                                                 size_t max_ranges,
+                                                 const std::string &root_folder,
+                                                 const std::string &bucket_name,
+                                                 S3ClientType &s3_client) {
+            const auto range_root = key_type_folder(root_folder, key_type) + "/";
+            Aws::S3::Model::ListObjectsV2Request objects_request;
+            objects_request.WithBucket(bucket_name.c_str());
+            objects_request.SetPrefix(range_root.c_str());
+            objects_request.SetMaxKeys(1);
+            auto list_objects_outcome = s3_client.ListObjectsV2(objects_request);
+            if (!list_objects_outcome.IsSuccess() || list_objects_outcome.GetResult().GetContents().empty())
+                return {KeyRange{}};
+
+            const auto first = std::string{list_objects_outcome.GetResult().GetContents()[0].GetKey().c_str()}.substr(range_root.size());
+            // Tokenized names start with the key descriptor, which itself starts with the '*' separator
+            auto id_start = first.find('*', 1);
+            if (id_start == std::string::npos)
+                return {KeyRange{}};
+
+            ++id_start;
+            return split_key_range(first, first.substr(0, id_start) + '~', max_ranges);
+        }
+
         template<class S3ClientType, class KeyBucketizer>
         bool do_key_exists_impl(
                 const VariantKey &key,
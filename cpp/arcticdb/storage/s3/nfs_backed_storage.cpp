@@ -149,14 +149,10 @@ void NfsBackedStorage::do_remove(Composite<VariantKey>&& ks, RemoveOpts) {
     s3::detail::do_remove_impl(std::move(enc), root_folder_, bucket_name_, s3_client_, NfsBucketizer{});
 }
 
-void NfsBackedStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string& prefix) {
-    auto func = [v = std::move(visitor), prefix=prefix] (VariantKey&& k) mutable {
-        auto key = unencode_object_id(k);
-        if(prefix.empty() || variant_key_id(key) == StreamId{prefix})
-            v(std::move(key));
-    };
+namespace {
 
-    auto prefix_handler = [] (const std::string& prefix, const std::string& key_type_dir, const KeyDescriptor&, KeyType key_type) {
+auto nfs_prefix_handler() {
+    return [] (const std::string& prefix, const std::string& key_type_dir, const KeyDescriptor&, KeyType key_type) {
         std::string new_prefix;
         if(!prefix.empty()) {
             uint32_t id = get_id_bucket(encode_item<StreamId, StringId, NumericId>(StringId{prefix}, is_ref_key_class(key_type)));
@@ -165,8 +161,28 @@ void NfsBackedStorage::do_iterate_type(KeyType key_type, const IterateTypeVisito
 
         return !prefix.empty() ? fmt::format("{}/{}", key_type_dir, new_prefix) : key_type_dir;
     };
+}
+
+} // namespace
+
+void NfsBackedStorage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string& prefix) {
+    auto func = [v = std::move(visitor), prefix=prefix] (VariantKey&& k) mutable {
+        auto key = unencode_object_id(k);
+        if(prefix.empty() || variant_key_id(key) == StreamId{prefix})
+            v(std::move(key));
+    };
+
+    s3::detail::do_iterate_type_impl(key_type, std::move(func), root_folder_, bucket_name_, s3_client_, NfsBucketizer{}, nfs_prefix_handler(), prefix);
+}
+
+void NfsBackedStorage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string& prefix) {
+    auto func = [&visitor, &prefix] (VariantKey&& k, size_t size) {
+        auto key = unencode_object_id(k);
+        if(prefix.empty() || variant_key_id(key) == StreamId{prefix})
+            visitor(std::move(key), size);
+    };
 
-    s3::detail::do_iterate_type_impl(key_type, std::move(func), root_folder_, bucket_name_, s3_client_, NfsBucketizer{}, prefix_handler, prefix);
+    s3::detail::do_iterate_type_impl(key_type, std::move(func), root_folder_, bucket_name_, s3_client_, NfsBucketizer{}, nfs_prefix_handler(), prefix);
 }
 
 bool NfsBackedStorage::do_key_exists(const VariantKey& key) {
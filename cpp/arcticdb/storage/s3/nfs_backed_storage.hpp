@@ -44,6 +44,8 @@ private:
 
     void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string &prefix) final;
 
+    void do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix) final;
+
     bool do_key_exists(const VariantKey& key) final;
 
     bool do_supports_prefix_matching() const final {
@@ -85,6 +85,22 @@ void S3Storage::do_iterate_type(KeyType key_type, const IterateTypeVisitor& visi
     detail::do_iterate_type_impl(key_type, std::move(visitor), root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, std::move(prefix_handler), prefix);
 }
 
+void S3Storage::do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string& prefix) {
+    auto prefix_handler = [] (const std::string& prefix, const std::string& key_type_dir, const KeyDescriptor key_descriptor, KeyType) {
+        return !prefix.empty() ? fmt::format("{}/{}*{}", key_type_dir, key_descriptor, prefix) : key_type_dir;
+    };
+
+    detail::do_iterate_type_impl(key_type, visitor, root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, std::move(prefix_handler), prefix);
+}
+
+std::vector<KeyRange> S3Storage::do_key_ranges(KeyType key_type, size_t max_ranges) {
+    return detail::do_key_ranges_impl(key_type, max_ranges, root_folder_, bucket_name_, s3_client_);
+}
+
+void S3Storage::do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+    detail::do_iterate_type_impl(key_type, visitor, root_folder_, bucket_name_, s3_client_, FlatBucketizer{}, detail::default_prefix_handler(), std::string{}, range);
+}
+
 bool S3Storage::do_key_exists(const VariantKey& key) {
     return detail::do_key_exists_impl(key, root_folder_, bucket_name_, s3_client_, FlatBucketizer{});
 }
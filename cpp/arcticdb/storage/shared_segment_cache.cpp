@@ -0,0 +1,399 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/storage/shared_segment_cache.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/hash.hpp>
+
+#include <boost/container/map.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/version.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace arcticdb::storage {
+
+namespace bip = boost::interprocess;
+
+namespace {
+
+using SegmentManager = bip::managed_shared_memory::segment_manager;
+
+template<typename T>
+using ShmAllocator = bip::allocator<T, SegmentManager>;
+
+using ShmString = bip::basic_string<char, std::char_traits<char>, ShmAllocator<char>>;
+
+// Readers that find every slot taken treat the entry as a miss
+constexpr size_t MaxPinsPerEntry = 16;
+
+// Bump whenever CacheEntry or CacheIndex changes, so that builds with different layouts use different shared memory
+constexpr uint32_t CacheLayoutVersion = 2;
+
+// A process can clear its own pins without the lock, if it cannot get it
+static_assert(std::atomic<int32_t>::is_always_lock_free);
+
+struct CacheEntry {
+    explicit CacheEntry(const ShmAllocator<char>& allocator) :
+        name_(allocator) {
+    }
+
+    // The full name, as entries are found by its hash
+    ShmString name_;
+    bip::offset_ptr<uint8_t> data_;
+    size_t size_ = 0;
+    uint64_t last_used_ = 0;
+    // Set once the writer has finished copying the segment in
+    bool ready_ = false;
+    // Removed while pinned, so freed when the last pin is released
+    bool removed_ = false;
+    // The process holding each pin, or zero
+    std::array<std::atomic<int32_t>, MaxPinsPerEntry> pins_{};
+
+    bool pinned() const {
+        return std::any_of(std::begin(pins_), std::end(pins_), [] (const auto& pid) { return pid != 0; });
+    }
+
+    // Unpinned but never finished, or removed, as when the process writing or reading it could not get the lock back
+    bool abandoned() const {
+        return (!ready_ || removed_) && !pinned();
+    }
+};
+
+using EntryMap = boost::container::map<
+    uint64_t,
+    CacheEntry,
+    std::less<uint64_t>,
+    ShmAllocator<std::pair<const uint64_t, CacheEntry>>>;
+
+int32_t current_pid() {
+    return static_cast<int32_t>(getpid());
+}
+
+bool process_is_alive(int32_t pid) {
+#ifdef _WIN32
+    // Without a cheap liveness check, pins are never assumed to be abandoned
+    return pid != 0;
+#else
+    return ::kill(pid, 0) == 0 || errno != ESRCH;
+#endif
+}
+
+// Hashed with xxhash rather than std::hash, which can differ between the builds sharing the cache
+std::string cache_entry_name(const std::string& library, const entity::AtomKey& key) {
+    return fmt::format("{}/{}", library, key);
+}
+
+} // namespace
+
+struct SharedSegmentCache::CacheIndex {
+    explicit CacheIndex(SegmentManager* segment_manager) :
+        entries_(ShmAllocator<std::pair<const uint64_t, CacheEntry>>(segment_manager)) {
+    }
+
+    bip::interprocess_mutex mutex_;
+    uint64_t clock_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+    size_t bytes_ = 0;
+    EntryMap entries_;
+};
+
+namespace {
+
+using IndexLock = bip::scoped_lock<bip::interprocess_mutex>;
+
+// The lock is not robust, so a timeout most likely means a process died holding it and every later attempt would time
+// out too. The first timeout therefore disables the cache for the rest of this process.
+std::optional<IndexLock> lock_index(SharedSegmentCache::CacheIndex& index, std::atomic<bool>& disabled, int64_t timeout_ms) {
+    if(disabled)
+        return std::nullopt;
+
+    IndexLock lock{index.mutex_, boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(timeout_ms)};
+    if(!lock.owns()) {
+        if(!disabled.exchange(true))
+            log::storage().warn("Timed out waiting for the shared segment cache lock, disabling the cache in this process");
+        return std::nullopt;
+    }
+    return std::make_optional<IndexLock>(std::move(lock));
+}
+
+void free_entry(bip::managed_shared_memory& segment, SharedSegmentCache::CacheIndex& index, EntryMap::iterator it) {
+    if(it->second.data_)
+        segment.deallocate(it->second.data_.get());
+
+    index.bytes_ -= it->second.size_;
+    index.entries_.erase(it);
+}
+
+// Without the lock the pin is still cleared, leaving a removed entry to be freed by the next eviction
+void release_pin(
+    bip::managed_shared_memory& segment,
+    SharedSegmentCache::CacheIndex& index,
+    std::atomic<bool>& disabled,
+    int64_t timeout_ms,
+    uint64_t hash,
+    CacheEntry* entry,
+    size_t slot) {
+    auto lock = lock_index(index, disabled, timeout_ms);
+    entry->pins_[slot] = 0;
+    if(!lock)
+        return;
+
+    auto it = index.entries_.find(hash);
+    util::check(it != index.entries_.end() && &it->second == entry, "Pinned shared segment cache entry has gone");
+    if(it->second.removed_ && !it->second.pinned())
+        free_entry(segment, index, it);
+}
+
+// Called with the index locked
+uint8_t* allocate_evicting(bip::managed_shared_memory& segment, SharedSegmentCache::CacheIndex& index, size_t size) {
+    if(auto ptr = segment.allocate(size, std::nothrow))
+        return static_cast<uint8_t*>(ptr);
+
+    std::vector<std::pair<uint64_t, uint64_t>> candidates;
+    for(auto& [hash, entry] : index.entries_) {
+        for(auto& pid : entry.pins_) {
+            if(pid != 0 && !process_is_alive(pid)) {
+                ARCTICDB_DEBUG(log::storage(), "Releasing shared segment cache pin held by exited process {}", pid);
+                pid = 0;
+            }
+        }
+        if(!entry.pinned())
+            candidates.emplace_back(entry.last_used_, hash);
+    }
+    std::sort(std::begin(candidates), std::end(candidates));
+
+    for(const auto& [last_used, hash] : candidates) {
+        free_entry(segment, index, index.entries_.find(hash));
+        ++index.evictions_;
+        if(auto ptr = segment.allocate(size, std::nothrow))
+            return static_cast<uint8_t*>(ptr);
+    }
+    return nullptr;
+}
+
+// Qualified by the layout, so that builds which disagree on it never open each other's shared memory
+std::string versioned_shared_memory_name(const std::string& name) {
+    return fmt::format("{}_v{}_{}_{}_{}", name, CacheLayoutVersion, BOOST_VERSION, sizeof(CacheEntry), sizeof(SharedSegmentCache::CacheIndex));
+}
+
+} // namespace
+
+std::shared_ptr<SharedSegmentCache> SharedSegmentCache::instance() {
+    std::call_once(SharedSegmentCache::init_flag_, &SharedSegmentCache::init);
+    return SharedSegmentCache::instance_;
+}
+
+void SharedSegmentCache::destroy_instance() {
+    instance_.reset();
+}
+
+void SharedSegmentCache::init() {
+    const auto size_bytes = ConfigsMap::instance()->get_int("SharedSegmentCache.SizeBytes", 0);
+    if(size_bytes <= 0)
+        return;
+
+    const auto name = ConfigsMap::instance()->get_string("SharedSegmentCache.Name", "arcticdb_segment_cache");
+    try {
+        instance_ = std::make_shared<SharedSegmentCache>(name, static_cast<size_t>(size_bytes));
+    } catch(const bip::interprocess_exception& e) {
+        log::storage().warn("Unable to open the shared segment cache {}: {}", name, e.what());
+    }
+}
+
+void SharedSegmentCache::remove_shared_memory(const std::string& name) {
+    bip::shared_memory_object::remove(versioned_shared_memory_name(name).c_str());
+}
+
+SharedSegmentCache::SharedSegmentCache(const std::string& name, size_t size_bytes) :
+    segment_(std::make_unique<bip::managed_shared_memory>(bip::open_or_create, versioned_shared_memory_name(name).c_str(), size_bytes)),
+    index_(segment_->find_or_construct<CacheIndex>("index")(segment_->get_segment_manager())),
+    lock_timeout_ms_(ConfigsMap::instance()->get_int("SharedSegmentCache.LockTimeoutMs", 1000)) {
+}
+
+std::optional<Segment> SharedSegmentCache::get(const std::string& library, const entity::AtomKey& key) {
+    const auto name = cache_entry_name(library, key);
+    const auto hash = arcticdb::hash(std::string_view{name});
+    CacheEntry* entry;
+    size_t slot;
+    {
+        auto lock = lock_index(*index_, disabled_, lock_timeout_ms_);
+        if(!lock)
+            return std::nullopt;
+
+        auto it = index_->entries_.find(hash);
+        if(it == index_->entries_.end() || !it->second.ready_ || it->second.removed_ || it->second.name_ != name.c_str()) {
+            ++index_->misses_;
+            return std::nullopt;
+        }
+        auto& pins = it->second.pins_;
+        auto free_pin = std::find(std::begin(pins), std::end(pins), 0);
+        if(free_pin == std::end(pins)) {
+            ++index_->misses_;
+            return std::nullopt;
+        }
+        *free_pin = current_pid();
+        slot = std::distance(std::begin(pins), free_pin);
+        it->second.last_used_ = ++index_->clock_;
+        ++index_->hits_;
+        entry = &it->second;
+    }
+
+    std::optional<Segment> output;
+    try {
+        output = Segment::from_bytes(entry->data_.get(), entry->size_, true);
+    } catch(...) {
+        release_pin(*segment_, *index_, disabled_, lock_timeout_ms_, hash, entry, slot);
+        throw;
+    }
+    release_pin(*segment_, *index_, disabled_, lock_timeout_ms_, hash, entry, slot);
+    return output;
+}
+
+void SharedSegmentCache::put(const std::string& library, const entity::AtomKey& key, Segment& segment) {
+    const auto name = cache_entry_name(library, key);
+    const auto hash = arcticdb::hash(std::string_view{name});
+    const auto header_size = segment.segment_header_bytes_size();
+    const auto size = segment.total_segment_size(header_size);
+    CacheEntry* entry;
+    {
+        auto lock = lock_index(*index_, disabled_, lock_timeout_ms_);
+        if(!lock)
+            return;
+
+        if(auto existing = index_->entries_.find(hash); existing != index_->entries_.end()) {
+            if(!existing->second.abandoned())
+                return;
+
+            free_entry(*segment_, *index_, existing);
+        }
+
+        auto data = allocate_evicting(*segment_, *index_, size);
+        if(!data) {
+            ARCTICDB_DEBUG(log::storage(), "No room for {} bytes in the shared segment cache", size);
+            return;
+        }
+        entry = &index_->entries_.try_emplace(hash, ShmAllocator<char>(segment_->get_segment_manager())).first->second;
+        entry->name_ = name.c_str();
+        entry->data_ = data;
+        entry->size_ = size;
+        entry->last_used_ = ++index_->clock_;
+        entry->pins_[0] = current_pid();
+        index_->bytes_ += size;
+    }
+
+    // Copied in without holding the lock, the pin keeps the entry from being evicted meanwhile
+    segment.write_to(entry->data_.get(), header_size);
+
+    auto lock = lock_index(*index_, disabled_, lock_timeout_ms_);
+    if(!lock) {
+        // Never marked ready, so once unpinned the entry is freed by the next put of the key or eviction
+        entry->pins_[0] = 0;
+        return;
+    }
+
+    entry->ready_ = true;
+    entry->pins_[0] = 0;
+    if(entry->removed_)
+        free_entry(*segment_, *index_, index_->entries_.find(hash));
+}
+
+void SharedSegmentCache::remove(const std::string& library, const entity::AtomKey& key) {
+    const auto name = cache_entry_name(library, key);
+    auto lock = lock_index(*index_, disabled_, lock_timeout_ms_);
+    if(!lock)
+        return;
+
+    auto it = index_->entries_.find(arcticdb::hash(std::string_view{name}));
+    if(it == index_->entries_.end() || it->second.name_ != name.c_str())
+        return;
+
+    if(it->second.pinned())
+        it->second.removed_ = true;
+    else
+        free_entry(*segment_, *index_, it);
+}
+
+SharedSegmentCache::Stats SharedSegmentCache::stats() {
+    Stats output;
+    auto lock = lock_index(*index_, disabled_, lock_timeout_ms_);
+    if(!lock)
+        return output;
+
+    output.hits_ = index_->hits_;
+    output.misses_ = index_->misses_;
+    output.evictions_ = index_->evictions_;
+    output.entries_ = index_->entries_.size();
+    output.bytes_ = index_->bytes_;
+    return output;
+}
+
+namespace {
+std::pair<uint64_t, CacheEntry*> find_entry(SharedSegmentCache::CacheIndex& index, const std::string& library, const entity::AtomKey& key) {
+    const auto name = cache_entry_name(library, key);
+    const auto hash = arcticdb::hash(std::string_view{name});
+    auto it = index.entries_.find(hash);
+    util::check(it != index.entries_.end() && it->second.name_ == name.c_str(), "{} is not in the shared segment cache", name);
+    return {hash, &it->second};
+}
+} // namespace
+
+size_t SharedSegmentCacheTestAccessor::pin(SharedSegmentCache& cache, const std::string& library, const entity::AtomKey& key, int32_t pid) {
+    IndexLock lock{cache.index_->mutex_};
+    auto& pins = find_entry(*cache.index_, library, key).second->pins_;
+    auto free_pin = std::find(std::begin(pins), std::end(pins), 0);
+    util::check(free_pin != std::end(pins), "No free pin for {}", key);
+    *free_pin = pid;
+    return static_cast<size_t>(std::distance(std::begin(pins), free_pin));
+}
+
+void SharedSegmentCacheTestAccessor::unpin(SharedSegmentCache& cache, const std::string& library, const entity::AtomKey& key, size_t slot) {
+    auto [hash, entry] = [&cache, &library, &key] () {
+        IndexLock lock{cache.index_->mutex_};
+        return find_entry(*cache.index_, library, key);
+    }();
+    release_pin(*cache.segment_, *cache.index_, cache.disabled_, cache.lock_timeout_ms_, hash, entry, slot);
+}
+
+void SharedSegmentCacheTestAccessor::abandon(SharedSegmentCache& cache, const std::string& library, const entity::AtomKey& key) {
+    IndexLock lock{cache.index_->mutex_};
+    find_entry(*cache.index_, library, key).second->ready_ = false;
+}
+
+void SharedSegmentCacheTestAccessor::lock(SharedSegmentCache& cache) {
+    cache.index_->mutex_.lock();
+}
+
+void SharedSegmentCacheTestAccessor::unlock(SharedSegmentCache& cache) {
+    cache.index_->mutex_.unlock();
+}
+
+bool SharedSegmentCacheTestAccessor::disabled(const SharedSegmentCache& cache) {
+    return cache.disabled_;
+}
+
+std::shared_ptr<SharedSegmentCache> SharedSegmentCache::instance_;
+std::once_flag SharedSegmentCache::init_flag_;
+
+} // namespace arcticdb::storage
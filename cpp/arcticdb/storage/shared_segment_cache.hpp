@@ -0,0 +1,106 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/codec/segment.hpp>
+#include <arcticdb/entity/atom_key.hpp>
+#include <arcticdb/entity/variant_key.hpp>
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace arcticdb::storage {
+
+/*
+ * Host-wide cache of TABLE_DATA segments, kept in a named shared memory segment that every process on the host opens,
+ * so that a hot segment is fetched from storage once per host rather than once per process.
+ *
+ * Data keys are never rewritten, so entries stay valid until the key is removed or they are evicted, least recently
+ * used first, to make room for new ones. Readers pin an entry while copying it out, and pinned entries are not
+ * evicted. Pins are recorded against the reading process, so pins left by a process that died are released when they
+ * next get in the way of an eviction. The cache's lock is not robust: if the process holding it dies, each other
+ * process times out waiting for it once, after SharedSegmentCache.LockTimeoutMs, and stops using the cache until it
+ * restarts. remove_shared_memory() clears the abandoned lock for new processes.
+ *
+ * Disabled unless SharedSegmentCache.SizeBytes is set. The shared memory is named by SharedSegmentCache.Name, suffixed
+ * with the layout of its contents so that incompatible builds never share it.
+ */
+class SharedSegmentCache {
+    static std::shared_ptr<SharedSegmentCache> instance_;
+    static std::once_flag init_flag_;
+
+    static void init();
+
+public:
+    struct Stats {
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+        uint64_t evictions_ = 0;
+        size_t entries_ = 0;
+        size_t bytes_ = 0;
+    };
+
+    // Null if the cache is disabled or the shared memory cannot be opened
+    static std::shared_ptr<SharedSegmentCache> instance();
+    static void destroy_instance();
+
+    static bool is_cacheable(const entity::VariantKey& key) {
+        return std::holds_alternative<entity::AtomKey>(key) && std::get<entity::AtomKey>(key).type() == entity::KeyType::TABLE_DATA;
+    }
+
+    // Takes the configured name, without the layout suffix
+    static void remove_shared_memory(const std::string& name);
+
+    SharedSegmentCache(const std::string& name, size_t size_bytes);
+
+    ARCTICDB_NO_MOVE_OR_COPY(SharedSegmentCache)
+
+    std::optional<Segment> get(const std::string& library, const entity::AtomKey& key);
+
+    void put(const std::string& library, const entity::AtomKey& key, Segment& segment);
+
+    void remove(const std::string& library, const entity::AtomKey& key);
+
+    Stats stats();
+
+    struct CacheIndex;
+
+private:
+    friend class SharedSegmentCacheTestAccessor;
+
+    std::unique_ptr<boost::interprocess::managed_shared_memory> segment_;
+    CacheIndex* index_;
+    const int64_t lock_timeout_ms_;
+    // Set on the first lock timeout
+    std::atomic<bool> disabled_{false};
+};
+
+// Acts on the shared state as another process would, for tests
+class SharedSegmentCacheTestAccessor {
+public:
+    // Pins a cached entry on behalf of the given process, returning the pin's slot
+    static size_t pin(SharedSegmentCache& cache, const std::string& library, const entity::AtomKey& key, int32_t pid);
+
+    static void unpin(SharedSegmentCache& cache, const std::string& library, const entity::AtomKey& key, size_t slot);
+
+    // Leaves a cached entry unfinished, as when its writer could not get the lock back to mark it ready
+    static void abandon(SharedSegmentCache& cache, const std::string& library, const entity::AtomKey& key);
+
+    static void lock(SharedSegmentCache& cache);
+
+    static void unlock(SharedSegmentCache& cache);
+
+    static bool disabled(const SharedSegmentCache& cache);
+};
+
+} // namespace arcticdb::storage
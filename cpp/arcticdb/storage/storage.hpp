@@ -15,6 +15,9 @@
 #include <arcticdb/entity/protobufs.hpp>
 #include <boost/callable_traits.hpp>
 #include <folly/Range.h>
+#include <algorithm>
+#include <optional>
+#include <string>
 #include <type_traits>
 #include <iterator>
 #include <array>
@@ -27,6 +30,46 @@ namespace arcticdb::storage {
 
 using ReadVisitor = std::function<void(const VariantKey&, Segment &&)>;
 
+/*
+ * A contiguous part of one key type in a backend's own ordering of its stored key names, so that the parts can be
+ * listed concurrently. The start is inclusive, the end exclusive, and unset bounds are open.
+ */
+struct KeyRange {
+    std::optional<std::string> start_;
+    std::optional<std::string> end_;
+};
+
+/*
+ * Splits a bytewise-ordered key space into up to max_ranges contiguous ranges, using the first and last keys to find
+ * the byte at which keys start to differ and dividing that byte's values evenly between the ranges. The first and
+ * last ranges are open, so keys outside [first, last] are still covered.
+ */
+inline std::vector<KeyRange> split_key_range(std::string_view first, std::string_view last, size_t max_ranges) {
+    const auto common = static_cast<size_t>(std::mismatch(first.begin(), first.end(), last.begin(), last.end()).first - first.begin());
+    if(max_ranges < 2 || common >= first.size() || common >= last.size())
+        return {KeyRange{}};
+
+    const auto low = static_cast<uint8_t>(first[common]);
+    const auto high = static_cast<uint8_t>(last[common]);
+    if(high <= low)
+        return {KeyRange{}};
+
+    const auto span = static_cast<size_t>(high - low) + 1;
+    const auto num_ranges = std::min(max_ranges, span);
+    std::vector<KeyRange> ranges(num_ranges);
+    for(size_t i = 1; i < num_ranges; ++i) {
+        auto boundary = std::string{first.substr(0, common)};
+        boundary.push_back(static_cast<char>(low + span * i / num_ranges));
+        ranges[i - 1].end_ = boundary;
+        ranges[i].start_ = std::move(boundary);
+    }
+    return ranges;
+}
+
+inline bool in_key_range(std::string_view key, const KeyRange& range) {
+    return (!range.start_ || key >= *range.start_) && (!range.end_ || key < *range.end_);
+}
+
 class DuplicateKeyException : public ArcticSpecificException<ErrorCode::E_DUPLICATE_KEY> {
 public:
     explicit DuplicateKeyException(VariantKey key) :
@@ -153,6 +196,26 @@ public:
         do_iterate_type(key_type, visitor, prefix);
     }
 
+    /*
+     * Splits a key type into up to max_ranges ranges for iterate_type_in_range. Backends that cannot list part of a
+     * key type return a single open range.
+     */
+    std::vector<KeyRange> key_ranges(KeyType key_type, size_t max_ranges) {
+        return do_key_ranges(key_type, max_ranges);
+    }
+
+    void iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+        do_iterate_type_in_range(key_type, range, visitor);
+    }
+
+    /*
+     * As iterate_type, but also passes the size of each object as stored. Backends that can take sizes from their
+     * listing metadata or value headers do so without reading the objects themselves.
+     */
+    void iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix = std::string()) {
+        do_iterate_type_with_size(key_type, visitor, prefix);
+    }
+
     std::string key_path(const VariantKey& key) const {
         return do_key_path(key);
     }
@@ -177,6 +240,30 @@ private:
 
     virtual void do_iterate_type(KeyType key_type, const IterateTypeVisitor& visitor, const std::string & prefix) = 0;
 
+    virtual std::vector<KeyRange> do_key_ranges(KeyType, size_t) {
+        return {KeyRange{}};
+    }
+
+    virtual void do_iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+        util::check(!range.start_ && !range.end_, "Storage {} cannot iterate part of a key type", lib_path_);
+        do_iterate_type(key_type, visitor, std::string{});
+    }
+
+    // Falls back to reading every object in full, for backends without a cheaper way to size them
+    virtual void do_iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string & prefix) {
+        std::vector<VariantKey> keys;
+        do_iterate_type(key_type, [&keys](VariantKey&& key) { keys.emplace_back(std::move(key)); }, prefix);
+        if(keys.empty())
+            return;
+
+        const ReadVisitor read_visitor = [&visitor](const VariantKey& key, Segment&& segment) {
+            visitor(VariantKey{key}, segment.total_segment_size());
+        };
+        ReadKeyOpts opts;
+        opts.ignores_missing_key_ = true;
+        do_read(Composite<VariantKey>{std::move(keys)}, read_visitor, opts);
+    }
+
     virtual std::string do_key_path(const VariantKey& key) const = 0;
 
     LibraryPath lib_path_;
@@ -8,6 +8,7 @@
 #include <arcticdb/storage/storage_factory.hpp>
 #include <arcticdb/storage/lmdb/lmdb_storage.hpp>
 #include <arcticdb/storage/memory/memory_storage.hpp>
+#include <arcticdb/storage/memory/sharded_memory_storage.hpp>
 #include <arcticdb/storage/mongo/mongo_storage.hpp>
 #include <arcticdb/storage/azure/azure_storage.hpp>
 #include <arcticdb/storage/s3/s3_storage.hpp>
@@ -48,6 +49,12 @@ std::unique_ptr<Storage> create_storage(
         storage = std::make_unique<memory::MemoryStorage>(
                 memory::MemoryStorage(library_path, mode, memory_config)
         );
+    } else if (type_name == memory::ShardedMemoryStorage::Config::descriptor()->full_name()) {
+        memory::ShardedMemoryStorage::Config sharded_memory_config;
+        storage_descriptor.config().UnpackTo(&sharded_memory_config);
+        storage = std::make_unique<memory::ShardedMemoryStorage>(
+                memory::ShardedMemoryStorage(library_path, mode, sharded_memory_config)
+        );
     } else if (type_name == nfs_backed::NfsBackedStorage::Config::descriptor()->full_name()) {
         nfs_backed::NfsBackedStorage::Config nfs_backed_config;
         storage_descriptor.config().UnpackTo(&nfs_backed_config);
@@ -13,6 +13,7 @@
 #include <arcticdb/entity/performance_tracing.hpp>
 #include <arcticdb/util/composite.hpp>
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -37,7 +38,12 @@ class Storages {
     using StorageVector = std::vector<std::unique_ptr<Storage>>;
 
     Storages(StorageVector&& storages, OpenMode mode) :
-        storages_(std::move(storages)), mode_(mode) {
+        storages_(std::move(storages)), mode_(mode), instance_id_(next_instance_id()) {
+    }
+
+    /** Unique within the process, so that caches can tell apart storages opened for libraries with the same name */
+    uint64_t instance_id() const {
+        return instance_id_;
     }
 
     void write(Composite<KeySegmentPair>&& kvs) {
@@ -95,6 +101,20 @@ class Storages {
         }
     }
 
+    std::vector<KeyRange> key_ranges(KeyType key_type, size_t max_ranges) {
+        return primary().key_ranges(key_type, max_ranges);
+    }
+
+    void iterate_type_in_range(KeyType key_type, const KeyRange& range, const IterateTypeVisitor& visitor) {
+        ARCTICDB_SAMPLE(StoragesIterateTypeInRange, RMTSF_Aggregate)
+        primary().iterate_type_in_range(key_type, range, visitor);
+    }
+
+    void iterate_type_with_size(KeyType key_type, const IterateTypeWithSizeVisitor& visitor, const std::string &prefix=std::string{}) {
+        ARCTICDB_SAMPLE(StoragesIterateTypeWithSize, RMTSF_Aggregate)
+        primary().iterate_type_with_size(key_type, visitor, prefix);
+    }
+
     /** Calls Storage::do_key_path on the primary storage. Remember to check the open mode. */
     std::string key_path(const VariantKey& key) const {
         return primary().key_path(key);
@@ -140,8 +160,14 @@ class Storages {
         return *storages_[0];
     }
 
+    static uint64_t next_instance_id() {
+        static std::atomic<uint64_t> next_id{0};
+        return next_id++;
+    }
+
     std::vector<std::unique_ptr<Storage>> storages_;
     OpenMode mode_;
+    uint64_t instance_id_;
 };
 
 inline std::shared_ptr<Storages> create_storages(const LibraryPath& library_path, OpenMode mode, const arcticdb::proto::storage::VariantStorage &storage_config) {
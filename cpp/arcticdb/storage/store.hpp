@@ -34,6 +34,9 @@ public:
     virtual folly::Future<VariantKey> copy(KeyType key_type, const StreamId& stream_id, VersionId version_id, const VariantKey& source_key) = 0;
 
     virtual VariantKey copy_sync(KeyType key_type, const StreamId& stream_id, VersionId version_id, const VariantKey& source_key) = 0;
+
+    // Encodes segments of key_type with codec instead of the store's default, or reverts to the default if nullopt
+    virtual void set_key_type_codec(KeyType key_type, const std::optional<arcticdb::proto::encoding::VariantCodec>& codec) = 0;
 };
 
 } // namespace arcticdb
\ No newline at end of file
@@ -0,0 +1,156 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/storage/mongo/mongo_client_wrapper.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace arcticdb::storage::mongo {
+
+/*
+ * Keeps each collection in memory and counts the calls made to it, each of which is a round trip to a real server.
+ * Calls can be given a fixed latency, to compare the cost of different numbers of round trips.
+ */
+class FakeMongoClient : public MongoClientWrapper {
+  public:
+    explicit FakeMongoClient(std::chrono::microseconds latency = std::chrono::microseconds{0}) :
+        latency_(latency) {
+    }
+
+    void write_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        std::vector<storage::KeySegmentPair>&& kvs) override {
+        round_trip();
+        std::lock_guard lock{mutex_};
+        auto& collection = collections_[collection_id(database_name, collection_name)];
+        for(auto& kv : kvs)
+            collection.insert_or_assign(kv.variant_key(), to_bytes(kv.segment()));
+    }
+
+    void update_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        std::vector<storage::KeySegmentPair>&& kvs,
+        bool upsert) override {
+        round_trip();
+        std::lock_guard lock{mutex_};
+        auto& collection = collections_[collection_id(database_name, collection_name)];
+        for(auto& kv : kvs) {
+            util::check(upsert || collection.find(kv.variant_key()) != collection.end(), "update called with upsert=false but key does not exist");
+            collection.insert_or_assign(kv.variant_key(), to_bytes(kv.segment()));
+        }
+    }
+
+    std::vector<storage::KeySegmentPair> read_segments(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const std::vector<entity::VariantKey> &keys) override {
+        round_trip();
+        std::lock_guard lock{mutex_};
+        std::vector<storage::KeySegmentPair> output;
+        auto& collection = collections_[collection_id(database_name, collection_name)];
+        for(const auto& key : keys) {
+            if(auto it = collection.find(key); it != collection.end())
+                output.emplace_back(entity::VariantKey{key}, Segment::from_bytes(it->second.data(), it->second.size(), true));
+        }
+        return output;
+    }
+
+    void remove_keyvalues(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const std::vector<entity::VariantKey> &keys) override {
+        round_trip();
+        std::lock_guard lock{mutex_};
+        auto& collection = collections_[collection_id(database_name, collection_name)];
+        for(const auto& key : keys)
+            collection.erase(key);
+    }
+
+    void iterate_type(
+        const std::string &database_name,
+        const std::string &collection_name,
+        KeyType,
+        folly::Function<void(entity::VariantKey &&)>&& visitor,
+        const std::optional<std::string> &prefix) override {
+        round_trip();
+        std::vector<entity::VariantKey> keys;
+        {
+            std::lock_guard lock{mutex_};
+            for(const auto& [key, _] : collections_[collection_id(database_name, collection_name)]) {
+                if(!prefix || prefix->empty() || fmt::format("{}", variant_key_id(key)) == *prefix)
+                    keys.push_back(key);
+            }
+        }
+        for(auto& key : keys)
+            visitor(std::move(key));
+    }
+
+    void ensure_collection(std::string_view, std::string_view) override {
+    }
+
+    void drop_collection(std::string database_name, std::string collection_name) override {
+        round_trip();
+        std::lock_guard lock{mutex_};
+        collections_.erase(collection_id(database_name, collection_name));
+    }
+
+    bool key_exists(
+        const std::string &database_name,
+        const std::string &collection_name,
+        const entity::VariantKey &key) override {
+        round_trip();
+        std::lock_guard lock{mutex_};
+        const auto& collection = collections_[collection_id(database_name, collection_name)];
+        return collection.find(key) != collection.end();
+    }
+
+    size_t round_trips() const {
+        return round_trips_;
+    }
+
+    void reset_round_trips() {
+        round_trips_ = 0;
+    }
+
+  private:
+    using Collection = std::unordered_map<entity::VariantKey, std::vector<uint8_t>>;
+
+    static std::string collection_id(const std::string& database_name, const std::string& collection_name) {
+        return fmt::format("{}.{}", database_name, collection_name);
+    }
+
+    // Stored as the bytes a real server would hold
+    static std::vector<uint8_t> to_bytes(Segment& segment) {
+        const auto header_size = segment.segment_header_bytes_size();
+        std::vector<uint8_t> bytes(segment.total_segment_size(header_size));
+        segment.write_to(bytes.data(), header_size);
+        return bytes;
+    }
+
+    void round_trip() {
+        ++round_trips_;
+        if(latency_.count() > 0)
+            std::this_thread::sleep_for(latency_);
+    }
+
+    const std::chrono::microseconds latency_;
+    std::atomic<size_t> round_trips_{0};
+    std::mutex mutex_;
+    std::map<std::string, Collection> collections_;
+};
+
+} // namespace arcticdb::storage::mongo
@@ -256,6 +256,14 @@ namespace arcticdb {
             }
         }
 
+        void iterate_type_parallel(KeyType kt, entity::IterateTypeVisitor func) override {
+            iterate_type(kt, std::move(func));
+        }
+
+        void iterate_type_with_size(KeyType, entity::IterateTypeWithSizeVisitor, const std::string&) override {
+            throw std::runtime_error("Not implemented");
+        }
+
         folly::Future<std::vector<VariantKey>> batch_write(
                 std::vector<std::pair<PartialKey, SegmentInMemory>> &&key_segments,
                 const std::shared_ptr<DeDupMap> &,
@@ -412,6 +420,8 @@ namespace arcticdb {
 
         void set_failure_sim(const arcticdb::proto::storage::VersionStoreConfig::StorageFailureSimulator &) override {}
 
+        void set_key_type_codec(KeyType, const std::optional<arcticdb::proto::encoding::VariantCodec>&) override {}
+
         void add_segment(const AtomKey &key, SegmentInMemory &&seg) {
             StorageFailureSimulator::instance()->go(FailureType::WRITE);
             std::lock_guard lock{mutex_};
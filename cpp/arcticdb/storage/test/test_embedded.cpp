@@ -17,6 +17,7 @@
 #endif
 
 #include <filesystem>
+#include <set>
 #include <stdexcept>
 #include <arcticdb/entity/atom_key.hpp>
 #include <arcticdb/util/buffer.hpp>
@@ -204,6 +205,58 @@ TEST_P(SimpleTestSuite, Strings) {
     ASSERT_EQ(std::string("baggy"), res_mem.string_at(1, 3));
 }
 
+TEST_P(SimpleTestSuite, IterateTypeInRanges) {
+    std::unique_ptr<as::Storage> storage = GetParam().new_backend();
+
+    constexpr size_t num_symbols = 100;
+    std::set<std::string> written;
+    for(size_t i = 0; i < num_symbols; ++i) {
+        auto symbol = fmt::format("sym_{:02d}", i);
+        ac::entity::AtomKey k = ac::entity::atom_key_builder().gen_id(1).build<ac::entity::KeyType::TABLE_DATA>(symbol);
+        as::KeySegmentPair kv(k);
+        kv.segment().set_buffer(std::make_shared<Buffer>());
+        storage->write(std::move(kv));
+        written.insert(std::move(symbol));
+    }
+
+    const auto ranges = storage->key_ranges(ac::entity::KeyType::TABLE_DATA, 8);
+    ASSERT_FALSE(ranges.empty());
+    ASSERT_FALSE(ranges.front().start_.has_value());
+    ASSERT_FALSE(ranges.back().end_.has_value());
+
+    // Every key is visited exactly once across the ranges
+    std::vector<std::string> found;
+    for(const auto& range : ranges) {
+        storage->iterate_type_in_range(ac::entity::KeyType::TABLE_DATA, range, [&](auto &&found_key) {
+            found.emplace_back(std::get<std::string>(to_atom(found_key).id()));
+        });
+    }
+    ASSERT_EQ(found.size(), num_symbols);
+    ASSERT_EQ(std::set<std::string>(found.begin(), found.end()), written);
+}
+
+TEST(KeyRanges, SplitKeyRange) {
+    using namespace arcticdb::storage;
+    const auto ranges = split_key_range("prefix_a", "prefix_z", 4);
+    ASSERT_EQ(ranges.size(), 4u);
+    ASSERT_FALSE(ranges[0].start_.has_value());
+    ASSERT_FALSE(ranges[3].end_.has_value());
+    for(size_t i = 1; i < ranges.size(); ++i) {
+        ASSERT_EQ(ranges[i - 1].end_, ranges[i].start_);
+        ASSERT_EQ(ranges[i].start_->substr(0, 7), "prefix_");
+    }
+    ASSERT_TRUE(in_key_range("prefix_a", ranges[0]));
+    ASSERT_TRUE(in_key_range("prefix_zzz", ranges[3]));
+    ASSERT_TRUE(in_key_range("zebra", ranges[3]));
+    ASSERT_FALSE(in_key_range("prefix_a", ranges[1]));
+
+    // Identical bounds or a single requested range cannot be split
+    ASSERT_EQ(split_key_range("same", "same", 4).size(), 1u);
+    ASSERT_EQ(split_key_range("a", "z", 1).size(), 1u);
+    // No more ranges than there are distinct values at the differing byte
+    ASSERT_EQ(split_key_range("k1", "k2", 16).size(), 2u);
+}
+
 using namespace std::string_literals;
 
 std::vector<BackendGenerator> get_backend_generators() {
@@ -30,4 +30,33 @@ TEST(InMemory, ReadTwice) {
     ReadQuery read_query;
     auto read_result1 = version_store.read_dataframe_version_internal(symbol, VersionQuery{}, read_query, ReadOptions{});
     auto read_result2 = version_store.read_dataframe_version_internal(symbol, VersionQuery{}, read_query, ReadOptions{});
-}
\ No newline at end of file
+}
+TEST(InMemory, ScanObjectSizes) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    auto version_store = get_test_engine();
+    std::vector<FieldRef> fields{
+        scalar_field(DataType::UINT64, "thing1"),
+    };
+    for(const auto& symbol : {"scan_a", "scan_b"}) {
+        auto test_frame = get_test_frame<stream::TimeseriesIndex>(symbol, fields, 100, 0);
+        version_store.write_versioned_dataframe_internal(symbol, std::move(test_frame.frame_), false, false, false);
+    }
+
+    auto sizes = version_store.scan_object_sizes();
+    auto by_stream = version_store.scan_object_sizes_by_stream();
+    const auto& [data_count, data_bytes] = sizes[KeyType::TABLE_DATA];
+    ASSERT_GT(data_bytes, 0u);
+
+    size_t stream_count = 0;
+    size_t stream_bytes = 0;
+    for(const auto& symbol : {"scan_a", "scan_b"}) {
+        const auto& [count, bytes] = by_stream.at(StreamId{StringId{symbol}}).at(KeyType::TABLE_DATA);
+        ASSERT_GT(count, 0u);
+        stream_count += count;
+        stream_bytes += bytes;
+    }
+    ASSERT_EQ(stream_count, data_count);
+    ASSERT_EQ(stream_bytes, data_bytes);
+}
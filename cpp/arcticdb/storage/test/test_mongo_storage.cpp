@@ -9,21 +9,52 @@
 
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/storage/mongo/mongo_storage.hpp>
+#include <arcticdb/storage/test/fake_mongo_client.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/timer.hpp>
 
+#include <cstdlib>
 #include <thread>
 #include <filesystem>
 #include <mongocxx/uri.hpp>
 
-const std::string test_server("mongodb://localhost:27017");
+#define GTEST_COUT std::cerr << "[          ] [ INFO ]"
 
 namespace fs = std::filesystem;
 
-TEST(MongoStorage, ClientSession) {
-    return; // need to run local mongo with /opt/mongo/bin/mongod --dbpath /tmp/something
-    namespace ac = arcticdb;
-    namespace as = arcticdb::storage;
-    namespace asmongo = arcticdb::storage::mongo;
+namespace {
+namespace ac = arcticdb;
+namespace as = arcticdb::storage;
+namespace asmongo = arcticdb::storage::mongo;
 
+// Runs against the server in ARCTICDB_MONGO_TEST_URI, e.g. one started with /opt/mongo/bin/mongod --dbpath /tmp/something
+class MongoServerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        const char* uri = std::getenv("ARCTICDB_MONGO_TEST_URI");
+        if(uri == nullptr)
+            GTEST_SKIP() << "ARCTICDB_MONGO_TEST_URI is not set";
+
+        test_server = uri;
+    }
+
+    std::string test_server;
+};
+
+std::vector<as::KeySegmentPair> mongo_test_kvs(size_t num_keys, std::vector<ac::entity::VariantKey>& keys) {
+    std::vector<as::KeySegmentPair> kvs;
+    for(size_t i = 0; i < num_keys; ++i) {
+        ac::entity::AtomKey k = ac::entity::atom_key_builder().gen_id(i).build<ac::entity::KeyType::TABLE_DATA>("sym");
+        as::KeySegmentPair kv(k);
+        kv.segment().header().set_start_ts(i);
+        keys.emplace_back(k);
+        kvs.emplace_back(std::move(kv));
+    }
+    return kvs;
+}
+} // namespace
+
+TEST_F(MongoServerTest, ClientSession) {
     auto environment_name = as::EnvironmentName{"res"};
     auto storage_name = as::StorageName{"mongo 01"};
 
@@ -109,3 +140,128 @@ TEST(MongoStorage, ClientSession) {
     numeric_res = storage.read(numeric_k, as::ReadKeyOpts{});
     ASSERT_EQ(numeric_res.segment().header().start_ts(), 7890);
 }
+
+TEST_F(MongoServerTest, BatchedReadWrite) {
+    arcticdb::proto::mongo_storage::Config cfg;
+    cfg.set_uri(test_server.c_str());
+
+    asmongo::MongoStorage storage({"testdb", "batched"}, as::OpenMode::DELETE, cfg);
+
+    constexpr size_t num_keys = 2500;
+    std::vector<ac::entity::VariantKey> keys;
+    storage.write(ac::Composite<as::KeySegmentPair>{mongo_test_kvs(num_keys, keys)});
+
+    size_t count = 0;
+    storage.iterate_type(ac::entity::KeyType::TABLE_DATA, [&](auto &&) { ++count; });
+    ASSERT_EQ(count, num_keys);
+
+    std::vector<uint64_t> start_ts(num_keys, 0);
+    storage.read(ac::Composite<ac::entity::VariantKey>{std::vector<ac::entity::VariantKey>{keys}}, [&](auto &&k, auto &&seg) {
+        start_ts[to_atom(k).gen_id()] = seg.header().start_ts();
+    }, as::ReadKeyOpts{});
+    for(size_t i = 0; i < num_keys; ++i)
+        ASSERT_EQ(start_ts[i], i);
+
+    storage.remove(ac::Composite<ac::entity::VariantKey>{std::vector<ac::entity::VariantKey>{keys}}, as::RemoveOpts{});
+    ASSERT_THROW(storage.read(ac::entity::VariantKey{keys[0]}, [](auto &&, auto &&) {}, as::ReadKeyOpts{}), as::KeyNotFoundException);
+}
+
+TEST(MongoStorageFake, BatchesPerKeyType) {
+    ac::ScopedConfig batch_size("MongoClient.BatchSize", 1000);
+    auto client = std::make_shared<asmongo::FakeMongoClient>();
+    asmongo::MongoStorage storage({"testdb", "fake"}, as::OpenMode::DELETE, client);
+
+    constexpr size_t num_keys = 2500;
+    std::vector<ac::entity::VariantKey> keys;
+    auto kvs = mongo_test_kvs(num_keys, keys);
+    ac::entity::RefKey ref_key{ac::StreamId{ac::StringId{"sym"}}, ac::entity::KeyType::VERSION_REF};
+    as::KeySegmentPair ref_kv(ref_key);
+    ref_kv.segment().header().set_start_ts(1);
+    kvs.emplace_back(std::move(ref_kv));
+    keys.emplace_back(ref_key);
+
+    // Three batches of data keys, one of ref keys
+    storage.write(ac::Composite<as::KeySegmentPair>{std::move(kvs)});
+    ASSERT_EQ(client->round_trips(), 4u);
+
+    client->reset_round_trips();
+    size_t found = 0;
+    storage.read(ac::Composite<ac::entity::VariantKey>{std::vector<ac::entity::VariantKey>{keys}}, [&](auto &&, auto &&) { ++found; }, as::ReadKeyOpts{});
+    ASSERT_EQ(found, keys.size());
+    ASSERT_EQ(client->round_trips(), 4u);
+
+    client->reset_round_trips();
+    storage.remove(ac::Composite<ac::entity::VariantKey>{std::vector<ac::entity::VariantKey>{keys}}, as::RemoveOpts{});
+    ASSERT_EQ(client->round_trips(), 4u);
+    ASSERT_FALSE(storage.key_exists(keys[0]));
+    ASSERT_FALSE(storage.key_exists(ref_key));
+}
+
+TEST(MongoStorageFake, LaterRefKeyWritesWin) {
+    ac::ScopedConfig batch_size("MongoClient.BatchSize", 1);
+    auto client = std::make_shared<asmongo::FakeMongoClient>();
+    asmongo::MongoStorage storage({"testdb", "fake"}, as::OpenMode::DELETE, client);
+
+    ac::entity::RefKey ref_key{ac::StreamId{ac::StringId{"sym"}}, ac::entity::KeyType::VERSION_REF};
+    std::vector<as::KeySegmentPair> kvs;
+    for(uint64_t start_ts = 1; start_ts <= 3; ++start_ts) {
+        as::KeySegmentPair kv(ref_key);
+        kv.segment().header().set_start_ts(start_ts);
+        kvs.emplace_back(std::move(kv));
+    }
+    storage.write(ac::Composite<as::KeySegmentPair>{std::move(kvs)});
+    ASSERT_EQ(client->round_trips(), 3u);
+    ASSERT_EQ(storage.read(ac::entity::VariantKey{ref_key}, as::ReadKeyOpts{}).segment().header().start_ts(), 3u);
+}
+
+TEST(MongoStorageFake, ReportsOnlyMissingKeys) {
+    ac::ScopedConfig batch_size("MongoClient.BatchSize", 2);
+    auto client = std::make_shared<asmongo::FakeMongoClient>();
+    asmongo::MongoStorage storage({"testdb", "fake"}, as::OpenMode::DELETE, client);
+
+    std::vector<ac::entity::VariantKey> keys;
+    storage.write(ac::Composite<as::KeySegmentPair>{mongo_test_kvs(5, keys)});
+    std::vector<ac::entity::VariantKey> absent;
+    mongo_test_kvs(7, absent);
+    absent.erase(absent.begin(), absent.begin() + 5);
+
+    auto to_read = keys;
+    to_read.insert(to_read.begin() + 2, absent[0]);
+    to_read.push_back(absent[1]);
+    std::vector<ac::entity::VariantKey> visited;
+    try {
+        storage.read(ac::Composite<ac::entity::VariantKey>{std::move(to_read)}, [&](auto &&k, auto &&) { visited.push_back(k); }, as::ReadKeyOpts{});
+        FAIL() << "Expected the absent keys to be reported";
+    } catch(as::KeyNotFoundException& e) {
+        std::vector<ac::entity::VariantKey> missing;
+        e.keys().broadcast([&missing](const auto& k) { missing.push_back(k); });
+        ASSERT_EQ(missing, absent);
+    }
+    ASSERT_EQ(visited.size(), keys.size());
+}
+
+// Times the same work with and without batching, against a fake server with a fixed latency per round trip
+TEST(MongoStorageFake, RoundTripReductionBenchmark) {
+    constexpr size_t num_keys = 500;
+    const std::chrono::microseconds latency{500};
+    std::vector<size_t> round_trips;
+    for(int64_t batch_size : {int64_t{1}, int64_t{1000}}) {
+        ac::ScopedConfig scoped_batch_size("MongoClient.BatchSize", batch_size);
+        auto client = std::make_shared<asmongo::FakeMongoClient>(latency);
+        asmongo::MongoStorage storage({"testdb", "fake"}, as::OpenMode::DELETE, client);
+        std::vector<ac::entity::VariantKey> keys;
+        auto kvs = mongo_test_kvs(num_keys, keys);
+
+        const auto timer_name = fmt::format("batch_size_{}", batch_size);
+        ac::interval_timer timer(timer_name);
+        storage.write(ac::Composite<as::KeySegmentPair>{std::move(kvs)});
+        storage.read(ac::Composite<ac::entity::VariantKey>{std::vector<ac::entity::VariantKey>{keys}}, [](auto &&, auto &&) {}, as::ReadKeyOpts{});
+        storage.remove(ac::Composite<ac::entity::VariantKey>{std::move(keys)}, as::RemoveOpts{});
+        timer.stop_timer(timer_name);
+
+        round_trips.push_back(client->round_trips());
+        GTEST_COUT << " " << client->round_trips() << " round trips " << timer.display_all() << std::endl;
+    }
+    ASSERT_EQ(round_trips[0], 3 * num_keys);
+    ASSERT_EQ(round_trips[1], 3u);
+}
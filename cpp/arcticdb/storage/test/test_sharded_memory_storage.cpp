@@ -0,0 +1,143 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/storage/memory/sharded_memory_storage.hpp>
+#include <arcticdb/codec/codec.hpp>
+#include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/stream/index.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace arcticdb {
+
+namespace {
+AtomKey sharded_test_key(VersionId version_id) {
+    return atom_key_builder().version_id(version_id).creation_ts(version_id).content_hash(version_id)
+        .start_index(0).end_index(1).build(StreamId{StringId{"sym"}}, KeyType::TABLE_DATA);
+}
+
+storage::KeySegmentPair sharded_test_kv(VersionId version_id, uint64_t value) {
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"sym"}}, stream::RowCountIndex{}, {
+        scalar_field(DataType::UINT64, "value")})};
+    segment.set_scalar(0, value);
+    segment.end_row();
+    return {sharded_test_key(version_id), encode_v1(std::move(segment), codec::default_passthrough_codec())};
+}
+
+uint64_t sharded_test_value(Segment&& segment) {
+    return decode_segment(std::move(segment)).scalar_at<uint64_t>(0, 0).value();
+}
+
+storage::memory::ShardedMemoryStorage make_sharded_storage(const storage::memory::ShardedMemoryStorage::Config& cfg) {
+    return storage::memory::ShardedMemoryStorage{storage::LibraryPath{"sharded", "test"}, storage::OpenMode::DELETE, cfg};
+}
+} // namespace
+
+TEST(ShardedMemoryStorage, ReadsShareStoredBytes) {
+    auto storage = make_sharded_storage({});
+    storage.write(sharded_test_kv(0, 5));
+    ASSERT_THROW(storage.write(sharded_test_kv(0, 6)), storage::DuplicateKeyException);
+
+    const uint8_t* first_data = nullptr;
+    for(auto i = 0; i < 2; ++i) {
+        storage.read(VariantKey{sharded_test_key(0)}, [&] (auto&&, Segment&& segment) {
+            if(first_data == nullptr)
+                first_data = segment.buffer().data();
+            else
+                ASSERT_EQ(segment.buffer().data(), first_data);
+
+            ASSERT_EQ(sharded_test_value(std::move(segment)), 5u);
+        }, storage::ReadKeyOpts{});
+    }
+
+    size_t count = 0;
+    storage.iterate_type(KeyType::TABLE_DATA, [&] (auto&&) { ++count; });
+    ASSERT_EQ(count, 1u);
+
+    storage.remove(VariantKey{sharded_test_key(0)}, storage::RemoveOpts{});
+    ASSERT_THROW(storage.read(VariantKey{sharded_test_key(0)}, [] (auto&&, auto&&) {}, storage::ReadKeyOpts{}), storage::KeyNotFoundException);
+}
+
+TEST(ShardedMemoryStorage, SegmentOutlivesRemovedKey) {
+    auto storage = make_sharded_storage({});
+    storage.write(sharded_test_kv(0, 7));
+    auto kv = storage.read(VariantKey{sharded_test_key(0)}, storage::ReadKeyOpts{});
+    storage.remove(VariantKey{sharded_test_key(0)}, storage::RemoveOpts{});
+    ASSERT_EQ(sharded_test_value(std::move(kv.segment())), 7u);
+}
+
+TEST(ShardedMemoryStorage, DeterministicFaults) {
+    storage::memory::ShardedMemoryStorage::Config cfg;
+    cfg.set_seed(42);
+    cfg.mutable_write()->set_failure_prob(0.5);
+
+    constexpr VersionId num_keys = 100;
+    auto failed_writes = [&cfg] () {
+        auto storage = make_sharded_storage(cfg);
+        std::vector<VersionId> failed;
+        for(VersionId version_id = 0; version_id < num_keys; ++version_id) {
+            try {
+                storage.write(sharded_test_kv(version_id, version_id));
+            } catch(const StorageException&) {
+                failed.push_back(version_id);
+            }
+        }
+        return failed;
+    };
+
+    const auto failed = failed_writes();
+    ASSERT_GT(failed.size(), 0u);
+    ASSERT_LT(failed.size(), size_t(num_keys));
+    ASSERT_EQ(failed_writes(), failed);
+}
+
+TEST(ShardedMemoryStorage, RetriesDrawNewFaults) {
+    storage::memory::ShardedMemoryStorage::Config cfg;
+    cfg.set_seed(42);
+    cfg.mutable_write()->set_failure_prob(0.5);
+
+    constexpr VersionId num_keys = 100;
+    constexpr size_t max_attempts = 64;
+    auto attempts_to_write = [&cfg] () {
+        auto storage = make_sharded_storage(cfg);
+        std::vector<size_t> attempts;
+        for(VersionId version_id = 0; version_id < num_keys; ++version_id) {
+            size_t attempt = 1;
+            for(;; ++attempt) {
+                try {
+                    storage.write(sharded_test_kv(version_id, version_id));
+                    break;
+                } catch(const StorageException&) {
+                    if(attempt == max_attempts)
+                        throw;
+                }
+            }
+            attempts.push_back(attempt);
+        }
+        return attempts;
+    };
+
+    const auto attempts = attempts_to_write();
+    ASSERT_GT(*std::max_element(attempts.begin(), attempts.end()), 1u);
+    ASSERT_EQ(attempts_to_write(), attempts);
+}
+
+TEST(ShardedMemoryStorage, Latency) {
+    storage::memory::ShardedMemoryStorage::Config cfg;
+    cfg.mutable_read()->set_latency_us(20'000);
+    auto storage = make_sharded_storage(cfg);
+    storage.write(sharded_test_kv(0, 1));
+
+    const auto start = std::chrono::steady_clock::now();
+    storage.read(VariantKey{sharded_test_key(0)}, storage::ReadKeyOpts{});
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{20});
+}
+
+} // namespace arcticdb
@@ -0,0 +1,234 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/storage/shared_segment_cache.hpp>
+#include <arcticdb/codec/codec.hpp>
+#include <arcticdb/codec/default_codecs.hpp>
+#include <arcticdb/stream/index.hpp>
+
+#include <arcticdb/util/configs_map.hpp>
+
+#include <folly/Random.h>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace arcticdb {
+
+namespace {
+AtomKey shared_cache_test_key(VersionId version_id) {
+    return atom_key_builder().version_id(version_id).creation_ts(version_id).content_hash(version_id)
+        .start_index(0).end_index(1).build(StreamId{StringId{"sym"}}, KeyType::TABLE_DATA);
+}
+
+Segment shared_cache_test_segment(uint64_t value, size_t num_rows = 1) {
+    SegmentInMemory segment{stream_descriptor(StreamId{StringId{"sym"}}, stream::RowCountIndex{}, {
+        scalar_field(DataType::UINT64, "value")})};
+    for(size_t row = 0; row < num_rows; ++row) {
+        segment.set_scalar(0, value);
+        segment.end_row();
+    }
+    return encode_v1(std::move(segment), codec::default_passthrough_codec());
+}
+
+uint64_t shared_cache_test_value(Segment&& segment) {
+    return decode_segment(std::move(segment)).scalar_at<uint64_t>(0, 0).value();
+}
+
+int32_t shared_cache_test_pid() {
+#ifdef _WIN32
+    return static_cast<int32_t>(_getpid());
+#else
+    return static_cast<int32_t>(getpid());
+#endif
+}
+
+// Fills a 256KB cache, evicting everything that is not pinned
+void shared_cache_test_fill(storage::SharedSegmentCache& cache, VersionId from) {
+    for(VersionId version_id = from; version_id < from + 16; ++version_id) {
+        auto segment = shared_cache_test_segment(version_id, 4096);
+        cache.put("lib", shared_cache_test_key(version_id), segment);
+    }
+}
+
+class SharedSegmentCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        name_ = fmt::format("arcticdb_test_segment_cache_{:x}", folly::Random::rand64());
+    }
+
+    void TearDown() override {
+        storage::SharedSegmentCache::remove_shared_memory(name_);
+    }
+
+    std::string name_;
+};
+} // namespace
+
+TEST_F(SharedSegmentCacheTest, RoundTrip) {
+    storage::SharedSegmentCache cache{name_, 1024 * 1024};
+    const auto key = shared_cache_test_key(0);
+    ASSERT_FALSE(cache.get("lib", key));
+
+    auto segment = shared_cache_test_segment(5);
+    cache.put("lib", key, segment);
+    ASSERT_FALSE(cache.get("other_lib", key));
+
+    auto cached = cache.get("lib", key);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(shared_cache_test_value(std::move(*cached)), 5u);
+
+    // Another process opening the same cache sees the same entries
+    storage::SharedSegmentCache other{name_, 1024 * 1024};
+    auto shared = other.get("lib", key);
+    ASSERT_TRUE(shared);
+    ASSERT_EQ(shared_cache_test_value(std::move(*shared)), 5u);
+
+    const auto stats = cache.stats();
+    ASSERT_EQ(stats.hits_, 2u);
+    ASSERT_EQ(stats.misses_, 2u);
+    ASSERT_EQ(stats.entries_, 1u);
+
+    other.remove("lib", key);
+    ASSERT_FALSE(cache.get("lib", key));
+    ASSERT_EQ(cache.stats().bytes_, 0u);
+}
+
+TEST_F(SharedSegmentCacheTest, EvictsLeastRecentlyUsed) {
+    constexpr size_t num_rows = 4096;
+    storage::SharedSegmentCache cache{name_, 256 * 1024};
+    for(VersionId version_id = 0; version_id < 16; ++version_id) {
+        auto segment = shared_cache_test_segment(version_id, num_rows);
+        cache.put("lib", shared_cache_test_key(version_id), segment);
+        // Keep the first entry in use so that it is never the least recently used
+        ASSERT_TRUE(cache.get("lib", shared_cache_test_key(0)));
+    }
+
+    ASSERT_GT(cache.stats().evictions_, 0u);
+    ASSERT_FALSE(cache.get("lib", shared_cache_test_key(1)));
+    auto latest = cache.get("lib", shared_cache_test_key(15));
+    ASSERT_TRUE(latest);
+    ASSERT_EQ(shared_cache_test_value(std::move(*latest)), 15u);
+    ASSERT_TRUE(cache.get("lib", shared_cache_test_key(0)));
+}
+
+TEST_F(SharedSegmentCacheTest, PinnedEntriesAreNotEvicted) {
+    using Accessor = storage::SharedSegmentCacheTestAccessor;
+    storage::SharedSegmentCache cache{name_, 256 * 1024};
+    const auto key = shared_cache_test_key(0);
+    auto segment = shared_cache_test_segment(0, 4096);
+    cache.put("lib", key, segment);
+
+    // Left as the least recently used entry, but held by a live process
+    const auto slot = Accessor::pin(cache, "lib", key, shared_cache_test_pid());
+    shared_cache_test_fill(cache, 1);
+    ASSERT_GT(cache.stats().evictions_, 0u);
+    auto cached = cache.get("lib", key);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(shared_cache_test_value(std::move(*cached)), 0u);
+
+    Accessor::unpin(cache, "lib", key, slot);
+    shared_cache_test_fill(cache, 17);
+    ASSERT_FALSE(cache.get("lib", key));
+}
+
+TEST_F(SharedSegmentCacheTest, RemovedWhilePinnedIsFreedOnUnpin) {
+    using Accessor = storage::SharedSegmentCacheTestAccessor;
+    storage::SharedSegmentCache cache{name_, 1024 * 1024};
+    const auto key = shared_cache_test_key(0);
+    auto segment = shared_cache_test_segment(5);
+    cache.put("lib", key, segment);
+    const auto slot = Accessor::pin(cache, "lib", key, shared_cache_test_pid());
+
+    // Kept for the reader copying it out, but no longer served
+    cache.remove("lib", key);
+    ASSERT_FALSE(cache.get("lib", key));
+    ASSERT_EQ(cache.stats().entries_, 1u);
+    ASSERT_GT(cache.stats().bytes_, 0u);
+
+    Accessor::unpin(cache, "lib", key, slot);
+    ASSERT_EQ(cache.stats().entries_, 0u);
+    ASSERT_EQ(cache.stats().bytes_, 0u);
+}
+
+#ifndef _WIN32
+TEST_F(SharedSegmentCacheTest, PinsOfExitedProcessesAreReleased) {
+    using Accessor = storage::SharedSegmentCacheTestAccessor;
+    const auto child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0)
+        _exit(0);
+
+    ASSERT_EQ(waitpid(child, nullptr, 0), child);
+
+    storage::SharedSegmentCache cache{name_, 256 * 1024};
+    const auto key = shared_cache_test_key(0);
+    auto segment = shared_cache_test_segment(0, 4096);
+    cache.put("lib", key, segment);
+    Accessor::pin(cache, "lib", key, static_cast<int32_t>(child));
+
+    // The pin is dropped once it stands in the way of an eviction
+    shared_cache_test_fill(cache, 1);
+    ASSERT_GT(cache.stats().evictions_, 0u);
+    ASSERT_FALSE(cache.get("lib", key));
+}
+#endif
+
+TEST_F(SharedSegmentCacheTest, AbandonedEntriesAreReplaced) {
+    using Accessor = storage::SharedSegmentCacheTestAccessor;
+    storage::SharedSegmentCache cache{name_, 1024 * 1024};
+    const auto key = shared_cache_test_key(0);
+    auto first = shared_cache_test_segment(5);
+    cache.put("lib", key, first);
+
+    // A finished entry is kept
+    auto second = shared_cache_test_segment(6);
+    cache.put("lib", key, second);
+    auto cached = cache.get("lib", key);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(shared_cache_test_value(std::move(*cached)), 5u);
+
+    Accessor::abandon(cache, "lib", key);
+    ASSERT_FALSE(cache.get("lib", key));
+
+    auto third = shared_cache_test_segment(7);
+    cache.put("lib", key, third);
+    cached = cache.get("lib", key);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(shared_cache_test_value(std::move(*cached)), 7u);
+    ASSERT_EQ(cache.stats().entries_, 1u);
+}
+
+TEST_F(SharedSegmentCacheTest, LockTimeoutDisablesCache) {
+    using Accessor = storage::SharedSegmentCacheTestAccessor;
+    ScopedConfig timeout("SharedSegmentCache.LockTimeoutMs", 50);
+    storage::SharedSegmentCache cache{name_, 1024 * 1024};
+    const auto key = shared_cache_test_key(0);
+    auto segment = shared_cache_test_segment(5);
+    cache.put("lib", key, segment);
+
+    // As if a process died holding the lock
+    storage::SharedSegmentCache other{name_, 1024 * 1024};
+    Accessor::lock(cache);
+    ASSERT_FALSE(other.get("lib", key));
+    ASSERT_TRUE(Accessor::disabled(other));
+    Accessor::unlock(cache);
+
+    // Stays disabled in the process that timed out, without waiting on the lock again
+    ASSERT_FALSE(other.get("lib", key));
+    ASSERT_EQ(other.stats().entries_, 0u);
+    ASSERT_FALSE(Accessor::disabled(cache));
+    ASSERT_TRUE(cache.get("lib", key));
+}
+
+} // namespace arcticdb
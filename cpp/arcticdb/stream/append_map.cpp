@@ -11,6 +11,7 @@
 #include <arcticdb/stream/protobuf_mappings.hpp>
 #include <arcticdb/stream/stream_source.hpp>
 #include <arcticdb/stream/index.hpp>
+#include <arcticdb/stream/index_aggregator.hpp>
 #include <arcticdb/entity/protobufs.hpp>
 #include <pipeline/query.hpp>
 #include <pipeline/frame_slice.hpp>
@@ -22,6 +23,9 @@ namespace arcticdb {
 using namespace arcticdb::pipelines;
 using namespace arcticdb::stream;
 
+// Times the head is re-read when the manifest it points to has been replaced, before falling back to walking the chain
+constexpr size_t ManifestReadAttempts = 3;
+
 struct AppendMapEntry {
     AppendMapEntry() = default;
 
@@ -61,6 +65,32 @@ AppendMapEntry entry_from_key(
     const entity::AtomKey& key,
     bool load_data);
 
+AppendMapEntry entry_from_descriptor(
+    TimeseriesDescriptor&& tsd,
+    std::optional<SegmentInMemory>&& seg,
+    const entity::AtomKey& key);
+
+// The APPEND_REF segment carries, in addition to the head of the chain, the keys of the incompletes appended since the
+// chain was last indexed (newest first, starting with the head), followed by the key of the APPEND_MANIFEST holding the
+// keys of all the older incompletes, if there is one. This allows all the incompletes to be fetched concurrently rather
+// than walking the chain one storage round-trip at a time. Every Append.ManifestInterval appends, the keys in the head
+// are folded into a new manifest, so that an append only rewrites a small head. A head with no rows (written by older
+// clients) falls back to chain-walking.
+struct AppendHead {
+    std::optional<entity::AtomKey> next_key_;
+    size_t total_rows_ = 0;
+    std::vector<entity::AtomKey> tail_;
+    std::optional<entity::AtomKey> manifest_key_;
+
+    bool has_chain_index() const {
+        return next_key_ && !tail_.empty() && tail_[0] == *next_key_;
+    }
+};
+
+AppendHead read_head_and_index(
+    const std::shared_ptr<stream::StreamSource>& store,
+    StreamId stream_id);
+
 //std::pair<std::optional<entity::AtomKey>, size_t> read_head(
 //    const std::shared_ptr<stream::StreamSource>& store,
 //    StreamId stream_id);
@@ -159,13 +189,13 @@ SegmentInMemory incomplete_segment_from_frame(
     using namespace arcticdb::stream;
 
     auto offset_in_frame = 0;
-    auto slice_num_for_column = 0;
     const auto num_rows = frame.num_rows;
     auto index_tensor = std::move(frame.index_tensor);
     const bool has_index = frame.has_index();
     const auto index = std::move(frame.index);
     SegmentInMemory output;
     auto field_tensors = std::move(frame.field_tensors);
+    const auto string_pool = frame.string_pool;
 
     std::visit([&](const auto& idx) {
         using IdxType = std::decay_t<decltype(idx)>;
@@ -183,8 +213,8 @@ SegmentInMemory incomplete_segment_from_frame(
 
         if (has_index) {
             util::check(static_cast<bool>(index_tensor), "Expected index tensor for index type {}", agg.descriptor().index());
-            auto opt_error = aggregator_set_data(agg.descriptor().field(0).type(), index_tensor.value(), agg, 0, num_rows, offset_in_frame, slice_num_for_column,
-                                num_rows, allow_sparse);
+            auto opt_error = aggregator_set_data(agg.descriptor().field(0).type(), index_tensor.value(), agg, 0, num_rows, offset_in_frame,
+                                allow_sparse, string_pool.get());
             if (opt_error.has_value()) {
                 opt_error->raise(agg.descriptor().field(0).name());
             }
@@ -193,8 +223,8 @@ SegmentInMemory incomplete_segment_from_frame(
         for(auto col = 0u; col < field_tensors.size(); ++col) {
             auto dest_col = col + agg.descriptor().index().field_count();
             auto &tensor = field_tensors[col];
-            auto opt_error = aggregator_set_data(agg.descriptor().field(dest_col).type(), tensor, agg, dest_col, num_rows, offset_in_frame, slice_num_for_column,
-                                num_rows, allow_sparse);
+            auto opt_error = aggregator_set_data(agg.descriptor().field(dest_col).type(), tensor, agg, dest_col, num_rows, offset_in_frame,
+                                allow_sparse, string_pool.get());
             if (opt_error.has_value()) {
                 opt_error->raise(agg.descriptor().field(dest_col).name());
             }
@@ -271,10 +301,19 @@ std::vector<SliceAndKey> get_incomplete(
     return output;
 }
 
-void write_head(const std::shared_ptr<Store>& store, const AtomKey& next_key, size_t total_rows) {
-    ARCTICDB_DEBUG(log::version(), "Writing append map head with key {}", next_key);
-    auto desc = stream_descriptor(next_key.id(), RowCountIndex{}, {});
+void write_head(
+    const std::shared_ptr<Store>& store,
+    const AtomKey& next_key,
+    size_t total_rows,
+    const std::vector<AtomKey>& head_keys) {
+    ARCTICDB_DEBUG(log::version(), "Writing append map head with key {} and {} indexed keys", next_key, head_keys.size());
+    util::check(head_keys.empty() || head_keys[0] == next_key,
+                "Append map chain index should start with the head key {}", next_key);
+    auto desc = idx_stream_desc(next_key.id(), RowCountIndex{});
     SegmentInMemory segment(desc);
+    for(const auto& key : head_keys)
+        write_key_to_segment(segment, key);
+
     auto tsd = pack_timeseries_descriptor(std::move(desc), total_rows, next_key, {});
     segment.set_timeseries_descriptor(std::move(tsd));
     store->write(KeyType::APPEND_REF, next_key.id(), std::move(segment)).get();
@@ -284,6 +323,89 @@ void remove_incomplete_segments(
     const std::shared_ptr<Store>& store,
     const StreamId& stream_id) {
     delete_keys_of_type_for_stream(store, stream_id, KeyType::APPEND_DATA);
+    delete_keys_of_type_for_stream(store, stream_id, KeyType::APPEND_MANIFEST);
+}
+
+std::optional<std::vector<AtomKey>> read_manifest(const std::shared_ptr<StreamSource>& store, const AtomKey& manifest_key) {
+    try {
+        auto [key, seg] = store->read(manifest_key).get();
+        std::vector<AtomKey> output;
+        output.reserve(seg.row_count());
+        for(ssize_t row = 0; row < ssize_t(seg.row_count()); ++row)
+            output.emplace_back(read_key_row(seg, row));
+
+        return output;
+    } catch (const storage::KeyNotFoundException&) {
+        ARCTICDB_DEBUG(log::version(), "Append manifest {} not found", manifest_key);
+        return std::nullopt;
+    }
+}
+
+// The keys older than the given one, found by following the chain one storage round-trip at a time
+std::vector<AtomKey> walk_chain_from(const std::shared_ptr<StreamSource>& store, const AtomKey& key) {
+    std::vector<AtomKey> output;
+    try {
+        auto next_key = entry_from_key(store, key, false).next_key_;
+        while(next_key) {
+            auto entry = entry_from_key(store, *next_key, false);
+            output.emplace_back(std::move(*next_key));
+            next_key = std::move(entry.next_key_);
+        }
+    } catch (const storage::KeyNotFoundException&) {
+        // Most likely compacted up to this point
+    }
+    return output;
+}
+
+// The keys indexed by the head's manifest. The manifest is only missing if it has been replaced since the head was
+// read, or compacted away along with the incompletes it indexed, so the incompletes it held are found by walking the
+// chain on from the oldest key in the tail, which yields nothing in the latter case
+std::vector<AtomKey> read_manifest_or_walk(const std::shared_ptr<StreamSource>& store, const AppendHead& head) {
+    if(!head.manifest_key_)
+        return {};
+
+    if(auto indexed = read_manifest(store, *head.manifest_key_))
+        return std::move(*indexed);
+
+    return walk_chain_from(store, head.tail_.back());
+}
+
+std::vector<AppendMapEntry> load_via_index(
+        const std::shared_ptr<Store>& store,
+        const std::vector<AtomKey>& chain_index,
+        bool load_data) {
+    ARCTICDB_DEBUG(log::version(), "Loading {} indexed incomplete segments", chain_index.size());
+    std::vector<folly::Future<std::pair<TimeseriesDescriptor, std::optional<SegmentInMemory>>>> futures;
+    futures.reserve(chain_index.size());
+    for(const auto& key : chain_index) {
+        if(load_data) {
+            futures.emplace_back(store->read(key).thenValue([] (auto&& key_seg) {
+                auto& seg = key_seg.second;
+                TimeseriesDescriptor tsd{seg.timeseries_proto(), seg.index_fields()};
+                return std::make_pair(std::move(tsd), std::make_optional<SegmentInMemory>(std::move(seg)));
+            }));
+        } else {
+            futures.emplace_back(folly::makeFutureWith([&store, &key] () {
+                return store->read_timeseries_descriptor(key);
+            }).thenValue([] (auto&& key_tsd) {
+                return std::make_pair(std::move(key_tsd.second), std::optional<SegmentInMemory>{});
+            }));
+        }
+    }
+
+    auto results = folly::collectAll(futures).get();
+    std::vector<AppendMapEntry> output;
+    output.reserve(results.size());
+    for(size_t idx = 0; idx < results.size(); ++idx) {
+        try {
+            auto [tsd, seg] = std::move(results[idx]).value();
+            output.emplace_back(entry_from_descriptor(std::move(tsd), std::move(seg), chain_index[idx]));
+        } catch (const storage::KeyNotFoundException&) {
+            // Most likely compacted up to this point, everything older than this has gone as well
+            break;
+        }
+    }
+    return output;
 }
 
 std::vector<AppendMapEntry> load_via_list(
@@ -295,7 +417,29 @@ std::vector<AppendMapEntry> load_via_list(
     ARCTICDB_DEBUG(log::version(), "Getting incomplete segments for stream {}", stream_id);
     ARCTICDB_SAMPLE_DEFAULT(GetIncomplete)
 
-    auto [next_key, total_rows] = read_head(store, stream_id);
+    auto head = read_head_and_index(store, stream_id);
+    // A manifest that has gone was most likely replaced by an append since the head was read, in which case the
+    // current head indexes the same incompletes
+    for(size_t attempt = 0; attempt < ManifestReadAttempts && head.has_chain_index() && head.manifest_key_; ++attempt) {
+        auto indexed = read_manifest(store, *head.manifest_key_);
+        if(!indexed) {
+            head = read_head_and_index(store, stream_id);
+            continue;
+        }
+
+        auto keys = std::move(head.tail_);
+        keys.insert(std::end(keys), std::make_move_iterator(std::begin(*indexed)), std::make_move_iterator(std::end(*indexed)));
+        return load_via_index(store, keys, load_data);
+    }
+
+    if(head.has_chain_index()) {
+        auto indexed = read_manifest_or_walk(store, head);
+        auto keys = std::move(head.tail_);
+        keys.insert(std::end(keys), std::make_move_iterator(std::begin(indexed)), std::make_move_iterator(std::end(indexed)));
+        return load_via_index(store, keys, load_data);
+    }
+
+    auto next_key = std::move(head.next_key_);
     std::vector<AppendMapEntry> output;
 
     try {
@@ -310,9 +454,9 @@ std::vector<AppendMapEntry> load_via_list(
     return output;
 }
 
-std::pair<std::optional<AtomKey>, size_t> read_head(const std::shared_ptr<StreamSource>& store, StreamId stream_id) {
+AppendHead read_head_and_index(const std::shared_ptr<StreamSource>& store, StreamId stream_id) {
     auto ref_key = RefKey{std::move(stream_id), KeyType::APPEND_REF};
-    auto output = std::make_pair<std::optional<AtomKey>, size_t>(std::nullopt, 0);
+    AppendHead output;
 
     if(!has_appends_key(store, ref_key))
         return output;
@@ -321,13 +465,27 @@ std::pair<std::optional<AtomKey>, size_t> read_head(const std::shared_ptr<Stream
     auto [key, seg] = std::move(fut).get();
     const auto& tsd = seg.index_descriptor();
     if(tsd.proto().has_next_key()) {
-        output.first = decode_key(tsd.proto().next_key());
+        output.next_key_ = decode_key(tsd.proto().next_key());
+    }
+
+    output.total_rows_ = tsd.proto().total_rows();
+    output.tail_.reserve(seg.row_count());
+    for(ssize_t row = 0; row < ssize_t(seg.row_count()); ++row) {
+        auto row_key = read_key_row(seg, row);
+        if(row_key.type() == KeyType::APPEND_MANIFEST)
+            output.manifest_key_ = std::move(row_key);
+        else
+            output.tail_.emplace_back(std::move(row_key));
     }
 
-    output.second = tsd.proto().total_rows();
     return output;
 }
 
+std::pair<std::optional<AtomKey>, size_t> read_head(const std::shared_ptr<StreamSource>& store, StreamId stream_id) {
+    auto head = read_head_and_index(store, std::move(stream_id));
+    return std::make_pair(std::move(head.next_key_), head.total_rows_);
+}
+
 std::pair<TimeseriesDescriptor, std::optional<SegmentInMemory>> get_descriptor_and_data(
     const std::shared_ptr<StreamSource>& store,
     const AtomKey& k,
@@ -353,8 +511,11 @@ AppendMapEntry create_entry(const arcticdb::proto::descriptors::TimeSeriesDescri
 
 AppendMapEntry entry_from_key(const std::shared_ptr<StreamSource>& store, const AtomKey& key, bool load_data) {
     auto [tsd, seg] = get_descriptor_and_data(store, key, load_data);
+    return entry_from_descriptor(std::move(tsd), std::move(seg), key);
+}
+
+AppendMapEntry entry_from_descriptor(TimeseriesDescriptor&& tsd, std::optional<SegmentInMemory>&& seg, const AtomKey& key) {
     auto entry = create_entry(tsd.proto());
-    auto descriptor = std::make_shared<StreamDescriptor>();
     auto desc = std::make_shared<StreamDescriptor>(tsd.as_stream_descriptor());
     auto index_field_count = desc->index().field_count();
     auto field_count = desc->fields().size();
@@ -366,6 +527,75 @@ AppendMapEntry entry_from_key(const std::shared_ptr<StreamSource>& store, const
     return entry;
 }
 
+size_t manifest_interval() {
+    return static_cast<size_t>(std::max<int64_t>(1, ConfigsMap::instance()->get_int("Append.ManifestInterval", 100)));
+}
+
+// Drops the keys from the first one that has gone. Incompletes are compacted oldest first, so the keys still present
+// are a prefix of the chain, and finding its end takes a logarithmic number of round-trips
+void trim_compacted(const std::shared_ptr<Store>& store, std::vector<AtomKey>& keys) {
+    size_t lo = 0;
+    size_t hi = keys.size();
+    while(lo < hi) {
+        const auto mid = lo + (hi - lo) / 2;
+        if(store->key_exists(keys[mid]).get())
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    keys.erase(std::begin(keys) + static_cast<ssize_t>(lo), std::end(keys));
+}
+
+AtomKey write_manifest(const std::shared_ptr<Store>& store, const StreamId& stream_id, const std::vector<AtomKey>& keys) {
+    auto desc = idx_stream_desc(stream_id, RowCountIndex{});
+    SegmentInMemory segment(desc);
+    for(const auto& key : keys)
+        write_key_to_segment(segment, key);
+
+    return to_atom(store->write(KeyType::APPEND_MANIFEST, 0, stream_id, 0, 0, std::move(segment)).get());
+}
+
+// The rows of the head that follows the given one once new_key has been appended
+std::vector<AtomKey> next_head_keys(const std::shared_ptr<Store>& store, const AtomKey& new_key, AppendHead&& head) {
+    if(!head.has_chain_index()) {
+        // Chains started by older clients are not indexed, so can only be walked until they have been compacted
+        if(head.next_key_ && store->key_exists(*head.next_key_).get())
+            return {};
+
+        return {new_key};
+    }
+
+    std::vector<AtomKey> output;
+    output.reserve(head.tail_.size() + 2);
+    output.emplace_back(new_key);
+    output.insert(std::end(output), std::begin(head.tail_), std::end(head.tail_));
+    if(output.size() <= manifest_interval()) {
+        if(head.manifest_key_)
+            output.emplace_back(*head.manifest_key_);
+
+        return output;
+    }
+
+    // Fold everything but the new key into a new manifest, dropping any keys that have since been compacted
+    std::vector<AtomKey> indexed(std::make_move_iterator(std::next(std::begin(output))), std::make_move_iterator(std::end(output)));
+    auto previous = read_manifest_or_walk(store, head);
+    indexed.insert(std::end(indexed), std::make_move_iterator(std::begin(previous)), std::make_move_iterator(std::end(previous)));
+    trim_compacted(store, indexed);
+    output.resize(1);
+    if(!indexed.empty())
+        output.emplace_back(write_manifest(store, new_key.id(), indexed));
+
+    return output;
+}
+
+void update_head(const std::shared_ptr<Store>& store, const AtomKey& new_key, size_t total_rows, AppendHead&& head) {
+    auto previous_manifest = head.manifest_key_;
+    auto head_keys = next_head_keys(store, new_key, std::move(head));
+    write_head(store, new_key, total_rows, head_keys);
+    if(previous_manifest && (head_keys.empty() || head_keys.back() != *previous_manifest))
+        store->remove_key(*previous_manifest, storage::RemoveOpts{true}).get();
+}
+
 void append_incomplete(
         const std::shared_ptr<Store>& store,
         const StreamId& stream_id,
@@ -375,15 +605,13 @@ void append_incomplete(
     ARCTICDB_SAMPLE_DEFAULT(AppendIncomplete)
     ARCTICDB_DEBUG(log::version(), "Writing incomplete frame for stream {}", stream_id);
 
-    auto [next_key, total_rows] = read_head(store, stream_id);
+    auto head = read_head_and_index(store, stream_id);
     const auto num_rows = frame.num_rows;
-    total_rows += num_rows;
-    auto desc = frame.desc.clone();
-    auto new_key = write_incomplete_frame(store, stream_id, std::move(frame), std::move(next_key)).get();
-
+    auto total_rows = head.total_rows_ + num_rows;
+    auto new_key = write_incomplete_frame(store, stream_id, std::move(frame), std::optional<AtomKey>{head.next_key_}).get();
 
     ARCTICDB_DEBUG(log::version(), "Wrote incomplete frame for stream {}, {} rows, total rows {}", stream_id, num_rows, total_rows);
-    write_head(store, to_atom(new_key), total_rows);
+    update_head(store, to_atom(new_key), total_rows, std::move(head));
 }
 
 void append_incomplete_segment(
@@ -395,13 +623,13 @@ void append_incomplete_segment(
     ARCTICDB_SAMPLE_DEFAULT(AppendIncomplete)
     ARCTICDB_DEBUG(log::version(), "Writing incomplete segment for stream {}", stream_id);
 
-    auto [next_key, total_rows] = read_head(store, stream_id);
+    auto head = read_head_and_index(store, stream_id);
 
     auto start_index = TimeseriesIndex::start_value_for_segment(seg);
     auto end_index = TimeseriesIndex::end_value_for_segment(seg);
     auto seg_row_count = seg.row_count();
 
-    auto tsd = pack_timeseries_descriptor(seg.descriptor().clone(), seg_row_count, std::move(next_key), {});
+    auto tsd = pack_timeseries_descriptor(seg.descriptor().clone(), seg_row_count, std::optional<AtomKey>{head.next_key_}, {});
     seg.set_timeseries_descriptor(std::move(tsd));
     util::check(static_cast<bool>(seg.metadata()), "Expected metadata");
     auto new_key = store->write(
@@ -412,9 +640,9 @@ void append_incomplete_segment(
             end_index,
             std::move(seg)).get();
 
-    total_rows += seg_row_count;
+    auto total_rows = head.total_rows_ + seg_row_count;
     ARCTICDB_DEBUG(log::version(), "Wrote incomplete frame for stream {}, {} rows, total rows {}", stream_id, seg_row_count, total_rows);
-    write_head(store, to_atom(std::move(new_key)), total_rows);
+    update_head(store, to_atom(new_key), total_rows, std::move(head));
 }
 
 std::vector<AppendMapEntry> get_incomplete_append_slices_for_stream_id(
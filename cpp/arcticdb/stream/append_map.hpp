@@ -58,7 +58,8 @@ void write_parallel(
 void write_head(
     const std::shared_ptr<Store>& store,
     const AtomKey& next_key,
-    size_t total_rows);
+    size_t total_rows,
+    const std::vector<AtomKey>& head_keys = {});
 
 void append_incomplete_segment(
     const std::shared_ptr<Store>& store,
@@ -44,6 +44,20 @@ struct StreamSource {
         entity::IterateTypeVisitor func,
         const std::string &prefix = std::string{}) = 0;
 
+    /*
+     * As iterate_type without a prefix, but lists ranges of the key space concurrently where the storage supports it.
+     * The visitor is never called concurrently, but keys arrive in no particular order. Must not be called from an
+     * IO task, as it waits on IO tasks of its own.
+     */
+    virtual void iterate_type_parallel(
+        KeyType type,
+        entity::IterateTypeVisitor func) = 0;
+
+    virtual void iterate_type_with_size(
+        KeyType type,
+        entity::IterateTypeWithSizeVisitor func,
+        const std::string &prefix = std::string{}) = 0;
+
     [[nodiscard]] virtual folly::Future<bool> key_exists(const entity::VariantKey &key) = 0;
     virtual bool key_exists_sync(const entity::VariantKey &key) = 0;
     virtual bool supports_prefix_matching() const = 0;
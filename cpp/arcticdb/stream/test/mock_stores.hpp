@@ -150,6 +150,8 @@ class NullStore :
 
     void set_failure_sim(const arcticdb::proto::storage::VersionStoreConfig::StorageFailureSimulator &) override {}
 
+    void set_key_type_codec(KeyType, const std::optional<arcticdb::proto::encoding::VariantCodec>&) override {}
+
 };
 
 } //namespace arcticdb
\ No newline at end of file
@@ -9,10 +9,12 @@
 
 #include <arcticdb/stream/test/stream_test_common.hpp>
 #include <arcticdb/stream/append_map.hpp>
+#include <arcticdb/stream/stream_utils.hpp>
 #include <arcticdb/async/task_scheduler.hpp>
 #include <arcticdb/storage/test/in_memory_store.hpp>
 #include <arcticdb/entity/merge_descriptors.hpp>
 #include <arcticdb/pipeline/read_frame.hpp>
+#include <arcticdb/util/configs_map.hpp>
 
 TEST(Append, Simple) {
     using namespace arcticdb;
@@ -39,6 +41,100 @@ TEST(Append, Simple) {
     ASSERT_EQ(allocated_frame.row_count(), size_t(frame.num_rows));
 }
 
+TEST(Append, ChainIndex) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    auto store = std::make_shared<InMemoryStore>();
+    StreamId stream_id{"test_append_chain_index"};
+    constexpr size_t num_appends = 5;
+    for(size_t i = 0; i < num_appends; ++i) {
+        auto wrapper = get_test_simple_frame(stream_id, 10, i * 10);
+        append_incomplete(store, stream_id, std::move(wrapper.frame_));
+    }
+
+    auto head_seg = store->read_sync(RefKey{stream_id, KeyType::APPEND_REF}, storage::ReadKeyOpts{}).second;
+    ASSERT_EQ(head_seg.row_count(), num_appends);
+
+    pipelines::FilterRange range;
+    auto incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), num_appends);
+
+    // Losing a key from the middle of the chain hides everything older than it, as with walking the chain
+    auto [next_key, total_rows] = read_head(store, stream_id);
+    ASSERT_EQ(total_rows, num_appends * 10);
+    ASSERT_EQ(stream::read_key_row(head_seg, 0), next_key.value());
+    auto missing_key = stream::read_key_row(head_seg, 2);
+    store->remove_key_sync(missing_key, {});
+    incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), 2u);
+
+    // Once the incompletes have been compacted away the index restarts
+    for(const auto& incomplete : incompletes)
+        store->remove_key_sync(incomplete.key(), {});
+
+    auto wrapper = get_test_simple_frame(stream_id, 10, num_appends * 10);
+    append_incomplete(store, stream_id, std::move(wrapper.frame_));
+    incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), 1u);
+}
+
+TEST(Append, ChainManifest) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    ScopedConfig interval("Append.ManifestInterval", 3);
+    auto store = std::make_shared<InMemoryStore>();
+    StreamId stream_id{"test_append_chain_manifest"};
+    auto append = [&] (size_t count, size_t start) {
+        for(size_t i = start; i < start + count; ++i) {
+            auto wrapper = get_test_simple_frame(stream_id, 10, i * 10);
+            append_incomplete(store, stream_id, std::move(wrapper.frame_));
+        }
+    };
+    auto manifest_count = [&] () {
+        size_t count = 0;
+        store->iterate_type(KeyType::APPEND_MANIFEST, [&count] (auto&&) { ++count; });
+        return count;
+    };
+
+    // The head never holds more than the interval's worth of keys plus the manifest, and replaced manifests are removed
+    constexpr size_t num_appends = 10;
+    append(num_appends, 0);
+    auto head_seg = store->read_sync(RefKey{stream_id, KeyType::APPEND_REF}, storage::ReadKeyOpts{}).second;
+    ASSERT_LE(head_seg.row_count(), 4u);
+    ASSERT_EQ(stream::read_key_row(head_seg, head_seg.row_count() - 1).type(), KeyType::APPEND_MANIFEST);
+    ASSERT_EQ(manifest_count(), 1u);
+
+    pipelines::FilterRange range;
+    auto incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), num_appends);
+
+    // A manifest replaced after the head was read must not hide the incompletes it indexed, nor must they be dropped
+    // from the next manifest
+    auto manifest_key = stream::read_key_row(head_seg, head_seg.row_count() - 1);
+    store->remove_key_sync(manifest_key, {});
+    incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), num_appends);
+    append(3, num_appends);
+    incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), num_appends + 3);
+    ASSERT_EQ(manifest_count(), 1u);
+
+    // Compacted keys are dropped when the head is next folded into a manifest
+    for(const auto& incomplete : incompletes)
+        store->remove_key_sync(incomplete.key(), {});
+
+    append(3, num_appends + 3);
+    incompletes = get_incomplete(store, stream_id, range, 0, false, false);
+    ASSERT_EQ(incompletes.size(), 3u);
+    head_seg = store->read_sync(RefKey{stream_id, KeyType::APPEND_REF}, storage::ReadKeyOpts{}).second;
+    ASSERT_EQ(stream::read_key_row(head_seg, head_seg.row_count() - 1).type(), KeyType::APPEND_MANIFEST);
+    auto manifest = store->read_sync(stream::read_key_row(head_seg, head_seg.row_count() - 1), storage::ReadKeyOpts{}).second;
+    ASSERT_LE(manifest.row_count(), 3u);
+    ASSERT_EQ(manifest_count(), 1u);
+}
+
 TEST(Append, MergeDescriptorsPromote) {
     using namespace arcticdb;
 
@@ -0,0 +1,105 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/stream/tick_writer.hpp>
+#include <arcticdb/stream/test/stream_test_common.hpp>
+#include <arcticdb/storage/test/in_memory_store.hpp>
+
+namespace {
+
+arcticdb::StreamDescriptor tick_descriptor(const arcticdb::StreamId& id) {
+    using namespace arcticdb::entity;
+    return get_test_descriptor<arcticdb::stream::TimeseriesIndex>(id, {
+        scalar_field(DataType::INT64, "bid_size"),
+        scalar_field(DataType::FLOAT64, "bid"),
+        scalar_field(DataType::UTF_DYNAMIC64, "venue"),
+    });
+}
+
+struct TickWriterTest : testing::Test {
+    void SetUp() override {
+        wal_dir_ = std::filesystem::temp_directory_path() / fmt::format("arcticdb_tick_writer_{}", ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(wal_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(wal_dir_);
+    }
+
+    std::filesystem::path wal_dir_;
+};
+
+}
+
+TEST_F(TickWriterTest, BatchesRows) {
+    using namespace arcticdb;
+    using namespace arcticdb::stream;
+
+    auto store = std::make_shared<InMemoryStore>();
+    auto segments = std::make_shared<std::vector<SegmentInMemory>>();
+    TickWriterOptions options;
+    options.max_flush_interval = 60 * ONE_SECOND;
+    {
+        TickWriter writer{store, tick_descriptor("ticks"), wal_dir_, options, TickSegmentSink{[segments] (SegmentInMemory&& seg) {
+            segments->emplace_back(std::move(seg));
+        }}};
+
+        for(timestamp i = 0; i < 10; ++i)
+            writer.append(i, {int64_t(i * 100), 1.5 + double(i), std::string{"LSE"}});
+
+        ASSERT_EQ(writer.buffered_rows(), 10u);
+        writer.flush();
+        ASSERT_EQ(writer.buffered_rows(), 0u);
+        ASSERT_EQ(segments->size(), 1u);
+
+        writer.append(10, {int64_t(1000), 11.5, std::string{"XETRA"}});
+        ASSERT_THROW(writer.append(5, {int64_t(0), 0.0, std::string{}}), SortingException);
+        ASSERT_THROW(writer.append(11, {int64_t(0)}), ArcticException);
+    }
+
+    // The destructor flushes the rest, and once everything is flushed no logs are left behind
+    ASSERT_EQ(segments->size(), 2u);
+    ASSERT_EQ(segments->at(0).row_count(), 10u);
+    ASSERT_EQ(segments->at(1).row_count(), 1u);
+    ASSERT_EQ(segments->at(0).scalar_at<int64_t>(3, 1).value(), 300);
+    ASSERT_EQ(segments->at(0).string_at(3, 3).value(), "LSE");
+    ASSERT_TRUE(std::filesystem::is_empty(wal_dir_));
+}
+
+TEST_F(TickWriterTest, RecoversUnflushedRows) {
+    using namespace arcticdb;
+    using namespace arcticdb::stream;
+
+    auto store = std::make_shared<InMemoryStore>();
+    TickWriterOptions options;
+    options.max_flush_interval = 60 * ONE_SECOND;
+    const size_t num_rows = 25;
+    {
+        // Storage is unavailable for the whole life of this writer, so nothing is delivered
+        TickWriter writer{store, tick_descriptor("ticks"), wal_dir_, options, TickSegmentSink{[] (SegmentInMemory&&) {
+            throw std::runtime_error("storage unavailable");
+        }}};
+        for(size_t i = 0; i < num_rows; ++i)
+            writer.append(timestamp(i), {int64_t(i), double(i), fmt::format("v{}", i)});
+
+        ASSERT_THROW(writer.flush(), std::runtime_error);
+    }
+
+    auto segments = std::make_shared<std::vector<SegmentInMemory>>();
+    TickWriter writer{store, tick_descriptor("ticks"), wal_dir_, options, TickSegmentSink{[segments] (SegmentInMemory&& seg) {
+        segments->emplace_back(std::move(seg));
+    }}};
+    ASSERT_EQ(writer.recovered_rows(), num_rows);
+    ASSERT_EQ(segments->size(), 1u);
+    ASSERT_EQ(segments->at(0).row_count(), num_rows);
+    ASSERT_EQ(segments->at(0).string_at(num_rows - 1, 3).value(), fmt::format("v{}", num_rows - 1));
+
+    // A recovered writer keeps enforcing ordering against the replayed rows
+    ASSERT_THROW(writer.append(0, {int64_t(0), 0.0, std::string{}}), SortingException);
+}
@@ -0,0 +1,426 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/stream/tick_writer.hpp>
+#include <arcticdb/stream/append_map.hpp>
+#include <arcticdb/util/hash.hpp>
+#include <arcticdb/util/preconditions.hpp>
+#include <arcticdb/util/clock.hpp>
+#include <arcticdb/log/log.hpp>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace arcticdb::stream {
+
+namespace {
+
+constexpr uint64_t WalMagic = 0x314C415754434954; // "TICTWAL1"
+constexpr const char* WalExtension = ".wal";
+
+/*
+ * Log layout: a header of the magic, the field count and the data type of each field, followed by records of
+ * [uint32 payload size][uint64 payload hash][payload]. The payload is the int64 timestamp followed by each value as
+ * a uint8 variant index and either 8 bytes or a uint32 length and the string bytes. A truncated or corrupt record
+ * marks the end of the log, as it can only be the tail of a write interrupted by a crash.
+ */
+template<typename T>
+void put(std::vector<uint8_t>& buffer, const T& val) {
+    const auto pos = buffer.size();
+    buffer.resize(pos + sizeof(T));
+    std::memcpy(buffer.data() + pos, &val, sizeof(T));
+}
+
+template<typename T>
+bool get(const uint8_t*& pos, const uint8_t* end, T& val) {
+    if(size_t(end - pos) < sizeof(T))
+        return false;
+
+    std::memcpy(&val, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+void encode_row(std::vector<uint8_t>& buffer, timestamp ts, const std::vector<TickValue>& values) {
+    put(buffer, ts);
+    for(const auto& value : values) {
+        put(buffer, static_cast<uint8_t>(value.index()));
+        std::visit([&buffer] (const auto& val) {
+            using ValueType = std::decay_t<decltype(val)>;
+            if constexpr (std::is_same_v<ValueType, std::string>) {
+                put(buffer, static_cast<uint32_t>(val.size()));
+                buffer.insert(buffer.end(), val.begin(), val.end());
+            } else {
+                put(buffer, val);
+            }
+        }, value);
+    }
+}
+
+bool decode_row(const uint8_t* pos, const uint8_t* end, size_t num_values, timestamp& ts, std::vector<TickValue>& values) {
+    values.clear();
+    if(!get(pos, end, ts))
+        return false;
+
+    for(size_t i = 0; i < num_values; ++i) {
+        uint8_t index;
+        if(!get(pos, end, index))
+            return false;
+
+        switch(index) {
+        case 0: { int64_t val; if(!get(pos, end, val)) return false; values.emplace_back(val); break; }
+        case 1: { uint64_t val; if(!get(pos, end, val)) return false; values.emplace_back(val); break; }
+        case 2: { double val; if(!get(pos, end, val)) return false; values.emplace_back(val); break; }
+        case 3: {
+            uint32_t size;
+            if(!get(pos, end, size) || size_t(end - pos) < size)
+                return false;
+
+            values.emplace_back(std::string(reinterpret_cast<const char*>(pos), size));
+            pos += size;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return pos == end;
+}
+
+std::vector<uint8_t> wal_header(const StreamDescriptor& desc) {
+    std::vector<uint8_t> header;
+    put(header, WalMagic);
+    put(header, static_cast<uint32_t>(desc.field_count()));
+    for(const auto& field : desc.fields())
+        put(header, static_cast<uint8_t>(field.type().data_type()));
+
+    return header;
+}
+
+void write_or_throw(std::FILE* file, const std::vector<uint8_t>& buffer, const std::filesystem::path& path) {
+    util::check_rte(std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() && std::fflush(file) == 0,
+                    "Failed to write to tick write-ahead log {}", path.string());
+}
+
+void sync_file(std::FILE* file) {
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    ::fsync(::fileno(file));
+#endif
+}
+
+std::optional<uint64_t> generation_from_path(const std::filesystem::path& path) {
+    if(path.extension() != WalExtension)
+        return std::nullopt;
+
+    try {
+        return std::stoull(path.stem().string());
+    } catch(const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+void remove_wal_files(const std::vector<std::filesystem::path>& paths) {
+    for(const auto& path : paths) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if(ec)
+            log::version().warn("Failed to remove flushed tick write-ahead log {}: {}", path.string(), ec.message());
+    }
+}
+
+void check_tick_value(const Field& field, const TickValue& value) {
+    const auto data_type = field.type().data_type();
+    util::check_arg(is_sequence_type(data_type) || is_numeric_type(data_type) || is_bool_type(data_type),
+                    "Unsupported type {} for tick column {}", data_type, field.name());
+    util::check_arg(is_sequence_type(data_type) == std::holds_alternative<std::string>(value),
+                    "Value of the wrong kind for tick column {} of type {}", field.name(), data_type);
+}
+
+template<typename RowBuilderType>
+void set_tick_value(RowBuilderType& row_builder, const Field& field, size_t pos, const TickValue& value) {
+    visit_field(field, [&] (auto type_desc_tag) {
+        using DataTypeTag = typename decltype(type_desc_tag)::DataTypeTag;
+        using RawType = typename DataTypeTag::raw_type;
+        if constexpr (is_sequence_type(DataTypeTag::data_type)) {
+            row_builder.set_string(pos, std::get<std::string>(value));
+        } else if constexpr (is_numeric_type(DataTypeTag::data_type) || is_bool_type(DataTypeTag::data_type)) {
+            std::visit([&row_builder, pos] (const auto& val) {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(val)>, std::string>)
+                    row_builder.set_scalar(pos, static_cast<RawType>(val));
+            }, value);
+        }
+    });
+}
+
+} // namespace
+
+TickWriter::TickWriter(
+    std::shared_ptr<Store> store,
+    StreamDescriptor desc,
+    std::filesystem::path wal_dir,
+    TickWriterOptions options,
+    std::optional<TickSegmentSink> sink) :
+    store_(std::move(store)),
+    desc_(std::move(desc)),
+    wal_dir_(std::move(wal_dir)),
+    options_(options),
+    agg_(FixedSchema{desc_, TimeseriesIndex::make_from_descriptor(desc_)}, [this] (auto&& segment) {
+        committed_segment_ = std::forward<SegmentInMemory>(segment);
+    }) {
+    util::check_arg(desc_.index().type() == IndexDescriptor::TIMESTAMP, "Tick writer requires a timestamp index");
+    for(const auto& field : desc_.fields())
+        util::check_arg(field.type().dimension() == Dimension::Dim0, "Tick writer only supports scalar columns, got {}", field.name());
+
+    if(sink) {
+        sink_ = std::move(*sink);
+    } else {
+        sink_ = [store = store_, stream_id = desc_.id()] (SegmentInMemory&& segment) {
+            append_incomplete_segment(store, stream_id, std::move(segment));
+        };
+    }
+
+    std::filesystem::create_directories(wal_dir_);
+    recover();
+    open_wal();
+    if(recovered_rows_ > 0) {
+        try {
+            flush();
+        } catch(const std::exception&) {
+            // The destructor does not run for a constructor that throws
+            std::fclose(wal_file_);
+            wal_file_ = nullptr;
+            throw;
+        }
+    }
+
+    flusher_ = std::thread([this] { run_flusher(); });
+}
+
+TickWriter::~TickWriter() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    flush_cv_.notify_all();
+    if(flusher_.joinable())
+        flusher_.join();
+
+    try {
+        flush();
+    } catch(const std::exception& e) {
+        log::version().error("Failed to flush tick writer for {} on shutdown, rows remain in the write-ahead log: {}", desc_.id(), e.what());
+    }
+
+    if(wal_file_ != nullptr)
+        std::fclose(wal_file_);
+
+    // With everything flushed the remaining logs hold no rows, and would otherwise pile up over restarts
+    if(agg_.row_count() == 0 && failed_flushes_.empty())
+        remove_wal_files(unflushed_wal_files_);
+}
+
+std::filesystem::path TickWriter::wal_path(uint64_t generation) const {
+    return wal_dir_ / fmt::format("{:020}{}", generation, WalExtension);
+}
+
+void TickWriter::check_row(timestamp ts, const std::vector<TickValue>& values) const {
+    const auto index_field_count = desc_.index().field_count();
+    util::check_arg(values.size() + index_field_count == desc_.field_count(),
+                    "Expected {} tick values, got {}", desc_.field_count() - index_field_count, values.size());
+    sorting::check<ErrorCode::E_UNSORTED_DATA>(!last_ts_ || ts >= *last_ts_,
+                    "Tick timestamps must not decrease: {} after {}", ts, last_ts_.value_or(0));
+
+    for(size_t i = 0; i < values.size(); ++i)
+        check_tick_value(desc_.fields(i + index_field_count), values[i]);
+}
+
+void TickWriter::add_row(timestamp ts, const std::vector<TickValue>& values) {
+    const auto index_field_count = desc_.index().field_count();
+    agg_.start_row(ts)([&] (auto& row_builder) {
+        for(size_t i = 0; i < values.size(); ++i)
+            set_tick_value(row_builder, desc_.fields(i + index_field_count), i + index_field_count, values[i]);
+    });
+    last_ts_ = ts;
+}
+
+void TickWriter::append(timestamp ts, const std::vector<TickValue>& values) {
+    bool should_flush;
+    {
+        std::lock_guard lock{mutex_};
+        record_buffer_.clear();
+        put(record_buffer_, uint32_t{0});
+        put(record_buffer_, uint64_t{0});
+        encode_row(record_buffer_, ts, values);
+        const auto header_size = sizeof(uint32_t) + sizeof(uint64_t);
+        const auto payload_size = static_cast<uint32_t>(record_buffer_.size() - header_size);
+        const auto payload_hash = static_cast<uint64_t>(hash(record_buffer_.data() + header_size, payload_size));
+        std::memcpy(record_buffer_.data(), &payload_size, sizeof(payload_size));
+        std::memcpy(record_buffer_.data() + sizeof(payload_size), &payload_hash, sizeof(payload_hash));
+
+        // The log never holds a row that cannot be replayed, and a row is only buffered once it is logged
+        check_row(ts, values);
+        write_or_throw(wal_file_, record_buffer_, wal_path(wal_generation_));
+        if(options_.sync_every_append)
+            sync_file(wal_file_);
+
+        add_row(ts, values);
+
+        should_flush = agg_.row_count() >= options_.max_rows_per_segment;
+    }
+    if(should_flush)
+        flush_cv_.notify_one();
+}
+
+size_t TickWriter::buffered_rows() const {
+    std::lock_guard lock{mutex_};
+    return const_cast<TickAggregator&>(agg_).row_count();
+}
+
+void TickWriter::recover() {
+    std::vector<std::pair<uint64_t, std::filesystem::path>> files;
+    for(const auto& entry : std::filesystem::directory_iterator(wal_dir_)) {
+        if(auto generation = generation_from_path(entry.path()); generation)
+            files.emplace_back(*generation, entry.path());
+    }
+    std::sort(std::begin(files), std::end(files));
+
+    const auto expected_header = wal_header(desc_);
+    const auto num_values = desc_.field_count() - desc_.index().field_count();
+    std::vector<TickValue> values;
+    for(const auto& [generation, path] : files) {
+        wal_generation_ = std::max(wal_generation_, generation + 1);
+        unflushed_wal_files_.emplace_back(path);
+        std::vector<uint8_t> contents(std::filesystem::file_size(path));
+        {
+            std::FILE* file = std::fopen(path.string().c_str(), "rb");
+            util::check_rte(file != nullptr, "Failed to open tick write-ahead log {}", path.string());
+            const auto read = std::fread(contents.data(), 1, contents.size(), file);
+            std::fclose(file);
+            contents.resize(read);
+        }
+        util::check_rte(contents.size() >= expected_header.size() &&
+                        std::equal(expected_header.begin(), expected_header.end(), contents.begin()),
+                        "Tick write-ahead log {} was written with a different descriptor for {}", path.string(), desc_.id());
+
+        const uint8_t* pos = contents.data() + expected_header.size();
+        const uint8_t* end = contents.data() + contents.size();
+        while(pos < end) {
+            uint32_t payload_size;
+            uint64_t payload_hash;
+            if(!get(pos, end, payload_size) || !get(pos, end, payload_hash) || size_t(end - pos) < payload_size ||
+               hash(pos, payload_size) != payload_hash) {
+                log::version().warn("Discarding torn record at the end of tick write-ahead log {}", path.string());
+                break;
+            }
+
+            timestamp ts;
+            if(!decode_row(pos, pos + payload_size, num_values, ts, values)) {
+                log::version().warn("Discarding undecodable record in tick write-ahead log {}", path.string());
+                break;
+            }
+            check_row(ts, values);
+            add_row(ts, values);
+            ++recovered_rows_;
+            pos += payload_size;
+        }
+    }
+
+    if(recovered_rows_ > 0)
+        log::version().info("Recovered {} un-flushed ticks for {} from {} write-ahead log files", recovered_rows_, desc_.id(), files.size());
+}
+
+void TickWriter::open_wal() {
+    const auto path = wal_path(wal_generation_);
+    wal_file_ = std::fopen(path.string().c_str(), "wb");
+    util::check_rte(wal_file_ != nullptr, "Failed to create tick write-ahead log {}", path.string());
+    write_or_throw(wal_file_, wal_header(desc_), path);
+    unflushed_wal_files_.emplace_back(path);
+}
+
+void TickWriter::seal_wal() {
+    sync_file(wal_file_);
+    std::fclose(wal_file_);
+    wal_file_ = nullptr;
+    ++wal_generation_;
+    open_wal();
+}
+
+void TickWriter::flush_impl() {
+    std::lock_guard flush_lock{flush_mutex_};
+    std::vector<PendingFlush> to_flush;
+    {
+        std::lock_guard lock{mutex_};
+        to_flush = std::move(failed_flushes_);
+        failed_flushes_.clear();
+        if(agg_.row_count() > 0) {
+            agg_.commit();
+            util::check(committed_segment_.has_value(), "Expected a segment from the tick aggregator");
+            // Rows in the logs being sealed are all in the committed segment, new appends go to the next generation
+            auto wal_files = std::move(unflushed_wal_files_);
+            unflushed_wal_files_.clear();
+            seal_wal();
+            to_flush.emplace_back(PendingFlush{std::move(*committed_segment_), std::move(wal_files)});
+            committed_segment_.reset();
+        } else if(unflushed_wal_files_.size() > 1) {
+            // Logs before the current one with no buffered rows are empty, e.g. recovered from a writer that was
+            // shut down cleanly
+            std::vector<std::filesystem::path> empty_files(unflushed_wal_files_.begin(), std::prev(unflushed_wal_files_.end()));
+            unflushed_wal_files_.erase(unflushed_wal_files_.begin(), std::prev(unflushed_wal_files_.end()));
+            remove_wal_files(empty_files);
+        }
+    }
+
+    for(size_t i = 0; i < to_flush.size(); ++i) {
+        try {
+            ARCTICDB_DEBUG(log::version(), "Flushing {} ticks for {}", to_flush[i].segment_.row_count(), desc_.id());
+            sink_(SegmentInMemory{to_flush[i].segment_});
+        } catch(const std::exception& e) {
+            log::version().error("Failed to flush ticks for {}, will retry: {}", desc_.id(), e.what());
+            std::lock_guard lock{mutex_};
+            // Preserve the order of the segments, the failed one and all after it are retried next time
+            for(size_t j = i; j < to_flush.size(); ++j)
+                failed_flushes_.emplace_back(std::move(to_flush[j]));
+            throw;
+        }
+
+        remove_wal_files(to_flush[i].wal_files_);
+    }
+}
+
+void TickWriter::flush() {
+    flush_impl();
+}
+
+void TickWriter::run_flusher() {
+    const auto interval = std::chrono::nanoseconds(options_.max_flush_interval);
+    while(true) {
+        {
+            std::unique_lock lock{mutex_};
+            flush_cv_.wait_for(lock, interval, [this] {
+                return stopping_ || agg_.row_count() >= options_.max_rows_per_segment;
+            });
+            if(stopping_)
+                return;
+        }
+
+        try {
+            flush_impl();
+        } catch(const std::exception&) {
+            // Already logged, the rows are retried on the next flush
+        }
+    }
+}
+
+} // namespace arcticdb::stream
@@ -0,0 +1,117 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/types.hpp>
+#include <arcticdb/stream/aggregator.hpp>
+#include <arcticdb/storage/store.hpp>
+#include <arcticdb/util/constants.hpp>
+
+#include <folly/Function.h>
+#include <boost/core/noncopyable.hpp>
+
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <variant>
+
+namespace arcticdb::stream {
+
+// A single column value of a tick, converted to the column type of the writer's descriptor when the row is built
+using TickValue = std::variant<int64_t, uint64_t, double, std::string>;
+
+// Receives each batched segment. The default appends it to the symbol's incomplete segments.
+using TickSegmentSink = folly::Function<void(SegmentInMemory&&)>;
+
+struct TickWriterOptions {
+    // Flush once this many rows are buffered...
+    size_t max_rows_per_segment = 100'000;
+    // ...or once this long has passed since the last flush, whichever comes first
+    timestamp max_flush_interval = 5 * ONE_SECOND;
+    // fsync the write-ahead log on every append rather than only when it is sealed for flushing. Without this an
+    // acknowledged append survives a process crash but not necessarily a machine crash.
+    bool sync_every_append = false;
+};
+
+/*
+ * Low-latency streaming writer for a single timestamp-indexed symbol. Each append is recorded in a local write-ahead
+ * log and added to an in-memory aggregator, so it is acknowledged without touching storage. A background thread
+ * batches the buffered rows into well-sized segments by row count or elapsed time and hands them to the sink.
+ *
+ * The log is a sequence of generation files in wal_dir, which must be private to this symbol. A generation is sealed
+ * when its rows are flushed and deleted once the sink has accepted them. Generations left behind by a crash are
+ * replayed and flushed when the next writer is constructed on the same directory. Rows may be delivered twice if
+ * the process dies between the sink accepting a segment and its log being deleted, in which case compacting with
+ * compact_incomplete_dedup_rows removes the duplicates.
+ */
+class TickWriter : boost::noncopyable {
+public:
+    TickWriter(
+        std::shared_ptr<Store> store,
+        StreamDescriptor desc,
+        std::filesystem::path wal_dir,
+        TickWriterOptions options = TickWriterOptions{},
+        std::optional<TickSegmentSink> sink = std::nullopt);
+
+    // Flushes everything buffered before returning
+    ~TickWriter();
+
+    // values are the non-index columns of the descriptor, in order. Timestamps must not decrease.
+    void append(timestamp ts, const std::vector<TickValue>& values);
+
+    // Synchronously flushes all buffered rows, including any from a previously failed flush
+    void flush();
+
+    size_t recovered_rows() const { return recovered_rows_; }
+
+    size_t buffered_rows() const;
+
+private:
+    using TickAggregator = Aggregator<TimeseriesIndex, FixedSchema, NeverSegmentPolicy>;
+
+    struct PendingFlush {
+        SegmentInMemory segment_;
+        std::vector<std::filesystem::path> wal_files_;
+    };
+
+    void check_row(timestamp ts, const std::vector<TickValue>& values) const;
+    void add_row(timestamp ts, const std::vector<TickValue>& values);
+    void recover();
+    void open_wal();
+    void seal_wal();
+    std::filesystem::path wal_path(uint64_t generation) const;
+    void flush_impl();
+    void run_flusher();
+
+    std::shared_ptr<Store> store_;
+    StreamDescriptor desc_;
+    std::filesystem::path wal_dir_;
+    TickWriterOptions options_;
+    TickSegmentSink sink_;
+
+    mutable std::mutex mutex_;
+    std::mutex flush_mutex_;
+    std::condition_variable flush_cv_;
+    TickAggregator agg_;
+    std::optional<SegmentInMemory> committed_segment_;
+    std::vector<PendingFlush> failed_flushes_;
+    std::optional<timestamp> last_ts_;
+
+    std::FILE* wal_file_ = nullptr;
+    uint64_t wal_generation_ = 0;
+    std::vector<std::filesystem::path> unflushed_wal_files_;
+    std::vector<uint8_t> record_buffer_;
+    size_t recovered_rows_ = 0;
+
+    bool stopping_ = false;
+    std::thread flusher_;
+};
+
+} // namespace arcticdb::stream
@@ -8,6 +8,7 @@
 #include <arcticdb/toolbox/library_tool.hpp>
 
 #include <arcticdb/async/async_store.hpp>
+#include <arcticdb/async/index_segment_cache.hpp>
 #include <arcticdb/codec/default_codecs.hpp>
 #include <arcticdb/entity/atom_key.hpp>
 #include <arcticdb/entity/protobufs.hpp>
@@ -27,7 +28,11 @@ Segment LibraryTool::read_to_segment(const VariantKey& key) {
     return kv.segment();
 }
 
+// Overwriting a key bypasses the store, so must drop anything cached for it
 void LibraryTool::write(VariantKey key, Segment segment) {
+    if(async::IndexSegmentCache::is_cacheable(key))
+        async::IndexSegmentCache::instance()->remove(lib_->cache_id(), to_atom(key));
+
     storage::KeySegmentPair kv{std::move(key), std::move(segment)};
     lib_->write(Composite<storage::KeySegmentPair>{std::move(kv)});
 }
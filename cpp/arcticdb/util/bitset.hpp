@@ -19,6 +19,9 @@ using BitSet = bm::bvector<>;
 using BitMagic = bm::bvector<>;
 using BitMagicStart = SmallMagicNum<'M', 's'>;
 using BitMagicEnd = SmallMagicNum<'M', 'e'>;
+// Alternative encodings of a sparse map, which share the end marker of the BitMagic serialization
+using SparsePositionsStart = SmallMagicNum<'M', 'p'>;
+using SparseRunsStart = SmallMagicNum<'M', 'r'>;
 using BitSetSizeType = bm::bvector<>::size_type;
 using BitIndex = bm::bvector<>::rs_index_type;
 
@@ -8,8 +8,12 @@
 #pragma once
 
 #include <iconv.h>
+#include <arcticdb/entity/types.hpp>
 #include <arcticdb/util/preconditions.hpp>
 
+#include <string>
+#include <string_view>
+
 namespace arcticdb {
 
 class EncodingConversion {
@@ -47,4 +51,33 @@ class PortableEncodingConversion {
         }
     };
 
+// Converts a fixed-width UTF-32 string, which is padded with zeros to the width of its column, to UTF-8
+inline std::string utf32_to_utf8(std::string_view sv) {
+    std::string output;
+    output.reserve(sv.size() / UNICODE_WIDTH);
+    for(auto pos = 0u; pos + UNICODE_WIDTH <= sv.size(); pos += UNICODE_WIDTH) {
+        uint32_t c;
+        memcpy(&c, sv.data() + pos, sizeof(c));
+        if(c == 0)
+            break;
+
+        if(c < 0x80) {
+            output.push_back(static_cast<char>(c));
+        } else if(c < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            output.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if(c < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+    return output;
+}
+
 } //namespace arcticdb
\ No newline at end of file
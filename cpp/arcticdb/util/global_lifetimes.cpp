@@ -13,6 +13,8 @@
 #include <arcticdb/log/log.hpp>
 #include <arcticdb/entity/metrics.hpp>
 #include <arcticdb/util/buffer_pool.hpp>
+#include <arcticdb/async/index_segment_cache.hpp>
+#include <arcticdb/storage/shared_segment_cache.hpp>
 
 #if defined(_MSC_VER) && defined(_DEBUG)
 #include <crtdbg.h>
@@ -22,6 +24,8 @@
 namespace arcticdb {
 
 ModuleData::~ModuleData() {
+    async::IndexSegmentCache::destroy_instance();
+    storage::SharedSegmentCache::destroy_instance();
     BufferPool::destroy_instance();
     TracingData::destroy_instance();
     SharedMemoryAllocator::destroy_instance();
@@ -9,6 +9,7 @@
 
 #include <arcticdb/util/offset_string.hpp>
 #include <arcticdb/util/preprocess.hpp>
+#include <arcticdb/util/bitset.hpp>
 #include <arcticdb/column_store/chunked_buffer.hpp>
 
 #include <bitmagic/bm.h>
@@ -16,6 +17,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace arcticdb::util {
 
@@ -116,6 +119,119 @@ inline util::BitMagic deserialize_bytes_to_bitmap(const std::uint8_t*& input, si
     return bv;
 }
 
+inline void write_varint(std::vector<uint8_t>& output, uint32_t value) {
+    while(value >= 0x80) {
+        output.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    output.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint32_t read_varint(const std::uint8_t*& input, const std::uint8_t* end) {
+    uint32_t value = 0;
+    for(uint32_t shift = 0; ; shift += 7) {
+        util::check(input < end && shift < 35, "Truncated varint in sparse map");
+        const auto byte = *input++;
+        value |= uint32_t(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0)
+            return value;
+    }
+}
+
+/*
+ * Besides BitMagic's own serialization, a sparse map can be stored as a list of the positions of its set bits, which
+ * is smallest for a handful of values in many rows, or as a list of runs of set bits, which is smallest for
+ * clustered values and nearly dense columns. Both are delta-encoded varints. Returns the cheaper of the two, or
+ * nullopt if neither is smaller than max_bytes.
+ */
+inline std::optional<std::pair<uint16_t, std::vector<uint8_t>>> encode_sparse_map_compact(
+    const util::BitMagic& bv,
+    size_t max_bytes) {
+    std::vector<uint8_t> positions;
+    std::vector<uint8_t> runs;
+    write_varint(positions, static_cast<uint32_t>(bv.count()));
+    uint32_t previous = 0;
+    uint32_t run_start = 0;
+    uint32_t run_length = 0;
+    uint32_t previous_run_end = 0;
+    size_t num_runs = 0;
+    bool positions_viable = true;
+    bool runs_viable = true;
+    for(auto en = bv.first(); en.valid() && (positions_viable || runs_viable); ++en) {
+        const auto pos = *en;
+        if(positions_viable) {
+            write_varint(positions, pos - previous);
+            previous = pos;
+            positions_viable = positions.size() < max_bytes;
+        }
+        if(run_length > 0 && pos == run_start + run_length) {
+            ++run_length;
+            continue;
+        }
+        if(run_length > 0 && runs_viable) {
+            write_varint(runs, run_start - previous_run_end);
+            write_varint(runs, run_length);
+            previous_run_end = run_start + run_length;
+            ++num_runs;
+            runs_viable = runs.size() < max_bytes;
+        }
+        run_start = pos;
+        run_length = 1;
+    }
+    if(runs_viable && run_length > 0) {
+        write_varint(runs, run_start - previous_run_end);
+        write_varint(runs, run_length);
+        ++num_runs;
+    }
+
+    std::vector<uint8_t> runs_with_count;
+    if(runs_viable) {
+        write_varint(runs_with_count, static_cast<uint32_t>(num_runs));
+        runs_with_count.insert(runs_with_count.end(), runs.begin(), runs.end());
+        runs_viable = runs_with_count.size() < max_bytes;
+    }
+
+    if(runs_viable && (!positions_viable || runs_with_count.size() <= positions.size()))
+        return std::make_pair(SparseRunsStart::Magic, std::move(runs_with_count));
+
+    if(positions_viable)
+        return std::make_pair(SparsePositionsStart::Magic, std::move(positions));
+
+    return std::nullopt;
+}
+
+// Reads a sparse map of total_bytes, including its start and end markers, in any of its encodings
+inline util::BitMagic decode_sparse_map(const std::uint8_t*& input, size_t total_bytes) {
+    const auto end = input + total_bytes - sizeof(BitMagicEnd);
+    const auto encoding = *reinterpret_cast<const uint16_t*>(input);
+    util::BitMagic bv;
+    if(encoding == SparsePositionsStart::Magic) {
+        check_magic<SparsePositionsStart>(input);
+        const auto count = read_varint(input, end);
+        uint32_t pos = 0;
+        for(uint32_t i = 0; i < count; ++i) {
+            pos += read_varint(input, end);
+            bv.set_bit_no_check(pos);
+        }
+    } else if(encoding == SparseRunsStart::Magic) {
+        check_magic<SparseRunsStart>(input);
+        const auto num_runs = read_varint(input, end);
+        uint32_t pos = 0;
+        for(uint32_t i = 0; i < num_runs; ++i) {
+            pos += read_varint(input, end);
+            const auto length = read_varint(input, end);
+            bv.set_range(pos, pos + length - 1);
+            pos += length;
+        }
+    } else {
+        check_magic<BitMagicStart>(input);
+        bv = deserialize_bytes_to_bitmap(input, total_bytes - (sizeof(BitMagicStart) + sizeof(BitMagicEnd)));
+    }
+    util::check(input == end, "Sparse map of {} bytes was not fully consumed by its encoding", total_bytes);
+    check_magic<BitMagicEnd>(input);
+    return bv;
+}
+
 inline void dump_bitvector(const util::BitMagic& bv) {
     auto en = bv.first();
     auto en_end = bv.end();
@@ -0,0 +1,137 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/version/de_dup_index.hpp>
+#include <arcticdb/storage/storage.hpp>
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/stream/index_aggregator.hpp>
+#include <arcticdb/stream/stream_utils.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/key_utils.hpp>
+
+#include <folly/hash/Hash.h>
+
+#include <unordered_set>
+#include <utility>
+
+namespace arcticdb {
+
+using namespace arcticdb::stream;
+
+namespace {
+
+// The index key columns follow the standard key row written by write_key_to_segment
+constexpr position_t IndexVersionIdColumn = position_t(pipelines::index::Fields::key_type) + 1;
+constexpr position_t IndexCreationTsColumn = IndexVersionIdColumn + 1;
+
+StreamDescriptor de_dup_index_stream_desc(const StreamId& stream_id) {
+    auto desc = idx_stream_desc(stream_id, RowCountIndex{});
+    desc.add_scalar_field(DataType::UINT64, "index_version_id");
+    desc.add_scalar_field(DataType::INT64, "index_creation_ts");
+    return desc;
+}
+
+// Identifies an index key by the fields that each entry is tagged with
+struct LiveIndexHash {
+    size_t operator()(const std::pair<VersionId, timestamp>& index) const {
+        return folly::hash::hash_combine(index.first, index.second);
+    }
+};
+
+} // namespace
+
+bool has_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id) {
+    return store->key_exists_sync(RefKey{stream_id, KeyType::DEDUP_INDEX});
+}
+
+std::vector<DeDupIndexEntry> read_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id) {
+    std::vector<DeDupIndexEntry> output;
+    SegmentInMemory seg;
+    try {
+        seg = store->read_sync(RefKey{stream_id, KeyType::DEDUP_INDEX}).second;
+    } catch (const storage::KeyNotFoundException&) {
+        ARCTICDB_DEBUG(log::version(), "No de-duplication index for symbol {}", stream_id);
+        return output;
+    }
+
+    output.reserve(seg.row_count());
+    for(ssize_t row = 0; row < ssize_t(seg.row_count()); ++row) {
+        output.emplace_back(DeDupIndexEntry{
+            read_key_row(seg, row),
+            seg.scalar_at<uint64_t>(row, IndexVersionIdColumn).value(),
+            seg.scalar_at<int64_t>(row, IndexCreationTsColumn).value()
+        });
+    }
+    return output;
+}
+
+void write_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id,
+    const std::vector<DeDupIndexEntry>& entries) {
+    SegmentInMemory segment{de_dup_index_stream_desc(stream_id)};
+    for(const auto& entry : entries) {
+        segment.set_scalar(IndexVersionIdColumn, entry.index_version_id_);
+        segment.set_scalar(IndexCreationTsColumn, entry.index_creation_ts_);
+        write_key_to_segment(segment, entry.data_key_);
+    }
+    store->write_sync(KeyType::DEDUP_INDEX, stream_id, std::move(segment));
+}
+
+std::vector<DeDupIndexEntry> filter_live_de_dup_entries(
+    std::vector<DeDupIndexEntry>&& entries,
+    const std::vector<AtomKey>& live_index_keys) {
+    std::unordered_set<std::pair<VersionId, timestamp>, LiveIndexHash> live;
+    live.reserve(live_index_keys.size());
+    for(const auto& index_key : live_index_keys)
+        live.emplace(index_key.version_id(), index_key.creation_ts());
+
+    entries.erase(std::remove_if(std::begin(entries), std::end(entries), [&live] (const auto& entry) {
+        return live.count({entry.index_version_id_, entry.index_creation_ts_}) == 0;
+    }), std::end(entries));
+    return std::move(entries);
+}
+
+void update_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const AtomKey& new_index_key,
+    std::vector<DeDupIndexEntry>&& live_entries) {
+    static const auto max_index_keys = ConfigsMap::instance()->get_int("Dedup.MaxIndexKeys", 100000);
+    auto data_keys = get_data_keys(store, new_index_key, storage::ReadKeyOpts{});
+
+    std::vector<DeDupIndexEntry> entries;
+    entries.reserve(data_keys.size() + live_entries.size());
+    std::unordered_set<AtomKey> seen;
+    for(auto& data_key : data_keys) {
+        if(seen.insert(data_key).second)
+            entries.emplace_back(DeDupIndexEntry{std::move(data_key), new_index_key.version_id(), new_index_key.creation_ts()});
+    }
+
+    for(auto& entry : live_entries) {
+        if(entries.size() >= size_t(max_index_keys))
+            break;
+
+        if(seen.insert(entry.data_key_).second)
+            entries.emplace_back(std::move(entry));
+    }
+
+    if(entries.size() > size_t(max_index_keys))
+        entries.resize(max_index_keys);
+
+    write_de_dup_index(store, new_index_key.id(), entries);
+}
+
+void populate_de_dup_map(DeDupMap& de_dup_map, const std::vector<DeDupIndexEntry>& entries) {
+    for(const auto& entry : entries)
+        de_dup_map.insert_key(entry.data_key_);
+}
+
+} //namespace arcticdb
@@ -0,0 +1,56 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/atom_key.hpp>
+#include <arcticdb/entity/types.hpp>
+#include <arcticdb/storage/store.hpp>
+#include <arcticdb/version/de_dup_map.hpp>
+
+#include <vector>
+
+namespace arcticdb {
+
+/*
+ * The de-duplication index is a DEDUP_INDEX ref key per symbol listing the data keys of recently written versions,
+ * each tagged with the index key that last referenced it. Entries are only trusted while that index key is still
+ * live, so data keys that have been removed by pruning or deletion are never handed out for re-use.
+ */
+struct DeDupIndexEntry {
+    entity::AtomKey data_key_;
+    entity::VersionId index_version_id_;
+    entity::timestamp index_creation_ts_;
+};
+
+bool has_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id);
+
+std::vector<DeDupIndexEntry> read_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id);
+
+void write_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id,
+    const std::vector<DeDupIndexEntry>& entries);
+
+// Keeps only the entries whose referencing index key is one of the supplied (undeleted) index keys
+std::vector<DeDupIndexEntry> filter_live_de_dup_entries(
+    std::vector<DeDupIndexEntry>&& entries,
+    const std::vector<entity::AtomKey>& live_index_keys);
+
+// Adds the data keys of new_index_key to the live entries and persists the result, newest first
+void update_de_dup_index(
+    const std::shared_ptr<Store>& store,
+    const entity::AtomKey& new_index_key,
+    std::vector<DeDupIndexEntry>&& live_entries);
+
+void populate_de_dup_map(DeDupMap& de_dup_map, const std::vector<DeDupIndexEntry>& entries);
+
+} //namespace arcticdb
@@ -19,7 +19,11 @@
 #include <arcticdb/version/version_tasks.hpp>
 #include <arcticdb/pipeline/index_utils.hpp>
 #include <arcticdb/version/version_map_batch_methods.hpp>
+#include <arcticdb/version/de_dup_index.hpp>
+#include <arcticdb/version/zstd_dictionaries.hpp>
 #include <arcticdb/util/container_filter_wrapper.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/version/reclaim_keys.hpp>
 #include <arcticdb/python/gil_lock.hpp>
 
 namespace arcticdb::version_store {
@@ -28,7 +32,12 @@ LocalVersionedEngine::LocalVersionedEngine(
         const std::shared_ptr<storage::Library>& library,
         const ClockType&) :
     store_(std::make_shared<async::AsyncStore<ClockType>>(library, codec::default_lz4_codec(), encoding_version(library->config()))),
-    symbol_list_(std::make_shared<SymbolList>(version_map_)){
+    symbol_list_(std::make_shared<SymbolList>(version_map_)),
+    // Loaders are called outside the registry's lock, so one can still run after this engine has been destroyed
+    zstd_dictionary_loader_(std::make_unique<ZstdDictionaryLoaderRegistration>([weak_store = std::weak_ptr<Store>{store_}] (uint64_t dictionary_id) {
+        auto store = weak_store.lock();
+        return store ? read_zstd_dictionary(store, dictionary_id) : std::nullopt;
+    })) {
     configure(library->config());
     ARCTICDB_RUNTIME_DEBUG(log::version(), "Created versioned engine at {} for library path {}  with config {}", uintptr_t(this),
                          library->library_path(), [&cfg=cfg_]{  return util::format(cfg); });
@@ -291,12 +300,10 @@ std::optional<VersionedItem> LocalVersionedEngine::get_version_from_snapshot(
     }
     // A snapshot will normally be in a ref key, but for old libraries it still needs to fall back to iteration of
     // atom keys.
-    auto segment = opt_snapshot.value().second;
-    for (size_t idx = 0; idx < segment.row_count(); idx++) {
-        auto stream_index = read_key_row(segment, static_cast<ssize_t>(idx));
-        if (stream_index.id() == stream_id) {
-            return VersionedItem{std::move(stream_index)};
-        }
+    auto& [snap_key, segment] = opt_snapshot.value();
+    auto index_key = find_index_key_in_snapshot(store(), segment, variant_key_type(snap_key) == KeyType::SNAPSHOT_REF, stream_id);
+    if (index_key) {
+        return VersionedItem{std::move(*index_key)};
     }
     ARCTICDB_DEBUG(log::version(), "read_snapshot: {} id not found for snapshot {}", stream_id, snap_name);
     return std::nullopt;
@@ -358,6 +365,22 @@ ReadVersionOutput LocalVersionedEngine::read_dataframe_version_internal(
     return ReadVersionOutput{version.value_or(VersionedItem{}), std::move(frame_and_descriptor)};
 }
 
+VersionedItem LocalVersionedEngine::read_row_slices_internal(
+    const StreamId& stream_id,
+    const VersionQuery& version_query,
+    ReadQuery& read_query,
+    const ReadOptions& read_options,
+    size_t max_concurrent_slices,
+    folly::Function<void(SegmentInMemory&&)>& visitor) {
+    auto version = get_version_to_read(stream_id, version_query, read_options);
+    if(!version)
+        missing_data::raise<ErrorCode::E_NO_SUCH_VERSION>(
+            "read_row_slices: version matching query '{}' not found for symbol '{}'", version_query, stream_id);
+
+    read_row_slices_impl(store(), *version, read_query, read_options, max_concurrent_slices, visitor);
+    return *version;
+}
+
 folly::Future<DescriptorItem> LocalVersionedEngine::get_descriptor(
     AtomKey&& key){
     return store()->read(key)
@@ -415,12 +438,15 @@ folly::Future<DescriptorItem> LocalVersionedEngine::get_descriptor(
 folly::Future<DescriptorItem> LocalVersionedEngine::get_descriptor_async(
     folly::Future<std::optional<AtomKey>>&& version_fut,
     const StreamId& stream_id,
-    const VersionQuery& version_query){
+    const VersionQuery& version_query,
+    const std::shared_ptr<SharedKeyReads<DescriptorItem>>& shared_reads){
     return  std::move(version_fut)
-    .thenValue([this, &stream_id, &version_query](std::optional<AtomKey>&& key){
+    .thenValue([this, &stream_id, &version_query, shared_reads](std::optional<AtomKey>&& key){
         missing_data::check<ErrorCode::E_NO_SUCH_VERSION>(key.has_value(),
         "Unable to retrieve descriptor data. {}@{}: version not found", stream_id, version_query);
-        return get_descriptor(std::move(key.value()));
+        return shared_reads->read(*key, [this] (const AtomKey& index_key) {
+            return get_descriptor(AtomKey{index_key});
+        });
     }).via(&async::cpu_executor());
 }
 
@@ -446,10 +472,11 @@ std::vector<std::variant<DescriptorItem, DataError>> LocalVersionedEngine::batch
                                                     "ReadOptions::batch_throw_on_error_ should always be set here");
 
     auto version_futures = batch_get_versions_async(store(), version_map(), stream_ids, version_queries, read_options.read_previous_on_failure_);
+    auto shared_reads = std::make_shared<SharedKeyReads<DescriptorItem>>();
     std::vector<folly::Future<DescriptorItem>> descriptor_futures;
     for (auto&& [idx, version_fut]: folly::enumerate(version_futures)) {
         descriptor_futures.push_back(
-            get_descriptor_async(std::move(version_fut), stream_ids[idx], version_queries[idx]));
+            get_descriptor_async(std::move(version_fut), stream_ids[idx], version_queries[idx], shared_reads));
     }
     auto descriptors = folly::collectAll(descriptor_futures).get();
     std::vector<std::variant<DescriptorItem, DataError>> descriptors_or_errors;
@@ -486,8 +513,20 @@ std::shared_ptr<DeDupMap> LocalVersionedEngine::get_de_dup_map(
     ){
     auto de_dup_map = std::make_shared<DeDupMap>();
     if (write_options.de_duplication) {
+        std::vector<DeDupIndexEntry> index_entries;
+        if (write_options.de_dup_index) {
+            // The persistent index covers every live version written through it, not just the latest, without reading
+            // any index keys. Versions created by appends and updates are not in it, so the latest is merged in below
+            index_entries = live_de_dup_index_entries(stream_id);
+            populate_de_dup_map(*de_dup_map, index_entries);
+        }
         auto maybe_undeleted_prev = get_latest_undeleted_version(store(), version_map(), stream_id, VersionQuery{}, ReadOptions{});
-        if (maybe_undeleted_prev) {
+        const auto prev_indexed = maybe_undeleted_prev && std::any_of(std::begin(index_entries), std::end(index_entries), [&prev = *maybe_undeleted_prev] (const auto& entry) {
+            return entry.index_version_id_ == prev.version_id() && entry.index_creation_ts_ == prev.creation_ts();
+        });
+        if (prev_indexed) {
+            ARCTICDB_DEBUG(log::version(), "Latest version of {} is already in the de-duplication index", stream_id);
+        } else if (maybe_undeleted_prev) {
             // maybe_undeleted_prev is index key
             auto data_keys = get_data_keys(store(), {maybe_undeleted_prev.value()}, storage::ReadKeyOpts{});
             for (const auto& data_key: data_keys) {
@@ -509,6 +548,15 @@ std::shared_ptr<DeDupMap> LocalVersionedEngine::get_de_dup_map(
     return de_dup_map;
 }
 
+std::vector<DeDupIndexEntry> LocalVersionedEngine::live_de_dup_index_entries(const StreamId& stream_id) {
+    auto entries = read_de_dup_index(store(), stream_id);
+    if (entries.empty())
+        return entries;
+
+    auto entry = version_map()->check_reload(store(), stream_id, LoadParameter{LoadType::LOAD_UNDELETED}, __FUNCTION__);
+    return filter_live_de_dup_entries(std::move(entries), entry->get_indexes(false));
+}
+
 
 VersionedItem LocalVersionedEngine::sort_index(const StreamId& stream_id, bool dynamic_schema) {
     auto maybe_prev = get_latest_undeleted_version(store(), version_map(), stream_id, VersionQuery{}, ReadOptions{});
@@ -608,6 +656,27 @@ VersionedItem LocalVersionedEngine::update_internal(
     }
 }
 
+VersionedItem LocalVersionedEngine::update_columns_internal(
+    const StreamId& stream_id,
+    InputTensorFrame&& frame,
+    bool prune_previous_versions) {
+    ARCTICDB_RUNTIME_DEBUG(log::version(), "Command: update_columns");
+    auto update_info = get_latest_undeleted_version_and_next_version_id(store(),
+                                                                        version_map(),
+                                                                        stream_id,
+                                                                        VersionQuery{},
+                                                                        ReadOptions{});
+    missing_data::check<ErrorCode::E_NO_SUCH_VERSION>(update_info.previous_index_key_.has_value(),
+                                                      "Cannot update columns of non-existent symbol {}", stream_id);
+    auto versioned_item = update_columns_impl(store(),
+                                              update_info,
+                                              std::move(frame),
+                                              get_write_options());
+    write_version_and_prune_previous_if_needed(
+        prune_previous_versions, versioned_item.key_, update_info.previous_index_key_);
+    return versioned_item;
+}
+
 VersionedItem LocalVersionedEngine::write_versioned_metadata_internal(
     const StreamId& stream_id,
     bool prune_previous_versions,
@@ -722,6 +791,39 @@ VersionedItem LocalVersionedEngine::write_versioned_dataframe_internal(
         validate_index);
 
     write_version_and_prune_previous_if_needed(prune_previous_versions, versioned_item.key_, maybe_prev);
+    if (write_options.de_duplication && write_options.de_dup_index)
+        update_de_dup_index(store(), versioned_item.key_, live_de_dup_index_entries(stream_id));
+
+    return versioned_item;
+}
+
+VersionedItem LocalVersionedEngine::write_versioned_frame_batches_internal(
+    const StreamId& stream_id,
+    folly::Function<std::optional<InputTensorFrame>()>& next_frame,
+    bool prune_previous_versions,
+    bool validate_index
+    ) {
+    ARCTICDB_SAMPLE(WriteVersionedFrameBatches, 0)
+
+    ARCTICDB_RUNTIME_DEBUG(log::version(), "Command: write_versioned_frame_batches");
+    auto maybe_prev = ::arcticdb::get_latest_version(store(), version_map(), stream_id, VersionQuery{}, ReadOptions{});
+    auto version_id = get_next_version_from_key(maybe_prev);
+    auto write_options = get_write_options();
+    auto de_dup_map = get_de_dup_map(stream_id, maybe_prev, write_options);
+
+    auto versioned_item = write_frame_batches_impl(
+        store(),
+        version_id,
+        stream_id,
+        next_frame,
+        write_options,
+        de_dup_map,
+        validate_index);
+
+    write_version_and_prune_previous_if_needed(prune_previous_versions, versioned_item.key_, maybe_prev);
+    if (write_options.de_duplication && write_options.de_dup_index)
+        update_de_dup_index(store(), versioned_item.key_, live_de_dup_index_entries(stream_id));
+
     return versioned_item;
 }
 
@@ -892,6 +994,30 @@ folly::Future<folly::Unit> LocalVersionedEngine::delete_trees_responsibly(
         });
     }
 
+    // Check de-duplication index:
+    // A version written through the index can re-use data keys from any version that was live at the time, not just
+    // its neighbours, and the index only remembers the last version to reference each key. So for symbols with an
+    // index, every remaining version could share data with the keys being deleted
+    if (check.prev_version || check.next_version) {
+        std::unordered_set<StreamId> stream_ids;
+        for (const auto& key: *keys_to_delete)
+            stream_ids.insert(key.id());
+
+        for (const auto& stream_id: stream_ids) {
+            if (!has_de_dup_index(store(), stream_id))
+                continue;
+
+            const auto entry = version_map()->check_reload(store(), stream_id, LoadParameter{LoadType::LOAD_UNDELETED}, __FUNCTION__);
+            for (const auto& index_key: entry->get_indexes(false))
+                not_to_delete.insert(index_key);
+
+            if (auto find_symbol = snapshot_map.find(stream_id); check.snapshots && find_symbol != snapshot_map.end()) {
+                for (const auto& pair: find_symbol->second)
+                    not_to_delete.insert(pair.first);
+            }
+        }
+    }
+
     // Resolve:
     // Check 2) implementations does not consider that the key they are adding to not_to_delete might actually be in
     // keys_to_delete, so excluding those:
@@ -899,60 +1025,24 @@ folly::Future<folly::Unit> LocalVersionedEngine::delete_trees_responsibly(
         not_to_delete.erase(key);
     }
 
-    storage::ReadKeyOpts read_opts;
-    read_opts.ignores_missing_key_ = true;
-    auto data_keys_to_be_deleted = get_data_keys_set(store(), *keys_to_delete, read_opts);
-    log::version().debug("Candidate: {} total of data keys", data_keys_to_be_deleted.size());
-
-    read_opts.dont_warn_about_missing_key = true;
-    auto data_keys_not_to_be_deleted = get_data_keys_set(store(), *not_to_delete, read_opts);
+    ReclamationPlan plan{
+        std::vector<IndexTypeKey>(keys_to_delete->begin(), keys_to_delete->end()),
+        std::vector<IndexTypeKey>(not_to_delete->begin(), not_to_delete->end())};
     not_to_delete.clear();
-    log::version().debug("Forbidden: {} total of data keys", data_keys_not_to_be_deleted.size());
-    storage::RemoveOpts remove_opts;
-    remove_opts.ignores_missing_key_ = true;
-
-    std::vector<entity::VariantKey> vks_column_stats;
-    std::transform(keys_to_delete->begin(),
-                    keys_to_delete->end(),
-                    std::back_inserter(vks_column_stats),
-                    [](const IndexTypeKey& index_key) {
-        return index_key_to_column_stats_key(index_key);
-    });
-    log::version().debug("Number of Column Stats keys to be deleted: {}", vks_column_stats.size());
-
-    std::vector<entity::VariantKey> vks_to_delete;
-    std::copy(std::make_move_iterator(keys_to_delete->begin()),
-                std::make_move_iterator(keys_to_delete->end()),
-                std::back_inserter(vks_to_delete));
-    log::version().debug("Number of Index keys to be deleted: {}", vks_to_delete.size());
-
-    std::vector<entity::VariantKey> vks_data_to_delete;
-    std::copy_if(std::make_move_iterator(data_keys_to_be_deleted.begin()),
-                std::make_move_iterator(data_keys_to_be_deleted.end()),
-                std::back_inserter(vks_data_to_delete),
-                [&](const auto& k) {return !data_keys_not_to_be_deleted.count(k);});
-    log::version().debug("Number of Data keys to be deleted: {}", vks_data_to_delete.size());
-
-    folly::Future<folly::Unit> remove_keys_fut;
-    if (!dry_run) {
-        // Delete any associated column stats keys first
-        remove_keys_fut = store()->remove_keys(std::move(vks_column_stats), remove_opts)
-        .thenValue([this, vks_to_delete = std::move(vks_to_delete), remove_opts](auto&& ) mutable {
-            log::version().debug("Column Stats keys deleted.");
-            return store()->remove_keys(std::move(vks_to_delete), remove_opts);
-        })
-        .thenValue([this, vks_data_to_delete = std::move(vks_data_to_delete), remove_opts](auto&&) mutable {
-            log::version().debug("Index keys deleted.");
-            return store()->remove_keys(std::move(vks_data_to_delete), remove_opts);
-        })
-        .thenValue([](auto&&){
-            log::version().debug("Data keys deleted.");
-            return folly::Unit();
-        });
-    }
-    return remove_keys_fut;
+    log::version().debug("Number of Index keys to be deleted: {}", plan.index_keys_to_delete_.size());
+    if (dry_run || plan.index_keys_to_delete_.empty())
+        return folly::Unit();
+
+    auto journal_key = write_reclamation_journal(store(), plan);
+    return reclaim_keys(store(), plan, journal_key);
 }
 
+size_t LocalVersionedEngine::resume_interrupted_deletes() {
+    ARCTICDB_RUNTIME_DEBUG(log::version(), "Command: resume_interrupted_deletes");
+    return resume_reclamations(store(), [this] (std::vector<AtomKey>&& index_keys) {
+        return delete_trees_responsibly(index_keys, get_master_snapshots_map(store()));
+    });
+}
 
 void LocalVersionedEngine::remove_incomplete(
     const StreamId& stream_id
@@ -1049,6 +1139,40 @@ VersionedItem LocalVersionedEngine::defragment_symbol_data(const StreamId& strea
     return versioned_item;
 }
 
+std::pair<VersionedItem, RecompressionStats> LocalVersionedEngine::recompress_symbol_data(
+    const StreamId& stream_id,
+    const arcticdb::proto::encoding::VariantCodec& codec,
+    std::optional<VersionId> before_version,
+    std::optional<timestamp> before_ts,
+    bool prune_previous_versions) {
+    log::version().info("Recompressing data for symbol {}", stream_id);
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(before_version.has_value() || before_ts.has_value(),
+        "Recompression requires a version or a time to recompress the data written before");
+    auto update_info = get_latest_undeleted_version_and_next_version_id(
+        store(), version_map(), stream_id, VersionQuery{}, ReadOptions{});
+    missing_data::check<ErrorCode::E_NO_SUCH_VERSION>(update_info.previous_index_key_.has_value(),
+        "Cannot recompress non-existent symbol {}", stream_id);
+    // Rewritten segments must be newer than the cutoffs, which is what lets a repeated run skip them
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!before_version || *before_version <= update_info.previous_index_key_->version_id(),
+        "Cannot recompress data written before version {} of {} as the latest version is {}",
+        before_version.value_or(0), stream_id, update_info.previous_index_key_->version_id());
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!before_ts || *before_ts <= util::SysClock::nanos_since_epoch(),
+        "Cannot recompress data written before a time in the future");
+
+    RecompressionStats stats;
+    auto versioned_item = VersionedItem{*update_info.previous_index_key_};
+    if (auto recompressed = recompress_symbol_data_impl(store(), update_info, codec, before_version, before_ts, stats)) {
+        versioned_item = std::move(*recompressed);
+        write_version_and_prune_previous_if_needed(prune_previous_versions, versioned_item.key_, update_info.previous_index_key_);
+    }
+    remove_recompression_journal(store(), stream_id);
+
+    log::version().info("Recompressed {} segments of {} from {} to {} bytes, sampled decode time {}ns -> {}ns over {} segments",
+                        stats.segments_rewritten_, stream_id, stats.bytes_before_, stats.bytes_after_,
+                        stats.decode_nanos_before_, stats.decode_nanos_after_, stats.segments_sampled_);
+    return {versioned_item, stats};
+}
+
 folly::Future<ReadVersionOutput> async_read_direct(
     const std::shared_ptr<Store>& store,
     const VariantKey& index_key,
@@ -1593,10 +1717,28 @@ std::vector<timestamp> LocalVersionedEngine::batch_get_update_times(
         const std::vector<StreamId>& stream_ids,
         const std::vector<VersionQuery>& version_queries) {
     util::check(stream_ids.size() == version_queries.size(), "Symbol vs version query size mismatch: {} != {}", stream_ids.size(), version_queries.size());
-    std::vector<timestamp> results;
+    // Snapshot queries are resolved through the snapshot rather than the version map, so are looked up one at a time
+    std::vector<timestamp> results(stream_ids.size());
+    std::vector<size_t> batch_indices;
+    std::vector<StreamId> batch_ids;
+    std::vector<VersionQuery> batch_queries;
     for(const auto& stream_id : folly::enumerate(stream_ids)) {
         const auto& query = version_queries[stream_id.index];
-        results.emplace_back(get_update_time_internal(*stream_id, query));
+        if(std::holds_alternative<SnapshotVersionQuery>(query.content_)) {
+            results[stream_id.index] = get_update_time_internal(*stream_id, query);
+        } else {
+            batch_indices.emplace_back(stream_id.index);
+            batch_ids.emplace_back(*stream_id);
+            batch_queries.emplace_back(query);
+        }
+    }
+
+    auto versions = folly::collect(batch_get_versions_async(store(), version_map(), batch_ids, batch_queries, std::nullopt)).get();
+    for(auto&& [idx, version] : folly::enumerate(versions)) {
+        if(!version)
+            throw storage::NoDataFoundException(fmt::format("get_update_time: version not found for symbol {}", batch_ids[idx]));
+
+        results[batch_indices[idx]] = version->creation_ts();
     }
     return results;
 }
@@ -1635,17 +1777,20 @@ folly::Future<std::pair<std::optional<VariantKey>, std::optional<google::protobu
 folly::Future<std::pair<VariantKey, std::optional<google::protobuf::Any>>> LocalVersionedEngine::get_metadata_async(
     folly::Future<std::optional<AtomKey>>&& version_fut,
     const StreamId& stream_id,
-    const VersionQuery& version_query
+    const VersionQuery& version_query,
+    const std::shared_ptr<SharedKeyReads<std::pair<VariantKey, std::optional<google::protobuf::Any>>>>& shared_reads
     ) {
     return  std::move(version_fut)
-    .thenValue([this, &stream_id, &version_query](std::optional<AtomKey>&& key){
+    .thenValue([this, &stream_id, &version_query, shared_reads](std::optional<AtomKey>&& key){
         missing_data::check<ErrorCode::E_NO_SUCH_VERSION>(key.has_value(),
         "Unable to retrieve  metadata. {}@{}: version not found", stream_id, version_query);
-        return get_metadata(std::move(key));
-    })
-    .thenValue([](auto&& metadata){
-        auto&& [opt_key, meta_proto] = metadata;
-        return std::make_pair(std::move(*opt_key), std::move(meta_proto));
+        return shared_reads->read(*key, [this] (const AtomKey& index_key) {
+            return get_metadata(std::make_optional(index_key))
+            .thenValue([](auto&& metadata){
+                auto&& [opt_key, meta_proto] = metadata;
+                return std::make_pair(std::move(*opt_key), std::move(meta_proto));
+            });
+        });
     });
 }
  
@@ -1658,9 +1803,10 @@ std::vector<std::variant<std::pair<VariantKey, std::optional<google::protobuf::A
     internal::check<ErrorCode::E_ASSERTION_FAILURE>(read_options.batch_throw_on_error_.has_value(),
                                                     "ReadOptions::batch_throw_on_error_ should always be set here");
     auto version_futures = batch_get_versions_async(store(), version_map(), stream_ids, version_queries, read_options.read_previous_on_failure_);
+    auto shared_reads = std::make_shared<SharedKeyReads<std::pair<VariantKey, std::optional<google::protobuf::Any>>>>();
     std::vector<folly::Future<std::pair<VariantKey, std::optional<google::protobuf::Any>>>> metadata_futures;
     for (auto&& [idx, version]: folly::enumerate(version_futures)) {
-        metadata_futures.push_back(get_metadata_async(std::move(version), stream_ids[idx], version_queries[idx]));
+        metadata_futures.push_back(get_metadata_async(std::move(version), stream_ids[idx], version_queries[idx], shared_reads));
     }
 
     auto metadatas = folly::collectAll(metadata_futures).get();
@@ -1741,6 +1887,13 @@ void LocalVersionedEngine::configure(const storage::LibraryDescriptor::VariantSt
             PrometheusConfigInstance::instance()->config.CopyFrom(cfg.prometheus_config());
             ARCTICDB_DEBUG(log::version(), "prometheus configured");
         }
+        if(cfg.write_options().use_zstd_dictionaries()) {
+            try {
+                apply_active_zstd_dictionaries(store);
+            } catch (const std::exception& e) {
+                log::version().warn("Failed to load zstd dictionaries, compressing without them: {}", e.what());
+            }
+        }
         },
         [](const auto& conf){
         util::raise_rte(
@@ -1750,6 +1903,18 @@ void LocalVersionedEngine::configure(const storage::LibraryDescriptor::VariantSt
     );
 }
 
+std::optional<uint64_t> LocalVersionedEngine::train_zstd_dictionary(
+    KeyType key_type,
+    size_t max_samples,
+    size_t max_dictionary_size) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(max_samples > 0 && max_dictionary_size > 0,
+        "Training a zstd dictionary needs a non-zero sample count and dictionary size");
+    if(!cfg().write_options().use_zstd_dictionaries())
+        log::version().warn("Library does not set use_zstd_dictionaries, so only this process will use the trained dictionary");
+
+    return train_key_type_zstd_dictionary(store(), key_type, max_samples, max_dictionary_size);
+}
+
 timestamp LocalVersionedEngine::latest_timestamp(const std::string& symbol) {
     if(auto latest_incomplete = latest_incomplete_timestamp(store(), symbol); latest_incomplete)
         return latest_incomplete.value();
@@ -1760,27 +1925,46 @@ timestamp LocalVersionedEngine::latest_timestamp(const std::string& symbol) {
     return -1;
 }
 
+namespace {
+
+std::vector<std::pair<KeyType, std::unordered_map<StreamId, std::pair<size_t, size_t>>>> scan_sizes_per_key_type(
+        const std::shared_ptr<Store>& store) {
+    std::vector<KeyType> key_types;
+    std::vector<folly::Future<std::unordered_map<StreamId, std::pair<size_t, size_t>>>> futures;
+    foreach_key_type([&store, &key_types, &futures](KeyType key_type) {
+        key_types.emplace_back(key_type);
+        futures.emplace_back(async::submit_io_task(ScanObjectSizesTask{store, key_type}));
+    });
+    auto sizes = folly::collect(futures).get();
+
+    std::vector<std::pair<KeyType, std::unordered_map<StreamId, std::pair<size_t, size_t>>>> output;
+    output.reserve(key_types.size());
+    for(size_t i = 0; i < key_types.size(); ++i)
+        output.emplace_back(key_types[i], std::move(sizes[i]));
+
+    return output;
+}
+
+} // namespace
+
 std::unordered_map<KeyType, std::pair<size_t, size_t>> LocalVersionedEngine::scan_object_sizes() {
     std::unordered_map<KeyType, std::pair<size_t, size_t>> sizes;
-    foreach_key_type([&store=store(), &sizes=sizes](KeyType key_type) {
-        std::vector<VariantKey> keys;
-        store->iterate_type(key_type, [&keys](const VariantKey &&k) {
-            keys.emplace_back(std::forward<const VariantKey>(k));
-        });
-        auto& pair = sizes[key_type];
-        pair.first = keys.size();
-        std::vector<stream::StreamSource::ReadContinuation> continuations;
-        std::atomic<size_t> key_size{0};
-        for(auto&& key ARCTICDB_UNUSED : keys) {
-            continuations.emplace_back([&key_size] (auto&& ks) {
-                auto key_seg = std::move(ks);
-                key_size += key_seg.segment().total_segment_size();
-                return key_seg.variant_key();
-            });
+    for(const auto& [key_type, sizes_by_stream] : scan_sizes_per_key_type(store())) {
+        auto& [count, bytes] = sizes[key_type];
+        for(const auto& [stream_id, stream_sizes] : sizes_by_stream) {
+            count += stream_sizes.first;
+            bytes += stream_sizes.second;
         }
-        store->batch_read_compressed(std::move(keys), std::move(continuations),BatchReadArgs{});
-        pair.second = key_size;
-    });
+    }
+    return sizes;
+}
+
+std::unordered_map<StreamId, std::unordered_map<KeyType, std::pair<size_t, size_t>>> LocalVersionedEngine::scan_object_sizes_by_stream() {
+    std::unordered_map<StreamId, std::unordered_map<KeyType, std::pair<size_t, size_t>>> sizes;
+    for(auto& [key_type, sizes_by_stream] : scan_sizes_per_key_type(store())) {
+        for(auto& [stream_id, stream_sizes] : sizes_by_stream)
+            sizes[stream_id][key_type] = stream_sizes;
+    }
     return sizes;
 }
 
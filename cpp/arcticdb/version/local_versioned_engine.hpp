@@ -18,7 +18,10 @@
 #include <arcticdb/pipeline/query.hpp>
 #include <arcticdb/pipeline/input_tensor_frame.hpp>
 #include <arcticdb/version/version_core.hpp>
+#include <arcticdb/version/version_map_batch_methods.hpp>
 #include <arcticdb/version/versioned_engine.hpp>
+#include <arcticdb/version/de_dup_index.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
 #include <arcticdb/entity/descriptor_item.hpp>
 #include <arcticdb/entity/data_error.hpp>
 
@@ -61,6 +64,11 @@ public:
         bool dynamic_schema,
         bool prune_previous_versions) override;
 
+    VersionedItem update_columns_internal(
+        const StreamId& stream_id,
+        InputTensorFrame&& frame,
+        bool prune_previous_versions);
+
     VersionedItem append_internal(
         const StreamId& stream_id,
         InputTensorFrame&& frame,
@@ -138,6 +146,14 @@ public:
             const VersionQuery& version_query,
             const ReadOptions& read_options);
 
+    VersionedItem read_row_slices_internal(
+        const StreamId& stream_id,
+        const VersionQuery& version_query,
+        ReadQuery& read_query,
+        const ReadOptions& read_options,
+        size_t max_concurrent_slices,
+        folly::Function<void(SegmentInMemory&&)>& visitor);
+
     void write_parallel_frame(
         const StreamId& stream_id,
         InputTensorFrame&& frame) const override;
@@ -170,6 +186,12 @@ public:
         bool dry_run = false
     );
 
+    /**
+     * Finishes any deletes that were interrupted after passing their pre-delete checks, such as by a crash.
+     * @return The number of interrupted deletes found.
+     */
+    size_t resume_interrupted_deletes();
+
     std::set<StreamId> list_streams_internal(
         std::optional<SnapshotId> snap_name,
         const std::optional<std::string>& regex,
@@ -186,6 +208,12 @@ public:
         bool validate_index
     ) override;
 
+    VersionedItem write_versioned_frame_batches_internal(
+        const StreamId& stream_id,
+        folly::Function<std::optional<InputTensorFrame>()>& next_frame,
+        bool prune_previous_versions,
+        bool validate_index);
+
     VersionedItem write_versioned_metadata_internal(
         const StreamId& stream_id,
         bool prune_previous_versions,
@@ -198,7 +226,8 @@ public:
     folly::Future<std::pair<VariantKey, std::optional<google::protobuf::Any>>> get_metadata_async(
         folly::Future<std::optional<AtomKey>>&& version_fut,
         const StreamId& stream_id,
-        const VersionQuery& version_query);
+        const VersionQuery& version_query,
+        const std::shared_ptr<SharedKeyReads<std::pair<VariantKey, std::optional<google::protobuf::Any>>>>& shared_reads);
 
     folly::Future<DescriptorItem> get_descriptor(
         AtomKey&& key);
@@ -206,7 +235,8 @@ public:
     folly::Future<DescriptorItem> get_descriptor_async(
         folly::Future<std::optional<AtomKey>>&& version_fut,
         const StreamId& stream_id,
-        const VersionQuery& version_query);
+        const VersionQuery& version_query,
+        const std::shared_ptr<SharedKeyReads<DescriptorItem>>& shared_reads);
 
     void create_column_stats_internal(
         const VersionedItem& versioned_item,
@@ -332,6 +362,19 @@ public:
     bool is_symbol_fragmented(const StreamId& stream_id, std::optional<size_t> segment_size) override;
 
     VersionedItem defragment_symbol_data(const StreamId& stream_id, std::optional<size_t> segment_size) override;
+
+    // Rewrites the data segments older than the cutoffs with codec in one new version. An interrupted run leaves
+    // only unreferenced segments behind, and is repeated from the start.
+    std::pair<VersionedItem, RecompressionStats> recompress_symbol_data(
+        const StreamId& stream_id,
+        const arcticdb::proto::encoding::VariantCodec& codec,
+        std::optional<VersionId> before_version,
+        std::optional<timestamp> before_ts,
+        bool prune_previous_versions);
+
+    // Trains a zstd dictionary on existing segments of key_type and compresses its new segments with it. The
+    // dictionary is used by other processes that open the library with the use_zstd_dictionaries write option.
+    std::optional<uint64_t> train_zstd_dictionary(KeyType key_type, size_t max_samples, size_t max_dictionary_size);
     
     StorageLockWrapper get_storage_lock(const StreamId& stream_id) override;
 
@@ -392,6 +435,7 @@ public:
         const WriteOptions& write_options);
 
     std::unordered_map<KeyType, std::pair<size_t, size_t>> scan_object_sizes();
+    std::unordered_map<StreamId, std::unordered_map<KeyType, std::pair<size_t, size_t>>> scan_object_sizes_by_stream();
     std::shared_ptr<Store>& _test_get_store() { return store_; }
     void _test_set_validate_version_map() {
         version_map()->set_validate(true);
@@ -449,12 +493,16 @@ protected:
         const std::vector<VersionQuery>& version_queries);
 
 private:
+    // Entries of the symbol's de-duplication index whose referencing version is still live
+    std::vector<DeDupIndexEntry> live_de_dup_index_entries(const StreamId& stream_id);
 
     std::shared_ptr<Store> store_;
     arcticdb::proto::storage::VersionStoreConfig cfg_;
     std::shared_ptr<VersionMap> version_map_ = std::make_shared<VersionMap>();
     std::shared_ptr<SymbolList> symbol_list_;
     std::optional<std::string> license_key_;
+    // Declared last so that it is unregistered before anything it uses is destroyed
+    std::unique_ptr<ZstdDictionaryLoaderRegistration> zstd_dictionary_loader_;
 };
 
 } // arcticdb::version_store
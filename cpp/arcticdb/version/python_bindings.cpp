@@ -14,6 +14,7 @@
 #include <arcticdb/version/version_store_api.hpp>
 #include <arcticdb/python/arctic_version.hpp>
 #include <arcticdb/python/python_utils.hpp>
+#include <arcticdb/pipeline/arrow_output.hpp>
 #include <arcticdb/pipeline/column_stats.hpp>
 #include <arcticdb/pipeline/query.hpp>
 #include <arcticdb/storage/mongo/mongo_instance.hpp>
@@ -111,6 +112,7 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("set_set_tz", &ReadOptions::set_set_tz)
         .def("set_optimise_string_memory", &ReadOptions::set_optimise_string_memory)
         .def("set_batch_throw_on_error", &ReadOptions::set_batch_throw_on_error)
+        .def("set_arrow_output", &ReadOptions::set_arrow_output)
         .def_property_readonly("incompletes", &ReadOptions::get_incompletes);
 
     using FrameDataWrapper = arcticdb::pipelines::FrameDataWrapper;
@@ -131,7 +133,15 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
             return self.frame().offset();
         })
         .def_property_readonly("names", &PythonOutputFrame::names, py::return_value_policy::reference)
-        .def_property_readonly("index_columns", &PythonOutputFrame::index_columns, py::return_value_policy::reference);
+        .def_property_readonly("index_columns", &PythonOutputFrame::index_columns, py::return_value_policy::reference)
+        .def("export_arrow", [](PythonOutputFrame& self, uintptr_t array_address, uintptr_t schema_address, bool dictionary_strings) {
+            arcticdb::pipelines::export_arrow(
+                self.frame(),
+                reinterpret_cast<ArrowArray*>(array_address),
+                reinterpret_cast<ArrowSchema*>(schema_address),
+                dictionary_strings);
+        }, py::arg("array_address"), py::arg("schema_address"), py::arg("dictionary_strings") = true,
+        "Export the frame into the ArrowArray and ArrowSchema structs at the given addresses, as used by pyarrow's _import_from_c");
 
     py::enum_<VersionRequestType>(version, "VersionRequestType", R"pbdoc(
         Enum of possible version request types passed to as_of.
@@ -187,6 +197,14 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def_property_readonly("symbol", &VersionedItem::symbol)
         .def_property_readonly("version", &VersionedItem::version);
 
+    py::class_<RecompressionStats>(version, "RecompressionStats")
+        .def_readonly("segments_rewritten", &RecompressionStats::segments_rewritten_)
+        .def_readonly("bytes_before", &RecompressionStats::bytes_before_)
+        .def_readonly("bytes_after", &RecompressionStats::bytes_after_)
+        .def_readonly("segments_sampled", &RecompressionStats::segments_sampled_)
+        .def_readonly("decode_nanos_before", &RecompressionStats::decode_nanos_before_)
+        .def_readonly("decode_nanos_after", &RecompressionStats::decode_nanos_after_);
+
     py::class_<DescriptorItem>(version, "DescriptorItem")
         .def_property_readonly("symbol", &DescriptorItem::symbol)
         .def_property_readonly("version", &DescriptorItem::version)
@@ -488,6 +506,20 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("defragment_symbol_data",
              &PythonVersionStore::defragment_symbol_data,
              py::call_guard<SingleThreadMutexHolder>(), "Compact small data segments into larger data segments")
+        .def("recompress_symbol_data",
+             [](PythonVersionStore& v, const StreamId& stream_id, int zstd_level, std::optional<VersionId> before_version,
+                std::optional<timestamp> before_ts, bool prune_previous_versions) {
+                 arcticdb::proto::encoding::VariantCodec codec;
+                 codec.mutable_zstd()->set_level(zstd_level);
+                 return v.recompress_symbol_data(stream_id, codec, before_version, before_ts, prune_previous_versions);
+             },
+             py::call_guard<SingleThreadMutexHolder>(), "Re-encode data segments written before a version or time with a heavier ZSTD level")
+        .def("train_zstd_dictionary",
+             &PythonVersionStore::train_zstd_dictionary,
+             py::arg("key_type"),
+             py::arg("max_samples") = 1000,
+             py::arg("max_dictionary_size") = 112640,
+             py::call_guard<SingleThreadMutexHolder>(), "Train a ZSTD dictionary on existing keys of a type and compress new keys of that type with it")
         .def("get_incomplete_symbols",
              &PythonVersionStore::get_incomplete_symbols,
              py::call_guard<SingleThreadMutexHolder>(), "Get all the symbols that have incomplete entries")
@@ -503,6 +535,9 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("update",
              &PythonVersionStore::update,
              py::call_guard<SingleThreadMutexHolder>(), "Update the most recent version of a dataframe")
+        .def("update_columns",
+             &PythonVersionStore::update_columns,
+             py::call_guard<SingleThreadMutexHolder>(), "Update some of the columns of the most recent version of a dataframe, rewriting only the column slices that hold them")
         .def("snapshot",
              &PythonVersionStore::snapshot,
              py::call_guard<SingleThreadMutexHolder>(), "Create a snapshot")
@@ -533,6 +568,12 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
         .def("write_versioned_dataframe",
              &PythonVersionStore::write_versioned_dataframe,
              py::call_guard<SingleThreadMutexHolder>(), "Write the most recent version of this dataframe to the store")
+        .def("write_arrow",
+             &PythonVersionStore::write_arrow,
+             py::call_guard<SingleThreadMutexHolder>(), "Write an Arrow struct array, such as an exported record batch, as the latest version of the symbol")
+        .def("write_arrow_batches",
+             &PythonVersionStore::write_arrow_batches,
+             py::call_guard<SingleThreadMutexHolder>(), "Write a sequence of Arrow struct arrays, such as the record batches of a file, as one version of the symbol")
         .def("write_versioned_composite_data",
              &PythonVersionStore::write_versioned_composite_data,
              py::call_guard<SingleThreadMutexHolder>(), "Allows the user to write multiple dataframes in a batch with one version entity")
@@ -545,6 +586,15 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
               },
              py::call_guard<SingleThreadMutexHolder>(),
              "Read the specified version of the dataframe from the store")
+        .def("read_row_slices",
+             [&](PythonVersionStore& v, StreamId sid, const VersionQuery& version_query, ReadQuery& read_query, const ReadOptions& read_options, size_t max_concurrent_slices, py::function callback){
+                folly::Function<void(SegmentInMemory&&)> visitor = [&callback](SegmentInMemory&& frame) {
+                    callback(PythonOutputFrame{std::move(frame), std::make_shared<BufferHolder>()});
+                };
+                return v.read_row_slices_internal(sid, version_query, read_query, read_options, max_concurrent_slices, visitor);
+             },
+             py::call_guard<SingleThreadMutexHolder>(),
+             "Read the specified version one row slice at a time, passing each slice's frame to the callback in row order")
         .def("read_index",
              [&](PythonVersionStore& v,  StreamId sid, const VersionQuery& version_query){
                  return adapt_read_df(v.read_index(sid, version_query));
@@ -564,6 +614,9 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
          .def("scan_object_sizes",
               &PythonVersionStore::scan_object_sizes,
             py::call_guard<SingleThreadMutexHolder>(), "Scan the sizes of object")
+         .def("scan_object_sizes_by_stream",
+              &PythonVersionStore::scan_object_sizes_by_stream,
+            py::call_guard<SingleThreadMutexHolder>(), "Scan the sizes of objects, broken down by symbol")
         .def("find_version",
              &PythonVersionStore::get_version_to_read,
              py::call_guard<SingleThreadMutexHolder>(), "Check if a specific stream has been written to previously")
@@ -576,6 +629,9 @@ void register_bindings(py::module &version, py::exception<arcticdb::ArcticExcept
          .def("fix_symbol_trees",
              &PythonVersionStore::fix_symbol_trees,
              py::call_guard<SingleThreadMutexHolder>(), "Regenerate symbol tree by adding indexes from snapshots")
+         .def("resume_interrupted_deletes",
+             &PythonVersionStore::resume_interrupted_deletes,
+             py::call_guard<SingleThreadMutexHolder>(), "Finish any deletes that were interrupted part way through")
          .def("flush_version_map",
              &PythonVersionStore::flush_version_map,
              py::call_guard<SingleThreadMutexHolder>(), "Flush the version cache")
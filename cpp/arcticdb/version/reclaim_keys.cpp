@@ -0,0 +1,252 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/version/reclaim_keys.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/storage/storage.hpp>
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/stream/index_aggregator.hpp>
+#include <arcticdb/stream/stream_utils.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/key_utils.hpp>
+#include <arcticdb/version/version_core.hpp>
+
+#include <folly/Random.h>
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+namespace arcticdb {
+
+using namespace arcticdb::stream;
+
+namespace {
+
+// The flag column follows the standard key row written by write_key_to_segment
+constexpr position_t KeepDataColumn = position_t(pipelines::index::Fields::key_type) + 1;
+
+StreamDescriptor reclamation_journal_stream_desc(const StreamId& stream_id) {
+    auto desc = idx_stream_desc(stream_id, RowCountIndex{});
+    desc.add_scalar_field(DataType::UINT8, "keep_data");
+    return desc;
+}
+
+size_t config_at_least_one(const std::string& name, int64_t default_value) {
+    return static_cast<size_t>(std::max<int64_t>(1, ConfigsMap::instance()->get_int(name, default_value)));
+}
+
+std::vector<AtomKey> data_keys_of(const std::shared_ptr<Store>& store, SegmentInMemory&& index_segment) {
+    std::vector<AtomKey> output;
+    for (auto&& key : recurse_segment(store, std::move(index_segment), std::nullopt)) {
+        if (key.type() == KeyType::TABLE_DATA)
+            output.emplace_back(key);
+    }
+    return output;
+}
+
+// Index keys being deleted that are already gone have nothing left to reclaim
+folly::Future<std::vector<AtomKey>> read_data_keys_to_delete(const std::shared_ptr<Store>& store, const AtomKey& index_key) {
+    return store->read(index_key)
+        .thenValue([store](auto&& key_seg) {
+            return data_keys_of(store, std::move(key_seg.second));
+        })
+        .thenError(folly::tag_t<storage::KeyNotFoundException>{}, [index_key](auto const&) {
+            ARCTICDB_DEBUG(log::version(), "Index key {} already removed", index_key);
+            return std::vector<AtomKey>{};
+        });
+}
+
+// A missing index key that is being kept is an error, as its data keys would otherwise be removed
+folly::Future<std::vector<AtomKey>> read_data_keys_to_keep(const std::shared_ptr<Store>& store, const AtomKey& index_key) {
+    return store->read(index_key).thenValue([store](auto&& key_seg) {
+        return data_keys_of(store, std::move(key_seg.second));
+    });
+}
+
+struct DataKeyReclamation {
+    std::shared_ptr<Store> store_;
+    std::vector<AtomKey> index_keys_;
+    storage::RemoveOpts remove_opts_;
+    size_t read_window_;
+    size_t batch_size_;
+    size_t max_batches_in_flight_;
+    // Holds the data keys that must be kept and then also those already queued for removal, so that each data key is
+    // removed at most once
+    std::unordered_set<AtomKey> data_keys_seen_;
+    std::vector<VariantKey> batch_;
+    std::deque<folly::Future<std::vector<stream::StreamSink::RemoveKeyResultType>>> batches_in_flight_;
+    size_t data_keys_removed_ = 0;
+
+    void submit_batch() {
+        data_keys_removed_ += batch_.size();
+        batches_in_flight_.emplace_back(store_->remove_keys(std::exchange(batch_, {}), remove_opts_));
+    }
+
+    // The batches beyond the bound on those in flight, which must finish before more are submitted
+    std::vector<folly::Future<std::vector<stream::StreamSink::RemoveKeyResultType>>> take_excess_batches() {
+        std::vector<folly::Future<std::vector<stream::StreamSink::RemoveKeyResultType>>> output;
+        while (batches_in_flight_.size() > max_batches_in_flight_) {
+            output.emplace_back(std::move(batches_in_flight_.front()));
+            batches_in_flight_.pop_front();
+        }
+        return output;
+    }
+};
+
+/*
+ * Removes the data keys of the index keys from offset onwards, reading read_window index segments at a time. Each step
+ * is chained onto the last rather than waited on, as deletes run from IO continuations when pruning previous versions.
+ * Steps are moved to the CPU executor so that reads that have already completed don't recurse.
+ */
+folly::Future<folly::Unit> reclaim_data_keys_from(const std::shared_ptr<DataKeyReclamation>& state, size_t offset) {
+    if (offset == state->index_keys_.size()) {
+        if (!state->batch_.empty())
+            state->submit_batch();
+
+        std::vector<folly::Future<std::vector<stream::StreamSink::RemoveKeyResultType>>> remaining;
+        for (auto& batch_fut : state->batches_in_flight_)
+            remaining.emplace_back(std::move(batch_fut));
+
+        state->batches_in_flight_.clear();
+        return folly::collect(remaining).thenValue([state](auto&&) {
+            log::version().debug("Number of Data keys deleted: {}", state->data_keys_removed_);
+            return folly::Unit{};
+        });
+    }
+
+    const auto end = std::min(offset + state->read_window_, state->index_keys_.size());
+    std::vector<folly::Future<std::vector<AtomKey>>> reads;
+    for (auto idx = offset; idx < end; ++idx)
+        reads.emplace_back(read_data_keys_to_delete(state->store_, state->index_keys_[idx]));
+
+    return folly::collect(reads).via(&async::cpu_executor()).thenValue([state, end](auto&& data_keys) {
+        for (auto& keys : data_keys) {
+            for (auto&& data_key : keys) {
+                if (!state->data_keys_seen_.insert(data_key).second)
+                    continue;
+
+                state->batch_.emplace_back(std::move(data_key));
+                if (state->batch_.size() == state->batch_size_)
+                    state->submit_batch();
+            }
+        }
+        return folly::collect(state->take_excess_batches()).thenValue([state, end](auto&&) {
+            return reclaim_data_keys_from(state, end);
+        });
+    });
+}
+
+} // namespace
+
+RefKey write_reclamation_journal(const std::shared_ptr<Store>& store, const ReclamationPlan& plan) {
+    const StreamId journal_id{fmt::format("{:x}-{:x}", store->current_timestamp(), folly::Random::rand64())};
+    SegmentInMemory segment{reclamation_journal_stream_desc(journal_id)};
+    for (const auto& index_key : plan.index_keys_to_delete_) {
+        segment.set_scalar(KeepDataColumn, uint8_t{0});
+        write_key_to_segment(segment, index_key);
+    }
+    for (const auto& index_key : plan.index_keys_to_keep_) {
+        segment.set_scalar(KeepDataColumn, uint8_t{1});
+        write_key_to_segment(segment, index_key);
+    }
+    store->write_sync(KeyType::DELETE_JOURNAL, journal_id, std::move(segment));
+    return RefKey{journal_id, KeyType::DELETE_JOURNAL};
+}
+
+ReclamationPlan read_reclamation_journal(const std::shared_ptr<Store>& store, const RefKey& journal_key) {
+    auto seg = store->read_sync(journal_key).second;
+    ReclamationPlan plan;
+    for (ssize_t row = 0; row < ssize_t(seg.row_count()); ++row) {
+        if (seg.scalar_at<uint8_t>(row, KeepDataColumn).value() != 0)
+            plan.index_keys_to_keep_.emplace_back(read_key_row(seg, row));
+        else
+            plan.index_keys_to_delete_.emplace_back(read_key_row(seg, row));
+    }
+    return plan;
+}
+
+folly::Future<folly::Unit> reclaim_keys(
+    const std::shared_ptr<Store>& store,
+    const ReclamationPlan& plan,
+    const std::optional<RefKey>& journal_key) {
+    ARCTICDB_SAMPLE(ReclaimKeys, 0)
+    auto state = std::make_shared<DataKeyReclamation>();
+    state->store_ = store;
+    state->index_keys_ = plan.index_keys_to_delete_;
+    state->remove_opts_.ignores_missing_key_ = true;
+    state->read_window_ = config_at_least_one("DeleteTree.ReadWindow", 64);
+    state->batch_size_ = config_at_least_one("Storage.DeleteBatchSize", 1000);
+    state->max_batches_in_flight_ = config_at_least_one("DeleteTree.BatchesInFlight", 8);
+
+    auto read_fn = [store](const AtomKey& index_key) { return read_data_keys_to_keep(store, index_key); };
+    return folly::collect(folly::window(plan.index_keys_to_keep_, read_fn, state->read_window_))
+        .via(&async::cpu_executor())
+        .thenValue([state](auto&& keep_data_keys) {
+            for (auto& keys : keep_data_keys)
+                state->data_keys_seen_.insert(std::make_move_iterator(keys.begin()), std::make_move_iterator(keys.end()));
+
+            log::version().debug("Forbidden: {} total of data keys", state->data_keys_seen_.size());
+            return reclaim_data_keys_from(state, 0);
+        })
+        .thenValue([state, journal_key](auto&&) {
+            std::vector<VariantKey> column_stats_keys;
+            std::vector<VariantKey> index_keys;
+            for (const auto& index_key : state->index_keys_) {
+                column_stats_keys.emplace_back(index_key_to_column_stats_key(index_key));
+                index_keys.emplace_back(index_key);
+            }
+            auto store = state->store_;
+            auto remove_opts = state->remove_opts_;
+            return store->remove_keys(std::move(column_stats_keys), remove_opts)
+                .thenValue([store, index_keys = std::move(index_keys), remove_opts](auto&&) mutable {
+                    log::version().debug("Column Stats keys deleted.");
+                    return store->remove_keys(std::move(index_keys), remove_opts);
+                })
+                .thenValue([store, journal_key, remove_opts](auto&&) {
+                    log::version().debug("Index keys deleted.");
+                    if (!journal_key)
+                        return folly::makeFuture();
+
+                    return store->remove_key(*journal_key, remove_opts).thenValue([](auto&&) { return folly::Unit{}; });
+                });
+        });
+}
+
+size_t resume_reclamations(const std::shared_ptr<Store>& store, const ReplanReclamation& replan) {
+    std::vector<RefKey> journal_keys;
+    store->iterate_type(KeyType::DELETE_JOURNAL, [&journal_keys](VariantKey&& key) {
+        journal_keys.emplace_back(to_ref(key));
+    });
+
+    for (const auto& journal_key : journal_keys) {
+        ReclamationPlan plan;
+        try {
+            plan = read_reclamation_journal(store, journal_key);
+        } catch (const storage::KeyNotFoundException&) {
+            ARCTICDB_DEBUG(log::version(), "Reclamation {} finished while resuming", journal_key);
+            continue;
+        }
+        log::version().info("Resuming the interrupted deletion of {} index keys recorded in {}",
+                            plan.index_keys_to_delete_.size(), journal_key);
+        try {
+            reclaim_keys(store, plan, journal_key).get();
+        } catch (const storage::KeyNotFoundException& e) {
+            // An index key the plan kept has gone since it was made, so the data keys it protected may no longer be
+            // the right ones to keep. The checks are run again against the current version map and snapshots.
+            log::version().warn("Replanning the deletion recorded in {} as a kept index key is missing: {}", journal_key, e.what());
+            replan(std::move(plan.index_keys_to_delete_)).get();
+            storage::RemoveOpts remove_opts;
+            remove_opts.ignores_missing_key_ = true;
+            store->remove_key(journal_key, remove_opts).get();
+        }
+    }
+    return journal_keys.size();
+}
+
+} //namespace arcticdb
@@ -0,0 +1,61 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/atom_key.hpp>
+#include <arcticdb/entity/types.hpp>
+#include <arcticdb/storage/store.hpp>
+
+#include <folly/futures/Future.h>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace arcticdb {
+
+/*
+ * Reclaims the keys of index keys that have passed the pre-delete checks.
+ *
+ * The plan is first recorded in a DELETE_JOURNAL ref key. The data keys go first: they are read out of the index
+ * segments with a bounded number of reads in flight, diffed against the data keys of the index keys being kept as they
+ * arrive, and removed in batches of Storage.DeleteBatchSize with a bounded number of batches in flight, so that each
+ * batch maps onto one bulk delete request on storages that support them. The column stats and index keys are removed
+ * next and the journal last, so a delete interrupted at any point leaves its journal and index keys behind to be
+ * finished by resume_reclamations().
+ */
+struct ReclamationPlan {
+    std::vector<entity::AtomKey> index_keys_to_delete_;
+    // Index keys that may share data keys with those being deleted
+    std::vector<entity::AtomKey> index_keys_to_keep_;
+};
+
+entity::RefKey write_reclamation_journal(const std::shared_ptr<Store>& store, const ReclamationPlan& plan);
+
+ReclamationPlan read_reclamation_journal(const std::shared_ptr<Store>& store, const entity::RefKey& journal_key);
+
+/*
+ * Index keys being deleted that are already gone are taken to have been reclaimed by an earlier attempt. A missing
+ * index key that is being kept fails the reclamation before anything is removed. Nothing waits on a future, so it can
+ * be chained from an IO continuation.
+ */
+folly::Future<folly::Unit> reclaim_keys(
+    const std::shared_ptr<Store>& store,
+    const ReclamationPlan& plan,
+    const std::optional<entity::RefKey>& journal_key);
+
+// Runs the pre-delete checks again for the given index keys and reclaims those that pass them
+using ReplanReclamation = std::function<folly::Future<folly::Unit>(std::vector<entity::AtomKey>&&)>;
+
+/*
+ * Finishes every reclamation whose journal is still present, returning how many there were. A reclamation that fails
+ * because one of its kept index keys is missing is replanned from its index keys to delete.
+ */
+size_t resume_reclamations(const std::shared_ptr<Store>& store, const ReplanReclamation& replan);
+
+} //namespace arcticdb
@@ -8,12 +8,140 @@
 #include <arcticdb/version/snapshot.hpp>
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/version/version_log.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <map>
 
 using namespace arcticdb::entity;
 using namespace arcticdb::stream;
 
 namespace arcticdb {
 
+namespace {
+
+size_t manifest_shard_size() {
+    return static_cast<size_t>(std::max<int64_t>(0, ConfigsMap::instance()->get_int("Snapshot.ManifestShardSize", 0)));
+}
+
+std::vector<AtomKey> get_versions_from_segment(
+    const SegmentInMemory& snapshot_segment
+    ) {
+    std::vector<AtomKey> res;
+    res.reserve(snapshot_segment.row_count());
+    for (size_t idx = 0; idx < snapshot_segment.row_count(); idx++) {
+        auto stream_index = read_key_row(snapshot_segment, idx);
+        res.push_back(stream_index);
+    }
+    return res;
+}
+
+// Most of the searches in snapshot are for a given symbol, this helps us do a binary search on the segment
+// on read time.
+void sort_by_symbol(std::vector<AtomKey>& keys) {
+    std::sort(keys.begin(), keys.end(), [](const AtomKey &l, const AtomKey &r) {return l.id() < r.id(); });
+}
+
+folly::Future<VariantKey> write_manifest_shard(
+    const std::shared_ptr<StreamSink>& store,
+    std::vector<AtomKey>::const_iterator begin,
+    std::vector<AtomKey>::const_iterator end) {
+    const auto first_symbol = begin->id();
+    folly::Future<VariantKey> shard_fut = folly::Future<VariantKey>::makeEmpty();
+    IndexAggregator<RowCountIndex> shard_agg(first_symbol, [&shard_fut, &store, &first_symbol](auto &&segment) {
+        shard_fut = store->write(KeyType::SNAPSHOT_MANIFEST,
+                                 0,  // version_id
+                                 first_symbol,
+                                 0,  // start_index
+                                 0,  // end_index
+                                 std::forward<decltype(segment)>(segment));
+    });
+    for (auto it = begin; it != end; ++it)
+        shard_agg.add_key(*it);
+
+    shard_agg.commit();
+    return shard_fut;
+}
+
+// Splits keys sorted by symbol into shards of around shard_size keys, never splitting a symbol's keys across shards
+void write_manifest_shards(
+    const std::shared_ptr<StreamSink>& store,
+    const std::vector<AtomKey>& keys,
+    size_t shard_size,
+    std::vector<folly::Future<VariantKey>>& shard_futs) {
+    auto begin = keys.cbegin();
+    while (begin != keys.cend()) {
+        auto end = begin + static_cast<ssize_t>(std::min<size_t>(shard_size, std::distance(begin, keys.cend())));
+        while (end != keys.cend() && end->id() == std::prev(end)->id())
+            ++end;
+
+        shard_futs.emplace_back(write_manifest_shard(store, begin, end));
+        begin = end;
+    }
+}
+
+std::vector<AtomKey> collect_shard_keys(std::vector<folly::Future<VariantKey>>&& shard_futs) {
+    auto shard_keys = folly::collect(shard_futs).get();
+    std::vector<AtomKey> output;
+    output.reserve(shard_keys.size());
+    for (auto& shard_key : shard_keys)
+        output.emplace_back(to_atom(std::move(shard_key)));
+
+    return output;
+}
+
+// The contents of each shard, read concurrently
+std::vector<std::vector<AtomKey>> read_manifest_shards(
+    const std::shared_ptr<Store>& store,
+    const std::vector<AtomKey>& shard_keys) {
+    std::vector<folly::Future<std::vector<AtomKey>>> shard_futs;
+    shard_futs.reserve(shard_keys.size());
+    for (const auto& shard_key : shard_keys) {
+        shard_futs.emplace_back(store->read(shard_key).thenValue([](auto&& key_seg) {
+            return get_versions_from_segment(key_seg.second);
+        }));
+    }
+    return folly::collect(shard_futs).get();
+}
+
+SegmentInMemory snapshot_segment_from_keys(
+    const std::vector<AtomKey>& rows,
+    const SnapshotId& snapshot_id,
+    std::optional<google::protobuf::Any>&& metadata) {
+    SegmentInMemory output;
+    IndexAggregator <RowCountIndex> snapshot_agg(snapshot_id, [&output](auto &&segment) {
+        output = std::forward<decltype(segment)>(segment);
+    });
+
+    for (const auto &key: rows) {
+        snapshot_agg.add_key(key);
+    }
+    if (metadata)
+        snapshot_agg.set_metadata(std::move(*metadata));
+
+    snapshot_agg.commit();
+    return output;
+}
+
+void write_snapshot_segment(
+    const std::shared_ptr<StreamSink>& store,
+    const std::vector<AtomKey>& rows,
+    const SnapshotId& snapshot_id,
+    std::optional<google::protobuf::Any>&& metadata,
+    KeyType key_type) {
+    IndexAggregator <RowCountIndex> snapshot_agg(snapshot_id, [&](auto &&segment) {
+        store->write(key_type, snapshot_id, std::move(segment)).get();
+    });
+
+    for (const auto &key: rows) {
+        snapshot_agg.add_key(key);
+    }
+    if (metadata)
+        snapshot_agg.set_metadata(std::move(*metadata));
+
+    snapshot_agg.commit();
+}
+} //namespace
+
 void write_snapshot_entry(
         std::shared_ptr <StreamSink> store,
         std::vector <AtomKey> &keys,
@@ -24,27 +152,30 @@ void write_snapshot_entry(
 ) {
     ARCTICDB_SAMPLE(WriteJournalEntry, 0)
     ARCTICDB_RUNTIME_DEBUG(log::version(), "Command: write snapshot entry");
-    IndexAggregator <RowCountIndex> snapshot_agg(snapshot_id, [&](auto &&segment) {
-        store->write(key_type, snapshot_id, std::move(segment)).get();
-    });
+    sort_by_symbol(keys);
 
-    // Most of the searches in snapshot are for a given symbol, this helps us do a binary search on the segment
-    // on read time.
-    std::sort(keys.begin(), keys.end(), [](const AtomKey &l, const AtomKey &r) {return l.id() < r.id(); });
-
-    for (const auto &key: keys) {
-        snapshot_agg.add_key(key);
-    }
     // Serialize and store the python metadata in the journal entry for snapshot.
+    std::optional<google::protobuf::Any> metadata;
     if (!user_meta.is_none()) {
         arcticdb::proto::descriptors::UserDefinedMetadata user_meta_proto;
         google::protobuf::Any output = {};
         python_util::pb_from_python(user_meta, user_meta_proto);
         output.PackFrom(user_meta_proto);
-        snapshot_agg.set_metadata(std::move(output));
+        metadata = std::move(output);
+    }
+
+    // Only ref keys are sharded, as the legacy SNAPSHOT atom keys are looked up by iteration
+    const auto shard_size = manifest_shard_size();
+    if (key_type == KeyType::SNAPSHOT_REF && shard_size > 0 && keys.size() > shard_size) {
+        std::vector<folly::Future<VariantKey>> shard_futs;
+        write_manifest_shards(store, keys, shard_size, shard_futs);
+        auto shard_keys = collect_shard_keys(std::move(shard_futs));
+        ARCTICDB_DEBUG(log::version(), "Wrote {} keys of snapshot {} to {} shards", keys.size(), snapshot_id, shard_keys.size());
+        write_snapshot_segment(store, shard_keys, snapshot_id, std::move(metadata), key_type);
+    } else {
+        write_snapshot_segment(store, keys, snapshot_id, std::move(metadata), key_type);
     }
 
-    snapshot_agg.commit();
     if (log_changes) {
         log_create_snapshot(store, snapshot_id);
     }
@@ -156,6 +287,200 @@ row_id_for_stream_in_snapshot_segment(SegmentInMemory &seg, bool using_ref_key,
     return std::nullopt;
 }
 
+bool is_sharded_snapshot(const SegmentInMemory& snapshot_segment) {
+    return snapshot_segment.row_count() > 0 && read_key_row(snapshot_segment, 0).type() == KeyType::SNAPSHOT_MANIFEST;
+}
+
+std::vector<AtomKey> get_manifest_shards(const SegmentInMemory& snapshot_segment) {
+    if (!is_sharded_snapshot(snapshot_segment))
+        return {};
+
+    return get_versions_from_segment(snapshot_segment);
+}
+
+void remove_manifest_shards(
+        const std::shared_ptr<Store>& store,
+        const SnapshotId& snapshot_id,
+        const std::vector<AtomKey>& shards) {
+    if (shards.empty())
+        return;
+
+    // Tombstones of the same snapshot written before amendments stopped sharing shards with them may still refer to
+    // some of these shards. Their ids are the snapshot's ref key followed by '@' and a timestamp.
+    std::unordered_set<AtomKey> referenced;
+    const auto tombstone_prefix = fmt::format("{}@", RefKey{snapshot_id, KeyType::SNAPSHOT_REF});
+    store->iterate_type(KeyType::SNAPSHOT_TOMBSTONE, [&store, &referenced, &tombstone_prefix](VariantKey&& tombstone_key) {
+        if (fmt::format("{}", variant_key_id(tombstone_key)).rfind(tombstone_prefix, 0) != 0)
+            return;
+
+        for (auto&& shard : get_manifest_shards(store->read_sync(tombstone_key).second))
+            referenced.emplace(std::move(shard));
+    });
+
+    std::vector<VariantKey> to_remove;
+    for (const auto& shard : shards) {
+        if (referenced.count(shard) == 0)
+            to_remove.emplace_back(shard);
+    }
+    ARCTICDB_DEBUG(log::version(), "Removing {} of {} manifest shards of snapshot {}", to_remove.size(), shards.size(), snapshot_id);
+    store->remove_keys(std::move(to_remove)).get();
+}
+
+std::vector<AtomKey> read_snapshot_index_keys(
+        const std::shared_ptr<Store>& store,
+        const SegmentInMemory& snapshot_segment) {
+    auto rows = get_versions_from_segment(snapshot_segment);
+    if (rows.empty() || rows[0].type() != KeyType::SNAPSHOT_MANIFEST)
+        return rows;
+
+    std::vector<AtomKey> res;
+    for (auto& shard : read_manifest_shards(store, rows)) {
+        res.insert(res.end(), std::make_move_iterator(shard.begin()), std::make_move_iterator(shard.end()));
+    }
+    return res;
+}
+
+std::optional<AtomKey> find_index_key_in_snapshot(
+        const std::shared_ptr<Store>& store,
+        SegmentInMemory& snapshot_segment,
+        bool using_ref_key,
+        const StreamId& stream_id) {
+    if (!is_sharded_snapshot(snapshot_segment)) {
+        auto opt_idx_for_stream_id = row_id_for_stream_in_snapshot_segment(snapshot_segment, using_ref_key, stream_id);
+        if (!opt_idx_for_stream_id)
+            return std::nullopt;
+
+        return read_key_row(snapshot_segment, static_cast<ssize_t>(*opt_idx_for_stream_id));
+    }
+
+    // Shards are named after their first symbol, so the only one that can hold stream_id is the last one starting at
+    // or before it
+    auto ub = std::upper_bound(std::begin(snapshot_segment), std::end(snapshot_segment), stream_id,
+                               [&](StreamId t, auto &row) {
+                                   return t < stream_id_from_segment<pipelines::index::Fields>(
+                                           snapshot_segment,
+                                           row.row_id_);
+                               });
+    if (ub == std::begin(snapshot_segment))
+        return std::nullopt;
+
+    auto shard_key = read_key_row(snapshot_segment, std::distance(std::begin(snapshot_segment), ub) - 1);
+    auto shard_segment = store->read_sync(shard_key).second;
+    auto opt_idx_for_stream_id = row_id_for_stream_in_snapshot_segment(shard_segment, true, stream_id);
+    if (!opt_idx_for_stream_id)
+        return std::nullopt;
+
+    return read_key_row(shard_segment, static_cast<ssize_t>(*opt_idx_for_stream_id));
+}
+
+SnapshotAmendment amend_snapshot_entry(
+        const std::shared_ptr<Store>& store,
+        const VariantKey& snap_key,
+        SegmentInMemory&& snapshot_segment,
+        std::vector<AtomKey>&& added_keys,
+        const std::vector<StreamId>& touched_symbols,
+        const std::function<bool(const AtomKey&)>& is_removed,
+        bool tombstone_previous,
+        bool log_changes) {
+    ARCTICDB_SAMPLE(AmendSnapshotEntry, 0)
+    const SnapshotId snapshot_id = variant_key_id(snap_key);
+    const auto shard_size = manifest_shard_size();
+    SnapshotAmendment output;
+    std::vector<AtomKey> new_rows;
+    auto rows = get_versions_from_segment(snapshot_segment);
+    const bool sharded = !rows.empty() && rows[0].type() == KeyType::SNAPSHOT_MANIFEST;
+    if (!sharded) {
+        // Flat snapshots are rewritten in full, and sharded once they grow past the shard size
+        for (auto&& key : rows) {
+            if (is_removed(key))
+                output.removed_keys_.emplace_back(std::move(key));
+            else
+                new_rows.emplace_back(std::move(key));
+        }
+        new_rows.insert(new_rows.end(), std::make_move_iterator(added_keys.begin()), std::make_move_iterator(added_keys.end()));
+        sort_by_symbol(new_rows);
+        if (shard_size > 0 && new_rows.size() > shard_size) {
+            std::vector<folly::Future<VariantKey>> shard_futs;
+            write_manifest_shards(store, new_rows, shard_size, shard_futs);
+            new_rows = collect_shard_keys(std::move(shard_futs));
+        }
+    } else {
+        // A symbol belongs to the last shard starting at or before it, or to the first shard if it sorts before them all
+        auto shard_for = [&rows](const StreamId& stream_id) -> size_t {
+            auto ub = std::upper_bound(rows.begin(), rows.end(), stream_id, [](const StreamId& l, const AtomKey& r) {
+                return l < r.id();
+            });
+            return ub == rows.begin() ? 0 : static_cast<size_t>(std::distance(rows.begin(), ub) - 1);
+        };
+        std::map<size_t, std::vector<AtomKey>> touched_shards;
+        for (const auto& stream_id : touched_symbols)
+            touched_shards[shard_for(stream_id)];
+
+        for (auto&& key : added_keys)
+            touched_shards[shard_for(key.id())].emplace_back(std::move(key));
+
+        std::vector<AtomKey> shards_to_read;
+        for (const auto& [shard_idx, keys] : touched_shards)
+            shards_to_read.push_back(rows[shard_idx]);
+
+        auto contents = read_manifest_shards(store, shards_to_read);
+        auto shard_contents = contents.begin();
+        std::vector<folly::Future<VariantKey>> shard_futs;
+        for (auto& [shard_idx, keys] : touched_shards) {
+            for (auto&& key : *shard_contents++) {
+                if (is_removed(key))
+                    output.removed_keys_.emplace_back(std::move(key));
+                else
+                    keys.emplace_back(std::move(key));
+            }
+            sort_by_symbol(keys);
+            // Each touched shard is rewritten on its own so that shards never overlap, and only split once it has
+            // doubled in size so that adding to a full shard doesn't leave a trail of tiny ones
+            const auto split_size = shard_size > 0 && keys.size() > 2 * shard_size ? shard_size : keys.size();
+            write_manifest_shards(store, keys, split_size, shard_futs);
+            output.replaced_shards_.push_back(rows[shard_idx]);
+        }
+        auto new_shards = collect_shard_keys(std::move(shard_futs));
+        for (size_t shard_idx = 0; shard_idx < rows.size(); ++shard_idx) {
+            if (touched_shards.find(shard_idx) == touched_shards.end())
+                new_rows.push_back(rows[shard_idx]);
+        }
+        new_rows.insert(new_rows.end(), new_shards.begin(), new_shards.end());
+        sort_by_symbol(new_rows);
+        ARCTICDB_DEBUG(log::version(), "Rewrote {} of {} shards of snapshot {}", touched_shards.size(), rows.size(), snapshot_id);
+    }
+
+    if (new_rows.empty() && !tombstone_previous) {
+        // Empty snapshot segments are never written, so the current one and its shards stay in place
+        output.replaced_shards_.clear();
+    }
+
+    std::optional<google::protobuf::Any> metadata;
+    if (snapshot_segment.metadata())
+        metadata = *snapshot_segment.metadata();
+
+    if (tombstone_previous && sharded) {
+        // The new segment shares the untouched shards, so a tombstone of the old segment would leave two owners for
+        // them. Delayed deletes only need the tombstone to keep the removed keys alive, so it holds just those, and
+        // the replaced shards are left for the caller to remove.
+        if (!output.removed_keys_.empty()) {
+            auto tombstone_metadata = metadata;
+            tombstone_snapshot(store, to_ref(snap_key), snapshot_segment_from_keys(output.removed_keys_, snapshot_id, std::move(tombstone_metadata)), log_changes);
+        } else if (log_changes) {
+            log_delete_snapshot(store, snapshot_id);
+        }
+    } else if (tombstone_previous) {
+        tombstone_snapshot(store, to_ref(snap_key), std::move(snapshot_segment), log_changes);
+    } else if (log_changes) {
+        log_delete_snapshot(store, snapshot_id);
+    }
+    write_snapshot_segment(store, new_rows, snapshot_id, std::move(metadata), KeyType::SNAPSHOT_REF);
+    if (log_changes) {
+        log_create_snapshot(store, snapshot_id);
+    }
+    return output;
+}
+
 std::unordered_map<VariantKey, SnapshotRefData> get_snapshots_and_index_keys(
         const std::shared_ptr<Store>& store
         ) {
@@ -165,8 +490,7 @@ std::unordered_map<VariantKey, SnapshotRefData> get_snapshots_and_index_keys(
         try {
             auto segment = store->read_sync(vk).second;
             std::unordered_set<VariantKey> index_keys;
-            for (size_t idx = 0; idx < segment.row_count(); idx++) {
-                auto key = read_key_row(segment, idx);
+            for (auto&& key : read_snapshot_index_keys(store, segment)) {
                 if (is_index_key_type(key.type())) {
                     index_keys.emplace(std::move(key));
                 }
@@ -196,11 +520,9 @@ std::unordered_set<entity::AtomKey> get_index_keys_in_snapshots(
                     variant_key_id(vk), stream_id);
           return;
         }
-        auto opt_idx_for_stream_id = row_id_for_stream_in_snapshot_segment(
-                snapshot_segment, snapshot_using_ref, stream_id);
-        if (opt_idx_for_stream_id) {
-            auto stream_idx = opt_idx_for_stream_id.value();
-            index_keys_in_snapshots.insert(read_key_row(snapshot_segment, stream_idx));
+        auto opt_index_key = find_index_key_in_snapshot(store, snapshot_segment, snapshot_using_ref, stream_id);
+        if (opt_index_key) {
+            index_keys_in_snapshots.insert(std::move(*opt_index_key));
         }
     });
 
@@ -270,25 +592,13 @@ std::set<StreamId> list_streams_in_snapshot(
 
     auto& snapshot_segment = opt_snap_key.value().second;
 
-    for (size_t idx = 0; idx < snapshot_segment.row_count(); idx++) {
-        auto stream_index = read_key_row(snapshot_segment, idx);
+    for (const auto& stream_index : read_snapshot_index_keys(store, snapshot_segment)) {
         res.insert(stream_index.id());
     }
     return res;
 }
 
 namespace {
-std::vector<AtomKey> get_versions_from_segment(
-    const SegmentInMemory& snapshot_segment
-    ) {
-    std::vector<AtomKey> res;
-    for (size_t idx = 0; idx < snapshot_segment.row_count(); idx++) {
-        auto stream_index = read_key_row(snapshot_segment, idx);
-        res.push_back(stream_index);
-    }
-    return res;
-}
-
 py::object get_metadata_from_segment(
     const SegmentInMemory& snapshot_segment
     ) {
@@ -309,7 +619,7 @@ std::vector<AtomKey> get_versions_from_snapshot(
     const VariantKey& vk) {
 
     auto snapshot_segment = store->read_sync(vk).second;
-    return get_versions_from_segment(snapshot_segment);
+    return read_snapshot_index_keys(store, snapshot_segment);
 }
 } //namespace
 
@@ -318,7 +628,7 @@ std::pair<std::vector<AtomKey>, py::object> get_versions_and_metadata_from_snaps
     const VariantKey& vk
     ) {
     auto snapshot_segment = store->read_sync(vk).second;
-    return {get_versions_from_segment(snapshot_segment), get_metadata_from_segment(snapshot_segment)};
+    return {read_snapshot_index_keys(store, snapshot_segment), get_metadata_from_segment(snapshot_segment)};
 }
 
 SnapshotMap get_versions_from_snapshots(
@@ -349,8 +659,7 @@ MasterSnapshotMap get_master_snapshots_map(
     iterate_snapshots(store, [&](VariantKey &sk) {
         auto snapshot_id = variant_key_id(sk);
         auto snapshot_segment = store->read_sync(sk).second;
-        for (size_t idx = 0; idx < snapshot_segment.row_count(); idx++) {
-            auto stream_index = read_key_row(snapshot_segment, idx);
+        for (const auto& stream_index : read_snapshot_index_keys(store, snapshot_segment)) {
             out[stream_index.id()][stream_index].insert(snapshot_id);
             if (get_keys_in_snapshot) {
                 auto[wanted_snap_key, sink] = get_keys_in_snapshot.value();
@@ -19,6 +19,8 @@
 #include <arcticdb/storage/store.hpp>
 #include <arcticdb/util/variant.hpp>
 
+#include <functional>
+
 using namespace arcticdb::entity;
 using namespace arcticdb::stream;
 
@@ -35,6 +37,17 @@ struct SnapshotRefData {
     std::unordered_set<VariantKey> index_keys_;
 };
 
+/*
+ * Snapshots larger than Snapshot.ManifestShardSize keys are sharded. Their contents, sorted by symbol, are split into
+ * SNAPSHOT_MANIFEST segments, and the snapshot segment holds the keys of those shards in place of the index keys. Each
+ * shard key is content-addressed and named after the first symbol in its shard, so a symbol can be found by binary
+ * searching the snapshot segment and reading a single shard, and amending the snapshot only rewrites the shards holding
+ * the symbols it touches. Smaller snapshots keep the flat layout. The default of 0 turns sharding off, since readers
+ * from before manifests cannot read sharded snapshots.
+ *
+ * Deleting a sharded snapshot with delayed deletes leaves a tombstone that refers to its shards. Nothing in this
+ * library removes snapshot tombstones, so whatever does must remove their shards too.
+ */
 void write_snapshot_entry(
     std::shared_ptr <StreamSink> store,
     std::vector <AtomKey> &keys,
@@ -71,6 +84,57 @@ std::optional<size_t> row_id_for_stream_in_snapshot_segment(
     bool using_ref_key,
     StreamId stream_id);
 
+bool is_sharded_snapshot(const SegmentInMemory& snapshot_segment);
+
+// The manifest shards a snapshot segment refers to, empty if it is not sharded
+std::vector<AtomKey> get_manifest_shards(const SegmentInMemory& snapshot_segment);
+
+/*
+ * Removes manifest shards that a snapshot no longer refers to, keeping any that a tombstone of the same snapshot
+ * still refers to.
+ */
+void remove_manifest_shards(
+    const std::shared_ptr<Store>& store,
+    const SnapshotId& snapshot_id,
+    const std::vector<AtomKey>& shards);
+
+// The index keys in a snapshot segment, reading any manifest shards it refers to concurrently
+std::vector<AtomKey> read_snapshot_index_keys(
+    const std::shared_ptr<Store>& store,
+    const SegmentInMemory& snapshot_segment);
+
+// Reads at most one manifest shard
+std::optional<AtomKey> find_index_key_in_snapshot(
+    const std::shared_ptr<Store>& store,
+    SegmentInMemory& snapshot_segment,
+    bool using_ref_key,
+    const StreamId& stream_id);
+
+struct SnapshotAmendment {
+    // Index keys the amendment took out of the snapshot
+    std::vector<AtomKey> removed_keys_;
+    // Manifest shards the amended snapshot no longer refers to
+    std::vector<AtomKey> replaced_shards_;
+};
+
+/**
+ * Rewrites a snapshot with added_keys added and any of its keys matching is_removed taken out. For sharded snapshots
+ * only the shards holding touched_symbols are read and rewritten; is_removed is only applied to those shards, so every
+ * removed key's symbol must be in touched_symbols.
+ * @param tombstone_previous Whether to tombstone the current snapshot segment rather than just overwrite it. For a
+ * sharded snapshot the tombstone only holds the removed keys, so that no shard is shared between the tombstone and the
+ * new segment, and the replaced shards can be removed straight away either way.
+ */
+SnapshotAmendment amend_snapshot_entry(
+    const std::shared_ptr<Store>& store,
+    const VariantKey& snap_key,
+    SegmentInMemory&& snapshot_segment,
+    std::vector<AtomKey>&& added_keys,
+    const std::vector<StreamId>& touched_symbols,
+    const std::function<bool(const AtomKey&)>& is_removed,
+    bool tombstone_previous,
+    bool log_changes);
+
 // Get a set of the index keys of a particular symbol that exist in any snapshot
 std::unordered_set<entity::AtomKey> get_index_keys_in_snapshots(
     std::shared_ptr <Store> store,
@@ -119,7 +119,7 @@ bool SymbolList::can_update_symbol_list(const std::shared_ptr<Store>& store,
     SymbolList::CollectionType SymbolList::load_from_version_keys(const std::shared_ptr<Store>& store) {
         SYMBOL_LIST_RUNTIME_LOG("Loading symbols from version keys");
         std::vector<StreamId> stream_ids;
-        store->iterate_type(KeyType::VERSION_REF, [&] (const auto& key) {
+        store->iterate_type_parallel(KeyType::VERSION_REF, [&] (const auto& key) {
             auto id = variant_key_id(key);
             stream_ids.push_back(id);
 
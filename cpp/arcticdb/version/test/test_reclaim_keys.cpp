@@ -0,0 +1,118 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/version/reclaim_keys.hpp>
+#include <arcticdb/storage/test/in_memory_store.hpp>
+#include <arcticdb/stream/index_aggregator.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+namespace arcticdb {
+
+namespace {
+AtomKey write_test_data_key(const std::shared_ptr<InMemoryStore>& store, const StreamId& stream_id, timestamp start) {
+    return to_atom(store->write(KeyType::TABLE_DATA, 0, stream_id, start, start + 1, SegmentInMemory{}).get());
+}
+
+AtomKey write_test_index_key(
+    const std::shared_ptr<InMemoryStore>& store,
+    const StreamId& stream_id,
+    VersionId version_id,
+    const std::vector<AtomKey>& data_keys) {
+    folly::Future<VariantKey> index_fut = folly::Future<VariantKey>::makeEmpty();
+    IndexAggregator<RowCountIndex> index_agg(stream_id, [&](auto&& segment) {
+        index_fut = store->write(KeyType::TABLE_INDEX, version_id, stream_id, 0, 0, std::forward<decltype(segment)>(segment));
+    });
+    for (const auto& data_key : data_keys)
+        index_agg.add_key(data_key);
+
+    index_agg.commit();
+    return to_atom(std::move(index_fut).get());
+}
+
+folly::Future<folly::Unit> unexpected_replan(std::vector<AtomKey>&&) {
+    ADD_FAILURE() << "Unexpected replan";
+    return folly::Unit{};
+}
+} // namespace
+
+TEST(ReclaimKeys, RemovesOnlyUnsharedData) {
+    ScopedConfig batch_size("Storage.DeleteBatchSize", 1);
+    auto store = std::make_shared<InMemoryStore>();
+    const StreamId stream_id{StringId{"sym"}};
+
+    auto only_deleted = write_test_data_key(store, stream_id, 0);
+    auto shared = write_test_data_key(store, stream_id, 1);
+    auto only_kept = write_test_data_key(store, stream_id, 2);
+    auto index_to_delete = write_test_index_key(store, stream_id, 0, {only_deleted, shared});
+    auto index_to_keep = write_test_index_key(store, stream_id, 1, {shared, only_kept});
+
+    ReclamationPlan plan{{index_to_delete}, {index_to_keep}};
+    auto journal_key = write_reclamation_journal(store, plan);
+    auto journalled = read_reclamation_journal(store, journal_key);
+    ASSERT_EQ(journalled.index_keys_to_delete_, plan.index_keys_to_delete_);
+    ASSERT_EQ(journalled.index_keys_to_keep_, plan.index_keys_to_keep_);
+
+    reclaim_keys(store, plan, journal_key).get();
+    ASSERT_FALSE(store->key_exists_sync(only_deleted));
+    ASSERT_FALSE(store->key_exists_sync(index_to_delete));
+    ASSERT_FALSE(store->key_exists_sync(journal_key));
+    ASSERT_TRUE(store->key_exists_sync(shared));
+    ASSERT_TRUE(store->key_exists_sync(only_kept));
+    ASSERT_TRUE(store->key_exists_sync(index_to_keep));
+}
+
+TEST(ReclaimKeys, ResumeInterrupted) {
+    auto store = std::make_shared<InMemoryStore>();
+    const StreamId stream_id{StringId{"sym"}};
+
+    std::vector<AtomKey> data_keys;
+    for (timestamp start = 0; start < 5; ++start)
+        data_keys.push_back(write_test_data_key(store, stream_id, start));
+
+    auto index_key = write_test_index_key(store, stream_id, 0, data_keys);
+
+    // As if the process died after removing some of the data keys
+    write_reclamation_journal(store, ReclamationPlan{{index_key}, {}});
+    store->remove_key_sync(data_keys[1], storage::RemoveOpts{});
+    store->remove_key_sync(data_keys[3], storage::RemoveOpts{});
+
+    ASSERT_EQ(resume_reclamations(store, unexpected_replan), 1u);
+    for (const auto& data_key : data_keys)
+        ASSERT_FALSE(store->key_exists_sync(data_key));
+
+    ASSERT_FALSE(store->key_exists_sync(index_key));
+    ASSERT_EQ(resume_reclamations(store, unexpected_replan), 0u);
+}
+
+TEST(ReclaimKeys, MissingKeptIndexKeyReplans) {
+    auto store = std::make_shared<InMemoryStore>();
+    const StreamId stream_id{StringId{"sym"}};
+
+    auto shared = write_test_data_key(store, stream_id, 0);
+    auto index_to_delete = write_test_index_key(store, stream_id, 0, {shared});
+    auto index_to_keep = write_test_index_key(store, stream_id, 1, {shared});
+    auto journal_key = write_reclamation_journal(store, ReclamationPlan{{index_to_delete}, {index_to_keep}});
+    store->remove_key_sync(index_to_keep, storage::RemoveOpts{});
+
+    // Nothing is removed on the strength of a plan whose kept keys have changed
+    ASSERT_THROW(reclaim_keys(store, read_reclamation_journal(store, journal_key), journal_key).get(), storage::KeyNotFoundException);
+    ASSERT_TRUE(store->key_exists_sync(shared));
+    ASSERT_TRUE(store->key_exists_sync(index_to_delete));
+
+    std::vector<AtomKey> replanned;
+    ASSERT_EQ(resume_reclamations(store, [&replanned](std::vector<AtomKey>&& index_keys) {
+        replanned = std::move(index_keys);
+        return folly::makeFuture(folly::Unit{});
+    }), 1u);
+    ASSERT_EQ(replanned, std::vector<AtomKey>{index_to_delete});
+    ASSERT_TRUE(store->key_exists_sync(shared));
+    ASSERT_FALSE(store->key_exists_sync(journal_key));
+}
+
+} // namespace arcticdb
@@ -0,0 +1,163 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/version/snapshot.hpp>
+#include <arcticdb/storage/test/in_memory_store.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+namespace arcticdb {
+
+namespace {
+AtomKey snapshot_test_index_key(const std::string& symbol, VersionId version_id) {
+    return atom_key_builder().version_id(version_id).creation_ts(PilotedClock::nanos_since_epoch()).content_hash(version_id)
+        .start_index(0).end_index(1).build(StreamId{symbol}, KeyType::TABLE_INDEX);
+}
+
+std::vector<std::string> snapshot_symbols(const std::vector<AtomKey>& keys) {
+    std::vector<std::string> output;
+    for (const auto& key : keys)
+        output.push_back(fmt::format("{}", key.id()));
+
+    return output;
+}
+} // namespace
+
+TEST(SnapshotManifest, ShardedSnapshot) {
+    ScopedConfig shard_size("Snapshot.ManifestShardSize", 2);
+    auto store = std::make_shared<InMemoryStore>();
+    const SnapshotId snap_name{StringId{"snap"}};
+
+    std::vector<AtomKey> keys;
+    for (const auto* symbol : {"e", "a", "c", "b", "d"})
+        keys.push_back(snapshot_test_index_key(symbol, 0));
+
+    write_snapshot_entry(store, keys, snap_name, py::none{}, false);
+
+    auto [snap_key, segment] = get_snapshot(store, snap_name).value();
+    ASSERT_TRUE(is_sharded_snapshot(segment));
+    const auto shards = get_manifest_shards(segment);
+    ASSERT_EQ(snapshot_symbols(shards), (std::vector<std::string>{"a", "c", "e"}));
+    ASSERT_EQ(snapshot_symbols(read_snapshot_index_keys(store, segment)), (std::vector<std::string>{"a", "b", "c", "d", "e"}));
+
+    ASSERT_EQ(find_index_key_in_snapshot(store, segment, true, StreamId{StringId{"d"}}), keys[3]);
+    ASSERT_FALSE(find_index_key_in_snapshot(store, segment, true, StreamId{StringId{"bb"}}));
+    ASSERT_FALSE(find_index_key_in_snapshot(store, segment, true, StreamId{StringId{"0"}}));
+
+    // Replacing a symbol only rewrites its own shard
+    auto new_key = snapshot_test_index_key("d", 1);
+    auto amendment = amend_snapshot_entry(
+        store,
+        snap_key,
+        std::move(segment),
+        {new_key},
+        {StreamId{StringId{"d"}}},
+        [](const AtomKey& key) { return key.id() == StreamId{StringId{"d"}}; },
+        false,
+        false);
+    ASSERT_EQ(amendment.removed_keys_, std::vector<AtomKey>{keys[3]});
+    ASSERT_EQ(amendment.replaced_shards_, std::vector<AtomKey>{shards[1]});
+
+    auto amended = get_snapshot(store, snap_name).value().second;
+    const auto amended_shards = get_manifest_shards(amended);
+    ASSERT_EQ(amended_shards.size(), 3u);
+    ASSERT_EQ(amended_shards[0], shards[0]);
+    ASSERT_NE(amended_shards[1], shards[1]);
+    ASSERT_EQ(amended_shards[2], shards[2]);
+    ASSERT_EQ(find_index_key_in_snapshot(store, amended, true, StreamId{StringId{"d"}}), new_key);
+
+    // Emptied shards are dropped
+    amendment = amend_snapshot_entry(
+        store,
+        snap_key,
+        std::move(amended),
+        {},
+        {StreamId{StringId{"a"}}, StreamId{StringId{"b"}}},
+        [](const AtomKey& key) { return key.id() == StreamId{StringId{"a"}} || key.id() == StreamId{StringId{"b"}}; },
+        false,
+        false);
+    ASSERT_EQ(amendment.removed_keys_.size(), 2u);
+    auto reduced = get_snapshot(store, snap_name).value().second;
+    ASSERT_EQ(snapshot_symbols(get_manifest_shards(reduced)), (std::vector<std::string>{"c", "e"}));
+    ASSERT_EQ(snapshot_symbols(read_snapshot_index_keys(store, reduced)), (std::vector<std::string>{"c", "d", "e"}));
+}
+
+TEST(SnapshotManifest, TombstonesDoNotShareShards) {
+    ScopedConfig shard_size("Snapshot.ManifestShardSize", 2);
+    auto store = std::make_shared<InMemoryStore>();
+    const SnapshotId snap_name{StringId{"snap"}};
+
+    std::vector<AtomKey> keys;
+    for (const auto* symbol : {"a", "b", "c", "d"})
+        keys.push_back(snapshot_test_index_key(symbol, 0));
+
+    write_snapshot_entry(store, keys, snap_name, py::none{}, false);
+    auto [snap_key, segment] = get_snapshot(store, snap_name).value();
+    const auto shards = get_manifest_shards(segment);
+    ASSERT_EQ(shards.size(), 2u);
+
+    // Amending with delayed deletes only puts the removed key in the tombstone
+    auto amendment = amend_snapshot_entry(
+        store,
+        snap_key,
+        std::move(segment),
+        {},
+        {StreamId{StringId{"a"}}},
+        [](const AtomKey& key) { return key.id() == StreamId{StringId{"a"}}; },
+        true,
+        false);
+    ASSERT_EQ(amendment.replaced_shards_, std::vector<AtomKey>{shards[0]});
+
+    std::vector<VariantKey> tombstones;
+    store->iterate_type(KeyType::SNAPSHOT_TOMBSTONE, [&tombstones](VariantKey&& key) { tombstones.emplace_back(std::move(key)); });
+    ASSERT_EQ(tombstones.size(), 1u);
+    auto tombstone_segment = store->read_sync(tombstones[0]).second;
+    ASSERT_FALSE(is_sharded_snapshot(tombstone_segment));
+    ASSERT_EQ(read_snapshot_index_keys(store, tombstone_segment), std::vector<AtomKey>{keys[0]});
+
+    remove_manifest_shards(store, snap_name, amendment.replaced_shards_);
+    ASSERT_FALSE(store->key_exists_sync(shards[0]));
+    auto amended = get_snapshot(store, snap_name).value().second;
+    ASSERT_EQ(snapshot_symbols(read_snapshot_index_keys(store, amended)), (std::vector<std::string>{"b", "c", "d"}));
+}
+
+TEST(SnapshotManifest, ShardsInOlderTombstonesAreKept) {
+    ScopedConfig shard_size("Snapshot.ManifestShardSize", 2);
+    auto store = std::make_shared<InMemoryStore>();
+    const SnapshotId snap_name{StringId{"snap"}};
+
+    std::vector<AtomKey> keys;
+    for (const auto* symbol : {"a", "b", "c", "d"})
+        keys.push_back(snapshot_test_index_key(symbol, 0));
+
+    write_snapshot_entry(store, keys, snap_name, py::none{}, false);
+    auto [snap_key, segment] = get_snapshot(store, snap_name).value();
+    const auto shards = get_manifest_shards(segment);
+
+    // Older amendments tombstoned the whole segment, sharing its shards with the snapshot that replaced it
+    tombstone_snapshot(store, to_ref(snap_key), std::move(segment), false);
+    remove_manifest_shards(store, snap_name, shards);
+    ASSERT_TRUE(store->key_exists_sync(shards[0]));
+    ASSERT_TRUE(store->key_exists_sync(shards[1]));
+}
+
+TEST(SnapshotManifest, SmallSnapshotsStayFlat) {
+    ScopedConfig shard_size("Snapshot.ManifestShardSize", 10);
+    auto store = std::make_shared<InMemoryStore>();
+    const SnapshotId snap_name{StringId{"snap"}};
+
+    std::vector<AtomKey> keys{snapshot_test_index_key("b", 0), snapshot_test_index_key("a", 0)};
+    write_snapshot_entry(store, keys, snap_name, py::none{}, false);
+
+    auto segment = get_snapshot(store, snap_name).value().second;
+    ASSERT_FALSE(is_sharded_snapshot(segment));
+    ASSERT_TRUE(get_manifest_shards(segment).empty());
+    ASSERT_EQ(snapshot_symbols(read_snapshot_index_keys(store, segment)), (std::vector<std::string>{"a", "b"}));
+}
+
+} // namespace arcticdb
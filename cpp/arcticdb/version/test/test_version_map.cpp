@@ -427,6 +427,78 @@ TEST(VersionMap, GetNextVersionInEntry) {
     ASSERT_EQ(get_next_version_in_entry(entry, 0).value(), 1);
 }
 
+TEST(VersionMap, SkipLinks) {
+    auto store = std::make_shared<InMemoryStore>();
+    StreamId id{"test_skip_links"};
+    ScopedConfig reload_interval("VersionMap.ReloadInterval", 0); // always reload
+
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    constexpr VersionId num_versions = 200;
+    constexpr VersionId tombstoned_version = 50;
+    std::vector<AtomKey> keys;
+    for (VersionId version_id = 0; version_id < num_versions; ++version_id) {
+        keys.push_back(atom_key_builder().version_id(version_id).creation_ts(1000 + version_id * 10).content_hash(version_id)
+            .start_index(0).end_index(1).build(id, KeyType::TABLE_INDEX));
+        version_map->write_version(store, keys.back());
+        if (version_id == 120)
+            tombstone_version(store, version_map, id, tombstoned_version, pipelines::VersionQuery{}, ReadOptions{});
+    }
+    version_map->flush();
+
+    auto count_version_keys = [](const auto& entry) {
+        return std::count_if(entry->keys_.begin(), entry->keys_.end(), [](const auto& k) { return k.type() == KeyType::VERSION; });
+    };
+
+    LoadParameter load_param{LoadType::LOAD_DOWNTO, 3};
+    load_param.follow_skip_links_ = true;
+    auto entry = version_map->check_reload(store, id, load_param, __FUNCTION__);
+    ASSERT_TRUE(entry->sparse_);
+    ASSERT_LT(count_version_keys(entry), 20);
+    ASSERT_EQ(find_index_key_for_version_id(3, entry), keys[3]);
+
+    // Every version is found, and the tombstone in the middle of the chain is not jumped over
+    for (VersionId version_id = 0; version_id < num_versions; ++version_id) {
+        auto found = get_specific_version(store, version_map, id, static_cast<SignedVersionId>(version_id), pipelines::VersionQuery{}, ReadOptions{});
+        if (version_id == tombstoned_version)
+            ASSERT_FALSE(found);
+        else
+            ASSERT_EQ(found, keys[version_id]);
+    }
+    // Negative versions count back from the latest
+    ASSERT_FALSE(get_specific_version(store, version_map, id, -150, pipelines::VersionQuery{}, ReadOptions{}));
+    ASSERT_EQ(get_specific_version(store, version_map, id, -149, pipelines::VersionQuery{}, ReadOptions{}), keys[51]);
+
+    auto at_time = load_index_key_from_time(store, version_map, id, 1000 + 10 * 10 + 5, pipelines::VersionQuery{}, ReadOptions{});
+    ASSERT_EQ(at_time, keys[10]);
+    at_time = load_index_key_from_time(store, version_map, id, 1000 + tombstoned_version * 10, pipelines::VersionQuery{}, ReadOptions{});
+    ASSERT_EQ(at_time, keys[tombstoned_version - 1]);
+
+    // Compaction removes the journal segments below the one it rewrites, and floors the head's links to match
+    auto ref_links_exist = [&store, &id]() {
+        VersionMapEntry ref_entry;
+        read_symbol_ref(store, id, ref_entry);
+        return ref_entry.head_links_ && std::all_of(ref_entry.head_links_->links_.begin(), ref_entry.head_links_->links_.end(),
+            [&store](const auto& link) { return store->key_exists_sync(link.version_key_); });
+    };
+    ScopedConfig max_blocks("VersionMap.MaxVersionBlocks", 1);
+    version_map->compact(store, id);
+    version_map->flush();
+    ASSERT_TRUE(ref_links_exist());
+    ASSERT_EQ(get_specific_version(store, version_map, id, 3, pipelines::VersionQuery{}, ReadOptions{}), keys[3]);
+
+    // Later writes link back over the compacted chain
+    for (VersionId version_id = num_versions; version_id < num_versions + 40; ++version_id) {
+        keys.push_back(atom_key_builder().version_id(version_id).creation_ts(1000 + version_id * 10).content_hash(version_id)
+            .start_index(0).end_index(1).build(id, KeyType::TABLE_INDEX));
+        version_map->write_version(store, keys.back());
+    }
+    version_map->flush();
+    ASSERT_TRUE(ref_links_exist());
+    ASSERT_EQ(get_specific_version(store, version_map, id, 7, pipelines::VersionQuery{}, ReadOptions{}), keys[7]);
+    ASSERT_EQ(get_specific_version(store, version_map, id, 210, pipelines::VersionQuery{}, ReadOptions{}), keys[210]);
+}
+
 TEST(VersionMap, FixRefKey) {
     auto store = std::make_shared<InMemoryStore>();
     StreamId id{"test_fix_ref"};
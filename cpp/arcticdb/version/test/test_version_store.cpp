@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <arcticdb/version/version_store_api.hpp>
+#include <arcticdb/version/version_functions.hpp>
 #include <arcticdb/storage/open_mode.hpp>
 #include <arcticdb/entity/types.hpp>
 #include <arcticdb/storage/memory/memory_storage.hpp>
@@ -353,6 +354,43 @@ TEST_F(VersionStoreTest, StressBatchReadUncompressed) {
     }
 }
 
+TEST_F(VersionStoreTest, BatchMetadataWithRepeatedSymbols) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    std::vector<StreamId> symbols;
+    for(int i = 0; i < 3; ++i) {
+        auto symbol = fmt::format("symbol_{}", i);
+        for(int j = 0; j < 2; ++j) {
+            auto wrapper = get_test_simple_frame(symbol, 10, i + j);
+            test_store_->write_versioned_dataframe_internal(symbol, std::move(wrapper.frame_), false, false, false);
+        }
+        // Each symbol is requested twice, at the latest version and at version 0
+        symbols.emplace_back(symbol);
+        symbols.emplace_back(symbol);
+    }
+
+    std::vector<VersionQuery> version_queries(symbols.size());
+    for(size_t i = 1; i < version_queries.size(); i += 2)
+        version_queries[i].set_version(0);
+
+    auto update_times = test_store_->batch_get_update_times(symbols, version_queries);
+    ReadOptions read_options;
+    read_options.set_batch_throw_on_error(true);
+    auto metadata = test_store_->batch_read_metadata_internal(symbols, version_queries, read_options);
+    auto descriptors = test_store_->batch_read_descriptor_internal(symbols, version_queries, read_options);
+    ASSERT_EQ(update_times.size(), symbols.size());
+    ASSERT_EQ(metadata.size(), symbols.size());
+    ASSERT_EQ(descriptors.size(), symbols.size());
+    for(size_t i = 0; i < symbols.size(); ++i) {
+        const auto& key = std::get<AtomKey>(std::get<0>(metadata[i]).first);
+        ASSERT_EQ(key.id(), symbols[i]);
+        ASSERT_EQ(key.version_id(), i % 2 == 0 ? 1u : 0u);
+        ASSERT_EQ(key.creation_ts(), update_times[i]);
+        ASSERT_EQ(std::get<DescriptorItem>(descriptors[i]).key_, key);
+    }
+}
+
 #define THREE_SIMPLE_KEYS \
     auto key1 = atom_key_builder().version_id(1).creation_ts(PilotedClock::nanos_since_epoch()).content_hash(3).start_index( \
         4).end_index(5).build(id, KeyType::TABLE_INDEX); \
@@ -750,6 +788,190 @@ TEST(VersionStore, UpdateWithinTypeAndSchemaChange) {
     }
 }
 
+TEST(VersionStore, UpdateColumns) {
+    using namespace arcticdb;
+    using namespace arcticdb::storage;
+    using namespace arcticdb::stream;
+    using namespace arcticdb::pipelines;
+
+    PilotedClock::reset();
+    StreamId symbol("update_columns");
+    arcticdb::proto::storage::VersionStoreConfig version_store_cfg;
+    version_store_cfg.mutable_write_options()->set_column_group_size(2);
+    version_store_cfg.mutable_write_options()->set_segment_row_size(20);
+    auto version_store = get_test_engine({version_store_cfg});
+    size_t num_rows{100};
+    size_t start_val{0};
+
+    std::vector<FieldRef> fields{
+        scalar_field(DataType::UINT8, "thing1"),
+        scalar_field(DataType::UINT8, "thing2"),
+        scalar_field(DataType::UINT16, "thing3"),
+        scalar_field(DataType::UINT16, "thing4")
+    };
+
+    auto test_frame = get_test_frame<stream::TimeseriesIndex>(symbol, fields, num_rows, start_val);
+    version_store.write_versioned_dataframe_internal(symbol, std::move(test_frame.frame_), false, false, false);
+
+    // The update must line up with whole row slices
+    std::vector<FieldRef> update_fields{scalar_field(DataType::UINT16, "thing3")};
+    auto misaligned_frame = get_test_frame<stream::TimeseriesIndex>(symbol, update_fields, 5, 25, 1);
+    ASSERT_THROW(version_store.update_columns_internal(symbol, std::move(misaligned_frame.frame_), false), NormalizationException);
+
+    RowRange update_range{20, 40};
+    size_t update_val{1};
+    auto update_frame = get_test_frame<stream::TimeseriesIndex>(symbol, update_fields, update_range.diff(), update_range.first, update_val);
+    update_frame.frame_.user_meta.set_version(3);
+    version_store.update_columns_internal(symbol, std::move(update_frame.frame_), false);
+
+    ReadQuery read_query;
+    auto read_result = version_store.read_dataframe_version_internal(symbol, VersionQuery{}, read_query, ReadOptions{});
+    const auto& seg = read_result.frame_and_descriptor_.frame_;
+    ASSERT_EQ(seg.row_count(), num_rows);
+    ASSERT_EQ(read_result.frame_and_descriptor_.desc_.proto().user_meta().version(), 3u);
+
+    for(auto i = 0u; i < num_rows; ++i) {
+        ASSERT_EQ(seg.scalar_at<uint8_t>(i, 1).value(), i);
+        ASSERT_EQ(seg.scalar_at<uint16_t>(i, 4).value(), i);
+        auto expected = update_range.contains(i) ? i + update_val : i;
+        ASSERT_EQ(seg.scalar_at<uint16_t>(i, 3).value(), expected);
+    }
+}
+
+TEST(VersionStore, RecompressSymbolData) {
+    using namespace arcticdb;
+    using namespace arcticdb::storage;
+    using namespace arcticdb::stream;
+    using namespace arcticdb::pipelines;
+
+    PilotedClock::reset();
+    StreamId symbol("recompress");
+    arcticdb::proto::storage::VersionStoreConfig version_store_cfg;
+    version_store_cfg.mutable_write_options()->set_column_group_size(2);
+    version_store_cfg.mutable_write_options()->set_segment_row_size(20);
+    auto version_store = get_test_engine({version_store_cfg});
+    size_t num_rows{100};
+
+    std::vector<FieldRef> fields{
+        scalar_field(DataType::UINT8, "thing1"),
+        scalar_field(DataType::UINT8, "thing2"),
+        scalar_field(DataType::UINT16, "thing3"),
+        scalar_field(DataType::UINT16, "thing4")
+    };
+
+    auto test_frame = get_test_frame<stream::TimeseriesIndex>(symbol, fields, num_rows, 0);
+    version_store.write_versioned_dataframe_internal(symbol, std::move(test_frame.frame_), false, false, false);
+    auto append_frame = get_test_frame<stream::TimeseriesIndex>(symbol, fields, 20, num_rows);
+    version_store.append_internal(symbol, std::move(append_frame.frame_), false, false, false);
+
+    arcticdb::proto::encoding::VariantCodec codec;
+    codec.mutable_zstd()->set_level(19);
+    ASSERT_THROW(version_store.recompress_symbol_data(symbol, codec, std::nullopt, std::nullopt, false), UserInputException);
+    ASSERT_THROW(version_store.recompress_symbol_data(symbol, codec, VersionId{2}, std::nullopt, false), UserInputException);
+
+    // The 10 segments written by version 0 are rewritten in a single version, the appended ones are left alone
+    auto [versioned_item, stats] = version_store.recompress_symbol_data(symbol, codec, VersionId{1}, std::nullopt, false);
+    ASSERT_EQ(stats.segments_rewritten_, 10u);
+    ASSERT_EQ(versioned_item.version(), 2u);
+    ASSERT_GT(stats.segments_sampled_, 0u);
+
+    // Repeating the operation finds nothing left to do
+    auto [repeated_item, repeated_stats] = version_store.recompress_symbol_data(symbol, codec, VersionId{1}, std::nullopt, false);
+    ASSERT_EQ(repeated_stats.segments_rewritten_, 0u);
+    ASSERT_EQ(repeated_item.version(), 2u);
+
+    ReadQuery read_query;
+    auto read_result = version_store.read_dataframe_version_internal(symbol, VersionQuery{}, read_query, ReadOptions{});
+    const auto& seg = read_result.frame_and_descriptor_.frame_;
+    ASSERT_EQ(seg.row_count(), num_rows + 20);
+    for(auto i = 0u; i < num_rows + 20; ++i) {
+        ASSERT_EQ(seg.scalar_at<uint8_t>(i, 1).value(), uint8_t(i));
+        ASSERT_EQ(seg.scalar_at<uint16_t>(i, 4).value(), i);
+    }
+}
+
+TEST(VersionStore, RecompressResumesFromJournal) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    ScopedConfig journal_interval("Recompress.JournalInterval", 3);
+    StreamId symbol("recompress_resume");
+    arcticdb::proto::storage::VersionStoreConfig version_store_cfg;
+    version_store_cfg.mutable_write_options()->set_segment_row_size(10);
+    auto version_store = get_test_engine({version_store_cfg});
+    constexpr size_t num_rows = 100;
+    std::vector<FieldRef> fields{scalar_field(DataType::UINT64, "value")};
+    auto test_frame = get_test_frame<stream::TimeseriesIndex>(symbol, fields, num_rows, 0);
+    version_store.write_versioned_dataframe_internal(symbol, std::move(test_frame.frame_), false, false, false);
+
+    arcticdb::proto::encoding::VariantCodec codec;
+    codec.mutable_zstd()->set_level(19);
+    auto store = version_store._test_get_store();
+
+    // As if the process died after rewriting every segment but before writing the new version
+    auto update_info = get_latest_undeleted_version_and_next_version_id(
+        store, version_store._test_get_version_map(), symbol, VersionQuery{}, ReadOptions{});
+    arcticdb::version_store::RecompressionStats interrupted_stats;
+    auto interrupted = arcticdb::version_store::recompress_symbol_data_impl(store, update_info, codec, VersionId{1}, std::nullopt, interrupted_stats);
+    ASSERT_TRUE(interrupted.has_value());
+    ASSERT_EQ(interrupted_stats.segments_rewritten_, 10u);
+    ASSERT_TRUE(store->key_exists_sync(RefKey{symbol, KeyType::RECOMPRESS_JOURNAL}));
+    const auto rewritten_keys = get_data_keys(store, interrupted->key_, storage::ReadKeyOpts{});
+
+    // The repeated run links the rewritten segments instead of rewriting them
+    auto [versioned_item, stats] = version_store.recompress_symbol_data(symbol, codec, VersionId{1}, std::nullopt, false);
+    ASSERT_EQ(stats.segments_rewritten_, 0u);
+    ASSERT_EQ(versioned_item.version(), 1u);
+    ASSERT_EQ(get_data_keys(store, versioned_item.key_, storage::ReadKeyOpts{}), rewritten_keys);
+    ASSERT_FALSE(store->key_exists_sync(RefKey{symbol, KeyType::RECOMPRESS_JOURNAL}));
+
+    ReadQuery read_query;
+    auto read_result = version_store.read_dataframe_version_internal(symbol, VersionQuery{}, read_query, ReadOptions{});
+    const auto& seg = read_result.frame_and_descriptor_.frame_;
+    ASSERT_EQ(seg.row_count(), num_rows);
+    for(auto i = 0u; i < num_rows; ++i)
+        ASSERT_EQ(seg.scalar_at<uint64_t>(i, 1).value(), i);
+}
+
+TEST(VersionStore, DeleteKeepsDataReusedThroughDeDupIndex) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    StreamId symbol("de_dup_delete");
+    arcticdb::proto::storage::VersionStoreConfig version_store_cfg;
+    version_store_cfg.mutable_write_options()->set_segment_row_size(20);
+    version_store_cfg.mutable_write_options()->set_de_duplication(true);
+    version_store_cfg.mutable_write_options()->set_de_dup_index(true);
+    auto version_store = get_test_engine<version_store::PythonVersionStore>({version_store_cfg});
+    constexpr size_t num_rows = 100;
+    std::vector<FieldRef> fields{scalar_field(DataType::UINT64, "value")};
+
+    // Version 2 has the same data as version 0 but not version 1, so it can only share data keys through the index
+    for(size_t start_val : {size_t{0}, num_rows, size_t{0}}) {
+        auto test_frame = get_test_frame<stream::TimeseriesIndex>(symbol, fields, num_rows, start_val);
+        version_store.write_versioned_dataframe_internal(symbol, std::move(test_frame.frame_), false, false, false);
+    }
+
+    auto store = version_store._test_get_store();
+    auto version_query = VersionQuery{};
+    version_query.set_version(2);
+    auto index_key = get_specific_version(store, version_store._test_get_version_map(), symbol, 2, version_query, ReadOptions{});
+    ASSERT_TRUE(index_key.has_value());
+    auto data_keys = get_data_keys(store, *index_key, storage::ReadKeyOpts{});
+    ASSERT_TRUE(std::all_of(data_keys.begin(), data_keys.end(), [] (const auto& key) { return key.version_id() == 0; }));
+
+    version_store.delete_version(symbol, 0);
+    for(const auto& data_key : data_keys)
+        ASSERT_TRUE(store->key_exists_sync(data_key));
+
+    ReadQuery read_query;
+    auto read_result = version_store.read_dataframe_version_internal(symbol, version_query, read_query, ReadOptions{});
+    const auto& seg = read_result.frame_and_descriptor_.frame_;
+    ASSERT_EQ(seg.row_count(), num_rows);
+    for(auto i = 0u; i < num_rows; ++i)
+        ASSERT_EQ(seg.scalar_at<uint64_t>(i, 1).value(), i);
+}
+
 TEST(VersionStore, TestWriteAppendMapHead) {
 
     using namespace arcticdb;
@@ -0,0 +1,144 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+/*
+ * Skip links for version chains.
+ *
+ * Each journal segment written by the version map is given a position in the chain, counting up from the oldest
+ * segment that has links. Alongside its usual pointer to the previous segment it keeps a link to the most recent
+ * earlier segment whose position is a multiple of 2^k, for each k. Following the furthest link that cannot jump over
+ * what is being looked for finds any version in O(log n) reads, in the same way as a deterministic skip list.
+ *
+ * Each link records the newest index version at or below its target, and a summary of the segments it jumps over.
+ * Lookups use these to check that nothing they skip could change their answer: an index that a timestamp lookup
+ * might return, or a tombstone of the version being looked for.
+ *
+ * The links are kept in segment metadata, which older readers ignore, and the head's links are repeated in the
+ * version ref so that writers can extend the chain without reading the head. Segments written without links, by
+ * older writers or by compaction, simply end the linked part of the chain. Compaction removes the segments below the
+ * one it rewrites, so it floors the head's links in the ref to that segment, and readers take the head's links from
+ * the ref.
+ */
+#pragma once
+
+#include <arcticdb/entity/atom_key.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace arcticdb {
+
+struct VersionChainSummary {
+    std::optional<timestamp> min_index_ts_;
+    std::optional<VersionId> min_tombstone_;
+    std::optional<VersionId> max_tombstone_;
+    std::optional<AtomKey> tombstone_all_;
+
+    void add_key(const AtomKey& key) {
+        if (is_index_key_type(key.type())) {
+            min_index_ts_ = std::min(min_index_ts_.value_or(key.creation_ts()), key.creation_ts());
+        } else if (key.type() == KeyType::TOMBSTONE) {
+            min_tombstone_ = std::min(min_tombstone_.value_or(key.version_id()), key.version_id());
+            max_tombstone_ = std::max(max_tombstone_.value_or(key.version_id()), key.version_id());
+        } else if (key.type() == KeyType::TOMBSTONE_ALL) {
+            if (!tombstone_all_ || tombstone_all_->version_id() < key.version_id())
+                tombstone_all_ = key;
+        }
+    }
+
+    void merge(const VersionChainSummary& other) {
+        if (other.min_index_ts_)
+            min_index_ts_ = std::min(min_index_ts_.value_or(*other.min_index_ts_), *other.min_index_ts_);
+
+        if (other.min_tombstone_) {
+            min_tombstone_ = std::min(min_tombstone_.value_or(*other.min_tombstone_), *other.min_tombstone_);
+            max_tombstone_ = std::max(max_tombstone_.value_or(*other.max_tombstone_), *other.max_tombstone_);
+        }
+
+        if (other.tombstone_all_ && (!tombstone_all_ || tombstone_all_->version_id() < other.tombstone_all_->version_id()))
+            tombstone_all_ = other.tombstone_all_;
+    }
+};
+
+struct VersionChainLink {
+    AtomKey version_key_;
+    uint64_t position_ = 0;
+    // The newest index version held by the target or any segment below it
+    std::optional<VersionId> index_version_;
+    // Everything held by the segments strictly between the linking segment and the target
+    VersionChainSummary skipped_;
+};
+
+struct VersionChainLinks {
+    uint64_t position_ = 0;
+    // The newest index version held by this segment or any segment below it
+    std::optional<VersionId> index_version_;
+    // The keys this segment adds to the chain, which later segments need when linking over it
+    VersionChainSummary contents_;
+    // Ordered nearest first
+    std::vector<VersionChainLink> links_;
+};
+
+/*
+ * The links for a journal segment holding key, written on top of head. If the head has no links, for instance because
+ * it was written by an older version, the new segment starts the linked part of the chain.
+ */
+inline VersionChainLinks next_chain_links(
+    const std::optional<VersionChainLinks>& head_links,
+    const std::optional<AtomKey>& head,
+    const AtomKey& key,
+    const std::optional<VersionId>& newest_index_version) {
+    VersionChainLinks output;
+    output.contents_.add_key(key);
+    output.index_version_ = is_index_key_type(key.type()) ? std::make_optional(key.version_id()) : newest_index_version;
+    if (!head || !head_links)
+        return output;
+
+    const auto& previous = *head_links;
+    output.position_ = previous.position_ + 1;
+    if (!is_index_key_type(key.type()))
+        output.index_version_ = previous.index_version_;
+
+    // The most recent segment at a multiple of 2^k is either the head, or whatever the head links to at that level
+    for (uint64_t step = 1; ; step <<= 1) {
+        const auto target = previous.position_ - previous.position_ % step;
+        if (output.links_.empty() || output.links_.back().position_ != target) {
+            if (target == previous.position_) {
+                output.links_.push_back(VersionChainLink{*head, target, previous.index_version_, VersionChainSummary{}});
+            } else {
+                auto link = std::find_if(std::begin(previous.links_), std::end(previous.links_), [target] (const auto& l) {
+                    return l.position_ == target;
+                });
+                if (link != std::end(previous.links_)) {
+                    output.links_.push_back(*link);
+                    output.links_.back().skipped_.merge(previous.contents_);
+                }
+            }
+        }
+        if (target == 0)
+            break;
+    }
+    return output;
+}
+
+/*
+ * The links for a segment written with a complete set of keys, such as by compaction, which starts a new linked chain.
+ */
+template<typename KeyContainer>
+VersionChainLinks chain_links_for_keys(const KeyContainer& keys) {
+    VersionChainLinks output;
+    for (const auto& key : keys) {
+        if (!output.index_version_ && is_index_key_type(key.type()))
+            output.index_version_ = key.version_id();
+
+        output.contents_.add_key(key);
+    }
+    return output;
+}
+
+} // namespace arcticdb
@@ -20,6 +20,7 @@
 #include <arcticdb/pipeline/read_options.hpp>
 #include <arcticdb/stream/stream_sink.hpp>
 #include <arcticdb/stream/stream_writer.hpp>
+#include <arcticdb/stream/index_aggregator.hpp>
 #include <arcticdb/entity/type_utils.hpp>
 #include <arcticdb/stream/schema.hpp>
 #include <arcticdb/pipeline/index_writer.hpp>
@@ -30,6 +31,12 @@
 #include <arcticdb/version/schema_checks.hpp>
 #include <arcticdb/version/version_utils.hpp>
 #include <arcticdb/entity/merge_descriptors.hpp>
+#include <arcticdb/stream/aggregator.hpp>
+#include <arcticdb/pipeline/frame_utils.hpp>
+#include <arcticdb/codec/codec.hpp>
+
+#include <algorithm>
+#include <chrono>
 
 namespace arcticdb::version_store {
 
@@ -103,6 +110,65 @@ folly::Future<entity::AtomKey> async_write_dataframe_impl(
     return write_frame(std::move(partial_key), std::move(frame), slicing_arg, store, de_dup_map, sparsify_floats);
 }
 
+VersionedItem write_frame_batches_impl(
+    const std::shared_ptr<Store>& store,
+    VersionId version_id,
+    const StreamId& stream_id,
+    folly::Function<std::optional<InputTensorFrame>()>& next_frame,
+    const WriteOptions& options,
+    const std::shared_ptr<DeDupMap>& de_dup_map,
+    bool validate_index) {
+    ARCTICDB_SAMPLE(WriteFrameBatches, 0)
+    if (0 == version_id)
+        verify_stream_id(stream_id);
+
+    const auto partial_key = IndexPartialKey{stream_id, version_id};
+    std::vector<SliceAndKey> slice_and_keys;
+    std::optional<InputTensorFrame> last_frame;
+    std::optional<timestamp> last_index;
+    auto sorted = SortedValue::ASCENDING;
+    size_t rows = 0;
+    size_t batches = 0;
+    while (auto frame = next_frame()) {
+        user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(frame->desc.id() == stream_id,
+            "Frame for {} written as {}", frame->desc.id(), stream_id);
+        if (last_frame) {
+            user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(frame->desc.fields() == last_frame->desc.fields(),
+                "Batch {} of {} does not match the columns of the first batch: {} != {}", batches, stream_id, frame->desc, last_frame->desc);
+        }
+
+        if (std::holds_alternative<stream::TimeseriesIndex>(frame->index) && frame->num_rows > 0) {
+            const auto first_index = *frame->index_tensor->ptr_cast<timestamp>(0);
+            auto frame_sorted = frame->desc.get_sorted();
+            if (last_index && first_index < *last_index)
+                frame_sorted = SortedValue::UNSORTED;
+
+            sorted = deduce_sorted(sorted, frame_sorted);
+            last_index = *frame->index_tensor->ptr_cast<timestamp>(frame->num_rows - 1);
+            sorting::check<ErrorCode::E_UNSORTED_DATA>(!validate_index || sorted == SortedValue::ASCENDING,
+                "When calling write with validate_index enabled, input data must be sorted, batch {} of {} is not", batches, stream_id);
+        }
+
+        // Slices take their row ranges from the offset, so that the batches follow on from each other
+        frame->set_offset(static_cast<ssize_t>(rows));
+        frame->set_bucketize_dynamic(options.bucketize_dynamic);
+        auto slicing_arg = get_slicing_policy(options, *frame);
+        auto keys = slice_and_write(*frame, slicing_arg, get_partial_key_gen(*frame, partial_key), store, de_dup_map).get();
+        slice_and_keys.insert(slice_and_keys.end(), std::make_move_iterator(keys.begin()), std::make_move_iterator(keys.end()));
+        rows += frame->num_rows;
+        ++batches;
+        last_frame = std::move(frame);
+    }
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(last_frame.has_value(), "No data to write for {}", stream_id);
+    ARCTICDB_DEBUG(log::version(), "Wrote {} rows of {} in {} batches as version {}", rows, stream_id, batches, version_id);
+
+    if (std::holds_alternative<stream::TimeseriesIndex>(last_frame->index))
+        last_frame->desc.set_sorted(sorted);
+
+    // The index descriptor counts the rows before the last frame from its offset
+    return VersionedItem(index::write_index(std::move(*last_frame), std::move(slice_and_keys), partial_key, store).get());
+}
+
 namespace {
 IndexDescriptor::Proto check_index_match(const arcticdb::stream::Index& index, const IndexDescriptor::Proto& desc) {
     if (std::holds_alternative<stream::TimeseriesIndex>(index))
@@ -224,6 +290,88 @@ inline std::pair<std::vector<SliceAndKey>, std::vector<SliceAndKey>> intersectin
     return std::make_pair(std::move(intersect_before), std::move(intersect_after));
 }
 
+// Rebuilds an existing column slice with the values of the updated columns taken from the frame, starting at
+// frame_row. The remaining columns, and the index, are kept as they are.
+SegmentInMemory rewrite_updated_columns(
+    SegmentInMemory&& existing,
+    const InputTensorFrame& frame,
+    const std::unordered_map<std::string, size_t>& update_columns,
+    size_t frame_row) {
+    const auto rows = existing.row_count();
+    const auto& existing_desc = existing.descriptor();
+    StreamDescriptor scratch_desc{existing_desc.id(), existing_desc.index()};
+    scratch_desc.add_field(existing_desc.fields(0));
+    std::vector<std::pair<position_t, size_t>> replaced_columns;
+    for (size_t col = existing_desc.index().field_count(); col < existing_desc.field_count(); ++col) {
+        const auto& field = existing_desc.fields(col);
+        if (auto it = update_columns.find(std::string{field.name()}); it != update_columns.end()) {
+            scratch_desc.add_field(field);
+            replaced_columns.emplace_back(position_t(col), it->second);
+        }
+    }
+
+    // Build the index and the updated columns for these rows in a scratch segment, as write_slices would
+    using SingleSegmentAggregator = stream::Aggregator<stream::TimeseriesIndex, stream::FixedSchema, stream::NeverSegmentPolicy>;
+    std::optional<SegmentInMemory> scratch;
+    SingleSegmentAggregator agg{stream::FixedSchema{scratch_desc, frame.index}, [&scratch](auto&& segment) {
+        scratch = std::forward<SegmentInMemory>(segment);
+    }};
+    auto opt_error = aggregator_set_data(frame.desc.fields(0).type(), frame.index_tensor.value(), agg, 0, rows, frame_row, false, frame.string_pool.get());
+    if (opt_error.has_value())
+        opt_error->raise(frame.desc.fields(0).name(), frame_row);
+
+    for (size_t i = 0; i < replaced_columns.size(); ++i) {
+        const auto frame_col = replaced_columns[i].second;
+        const auto& fd = frame.desc.fields(frame_col + frame.desc.index().field_count());
+        opt_error = aggregator_set_data(fd.type(), frame.field_tensors[frame_col], agg, i + 1, rows, frame_row, false, frame.string_pool.get());
+        if (opt_error.has_value())
+            opt_error->raise(fd.name(), frame_row);
+    }
+    agg.end_block_write(rows);
+    agg.commit();
+    util::check(scratch.has_value() && scratch->row_count() == rows, "Expected {} rows in rewritten column slice", rows);
+
+    for (size_t row = 0; row < rows; ++row) {
+        normalization::check<ErrorCode::E_UPDATE_NOT_SUPPORTED>(
+            existing.scalar_at<timestamp>(row, 0) == scratch->scalar_at<timestamp>(row, 0),
+            "Column update requires the update frame to have the same index values as the rows it replaces, mismatch at row {} of column slice {}",
+            row, frame_row);
+    }
+
+    // Strings are re-interned into a new pool holding only the strings still referenced, so that the replaced values
+    // do not stay behind in the rewritten segment
+    auto string_pool = std::make_shared<StringPool>();
+    auto reintern = [rows, &string_pool] (const Column& source, const StringPool& source_pool, TypeDescriptor type) {
+        auto column = std::make_shared<Column>(type, rows, false, false);
+        for (size_t row = 0; row < rows; ++row) {
+            auto offset = source.scalar_at<StringPool::offset_t>(row).value();
+            if (offset != not_a_string() && offset != nan_placeholder())
+                offset = string_pool->get(source_pool.get_const_view(offset)).offset();
+
+            column->push_back(offset);
+        }
+        return column;
+    };
+
+    auto replaced = replaced_columns.begin();
+    for (size_t col = existing_desc.index().field_count(); col < existing_desc.field_count(); ++col) {
+        const auto type = existing_desc.fields(col).type();
+        if (replaced != replaced_columns.end() && replaced->first == position_t(col)) {
+            const auto scratch_col = position_t(std::distance(replaced_columns.begin(), replaced) + 1);
+            if (is_sequence_type(type.data_type()))
+                existing.columns()[col] = reintern(scratch->column(scratch_col), scratch->const_string_pool(), type);
+            else
+                existing.columns()[col] = scratch->column_ptr(scratch_col);
+
+            ++replaced;
+        } else if (is_sequence_type(type.data_type())) {
+            existing.columns()[col] = reintern(existing.column(position_t(col)), existing.const_string_pool(), type);
+        }
+    }
+    existing.set_string_pool(string_pool);
+    return std::move(existing);
+}
+
 } // namespace
 
 VersionedItem delete_range_impl(
@@ -390,6 +538,104 @@ VersionedItem update_impl(
     return versioned_item;
 }
 
+VersionedItem update_columns_impl(
+    const std::shared_ptr<Store>& store,
+    const UpdateInfo& update_info,
+    InputTensorFrame&& frame,
+    const WriteOptions&& options) {
+    util::check(update_info.previous_index_key_.has_value(), "Cannot update columns as there is no previous index key to update into");
+    const StreamId stream_id = frame.desc.id();
+    ARCTICDB_DEBUG(log::version(), "Update columns of versioned dataframe for stream_id: {} , version_id = {}", stream_id, update_info.previous_index_key_->version_id());
+    auto index_segment_reader = index::get_index_reader(*(update_info.previous_index_key_), store);
+    util::check_rte(!index_segment_reader.is_pickled(), "Cannot update pickled data");
+    auto index_desc = check_index_match(frame.index, index_segment_reader.tsd().proto().stream_descriptor().index());
+    util::check(index_desc.kind() == IndexDescriptor::TIMESTAMP, "Update not supported for non-timeseries indexes");
+    sorted_data_check_update(frame, index_segment_reader);
+    normalization::check<ErrorCode::E_UPDATE_NOT_SUPPORTED>(!options.dynamic_schema && !index_segment_reader.bucketize_dynamic(),
+        "Column update is only supported with static schema");
+    (void)check_and_mark_slices(index_segment_reader, false, false, std::nullopt, false);
+
+    const auto existing_desc = index_segment_reader.tsd().as_stream_descriptor();
+    const auto index_field_count = frame.desc.index().field_count();
+    std::unordered_map<std::string, size_t> update_columns;
+    for (size_t col = index_field_count; col < frame.desc.field_count(); ++col) {
+        const auto& field = frame.desc.fields(col);
+        auto existing_pos = existing_desc.find_field(field.name());
+        schema::check<ErrorCode::E_COLUMN_DOESNT_EXIST>(existing_pos.has_value(),
+            "Cannot update column {} of {} as it does not exist", field.name(), stream_id);
+        schema::check<ErrorCode::E_DESCRIPTOR_MISMATCH>(existing_desc.fields(*existing_pos).type() == field.type(),
+            "Cannot update column {} of {} with type {}, existing type is {}",
+            field.name(), stream_id, field.type(), existing_desc.fields(*existing_pos).type());
+        update_columns.try_emplace(std::string{field.name()}, col - index_field_count);
+    }
+    normalization::check<ErrorCode::E_UPDATE_NOT_SUPPORTED>(!update_columns.empty() && frame.num_rows > 0,
+        "Column update requires at least one column and one row");
+
+    std::vector<FilterQuery<index::IndexSegmentReader>> queries =
+        build_update_query_filters<index::IndexSegmentReader>(std::monostate{}, frame.index, frame.index_range, false, false);
+    auto affected_keys = filter_index(index_segment_reader, combine_filter_functions(queries));
+    std::set<RowRange> affected_rows;
+    for (const auto& slice_and_key : affected_keys)
+        affected_rows.insert(slice_and_key.slice_.row_range);
+
+    // The update has to replace whole row slices so that the existing row boundaries can be kept
+    size_t affected_row_count = 0;
+    for (const auto& row_range : affected_rows) {
+        util::check(affected_row_count == 0 || row_range.first == affected_rows.begin()->first + affected_row_count,
+                    "Unexpected gap in affected row slices at {}", row_range);
+        affected_row_count += row_range.diff();
+    }
+    normalization::check<ErrorCode::E_UPDATE_NOT_SUPPORTED>(affected_row_count == frame.num_rows,
+        "Column update requires the update frame to cover whole row slices: it has {} rows but the rows it overlaps span {}",
+        frame.num_rows, affected_row_count);
+
+    const auto first_affected_row = affected_rows.empty() ? 0 : affected_rows.begin()->first;
+    std::vector<SliceAndKey> slice_and_keys;
+    std::vector<size_t> to_rewrite;
+    std::vector<folly::Future<stream::ReadKeyOutput>> reads;
+    for (const auto& slice_and_key : index_segment_reader) {
+        slice_and_keys.emplace_back(slice_and_key);
+        if (affected_rows.count(slice_and_key.slice_.row_range) == 0)
+            continue;
+
+        const auto& col_range = slice_and_key.slice_.col_range;
+        bool has_updated_column = false;
+        for (auto col = col_range.first; col < col_range.second && !has_updated_column; ++col)
+            has_updated_column = update_columns.count(std::string{existing_desc.fields(col).name()}) != 0;
+
+        // Column slices with none of the updated columns are relinked with their original keys
+        if (has_updated_column) {
+            to_rewrite.emplace_back(slice_and_keys.size() - 1);
+            reads.emplace_back(store->read(slice_and_key.key()));
+        }
+    }
+
+    ARCTICDB_DEBUG(log::version(), "Column update of {} rewriting {} of {} column slices", stream_id, to_rewrite.size(), affected_keys.size());
+    auto segments = folly::collect(reads).get();
+    std::vector<folly::Future<VariantKey>> writes;
+    writes.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const auto& slice_and_key = slice_and_keys[to_rewrite[i]];
+        const auto& key = slice_and_key.key();
+        auto segment = rewrite_updated_columns(std::move(segments[i].second), frame, update_columns, slice_and_key.slice_.row_range.first - first_affected_row);
+        writes.emplace_back(store->write(key.type(), update_info.next_version_id_, key.id(), key.start_index(), key.end_index(), std::move(segment)));
+    }
+
+    auto new_keys = folly::collect(writes).get();
+    for (size_t i = 0; i < new_keys.size(); ++i)
+        slice_and_keys[to_rewrite[i]].key_ = to_atom(std::move(new_keys[i]));
+
+    std::sort(std::begin(slice_and_keys), std::end(slice_and_keys));
+    const auto row_count = index_segment_reader.tsd().proto().total_rows();
+    auto time_series = timseries_descriptor_from_index_segment(row_count, std::move(index_segment_reader), std::nullopt, false);
+    // As with update, the new version carries the metadata passed with the frame
+    *time_series.mutable_proto().mutable_user_meta() = std::move(frame.user_meta);
+    auto version_key = index::write_index<TimeseriesIndex>(std::move(time_series), std::move(slice_and_keys), IndexPartialKey{stream_id, update_info.next_version_id_}, store).get();
+    auto versioned_item = VersionedItem(to_atom(std::move(version_key)));
+    ARCTICDB_DEBUG(log::version(), "updated columns of stream_id: {} , version_id: {}", stream_id, update_info.next_version_id_);
+    return versioned_item;
+}
+
 FrameAndDescriptor read_multi_key(
     const std::shared_ptr<Store>& store,
     const SegmentInMemory& index_key_seg) {
@@ -590,6 +836,130 @@ void add_index_columns_to_query(const ReadQuery& read_query, const TimeseriesDes
     }
 }
 
+namespace {
+
+template<typename Iterator>
+std::shared_ptr<PipelineContext> row_slice_context(
+        const PipelineContext& parent,
+        Iterator begin,
+        Iterator end,
+        bool dynamic_schema) {
+    auto context = std::make_shared<PipelineContext>();
+    context->desc_ = parent.desc_;
+    context->orig_desc_ = parent.orig_desc_;
+    context->stream_id_ = parent.stream_id_;
+    context->version_id_ = parent.version_id_;
+    context->norm_meta_ = parent.norm_meta_;
+    context->selected_columns_ = parent.selected_columns_;
+    context->filter_columns_ = parent.filter_columns_;
+    context->filter_columns_set_ = parent.filter_columns_set_;
+    context->overall_column_bitset_ = parent.overall_column_bitset_;
+    context->bucketize_dynamic_ = parent.bucketize_dynamic_;
+    context->slice_and_keys_.assign(begin, end);
+    mark_index_slices(context, dynamic_schema, context->bucketize_dynamic_);
+    return context;
+}
+
+// The rows of a frame within the query's row filter, which the Python read path otherwise trims after reading
+std::pair<size_t, size_t> rows_in_filter(const SegmentInMemory& frame, const FilterRange& row_filter) {
+    const auto rows = frame.row_count();
+    return util::variant_match(row_filter,
+        [&frame, rows] (const RowRange& row_range) {
+            const auto offset = static_cast<size_t>(frame.offset());
+            const auto first = std::clamp(row_range.first, offset, offset + rows) - offset;
+            const auto last = std::clamp(row_range.second, offset, offset + rows) - offset;
+            return std::make_pair(first, std::max(first, last));
+        },
+        [&frame, rows] (const IndexRange& index_range) {
+            if(rows == 0 || frame.descriptor().index().type() != IndexDescriptor::TIMESTAMP)
+                return std::make_pair(size_t{0}, rows);
+
+            const auto start = std::get<NumericIndex>(index_range.start_);
+            const auto end = std::get<NumericIndex>(index_range.end_);
+            auto index_at = [&frame] (size_t row) { return frame.scalar_at<timestamp>(row, 0).value(); };
+            size_t lo = 0, hi = rows;
+            while(lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+                if(index_at(mid) < start) lo = mid + 1; else hi = mid;
+            }
+            const auto first = lo;
+            hi = rows;
+            while(lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+                if(index_at(mid) <= end) lo = mid + 1; else hi = mid;
+            }
+            return std::make_pair(first, lo);
+        },
+        [rows] (const auto&) {
+            return std::make_pair(size_t{0}, rows);
+        });
+}
+
+} // namespace
+
+void read_row_slices_impl(
+    const std::shared_ptr<Store>& store,
+    const VersionedItem& version,
+    ReadQuery& read_query,
+    const ReadOptions& read_options,
+    size_t max_concurrent_slices,
+    folly::Function<void(SegmentInMemory&&)>& visitor) {
+    using namespace arcticdb::pipelines;
+    ARCTICDB_SAMPLE(ReadRowSlices, 0)
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(read_query.clauses_.empty(),
+        "Query clauses cannot be applied when reading row slices for export");
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(max_concurrent_slices > 0,
+        "Must read at least one row slice at a time");
+
+    auto pipeline_context = std::make_shared<PipelineContext>();
+    pipeline_context->stream_id_ = version.key_.id();
+    read_indexed_keys_to_pipeline(store, pipeline_context, version, read_query, read_options);
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(!pipeline_context->multi_key_ && !pipeline_context->is_pickled(),
+        "Symbol {} does not hold a dataframe, so cannot be exported", pipeline_context->stream_id_);
+
+    modify_descriptor(pipeline_context, read_options);
+    generate_filtered_field_descriptors(pipeline_context, read_query.columns);
+
+    auto export_options = read_options;
+    export_options.set_arrow_output(true);
+    const auto dynamic_schema = opt_false(read_options.dynamic_schema_);
+    const auto& slice_and_keys = pipeline_context->slice_and_keys_;
+    std::vector<std::shared_ptr<PipelineContext>> slice_contexts;
+    for(auto group_start = slice_and_keys.begin(); group_start != slice_and_keys.end();) {
+        const auto row_range = group_start->slice_.row_range;
+        auto group_end = std::find_if(group_start, slice_and_keys.end(), [&row_range] (const SliceAndKey& slice_and_key) {
+            return slice_and_key.slice_.row_range != row_range;
+        });
+        slice_contexts.emplace_back(row_slice_context(*pipeline_context, group_start, group_end, dynamic_schema));
+        group_start = group_end;
+    }
+
+    for(size_t batch_start = 0; batch_start < slice_contexts.size(); batch_start += max_concurrent_slices) {
+        const auto batch_end = std::min(batch_start + max_concurrent_slices, slice_contexts.size());
+        auto buffers = std::make_shared<BufferHolder>();
+        std::vector<SegmentInMemory> frames;
+        std::vector<folly::Future<std::vector<VariantKey>>> fetches;
+        for(auto i = batch_start; i < batch_end; ++i) {
+            frames.emplace_back(allocate_frame(slice_contexts[i]));
+            fetches.emplace_back(fetch_data(frames.back(), slice_contexts[i], store, dynamic_schema, buffers));
+        }
+        folly::collect(fetches).get();
+
+        for(auto i = batch_start; i < batch_end; ++i) {
+            auto& frame = frames[i - batch_start];
+            reduce_and_fix_columns(slice_contexts[i], frame, export_options);
+            const auto [first, last] = rows_in_filter(frame, read_query.row_filter);
+            if(first == last)
+                continue;
+
+            if(first == 0 && last == frame.row_count())
+                visitor(std::move(frame));
+            else
+                visitor(frame.truncate(first, last));
+        }
+    }
+}
+
 FrameAndDescriptor read_index_impl(
     const std::shared_ptr<Store>& store,
     const VersionedItem& version) {
@@ -1302,4 +1672,211 @@ VersionedItem defragment_symbol_data_impl(
     return vit;
 }
 
+void RecompressionStats::add(const RecompressionStats& other) {
+    segments_rewritten_ += other.segments_rewritten_;
+    bytes_before_ += other.bytes_before_;
+    bytes_after_ += other.bytes_after_;
+    segments_sampled_ += other.segments_sampled_;
+    decode_nanos_before_ += other.decode_nanos_before_;
+    decode_nanos_after_ += other.decode_nanos_after_;
+}
+
+namespace {
+
+struct RecompressedSegment {
+    storage::KeySegmentPair key_segment_;
+    RecompressionStats stats_;
+};
+
+uint64_t nanos_since(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+RecompressedSegment recompress_segment(
+        storage::KeySegmentPair&& original,
+        VersionId version_id,
+        const arcticdb::proto::encoding::VariantCodec& codec,
+        bool sample_decode) {
+    RecompressionStats stats;
+    const auto original_key = original.atom_key();
+    auto segment = original.release_segment();
+    stats.bytes_before_ = segment.total_segment_size();
+    const auto encoding_version = EncodingVersion(segment.header().encoding_version());
+
+    auto start = std::chrono::steady_clock::now();
+    auto decoded = decode_segment(std::move(segment));
+    const auto decode_nanos_before = nanos_since(start);
+    auto encoded = encode_dispatch(std::move(decoded), codec, encoding_version);
+    stats.bytes_after_ = encoded.total_segment_size();
+    stats.segments_rewritten_ = 1;
+    if(sample_decode) {
+        start = std::chrono::steady_clock::now();
+        (void)decode_segment_copy(encoded);
+        stats.decode_nanos_after_ = nanos_since(start);
+        stats.decode_nanos_before_ = decode_nanos_before;
+        stats.segments_sampled_ = 1;
+    }
+
+    const stream::StreamSink::PartialKey partial_key{
+        original_key.type(), version_id, original_key.id(), original_key.start_index(), original_key.end_index()};
+    auto new_key = partial_key.build_key(util::SysClock::nanos_since_epoch(), hash_segment_header(encoded.header()));
+    return {storage::KeySegmentPair{std::move(new_key), std::move(encoded)}, stats};
+}
+
+// Each journal row holds a rewritten key, the key it replaces differs from it only in these columns
+constexpr position_t OriginalVersionIdColumn = position_t(pipelines::index::Fields::key_type) + 1;
+constexpr position_t OriginalCreationTsColumn = OriginalVersionIdColumn + 1;
+constexpr position_t OriginalContentHashColumn = OriginalCreationTsColumn + 1;
+
+StreamDescriptor recompression_journal_stream_desc(const StreamId& stream_id) {
+    auto desc = stream::idx_stream_desc(stream_id, stream::RowCountIndex{});
+    desc.add_scalar_field(DataType::UINT64, "original_version_id");
+    desc.add_scalar_field(DataType::INT64, "original_creation_ts");
+    desc.add_scalar_field(DataType::UINT64, "original_content_hash");
+    return desc;
+}
+
+void write_recompression_journal(
+        const std::shared_ptr<Store>& store,
+        const StreamId& stream_id,
+        const std::unordered_map<AtomKey, AtomKey>& rewritten) {
+    SegmentInMemory segment{recompression_journal_stream_desc(stream_id)};
+    for (const auto& [original_key, new_key] : rewritten) {
+        segment.set_scalar(OriginalVersionIdColumn, original_key.version_id());
+        segment.set_scalar(OriginalCreationTsColumn, original_key.creation_ts());
+        segment.set_scalar(OriginalContentHashColumn, original_key.content_hash());
+        stream::write_key_to_segment(segment, new_key);
+    }
+    store->write_sync(KeyType::RECOMPRESS_JOURNAL, stream_id, std::move(segment));
+}
+
+// Maps the original keys to their rewritten keys, leaving out any rewritten key that is no longer in storage
+std::unordered_map<AtomKey, AtomKey> read_recompression_journal(const std::shared_ptr<Store>& store, const StreamId& stream_id) {
+    std::unordered_map<AtomKey, AtomKey> output;
+    SegmentInMemory seg;
+    try {
+        seg = store->read_sync(RefKey{stream_id, KeyType::RECOMPRESS_JOURNAL}).second;
+    } catch (const storage::KeyNotFoundException&) {
+        return output;
+    }
+
+    std::vector<AtomKey> original_keys;
+    std::vector<VariantKey> new_keys;
+    for (ssize_t row = 0; row < ssize_t(seg.row_count()); ++row) {
+        auto new_key = stream::read_key_row(seg, row);
+        original_keys.emplace_back(atom_key_builder()
+            .version_id(seg.scalar_at<uint64_t>(row, OriginalVersionIdColumn).value())
+            .creation_ts(seg.scalar_at<int64_t>(row, OriginalCreationTsColumn).value())
+            .content_hash(seg.scalar_at<uint64_t>(row, OriginalContentHashColumn).value())
+            .start_index(new_key.start_index())
+            .end_index(new_key.end_index())
+            .build(new_key.id(), new_key.type()));
+        new_keys.emplace_back(std::move(new_key));
+    }
+
+    auto exists = folly::collect(store->batch_key_exists(new_keys)).get();
+    for (size_t i = 0; i < new_keys.size(); ++i) {
+        if (exists[i])
+            output.try_emplace(std::move(original_keys[i]), to_atom(std::move(new_keys[i])));
+    }
+    return output;
+}
+
+} // namespace
+
+void remove_recompression_journal(const std::shared_ptr<Store>& store, const StreamId& stream_id) {
+    storage::RemoveOpts opts;
+    opts.ignores_missing_key_ = true;
+    store->remove_key_sync(RefKey{stream_id, KeyType::RECOMPRESS_JOURNAL}, opts);
+}
+
+std::optional<VersionedItem> recompress_symbol_data_impl(
+        const std::shared_ptr<Store>& store,
+        const UpdateInfo& update_info,
+        const arcticdb::proto::encoding::VariantCodec& codec,
+        std::optional<VersionId> before_version,
+        std::optional<timestamp> before_ts,
+        RecompressionStats& stats) {
+    util::check(update_info.previous_index_key_.has_value(), "No latest undeleted version found for recompression");
+    const auto& previous_key = *update_info.previous_index_key_;
+    auto index_segment_reader = index::get_index_reader(previous_key, store);
+
+    std::vector<SliceAndKey> slice_and_keys;
+    std::unordered_map<AtomKey, std::vector<size_t>> to_rewrite;
+    std::vector<AtomKey> keys;
+    for (const auto& slice_and_key : index_segment_reader) {
+        slice_and_keys.emplace_back(slice_and_key);
+        const auto& key = slice_and_key.key();
+        const bool is_old = (!before_version || key.version_id() < *before_version) && (!before_ts || key.creation_ts() < *before_ts);
+        if (!is_old)
+            continue;
+
+        auto [it, inserted] = to_rewrite.try_emplace(key);
+        if (inserted)
+            keys.emplace_back(key);
+
+        it->second.emplace_back(slice_and_keys.size() - 1);
+    }
+
+    if (keys.empty())
+        return std::nullopt;
+
+    // Segments already rewritten by an interrupted run are linked rather than rewritten
+    auto rewritten = read_recompression_journal(store, previous_key.id());
+    std::vector<std::pair<AtomKey, size_t>> ordered_keys;
+    ordered_keys.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (auto it = rewritten.find(keys[i]); it != rewritten.end()) {
+            for (auto pos : to_rewrite[keys[i]])
+                slice_and_keys[pos].key_ = it->second;
+        } else {
+            ordered_keys.emplace_back(keys[i], i);
+        }
+    }
+
+    ARCTICDB_DEBUG(log::version(), "Recompressing {} segments of {} into version {}, {} already rewritten",
+                   ordered_keys.size(), previous_key.id(), update_info.next_version_id_, keys.size() - ordered_keys.size());
+    const auto sample_rate = std::max<int64_t>(1, ConfigsMap::instance()->get_int("Recompress.DecodeSampleRate", 20));
+    const auto concurrency = static_cast<size_t>(ConfigsMap::instance()->get_int("Recompress.Concurrency", 2 * async::TaskScheduler::instance()->cpu_thread_count()));
+    const auto journal_interval = static_cast<size_t>(std::max<int64_t>(1, ConfigsMap::instance()->get_int("Recompress.JournalInterval", 100)));
+    auto codec_ptr = std::make_shared<const arcticdb::proto::encoding::VariantCodec>(codec);
+
+    // The journal is rewritten after every journal_interval segments, which bounds the work an interruption loses
+    for (size_t chunk_start = 0; chunk_start < ordered_keys.size(); chunk_start += journal_interval) {
+        const auto chunk_end = std::min(chunk_start + journal_interval, ordered_keys.size());
+        std::vector<std::pair<AtomKey, size_t>> chunk(ordered_keys.begin() + chunk_start, ordered_keys.begin() + chunk_end);
+        // Bounds the number of segments held in memory at once
+        auto futs = folly::window(std::move(chunk), [&store, codec_ptr, sample_rate, version_id = update_info.next_version_id_] (auto&& key_pos) {
+            const bool sample_decode = key_pos.second % static_cast<size_t>(sample_rate) == 0;
+            return store->read_compressed(key_pos.first)
+                .via(&async::cpu_executor())
+                .thenValue([codec_ptr, version_id, sample_decode] (storage::KeySegmentPair&& key_segment) {
+                    return recompress_segment(std::move(key_segment), version_id, *codec_ptr, sample_decode);
+                })
+                .thenValue([store, old_key = key_pos.first] (RecompressedSegment&& recompressed) {
+                    auto new_key = recompressed.key_segment_.atom_key();
+                    return store->write_compressed(std::move(recompressed.key_segment_))
+                        .thenValue([old_key, new_key = std::move(new_key), segment_stats = recompressed.stats_] (auto&&) {
+                            return std::make_tuple(old_key, new_key, segment_stats);
+                        });
+                });
+        }, std::max<size_t>(1, concurrency));
+
+        for (auto&& [old_key, new_key, segment_stats] : folly::collect(futs).get()) {
+            for (auto pos : to_rewrite[old_key])
+                slice_and_keys[pos].key_ = new_key;
+
+            rewritten.insert_or_assign(old_key, new_key);
+            stats.add(segment_stats);
+        }
+        write_recompression_journal(store, previous_key.id(), rewritten);
+    }
+
+    const auto row_count = index_segment_reader.tsd().proto().total_rows();
+    auto index = stream::index_type_from_descriptor(index_segment_reader.tsd().as_stream_descriptor());
+    auto time_series = timseries_descriptor_from_index_segment(row_count, std::move(index_segment_reader), std::nullopt, false);
+    auto version_key = index::write_index(index, std::move(time_series), std::move(slice_and_keys), IndexPartialKey{previous_key.id(), update_info.next_version_id_}, store).get();
+    return VersionedItem(to_atom(std::move(version_key)));
+}
+
 } //namespace arcticdb::version_store
@@ -22,6 +22,8 @@
 #include <arcticdb/entity/frame_and_descriptor.hpp>
 #include <arcticdb/version/version_store_objects.hpp>
 
+#include <folly/Function.h>
+
 #include <string>
 
 namespace arcticdb::version_store {
@@ -49,6 +51,23 @@ folly::Future<entity::AtomKey> async_write_dataframe_impl(
     bool validate_index
 );
 
+/**
+ * Writes a dataframe that arrives as a sequence of frames, such as the record batches of a file, as a single version.
+ * Each frame is sliced and written before the next is requested, so only one is held in memory at a time, and its
+ * buffers need only stay valid until next_frame is called again. Every frame must have the same columns as the
+ * first, and the metadata of the last one is kept. With validate_index, a timeseries index must be sorted within
+ * and across frames.
+ */
+VersionedItem write_frame_batches_impl(
+    const std::shared_ptr<Store>& store,
+    VersionId version_id,
+    const StreamId& stream_id,
+    folly::Function<std::optional<InputTensorFrame>()>& next_frame,
+    const WriteOptions& options,
+    const std::shared_ptr<DeDupMap>& de_dup_map,
+    bool validate_index
+);
+
 folly::Future<AtomKey> async_append_impl(
     const std::shared_ptr<Store>& store,
     const UpdateInfo& update_info,
@@ -71,6 +90,17 @@ VersionedItem update_impl(
     const WriteOptions&& options,
     bool dynamic_schema);
 
+/**
+ * Replaces the values of the columns in the frame, leaving all other columns as they are. Only the column slices
+ * holding updated columns are rewritten, the rest are relinked into the new version with their existing keys. The
+ * frame must have the same index values as the whole row slices it overlaps, as the row boundaries are kept.
+ */
+VersionedItem update_columns_impl(
+    const std::shared_ptr<Store>& store,
+    const UpdateInfo& update_info,
+    InputTensorFrame&& frame,
+    const WriteOptions&& options);
+
 VersionedItem delete_range_impl(
     const std::shared_ptr<Store>& store,
     const AtomKey& prev,
@@ -114,6 +144,20 @@ FrameAndDescriptor read_index_impl(
     const std::shared_ptr<Store>& store,
     const VersionedItem& version);
 
+/*
+ * Reads a version one row slice at a time, for export through the Arrow C data interface. Up to max_concurrent_slices
+ * slices are fetched and decoded in parallel, then passed to the visitor in row order with their strings left in the
+ * frame's string pool. Column selection is pushed down to the fetch, and the first and last frames are trimmed to the
+ * query's date or row range.
+ */
+void read_row_slices_impl(
+    const std::shared_ptr<Store>& store,
+    const VersionedItem& version,
+    ReadQuery& read_query,
+    const ReadOptions& read_options,
+    size_t max_concurrent_slices,
+    folly::Function<void(SegmentInMemory&&)>& visitor);
+
 VersionedItem compact_incomplete_impl(
     const std::shared_ptr<Store>& store,
     const StreamId& stream_id,
@@ -147,7 +191,38 @@ VersionedItem defragment_symbol_data_impl(
         const UpdateInfo& update_info,
         const WriteOptions& options,
         size_t segment_size);
-        
+
+struct RecompressionStats {
+    size_t segments_rewritten_ = 0;
+    uint64_t bytes_before_ = 0;
+    uint64_t bytes_after_ = 0;
+    // Decode times of a sample of the rewritten segments, in their original and in their new encoding
+    size_t segments_sampled_ = 0;
+    uint64_t decode_nanos_before_ = 0;
+    uint64_t decode_nanos_after_ = 0;
+
+    void add(const RecompressionStats& other);
+};
+
+/**
+ * Re-encodes with codec the data segments of the latest version that were written before before_version and
+ * before_ts, and indexes them in a single new version along with the untouched segments. Row and column boundaries
+ * are kept. Returns nullopt when there is nothing to rewrite.
+ *
+ * Every Recompress.JournalInterval segments, the rewritten keys are recorded in the symbol's RECOMPRESS_JOURNAL, so
+ * that a run which is interrupted and repeated links the segments it already rewrote. The journal is removed with
+ * remove_recompression_journal once the new version has been written.
+ */
+std::optional<VersionedItem> recompress_symbol_data_impl(
+        const std::shared_ptr<Store>& store,
+        const UpdateInfo& update_info,
+        const arcticdb::proto::encoding::VariantCodec& codec,
+        std::optional<VersionId> before_version,
+        std::optional<timestamp> before_ts,
+        RecompressionStats& stats);
+
+void remove_recompression_journal(const std::shared_ptr<Store>& store, const StreamId& stream_id);
+
 VersionedItem sort_merge_impl(
     const std::shared_ptr<Store>& store,
     const StreamId& stream_id,
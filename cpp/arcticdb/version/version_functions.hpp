@@ -86,6 +86,7 @@ inline std::optional<AtomKey> get_specific_version(
         const ReadOptions& read_option,
         bool include_deleted = false) {
     LoadParameter load_param{LoadType::LOAD_DOWNTO, signed_version_id};
+    load_param.follow_skip_links_ = true;
     auto entry = version_map->check_reload(store, stream_id, load_param, __FUNCTION__);
     set_load_param_options(load_param, version_query, read_option);
     VersionId version_id;
@@ -251,6 +252,7 @@ inline std::optional<AtomKey> load_index_key_from_time(
     const ReadOptions& read_options) {
     LoadParameter load_param{LoadType::LOAD_FROM_TIME, from_time};
     set_load_param_options(load_param, version_query, read_options);
+    load_param.follow_skip_links_ = true;
     auto entry = version_map->check_reload(store, stream_id, load_param, __FUNCTION__);
     auto indexes = entry->get_indexes(false);
     return get_index_key_from_time(from_time, indexes);
@@ -292,7 +294,7 @@ inline std::set<StreamId> list_streams(
                             },
                             prefix.value());
     } else {
-        store->iterate_type(KeyType::VERSION_REF, [&store, &res, &version_map, all_symbols](auto &&vk) {
+        store->iterate_type_parallel(KeyType::VERSION_REF, [&store, &res, &version_map, all_symbols](auto &&vk) {
             const auto key = std::forward<VariantKey>(vk);
             util::check(!variant_key_id_empty(key), "Unexpected empty id in key {}", key);
             if(all_symbols)
@@ -81,6 +81,11 @@ class VersionMapImpl {
      * We also have methods to compact this linked list on storage if it becomes too large on disk, which would lead
      * us to do multiple reads from storage if not compacted.
      *
+     * SKIP LINKS
+     * Each version key also carries links further down the chain in its segment metadata (see version_chain_links.hpp),
+     * so that a lookup of a single old version or timestamp can find it in O(log n) reads instead of walking the
+     * whole chain. Entries loaded that way have gaps, so are marked sparse_ and are not reused from the cache.
+     *
      * FALLBACK TO ITERATION
      * We also have an alternative method to fetch all version keys which is to fall back to iterating the storage
      * to basically just fetch all relevant key types, which is useful in case we have consistency issues in
@@ -146,6 +151,7 @@ public:
         const LoadParameter& load_params) const {
         auto next_key = ref_entry.head_;
         entry->head_ = ref_entry.head_;
+        entry->head_links_ = ref_entry.head_links_;
 
         std::optional<VersionId> latest_version;
         LoadProgress load_progress;
@@ -153,8 +159,17 @@ public:
         if (key_exists_in_ref_entry(load_params, ref_entry, std::nullopt, load_progress)) {
             entry->keys_.push_back(ref_entry.keys_[0]);
         } else {
+            static const auto use_skip_links = ConfigsMap::instance()->get_int("VersionMap.UseSkipLinks", 1) == 1;
+            const bool follow_links = use_skip_links && load_params.follow_skip_links_;
+            std::optional<VersionChainLinks> links;
+            bool at_head = true;
             do {
-                auto [key, seg] = store->read_sync(next_key.value());
+                auto seg = follow_links && links ?
+                    read_via_skip_link(store, *links, next_key.value(), load_params, latest_version, entry) :
+                    store->read_sync(next_key.value()).second;
+                // The ref holds the head's links as compaction last left them, the head segment as first written
+                links = at_head ? ref_entry.head_links_ : read_chain_links(seg);
+                at_head = false;
                 next_key = read_segment_with_keys(seg, entry, load_progress);
                 set_latest_version(entry, latest_version);
             } while (next_key
@@ -166,6 +181,43 @@ public:
         set_loaded_until(load_progress, entry);
     }
 
+    /*
+     * Reads the journal segment after one with the given links, jumping as far down the chain as the lookup allows.
+     * Falls back to the segment's own next key if no link can be followed.
+     */
+    SegmentInMemory read_via_skip_link(
+        const std::shared_ptr<Store>& store,
+        const VersionChainLinks& links,
+        const AtomKey& next_key,
+        const LoadParameter& load_params,
+        const std::optional<VersionId>& latest_version,
+        const std::shared_ptr<VersionMapEntry>& entry) const {
+        for (auto link = links.links_.rbegin(); link != links.links_.rend(); ++link) {
+            if (link->version_key_ == next_key)
+                break;
+
+            if (!can_follow_link(*link, load_params, latest_version))
+                continue;
+
+            try {
+                auto [key, seg] = store->read_sync(link->version_key_);
+                util::check(!entry->keys_.empty() && entry->keys_.back() == next_key,
+                            "Expected next version key {} at the end of the entry", next_key);
+                entry->keys_.back() = link->version_key_;
+                if (link->skipped_.tombstone_all_)
+                    entry->try_set_tombstone_all(*link->skipped_.tombstone_all_);
+
+                entry->sparse_ = true;
+                return std::move(seg);
+            } catch (const storage::KeyNotFoundException&) {
+                // Compaction floors the links in the ref, but a concurrent compaction can still remove a target
+                // between reading the ref and following the link
+                ARCTICDB_DEBUG(log::version(), "Skip link to {} is stale, trying a nearer one", link->version_key_);
+            }
+        }
+        return store->read_sync(next_key).second;
+    }
+
     void load_via_ref_key(
         std::shared_ptr<Store> store,
         const StreamId& stream_id,
@@ -392,6 +444,7 @@ public:
                      [](const auto& k){return is_index_or_tombstone(k);});
 
         update_version_key(store, *parent, index_keys_compacted, stream_id);
+        floor_head_links(store, new_entry);
         store->remove_keys(version_keys_compacted).get();
 
         new_entry->keys_.erase(std::remove_if(parent + 1,
@@ -403,6 +456,32 @@ public:
         return new_entry;
     }
 
+    /*
+     * Compaction folds every journal segment below the parent into it and removes them, so the head may only keep
+     * its link to the parent itself. The floored links are written to the ref, which is where readers take the head's
+     * links from and writers extend the chain from, unless a writer has moved the head on in the meantime. In that
+     * case the new head was written with the old links, and lookups fall back to nearer links when they find a
+     * target missing.
+     */
+    void floor_head_links(const std::shared_ptr<Store>& store, const std::shared_ptr<VersionMapEntry>& entry) const {
+        if (!entry->head_links_)
+            return;
+
+        auto& links = entry->head_links_->links_;
+        const auto parent_position = entry->head_links_->position_ > 0 ? entry->head_links_->position_ - 1 : 0;
+        links.erase(std::remove_if(std::begin(links), std::end(links), [parent_position] (const auto& link) {
+            return link.position_ < parent_position;
+        }), std::end(links));
+
+        VersionMapEntry ref_entry;
+        read_symbol_ref(store, entry->head_->id(), ref_entry);
+        if (ref_entry.head_ != entry->head_ || ref_entry.keys_.empty()) {
+            ARCTICDB_DEBUG(log::version(), "Head of {} moved during compaction, leaving its skip links", entry->head_->id());
+            return;
+        }
+        write_symbol_ref(store, ref_entry.keys_[0], std::nullopt, *entry->head_, entry->head_links_);
+    }
+
     /** To be run as a stand-alone job only because it calls flush(). */
     void compact_if_necessary_stand_alone(const std::shared_ptr<Store>& store, size_t batch_size) {
         auto map = get_num_version_entries(store, batch_size);
@@ -490,9 +569,16 @@ public:
         if (validate_)
             entry->validate();
 
-        auto journal_key = to_atom(std::move(journal_single_key(store, key, entry->head_)));
+        std::optional<VersionId> newest_index_version;
+        if (!entry->head_links_) {
+            if (auto newest_index = entry->get_first_index(true); newest_index)
+                newest_index_version = newest_index->version_id();
+        }
+        auto links = next_chain_links(entry->head_links_, entry->head_, key, newest_index_version);
+        auto journal_key = to_atom(std::move(journal_single_key(store, key, entry->head_, links)));
         write_to_entry(entry, key, journal_key);
-        write_symbol_ref(store, key, std::nullopt, journal_key);
+        write_symbol_ref(store, key, std::nullopt, journal_key, links);
+        entry->head_links_ = std::move(links);
     }
 
     AtomKey write_tombstone(
@@ -635,6 +721,7 @@ private:
             const std::shared_ptr<VersionMapEntry> &entry) {
         AtomKey journal_key;
         entry->validate_types();
+        auto links = chain_links_for_keys(entry->keys_);
 
         IndexAggregator<RowCountIndex> version_agg(stream_id, [&store, &journal_key, &version_id, &stream_id](auto &&segment) {
             stream::StreamSink::PartialKey pk{
@@ -651,8 +738,10 @@ private:
             version_agg.add_key(key);
         }
 
+        version_agg.set_metadata(encode_chain_links(links));
         version_agg.commit();
-        write_symbol_ref(store, *entry->keys_.cbegin(), std::nullopt, journal_key);
+        write_symbol_ref(store, *entry->keys_.cbegin(), std::nullopt, journal_key, links);
+        entry->head_links_ = std::move(links);
         return journal_key;
     }
 
@@ -682,7 +771,7 @@ private:
             auto temp = std::make_shared<VersionMapEntry>(*entry);
             load_via_ref_key(store, stream_id, load_param, temp);
             std::swap(*entry, *temp);
-            entry->load_type_ = load_param.load_type_;
+            entry->load_type_ = entry->sparse_ ? LoadType::NOT_LOADED : load_param.load_type_;
         }
         catch (const std::runtime_error &err) {
             if (iterate_on_failure) {
@@ -708,7 +797,8 @@ private:
     VariantKey journal_single_key(
         std::shared_ptr<StreamSink> store,
         const AtomKey &key,
-        std::optional<AtomKey> prev_journal_key) {
+        std::optional<AtomKey> prev_journal_key,
+        const VersionChainLinks& links) {
         ARCTICDB_SAMPLE(WriteJournalEntry, 0)
         ARCTICDB_DEBUG(log::version(), "Version map writing version for key {}", key);
 
@@ -728,6 +818,7 @@ private:
         if (prev_journal_key)
             journal_agg.add_key(prev_journal_key.value());
 
+        journal_agg.set_metadata(encode_chain_links(links));
         journal_agg.commit();
         return journal_key;
     }
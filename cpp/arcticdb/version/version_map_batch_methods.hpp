@@ -71,6 +71,7 @@ inline std::shared_ptr<std::unordered_map<StreamId, AtomKey>> batch_get_specific
     async::submit_tasks_for_range(sym_versions,
                                   [store, version_map](auto& sym_version) {
         LoadParameter load_param{LoadType::LOAD_DOWNTO, static_cast<SignedVersionId>(sym_version.second)};
+        load_param.follow_skip_links_ = true;
         return async::submit_io_task(CheckReloadTask{store, version_map, sym_version.first, load_param});
         },
         [output](auto& sym_version, auto&& entry) {
@@ -257,7 +258,10 @@ inline std::vector<folly::Future<std::optional<AtomKey>>> batch_get_versions_asy
             it->second.load_param_.use_previous_ = true;
 
         if(it->second.count_ == 1) {
-            version_entry_fut = async::submit_io_task(CheckReloadTask{store, version_map, *symbol, it->second.load_param_});
+            // Only one key is wanted for the symbol, so the version chain can be searched rather than walked
+            auto load_param = it->second.load_param_;
+            load_param.follow_skip_links_ = true;
+            version_entry_fut = async::submit_io_task(CheckReloadTask{store, version_map, *symbol, load_param});
         } else {
             auto fut = shared_futures.find(*symbol);
             if(fut == shared_futures.end()) {
@@ -277,6 +281,28 @@ inline std::vector<folly::Future<std::optional<AtomKey>>> batch_get_versions_asy
     return output;
 }
 
+/*
+ * Shares one read between the entries of a batch that resolve to the same key, such as a symbol requested more than
+ * once. Keys are only known once the version map has been loaded, so reads are added from future continuations.
+ */
+template<typename ResultType>
+class SharedKeyReads {
+public:
+    template<typename ReadFunction>
+    folly::Future<ResultType> read(const AtomKey& key, ReadFunction&& read_function) {
+        std::lock_guard lock{mutex_};
+        auto it = reads_.find(key);
+        if(it == reads_.end())
+            it = reads_.emplace(key, folly::FutureSplitter<ResultType>{read_function(key)}).first;
+
+        return it->second.getFuture();
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<AtomKey, folly::FutureSplitter<ResultType>> reads_;
+};
+
 inline std::vector<folly::Future<folly::Unit>> batch_write_version(
     const std::shared_ptr<Store> &store,
     const std::shared_ptr<VersionMap> &version_map,
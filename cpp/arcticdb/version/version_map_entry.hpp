@@ -12,6 +12,7 @@
 #pragma once
 
 #include <arcticdb/entity/atom_key.hpp>
+#include <arcticdb/version/version_chain_links.hpp>
 
 #include <deque>
 #include <vector>
@@ -65,6 +66,9 @@ struct LoadParameter {
     bool use_previous_ = false;
     bool skip_compat_ = true;
     bool iterate_on_failure_ = false;
+    // Set by lookups of a single version or timestamp, which only need the matching keys rather than every key down
+    // to them, so can follow the chain's skip links
+    bool follow_skip_links_ = false;
 
     void validate() const {
         util::check((load_type_ == LoadType::LOAD_DOWNTO) == load_until_.has_value(),
@@ -158,6 +162,8 @@ struct VersionMapEntry {
         tombstones_.clear();
         tombstone_all_.reset();
         keys_.clear();
+        head_links_.reset();
+        sparse_ = false;
     }
 
     bool empty() const {
@@ -175,6 +181,8 @@ struct VersionMapEntry {
         swap(left.tombstone_all_, right.tombstone_all_);
         swap(left.head_, right.head_);
         swap(left.load_type_, right.load_type_);
+        swap(left.head_links_, right.head_links_);
+        swap(left.sparse_, right.sparse_);
     }
 
     // Below four functions used to return optional<AtomKey> of the tombstone, but copying keys is expensive and only
@@ -337,6 +345,10 @@ struct VersionMapEntry {
     std::deque<AtomKey> keys_;
     std::unordered_map<VersionId, AtomKey> tombstones_;
     std::optional<AtomKey> tombstone_all_;
+    // The skip links of the journal segment in head_, if it has any
+    std::optional<VersionChainLinks> head_links_;
+    // Set when loading followed skip links, so keys_ has gaps and the entry can only answer the query it was loaded for
+    bool sparse_ = false;
 };
 
 inline bool is_live_index_type_key(const AtomKeyImpl& key, const std::shared_ptr<VersionMapEntry>& entry) {
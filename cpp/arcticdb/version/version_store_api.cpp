@@ -28,6 +28,7 @@
 #include <arcticdb/version/version_utils.hpp>
 #include <arcticdb/pipeline/pipeline_utils.hpp>
 #include <arcticdb/pipeline/frame_utils.hpp>
+#include <arcticdb/pipeline/arrow_input.hpp>
 
 #include <regex>
 
@@ -327,7 +328,6 @@ void PythonVersionStore::add_to_snapshot(
         throw NoDataFoundException(snap_name);
     }
     auto [snap_key, snap_segment] = opt_snapshot.value();
-    auto [snapshot_contents, user_meta] = get_versions_and_metadata_from_snapshot(store(), snap_key);
     auto [specific_versions_index_map, latest_versions_index_map] = get_stream_index_map(stream_ids, version_queries);
     for(const auto& latest_version : *latest_versions_index_map) {
         specific_versions_index_map->try_emplace(std::make_pair(latest_version.first, latest_version.second.version_id()), latest_version.second);
@@ -337,36 +337,30 @@ void PythonVersionStore::add_to_snapshot(
             utils::copy_of_values_as<VariantKey>(*specific_versions_index_map), store(), false);
     util::check(missing.empty(), "Cannot snapshot version(s) that have been deleted: {}", missing);
 
-    std::vector<AtomKey> deleted_keys;
-    std::vector<AtomKey> retained_keys;
+    std::vector<AtomKey> added_keys;
     std::unordered_set<StreamId> affected_keys;
     for(const auto& [id_version, key] : *specific_versions_index_map) {
         auto [it, inserted] = affected_keys.insert(id_version.first);
         util::check(inserted, "Multiple elements in add_to_snapshot with key {}", id_version.first);
+        added_keys.emplace_back(key);
     }
 
-    for(auto&& key : snapshot_contents) {
-        auto new_version = affected_keys.find(key.id());
-        if(new_version == std::end(affected_keys)) {
-            retained_keys.emplace_back(std::move(key));
-        } else {
-            deleted_keys.emplace_back(std::move(key));
-        }
-    }
-
-    for(auto&& [id, key] : *specific_versions_index_map)
-        retained_keys.emplace_back(std::move(key));
-
-    std::sort(std::begin(retained_keys), std::end(retained_keys));
-    if(variant_key_type(snap_key) == KeyType::SNAPSHOT_REF && cfg().write_options().delayed_deletes()) {
-        tombstone_snapshot(store(), to_ref(snap_key), std::move(snap_segment), version_map()->log_changes());
-    } else {
-        delete_trees_responsibly(deleted_keys, get_master_snapshots_map(store()), snap_name).get();
-        if (version_map()->log_changes()) {
-            log_delete_snapshot(store(), snap_name);
-        }
-    }
-    write_snapshot_entry(store(), retained_keys, snap_name, user_meta, version_map()->log_changes());
+    const bool tombstone_previous = variant_key_type(snap_key) == KeyType::SNAPSHOT_REF && cfg().write_options().delayed_deletes();
+    auto amendment = amend_snapshot_entry(
+        store(),
+        snap_key,
+        std::move(snap_segment),
+        std::move(added_keys),
+        std::vector<StreamId>(affected_keys.begin(), affected_keys.end()),
+        [&affected_keys](const AtomKey& key) { return affected_keys.count(key.id()) != 0; },
+        tombstone_previous,
+        version_map()->log_changes());
+
+    // The removed keys are left to the tombstone under delayed deletes, but no tombstone refers to the replaced shards
+    if(tombstone_previous)
+        remove_manifest_shards(store(), snap_name, amendment.replaced_shards_);
+    else
+        delete_replaced_snapshot_contents(snap_name, amendment);
 }
 
 void PythonVersionStore::remove_from_snapshot(
@@ -381,7 +375,6 @@ void PythonVersionStore::remove_from_snapshot(
         throw NoDataFoundException(snap_name);
     }
     auto [snap_key, snap_segment] = opt_snapshot.value();
-    auto [snapshot_contents, user_meta] = get_versions_and_metadata_from_snapshot(store(), snap_key);
 
     using SymbolVersion = std::pair<StreamId, VersionId>;
     std::unordered_set<SymbolVersion> symbol_versions;
@@ -389,25 +382,29 @@ void PythonVersionStore::remove_from_snapshot(
         symbol_versions.emplace(stream_ids[i], version_ids[i]);
     }
 
-    std::vector<AtomKey> deleted_keys;
-    std::vector<AtomKey> retained_keys;
-    for(auto&& key : snapshot_contents) {
-        if(symbol_versions.find(SymbolVersion{key.id(), key.version_id()}) == symbol_versions.end()) {
-            retained_keys.emplace_back(std::move(key));
-        } else {
-            deleted_keys.emplace_back(std::move(key));
-        }
-    }
+    const bool tombstone_previous = variant_key_type(snap_key) == KeyType::SNAPSHOT_REF && cfg().write_options().delayed_deletes();
+    auto amendment = amend_snapshot_entry(
+        store(),
+        snap_key,
+        std::move(snap_segment),
+        {},
+        stream_ids,
+        [&symbol_versions](const AtomKey& key) {
+            return symbol_versions.find(SymbolVersion{key.id(), key.version_id()}) != symbol_versions.end();
+        },
+        tombstone_previous,
+        version_map()->log_changes());
+
+    // The removed keys are left to the tombstone under delayed deletes, but no tombstone refers to the replaced shards
+    if(tombstone_previous)
+        remove_manifest_shards(store(), snap_name, amendment.replaced_shards_);
+    else
+        delete_replaced_snapshot_contents(snap_name, amendment);
+}
 
-    if(variant_key_type(snap_key) == KeyType::SNAPSHOT_REF && cfg().write_options().delayed_deletes()) {
-        tombstone_snapshot(store(), to_ref(snap_key), std::move(snap_segment), version_map()->log_changes());
-    } else {
-        delete_trees_responsibly(deleted_keys, get_master_snapshots_map(store()), snap_name).get();
-        if (version_map()->log_changes()) {
-            log_delete_snapshot(store(), snap_name);
-        }
-    }
-    write_snapshot_entry(store(), retained_keys, snap_name, user_meta, version_map()->log_changes());
+void PythonVersionStore::delete_replaced_snapshot_contents(const SnapshotId& snap_name, const SnapshotAmendment& amendment) {
+    delete_trees_responsibly(amendment.removed_keys_, get_master_snapshots_map(store()), snap_name).get();
+    remove_manifest_shards(store(), snap_name, amendment.replaced_shards_);
 }
 
 void PythonVersionStore::snapshot(
@@ -577,6 +574,66 @@ VersionedItem PythonVersionStore::write_versioned_dataframe(
     return versioned_item;
 }
 
+VersionedItem PythonVersionStore::write_arrow(
+    const StreamId& stream_id,
+    uintptr_t array_address,
+    uintptr_t schema_address,
+    const std::optional<std::string>& index_column,
+    const py::object& norm,
+    const py::object& user_meta,
+    bool prune_previous_versions) {
+    ARCTICDB_SAMPLE(WriteArrow, 0)
+    auto input = arrow_to_frame(
+        stream_id,
+        reinterpret_cast<ArrowArray*>(array_address),
+        reinterpret_cast<ArrowSchema*>(schema_address),
+        index_column);
+    python_util::pb_from_python(norm, input.frame_.norm_meta);
+    if(!user_meta.is_none())
+        python_util::pb_from_python(user_meta, input.frame_.user_meta);
+
+    // The frame's tensors point into the imported Arrow buffers, which input keeps alive until the write completes
+    auto versioned_item = write_versioned_dataframe_internal(stream_id, std::move(input.frame_), prune_previous_versions, false, index_column.has_value());
+
+    if(cfg().symbol_list())
+        symbol_list().add_symbol(store(), stream_id);
+
+    return versioned_item;
+}
+
+VersionedItem PythonVersionStore::write_arrow_batches(
+    const StreamId& stream_id,
+    const py::function& next_batch,
+    const std::optional<std::string>& index_column,
+    const py::object& norm,
+    const py::object& user_meta,
+    bool prune_previous_versions) {
+    ARCTICDB_SAMPLE(WriteArrowBatches, 0)
+    // Each batch's buffers are released when the next one is requested, by which time its slices have been written
+    std::shared_ptr<ArrowInputData> current;
+    folly::Function<std::optional<InputTensorFrame>()> next_frame = [&]() -> std::optional<InputTensorFrame> {
+        current.reset();
+        ArrowArray array{};
+        ArrowSchema schema{};
+        if(!next_batch(reinterpret_cast<uintptr_t>(&array), reinterpret_cast<uintptr_t>(&schema)).cast<bool>())
+            return std::nullopt;
+
+        auto input = arrow_to_frame(stream_id, &array, &schema, index_column);
+        python_util::pb_from_python(norm, input.frame_.norm_meta);
+        if(!user_meta.is_none())
+            python_util::pb_from_python(user_meta, input.frame_.user_meta);
+
+        current = std::move(input.data_);
+        return std::move(input.frame_);
+    };
+    auto versioned_item = write_versioned_frame_batches_internal(stream_id, next_frame, prune_previous_versions, index_column.has_value());
+
+    if(cfg().symbol_list())
+        symbol_list().add_symbol(store(), stream_id);
+
+    return versioned_item;
+}
+
 VersionedItem PythonVersionStore::append(
     const StreamId& stream_id,
     const py::tuple &item,
@@ -603,6 +660,17 @@ VersionedItem PythonVersionStore::update(
                            dynamic_schema, prune_previous_versions);
 }
 
+VersionedItem PythonVersionStore::update_columns(
+        const StreamId &stream_id,
+        const py::tuple &item,
+        const py::object &norm,
+        const py::object &user_meta,
+        bool prune_previous_versions) {
+    return update_columns_internal(stream_id,
+                                   convert::py_ndf_to_frame(stream_id, item, norm, user_meta),
+                                   prune_previous_versions);
+}
+
 VersionedItem PythonVersionStore::delete_range(
     const StreamId& stream_id,
     const UpdateQuery& query,
@@ -808,14 +876,17 @@ void PythonVersionStore::delete_snapshot(const SnapshotId& snap_name) {
         ARCTICDB_DEBUG(log::version(), "Delaying deletion of Snapshot {}", snap_name);
         tombstone_snapshot(store(), to_ref(snap_key), std::move(snap_segment), version_map()->log_changes());
     } else {
-        delete_snapshot_sync(snap_name, snap_key);
+        delete_snapshot_sync(snap_name, snap_key, get_manifest_shards(snap_segment));
         if (version_map()->log_changes()) {
             log_delete_snapshot(store(), snap_name);
         }
     }
 }
 
-void PythonVersionStore::delete_snapshot_sync(const SnapshotId& snap_name, const VariantKey& snap_key) {
+void PythonVersionStore::delete_snapshot_sync(
+    const SnapshotId& snap_name,
+    const VariantKey& snap_key,
+    const std::vector<AtomKey>& manifest_shards) {
     ARCTICDB_DEBUG(log::version(), "Deleting data of Snapshot {}", snap_name);
 
     std::vector<AtomKey> index_keys_in_current_snapshot;
@@ -825,6 +896,7 @@ void PythonVersionStore::delete_snapshot_sync(const SnapshotId& snap_name, const
 
     ARCTICDB_DEBUG(log::version(), "Deleting Snapshot {}", snap_name);
     store()->remove_key(snap_key).get();
+    remove_manifest_shards(store(), snap_name, manifest_shards);
 
     try {
         delete_trees_responsibly(
@@ -851,9 +923,9 @@ std::vector<SnapshotVariantKey> ARCTICDB_UNUSED iterate_snapshot_tombstones (
             std::vector<IndexTypeKey> indexes{};
             auto snap_seg = store->read_sync(snap_tomb_key).second;
             auto before = candidates.size();
+            auto snap_keys = read_snapshot_index_keys(store, snap_seg);
 
-            for (size_t idx = 0; idx < snap_seg.row_count(); idx++) {
-                auto key = read_key_row(snap_seg, static_cast<ssize_t>(idx));
+            for (auto& key : snap_keys) {
                 if (candidates.count(key) == 0) { // Snapshots often hold the same keys, so worthwhile optimisation
                     indexes.emplace_back(std::move(key));
                 }
@@ -866,7 +938,7 @@ std::vector<SnapshotVariantKey> ARCTICDB_UNUSED iterate_snapshot_tombstones (
             }
 
             log::version().info("Processed {} keys from snapshot {}. {} are unique.",
-                                snap_seg.row_count(), variant_key_id(snap_tomb_key), candidates.size() - before);
+                                snap_keys.size(), variant_key_id(snap_tomb_key), candidates.size() - before);
             snap_tomb_keys.emplace_back(std::move(snap_tomb_key));
         });
     }
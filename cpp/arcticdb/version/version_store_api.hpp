@@ -72,6 +72,26 @@ class PythonVersionStore : public LocalVersionedEngine {
         bool allow_sparse,
         bool validate_index);
 
+    // Writes an Arrow struct array, such as an exported record batch, taking ownership of the structs at the given addresses
+    VersionedItem write_arrow(
+        const StreamId& stream_id,
+        uintptr_t array_address,
+        uintptr_t schema_address,
+        const std::optional<std::string>& index_column,
+        const py::object& norm,
+        const py::object& user_meta,
+        bool prune_previous_versions);
+
+    // Writes a sequence of Arrow struct arrays as one version. next_batch(array_address, schema_address) exports the
+    // next batch into the structs at the given addresses and returns false once there are no more
+    VersionedItem write_arrow_batches(
+        const StreamId& stream_id,
+        const py::function& next_batch,
+        const std::optional<std::string>& index_column,
+        const py::object& norm,
+        const py::object& user_meta,
+        bool prune_previous_versions);
+
     VersionedItem write_versioned_composite_data(
         const StreamId& stream_id,
         const py::object &metastruct,
@@ -111,6 +131,13 @@ class PythonVersionStore : public LocalVersionedEngine {
         bool dynamic_schema,
         bool prune_previous_versions);
 
+    VersionedItem update_columns(
+        const StreamId& stream_id,
+        const py::tuple &item,
+        const py::object &norm,
+        const py::object & user_meta,
+        bool prune_previous_versions);
+
     VersionedItem delete_range(
         const StreamId& stream_id,
         const UpdateQuery& query,
@@ -343,7 +370,12 @@ private:
         const std::vector<UpdateInfo>& stream_update_info_vector,
         bool prune_previous_versions);
 
-    void delete_snapshot_sync(const SnapshotId& snap_name, const VariantKey& snap_key);
+    void delete_snapshot_sync(
+        const SnapshotId& snap_name,
+        const VariantKey& snap_key,
+        const std::vector<AtomKey>& manifest_shards);
+
+    void delete_replaced_snapshot_contents(const SnapshotId& snap_name, const SnapshotAmendment& amendment);
 };
 
 struct ManualClockVersionStore : PythonVersionStore {
@@ -170,4 +170,26 @@ struct WriteAndPrunePreviousTask : async::BaseTask {
 };
 
 
+// Counts the objects of one key type and their stored sizes per stream, without reading the objects where the
+// storage can size them from its listings
+struct ScanObjectSizesTask : async::BaseTask {
+    const std::shared_ptr<Store> store_;
+    const KeyType key_type_;
+
+    ScanObjectSizesTask(std::shared_ptr<Store> store, KeyType key_type) :
+        store_(std::move(store)),
+        key_type_(key_type) {
+    }
+
+    std::unordered_map<StreamId, std::pair<size_t, size_t>> operator()() const {
+        std::unordered_map<StreamId, std::pair<size_t, size_t>> sizes;
+        store_->iterate_type_with_size(key_type_, [&sizes](VariantKey&& key, size_t size) {
+            auto& [count, bytes] = sizes[variant_key_id(key)];
+            ++count;
+            bytes += size;
+        });
+        return sizes;
+    }
+};
+
 } //namespace arcticdb
@@ -9,6 +9,7 @@
 
 #include <arcticdb/entity/key.hpp>
 #include <arcticdb/entity/types.hpp>
+#include <arcticdb/entity/protobuf_mappings.hpp>
 #include <arcticdb/storage/store.hpp>
 #include <arcticdb/stream/stream_sink.hpp>
 #include <arcticdb/stream/index_aggregator.hpp>
@@ -71,6 +72,80 @@ struct LoadProgress {
     timestamp earliest_loaded_timestamp_ = std::numeric_limits<timestamp>::max();
 };
 
+inline void summary_to_proto(const VersionChainSummary& summary, arcticdb::proto::descriptors::VersionChainSummary& output) {
+    if (summary.min_index_ts_) {
+        output.set_has_index(true);
+        output.set_min_index_ts(*summary.min_index_ts_);
+    }
+    if (summary.min_tombstone_) {
+        output.set_has_tombstone(true);
+        output.set_min_tombstone(*summary.min_tombstone_);
+        output.set_max_tombstone(*summary.max_tombstone_);
+    }
+    if (summary.tombstone_all_)
+        *output.mutable_tombstone_all() = encode_key(*summary.tombstone_all_);
+}
+
+inline VersionChainSummary summary_from_proto(const arcticdb::proto::descriptors::VersionChainSummary& input) {
+    VersionChainSummary output;
+    if (input.has_index())
+        output.min_index_ts_ = input.min_index_ts();
+    if (input.has_tombstone()) {
+        output.min_tombstone_ = input.min_tombstone();
+        output.max_tombstone_ = input.max_tombstone();
+    }
+    if (input.has_tombstone_all())
+        output.tombstone_all_ = decode_key(input.tombstone_all());
+    return output;
+}
+
+inline google::protobuf::Any encode_chain_links(const VersionChainLinks& links) {
+    arcticdb::proto::descriptors::VersionChainLinks output;
+    output.set_position(links.position_);
+    if (links.index_version_) {
+        output.set_has_index(true);
+        output.set_index_version(*links.index_version_);
+    }
+    summary_to_proto(links.contents_, *output.mutable_contents());
+    for (const auto& link : links.links_) {
+        auto* link_proto = output.add_links();
+        *link_proto->mutable_version_key() = encode_key(link.version_key_);
+        link_proto->set_position(link.position_);
+        if (link.index_version_) {
+            link_proto->set_has_index(true);
+            link_proto->set_index_version(*link.index_version_);
+        }
+        summary_to_proto(link.skipped_, *link_proto->mutable_skipped());
+    }
+    google::protobuf::Any any;
+    any.PackFrom(output);
+    return any;
+}
+
+inline std::optional<VersionChainLinks> read_chain_links(const SegmentInMemory& seg) {
+    const auto* metadata = seg.metadata();
+    if (!metadata || !metadata->Is<arcticdb::proto::descriptors::VersionChainLinks>())
+        return std::nullopt;
+
+    arcticdb::proto::descriptors::VersionChainLinks input;
+    metadata->UnpackTo(&input);
+    VersionChainLinks output;
+    output.position_ = input.position();
+    if (input.has_index())
+        output.index_version_ = input.index_version();
+    output.contents_ = summary_from_proto(input.contents());
+    output.links_.reserve(input.links_size());
+    for (const auto& link_proto : input.links()) {
+        auto& link = output.links_.emplace_back();
+        link.version_key_ = decode_key(link_proto.version_key());
+        link.position_ = link_proto.position();
+        if (link_proto.has_index())
+            link.index_version_ = link_proto.index_version();
+        link.skipped_ = summary_from_proto(link_proto.skipped());
+    }
+    return output;
+}
+
 inline std::optional<AtomKey> read_segment_with_keys(
     const SegmentInMemory &seg,
     VersionMapEntry &entry,
@@ -230,12 +305,14 @@ inline void read_symbol_ref(const std::shared_ptr<StreamSource>& store, const St
 
     LoadProgress load_progress;
     entry.head_ = read_segment_with_keys(seg, entry, load_progress);
+    entry.head_links_ = read_chain_links(seg);
 }
 
 inline void write_symbol_ref(std::shared_ptr<StreamSink> store,
                              const AtomKey &latest_index,
                              const std::optional<AtomKey>&,
-                             const AtomKey &journal_key) {
+                             const AtomKey &journal_key,
+                             const std::optional<VersionChainLinks>& head_links = std::nullopt) {
     check_is_index_or_tombstone(latest_index);
     check_is_version(journal_key);
 
@@ -249,6 +326,8 @@ inline void write_symbol_ref(std::shared_ptr<StreamSink> store,
     ref_agg.add_key(latest_index);
 
     ref_agg.add_key(journal_key);
+    if (head_links)
+        ref_agg.set_metadata(encode_chain_links(*head_links));
     ref_agg.commit();
     ARCTICDB_DEBUG(log::version(), "Done writing symbol ref for key: {}", journal_key);
 }
@@ -355,6 +434,39 @@ inline bool key_exists_in_ref_entry(const LoadParameter& load_params, const Vers
     return false;
 }
 
+/*
+ * Whether a lookup of a single version or timestamp can follow a skip link, because nothing in the journal segments
+ * it jumps over could change the result. Tombstone-all keys in those segments are carried by the link, so only
+ * individual tombstones need checking.
+ */
+inline bool can_follow_link(
+    const VersionChainLink& link,
+    const LoadParameter& load_params,
+    const std::optional<VersionId>& latest_version) {
+    const auto& skipped = link.skipped_;
+    if (load_params.load_type_ == LoadType::LOAD_DOWNTO) {
+        std::optional<VersionId> version_id;
+        if (is_positive_version_query(load_params))
+            version_id = static_cast<VersionId>(load_params.load_until_.value());
+        else if (latest_version)
+            version_id = get_version_id_negative_index(latest_version.value(), load_params.load_until_.value());
+
+        if (!version_id || !link.index_version_ || *link.index_version_ < *version_id)
+            return false;
+
+        return !skipped.min_tombstone_ || *version_id < *skipped.min_tombstone_ || *version_id > *skipped.max_tombstone_;
+    }
+
+    if (load_params.load_type_ == LoadType::LOAD_FROM_TIME) {
+        // Skipped indexes are newer than any version at or below the target, so only matter if they could match
+        if (skipped.min_index_ts_ && *skipped.min_index_ts_ <= load_params.load_from_time_.value())
+            return false;
+
+        return !skipped.min_tombstone_ || !link.index_version_ || *skipped.min_tombstone_ > *link.index_version_;
+    }
+    return false;
+}
+
 inline void set_loaded_until(const LoadProgress& load_progress, const std::shared_ptr<VersionMapEntry>& entry) {
     entry->loaded_until_ = load_progress.loaded_until_;
 }
@@ -0,0 +1,165 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/version/zstd_dictionaries.hpp>
+#include <arcticdb/codec/zstd_dictionary.hpp>
+#include <arcticdb/storage/storage.hpp>
+#include <arcticdb/stream/index.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+namespace arcticdb {
+
+using namespace arcticdb::stream;
+
+namespace {
+
+// Dictionaries are keyed by their decimal id, so this cannot collide with any of them
+const StreamId ActiveZstdDictionariesId{StringId{"__active__"}};
+
+StreamId zstd_dictionary_stream_id(uint64_t dictionary_id) {
+    return StreamId{std::to_string(dictionary_id)};
+}
+
+void add_samples(const ChunkedBuffer& buffer, std::vector<std::string_view>& samples) {
+    for(const auto* block : buffer.blocks()) {
+        if(block->bytes() > 0)
+            samples.emplace_back(reinterpret_cast<const char*>(block->data()), block->bytes());
+    }
+}
+
+} // namespace
+
+std::optional<std::string> read_zstd_dictionary(const std::shared_ptr<Store>& store, uint64_t dictionary_id) {
+    SegmentInMemory seg;
+    try {
+        seg = store->read_sync(RefKey{zstd_dictionary_stream_id(dictionary_id), KeyType::ZSTD_DICTIONARY}).second;
+    } catch (const storage::KeyNotFoundException&) {
+        return std::nullopt;
+    }
+    util::check(seg.row_count() == 1, "Expected a single row in zstd dictionary {}, got {}", dictionary_id, seg.row_count());
+    return std::string{seg.string_at(0, 0).value()};
+}
+
+uint64_t write_zstd_dictionary(const std::shared_ptr<Store>& store, std::string dictionary) {
+    auto cached = ZstdDictionaries::instance()->add(std::move(dictionary));
+    const auto stream_id = zstd_dictionary_stream_id(cached->id());
+    SegmentInMemory segment{stream_descriptor(stream_id, RowCountIndex{}, {
+        scalar_field(DataType::ASCII_DYNAMIC64, "dictionary")
+    })};
+    segment.set_string(0, cached->data());
+    segment.end_row();
+    store->write_sync(KeyType::ZSTD_DICTIONARY, stream_id, std::move(segment));
+    return cached->id();
+}
+
+ActiveZstdDictionaries read_active_zstd_dictionaries(const std::shared_ptr<Store>& store) {
+    ActiveZstdDictionaries output;
+    SegmentInMemory seg;
+    try {
+        seg = store->read_sync(RefKey{ActiveZstdDictionariesId, KeyType::ZSTD_DICTIONARY}).second;
+    } catch (const storage::KeyNotFoundException&) {
+        return output;
+    }
+
+    for(ssize_t row = 0; row < ssize_t(seg.row_count()); ++row)
+        output.try_emplace(KeyType(seg.scalar_at<uint8_t>(row, 0).value()), seg.scalar_at<uint64_t>(row, 1).value());
+
+    return output;
+}
+
+void write_active_zstd_dictionaries(const std::shared_ptr<Store>& store, const ActiveZstdDictionaries& active) {
+    SegmentInMemory segment{stream_descriptor(ActiveZstdDictionariesId, RowCountIndex{}, {
+        scalar_field(DataType::UINT8, "key_type"),
+        scalar_field(DataType::UINT64, "dictionary_id")
+    })};
+    for(const auto& [key_type, dictionary_id] : active) {
+        segment.set_scalar(0, static_cast<uint8_t>(key_type));
+        segment.set_scalar(1, dictionary_id);
+        segment.end_row();
+    }
+    store->write_sync(KeyType::ZSTD_DICTIONARY, ActiveZstdDictionariesId, std::move(segment));
+}
+
+arcticdb::proto::encoding::VariantCodec zstd_dictionary_codec(uint64_t dictionary_id) {
+    static const auto level = ConfigsMap::instance()->get_int("ZstdDictionary.Level", 3);
+    arcticdb::proto::encoding::VariantCodec codec;
+    auto zstd = codec.mutable_zstd();
+    zstd->set_level(static_cast<int32_t>(level));
+    zstd->set_dictionary_id(dictionary_id);
+    return codec;
+}
+
+void apply_active_zstd_dictionaries(const std::shared_ptr<Store>& store) {
+    for(const auto& [key_type, dictionary_id] : read_active_zstd_dictionaries(store)) {
+        // The dictionaries themselves must stay readable without a dictionary
+        if(key_type == KeyType::ZSTD_DICTIONARY)
+            continue;
+
+        ZstdDictionaries::instance()->get(dictionary_id);
+        store->set_key_type_codec(key_type, zstd_dictionary_codec(dictionary_id));
+        ARCTICDB_DEBUG(log::version(), "Compressing {} keys with zstd dictionary {}", key_type, dictionary_id);
+    }
+}
+
+std::optional<uint64_t> train_key_type_zstd_dictionary(
+    const std::shared_ptr<Store>& store,
+    KeyType key_type,
+    size_t max_samples,
+    size_t max_dictionary_size) {
+    user_input::check<ErrorCode::E_INVALID_USER_ARGUMENT>(key_type != KeyType::ZSTD_DICTIONARY,
+        "Cannot train a zstd dictionary for the dictionary keys themselves");
+
+    std::vector<VariantKey> keys;
+    store->iterate_type(key_type, [&keys, max_samples] (VariantKey&& key) {
+        if(keys.size() < max_samples)
+            keys.emplace_back(std::move(key));
+    });
+
+    std::vector<folly::Future<std::optional<SegmentInMemory>>> reads;
+    reads.reserve(keys.size());
+    for(const auto& key : keys) {
+        reads.emplace_back(store->read(key)
+            .thenValue([] (auto&& key_segment) {
+                return std::make_optional(std::move(key_segment.second));
+            })
+            .thenError(folly::tag_t<storage::KeyNotFoundException>{}, [] (auto&&) {
+                // Removed since it was listed
+                return std::optional<SegmentInMemory>{};
+            }));
+    }
+
+    std::vector<SegmentInMemory> segments;
+    segments.reserve(keys.size());
+    for(auto& segment : folly::collect(reads).get()) {
+        if(segment)
+            segments.emplace_back(std::move(*segment));
+    }
+
+    // Blocks are compressed individually, so each column and string pool block is a separate sample
+    std::vector<std::string_view> samples;
+    for(const auto& segment : segments) {
+        for(const auto& column : segment.columns())
+            add_samples(column->data().buffer(), samples);
+
+        if(segment.has_string_pool())
+            add_samples(segment.const_string_pool().data(), samples);
+    }
+
+    auto dictionary = train_zstd_dictionary(samples, max_dictionary_size);
+    if(dictionary.empty())
+        return std::nullopt;
+
+    const auto dictionary_id = write_zstd_dictionary(store, std::move(dictionary));
+    auto active = read_active_zstd_dictionaries(store);
+    active.insert_or_assign(key_type, dictionary_id);
+    write_active_zstd_dictionaries(store, active);
+    store->set_key_type_codec(key_type, zstd_dictionary_codec(dictionary_id));
+    log::version().info("Trained zstd dictionary {} for {} keys from {} samples", dictionary_id, key_type, samples.size());
+    return dictionary_id;
+}
+
+} // namespace arcticdb
@@ -0,0 +1,55 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/entity/key.hpp>
+#include <arcticdb/entity/protobufs.hpp>
+#include <arcticdb/storage/store.hpp>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace arcticdb {
+
+/*
+ * Trained zstd dictionaries for the small segments of a library, such as index, version and symbol list keys, where
+ * there is too little data in any one block for plain compression to find much redundancy.
+ *
+ * Each dictionary is stored under a ZSTD_DICTIONARY ref key named by its id and never rewritten, since blocks
+ * compressed with it may stay live indefinitely. A further ZSTD_DICTIONARY ref key maps each key type to the
+ * dictionary that its new segments are compressed with.
+ */
+using ActiveZstdDictionaries = std::unordered_map<entity::KeyType, uint64_t>;
+
+std::optional<std::string> read_zstd_dictionary(const std::shared_ptr<Store>& store, uint64_t dictionary_id);
+
+// Stores the dictionary and adds it to the process-wide cache, returning its id
+uint64_t write_zstd_dictionary(const std::shared_ptr<Store>& store, std::string dictionary);
+
+ActiveZstdDictionaries read_active_zstd_dictionaries(const std::shared_ptr<Store>& store);
+
+void write_active_zstd_dictionaries(const std::shared_ptr<Store>& store, const ActiveZstdDictionaries& active);
+
+arcticdb::proto::encoding::VariantCodec zstd_dictionary_codec(uint64_t dictionary_id);
+
+// Loads the library's active dictionaries and has the store compress each key type with its dictionary
+void apply_active_zstd_dictionaries(const std::shared_ptr<Store>& store);
+
+/*
+ * Trains a dictionary on the column and string pool blocks of up to max_samples existing segments of key_type, makes
+ * it the active dictionary for the key type and applies it to the store. Returns nullopt if there were too few
+ * samples to train on.
+ */
+std::optional<uint64_t> train_key_type_zstd_dictionary(
+    const std::shared_ptr<Store>& store,
+    entity::KeyType key_type,
+    size_t max_samples,
+    size_t max_dictionary_size);
+
+} // namespace arcticdb
@@ -1677,6 +1677,191 @@ class NativeVersionStore:
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
         return self._post_process_dataframe(read_result, read_query, query_builder)
 
+    def export_file(
+        self,
+        symbol: str,
+        path: str,
+        file_format: str = "parquet",
+        as_of: Optional[VersionQueryInput] = None,
+        date_range: Optional[DateRangeInput] = None,
+        row_range: Optional[Tuple[int, int]] = None,
+        columns: Optional[List[str]] = None,
+        max_concurrent_slices: int = 8,
+        **kwargs,
+    ) -> VersionedItem:
+        """
+        Export a version of the named symbol to a Parquet or Arrow IPC file without building a DataFrame.
+
+        The version is read one row slice at a time, with up to `max_concurrent_slices` slices fetched and decoded in
+        parallel, and each slice is handed to pyarrow through the Arrow C data interface and written as its own record
+        batch (or Parquet row group). Every batch has the same schema: strings are exported as plain large strings,
+        which Parquet then dictionary encodes itself where that pays off.
+
+        Parameters
+        ----------
+        symbol : `str`
+            Symbol name.
+        path : `str`
+            File to write.
+        file_format : `str`, default="parquet"
+            Either "parquet" or "ipc".
+        as_of, date_range, row_range, columns
+            As for `read`.
+        max_concurrent_slices : `int`, default=8
+            Number of row slices to hold in memory at once.
+
+        Returns
+        -------
+        VersionedItem
+            The version exported, with data set to None.
+        """
+        import pyarrow as pa
+        from pyarrow.cffi import ffi
+
+        check(file_format in ("parquet", "ipc"), "Unknown export file format {}", file_format)
+        version_query, read_options, read_query = self._get_queries(
+            symbol=symbol,
+            as_of=as_of,
+            date_range=date_range,
+            row_range=row_range,
+            columns=columns,
+            query_builder=None,
+            **kwargs,
+        )
+        writer = None
+        writer_schema = None
+
+        def write_slice(frame):
+            nonlocal writer, writer_schema
+            array = ffi.new("struct ArrowArray*")
+            schema = ffi.new("struct ArrowSchema*")
+            frame.export_arrow(int(ffi.cast("uintptr_t", array)), int(ffi.cast("uintptr_t", schema)), False)
+            batch = pa.RecordBatch._import_from_c(int(ffi.cast("uintptr_t", array)), int(ffi.cast("uintptr_t", schema)))
+            if writer is None:
+                if file_format == "parquet":
+                    import pyarrow.parquet as pq
+
+                    writer = pq.ParquetWriter(path, batch.schema)
+                else:
+                    writer = pa.ipc.new_file(path, batch.schema)
+                writer_schema = batch.schema
+            elif batch.schema != writer_schema:
+                # Slices are exported with the version's merged descriptor, so this only reconciles details such as
+                # schema metadata
+                batch = pa.Table.from_batches([batch]).cast(writer_schema).to_batches()[0]
+            if file_format == "parquet":
+                writer.write_table(pa.Table.from_batches([batch]))
+            else:
+                writer.write_batch(batch)
+
+        try:
+            vit = self.version_store.read_row_slices(
+                symbol, version_query, read_query, read_options, max_concurrent_slices, write_slice
+            )
+        finally:
+            if writer is not None:
+                writer.close()
+
+        return VersionedItem(
+            symbol=vit.symbol,
+            library=self._library.library_path,
+            version=vit.version,
+            metadata=None,
+            data=None,
+            host=self.env,
+        )
+
+    def import_file(
+        self,
+        symbol: str,
+        path: str,
+        file_format: str = "parquet",
+        index_column: Optional[str] = None,
+        metadata: Optional[Any] = None,
+        prune_previous_version: Optional[bool] = None,
+        **kwargs,
+    ) -> VersionedItem:
+        """
+        Write the contents of a Parquet or Arrow IPC file as a new version of the named symbol without building a
+        DataFrame.
+
+        The file is read with pyarrow one record batch (or Parquet row group) at a time, and each batch is handed to
+        the store through the Arrow C data interface and written before the next is read, so the whole file is never
+        held in memory. Numeric columns are written from the Arrow buffers in place, and string columns, including
+        dictionary encoded ones, are written without creating Python strings. Every batch must have the same columns.
+
+        Parameters
+        ----------
+        symbol : `str`
+            Symbol name.
+        path : `str`
+            File to read.
+        file_format : `str`, default="parquet"
+            Either "parquet" or "ipc".
+        index_column : `Optional[str]`, default=None
+            Timestamp column to use as the symbol's index. It must be sorted. Without it the data is written with a
+            row count index.
+        metadata : `Optional[Any]`, default=None
+            As for `write`.
+        prune_previous_version : `Optional[bool]`, default=None
+            As for `write`.
+
+        Returns
+        -------
+        VersionedItem
+        """
+        import pyarrow as pa
+
+        check(file_format in ("parquet", "ipc"), "Unknown import file format {}", file_format)
+        self.check_symbol_validity(symbol)
+        proto_cfg = self._lib_cfg.lib_desc.version.write_options
+        prune_previous_version = self.resolve_defaults(
+            "prune_previous_version", proto_cfg, global_default=False, existing_value=prune_previous_version, **kwargs
+        )
+        with pa.memory_map(path) as source:
+            if file_format == "parquet":
+                import pyarrow.parquet as pq
+
+                parquet_file = pq.ParquetFile(source)
+                file_schema = parquet_file.schema_arrow
+                batches = parquet_file.iter_batches()
+            else:
+                reader = pa.ipc.open_file(source)
+                file_schema = reader.schema
+                batches = (reader.get_batch(i) for i in range(reader.num_record_batches))
+
+            # The normalization metadata only depends on the column names and index, so it can come from an empty frame
+            empty = file_schema.empty_table().to_pandas()
+            if index_column is not None:
+                empty = empty.set_index(index_column)
+            udm, _, norm_meta = self._try_normalize(symbol, empty, metadata, False, True, None)
+
+            written = False
+
+            def next_batch(array_address, schema_address):
+                nonlocal written
+                batch = next(batches, None)
+                if batch is None:
+                    if written:
+                        return False
+                    # An empty file is still written, as an empty version
+                    batch = pa.RecordBatch.from_pylist([], schema=file_schema)
+                written = True
+                batch._export_to_c(array_address, schema_address)
+                return True
+
+            vit = self.version_store.write_arrow_batches(
+                symbol, next_batch, index_column, norm_meta, udm, prune_previous_version
+            )
+        return VersionedItem(
+            symbol=vit.symbol,
+            library=self._library.library_path,
+            version=vit.version,
+            metadata=metadata,
+            data=None,
+            host=self.env,
+        )
+
     def head(
         self,
         symbol: str,
@@ -6,6 +6,8 @@ Use of this software is governed by the Business Source License 1.1 included in
 As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
 """
 from arcticdb import Arctic
+from arcticdb.version_store.library import WritePayload
+from arcticdb_ext import set_config_int, unset_config_int
 
 from .common import *
 
@@ -56,3 +58,39 @@ class ListFunctions:
     def time_has_symbol(self, num_symbols):
         lib = self.ac[f"{num_symbols}_num_symbols"]
         lib.has_symbol("250_sym")
+
+
+class ListSymbolsFromVersionKeys:
+    """
+    Lists symbols from the version keys with one listing cursor and with the key type split into ranges listed
+    concurrently. Only LMDB is benchmarked: the in-memory backend cannot split a key type and always lists it as a
+    single range, so it would time the same path for both parameters.
+    """
+
+    number = 5
+    timeout = 6000
+
+    params = ([1, 16], [5000])
+    param_names = ["iterate_type_ranges", "num_symbols"]
+
+    def setup_cache(self):
+        self.ac = Arctic("lmdb://list_symbols_from_version_keys")
+
+        _, num_symbols = ListSymbolsFromVersionKeys.params
+        for syms in num_symbols:
+            lib_name = f"{syms}_num_symbols"
+            self.ac.delete_library(lib_name)
+            self.ac.create_library(lib_name)
+            lib = self.ac[lib_name]
+            lib.write_batch([WritePayload(f"{sym}_sym", generate_benchmark_df(1)) for sym in range(syms)])
+
+    def setup(self, iterate_type_ranges, num_symbols):
+        set_config_int("Storage.IterateTypeRanges", iterate_type_ranges)
+        self.ac = Arctic("lmdb://list_symbols_from_version_keys")
+
+    def teardown(self, iterate_type_ranges, num_symbols):
+        unset_config_int("Storage.IterateTypeRanges")
+
+    def time_list_symbols_without_symbol_list(self, iterate_type_ranges, num_symbols):
+        lib = self.ac[f"{num_symbols}_num_symbols"]
+        lib._nvs.list_symbols(use_symbol_list=False)
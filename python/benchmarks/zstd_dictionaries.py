@@ -0,0 +1,74 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+from arcticdb import Arctic
+from arcticdb.version_store.library import WritePayload
+from arcticdb_ext.storage import KeyType
+
+from .common import *
+
+
+TRAINED_KEY_TYPES = [KeyType.TABLE_INDEX, KeyType.VERSION, KeyType.SYMBOL_LIST]
+
+
+class ZstdDictionaries:
+    """
+    Index, version and symbol list keys are too small for plain compression to find much redundancy. Compares their
+    stored size, and the time to read them back, with and without trained dictionaries.
+    """
+
+    number = 5
+    timeout = 6000
+
+    params = ([False, True], [1000])
+    param_names = ["trained", "num_symbols"]
+
+    rows = 10
+
+    def setup_cache(self):
+        self.ac = Arctic("lmdb://zstd_dictionaries")
+
+        trained_params, num_symbols = ZstdDictionaries.params
+        for trained in trained_params:
+            for syms in num_symbols:
+                lib_name = f"{trained}_{syms}_num_symbols"
+                self.ac.delete_library(lib_name)
+                self.ac.create_library(lib_name)
+                lib = self.ac[lib_name]
+                payloads = [WritePayload(f"{sym}_sym", generate_benchmark_df(ZstdDictionaries.rows)) for sym in range(syms)]
+                lib.write_batch(payloads)
+                if trained:
+                    for key_type in TRAINED_KEY_TYPES:
+                        lib._nvs.version_store.train_zstd_dictionary(key_type)
+
+                # Both libraries are rewritten so that they hold the same keys, compressed with the dictionaries if
+                # they were trained
+                lib.write_batch(payloads, prune_previous_versions=True)
+
+    def setup(self, trained, num_symbols):
+        self.ac = Arctic("lmdb://zstd_dictionaries")
+        self.lib = self.ac[f"{trained}_{num_symbols}_num_symbols"]
+        self.symbols = [f"{sym}_sym" for sym in range(num_symbols)]
+
+    def _stored_bytes(self, key_type):
+        return self.lib._nvs.version_store.scan_object_sizes()[key_type][1]
+
+    def track_index_bytes(self, trained, num_symbols):
+        return self._stored_bytes(KeyType.TABLE_INDEX)
+
+    track_index_bytes.unit = "bytes"
+
+    def track_version_bytes(self, trained, num_symbols):
+        return self._stored_bytes(KeyType.VERSION)
+
+    track_version_bytes.unit = "bytes"
+
+    def time_get_description_batch(self, trained, num_symbols):
+        self.lib.get_description_batch(self.symbols)
+
+    def time_list_symbols(self, trained, num_symbols):
+        self.lib.list_symbols()
@@ -478,3 +478,30 @@ def test_append_docs_example(lmdb_version_store):
     assert_frame_equal(lib.read("test_frame").data, expected)
 
     print(lib.tail("test_frame", 7, as_of=0).data)
+
+
+def test_append_dynamic_schema_changes(lmdb_version_store_dynamic_schema, sym):
+    # Each append is its own segment, so the read decodes segments with different fields, including one with the same
+    # fields as an earlier segment that reuses its decode plan
+    lib = lmdb_version_store_dynamic_schema
+
+    def frame(start, **columns):
+        return pd.DataFrame(columns, index=pd.date_range(pd.Timestamp(2000, 1, 1) + pd.Timedelta(days=start), periods=3))
+
+    dfs = [
+        frame(0, a=np.arange(3, dtype=np.int32), b=np.arange(3, dtype=np.float64)),
+        # Column added
+        frame(3, a=np.arange(3, 6, dtype=np.int32), b=np.arange(3, 6, dtype=np.float64), c=np.arange(3, 6, dtype=np.float64)),
+        # Column dropped and a promoted from int32 to int64
+        frame(6, a=np.arange(2**40, 2**40 + 3, dtype=np.int64), c=np.arange(6, 9, dtype=np.float64)),
+        frame(9, a=np.arange(9, 12, dtype=np.int32), b=np.arange(9, 12, dtype=np.float64)),
+    ]
+    lib.write(sym, dfs[0])
+    for df in dfs[1:]:
+        lib.append(sym, df)
+
+    expected = pd.concat(dfs)
+    assert expected["a"].dtype == np.int64
+    assert_frame_equal(lib.read(sym).data, expected[["a", "b", "c"]], check_like=True)
+    assert_frame_equal(lib.read(sym, columns=["c", "a"]).data, expected[["c", "a"]], check_like=True)
+    assert_frame_equal(lib.read(sym, columns=["b"]).data, expected[["b"]])
@@ -0,0 +1,82 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb.util.test import assert_frame_equal
+from arcticdb_ext.exceptions import SortingException
+
+pa = pytest.importorskip("pyarrow")
+pq = pytest.importorskip("pyarrow.parquet")
+
+
+def _string_frame(rows):
+    # The first column repeats a few values, the second is all distinct, so slices would pick different encodings
+    return pd.DataFrame(
+        {
+            "x": np.arange(rows, dtype=np.int64),
+            "repeated": [f"r{i % 3}" for i in range(rows)],
+            "distinct": [f"d{i}" for i in range(rows)],
+            "y": np.arange(rows, dtype=np.float64),
+        },
+        index=pd.date_range("2023-01-01", periods=rows, freq="s"),
+    )
+
+
+@pytest.mark.parametrize("file_format", ["parquet", "ipc"])
+def test_export_import_round_trip(lmdb_version_store_tiny_segment, tmp_path, file_format):
+    lib = lmdb_version_store_tiny_segment
+    df = _string_frame(9)
+    lib.write("sym", df)
+    path = str(tmp_path / f"sym.{file_format}")
+
+    lib.export_file("sym", path, file_format=file_format)
+    if file_format == "parquet":
+        table = pq.read_table(path)
+        assert pq.ParquetFile(path).num_row_groups == 5
+    else:
+        with pa.memory_map(path) as source:
+            reader = pa.ipc.open_file(source)
+            assert reader.num_record_batches == 5
+            assert len({reader.get_batch(i).schema for i in range(reader.num_record_batches)}) == 1
+            table = reader.read_all()
+    assert table.column("distinct").to_pylist() == df["distinct"].tolist()
+    assert table.column("repeated").to_pylist() == df["repeated"].tolist()
+
+    vit = lib.import_file("imported", path, file_format=file_format, index_column="index")
+    assert vit.version == 0
+    assert_frame_equal(lib.read("imported").data, df.rename_axis("index"))
+
+
+@pytest.mark.parametrize("file_format", ["parquet", "ipc"])
+def test_import_batches_without_index(lmdb_version_store, tmp_path, file_format):
+    df = pd.DataFrame({"x": np.arange(10, dtype=np.int64), "s": [f"s{i % 4}" for i in range(10)]})
+    table = pa.Table.from_pandas(df, preserve_index=False)
+    path = str(tmp_path / f"sym.{file_format}")
+    if file_format == "parquet":
+        pq.write_table(table, path, row_group_size=3)
+    else:
+        with pa.ipc.new_file(path, table.schema) as writer:
+            for batch in table.to_batches(max_chunksize=3):
+                writer.write_batch(batch)
+
+    lmdb_version_store.import_file("sym", path, file_format=file_format)
+    assert_frame_equal(lmdb_version_store.read("sym").data, df)
+
+
+def test_import_unsorted_batches(lmdb_version_store, tmp_path):
+    index = pd.date_range("2023-01-01", periods=6, freq="s")
+    df = pd.DataFrame({"index": index[[3, 4, 5, 0, 1, 2]], "x": np.arange(6, dtype=np.int64)})
+    path = str(tmp_path / "sym.parquet")
+    pq.write_table(pa.Table.from_pandas(df, preserve_index=False), path, row_group_size=3)
+
+    # Each batch is sorted on its own but the second starts before the first ends
+    with pytest.raises(SortingException):
+        lmdb_version_store.import_file("sym", path, index_column="index")
+    assert not lmdb_version_store.has_symbol("sym")